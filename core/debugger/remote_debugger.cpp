@@ -618,12 +618,44 @@ Error RemoteDebugger::_core_capture(const String &p_cmd, const Array &p_data, bo
 		script_debugger->set_skip_breakpoints(p_data[0]);
 	} else if (p_cmd == "break") {
 		script_debugger->debug(script_debugger->get_break_language());
+	} else if (p_cmd == "allocation_dump") {
+		send_message("allocation_dump", _get_allocation_dump());
 	} else {
 		r_captured = false;
 	}
 	return OK;
 }
 
+Array RemoteDebugger::_get_allocation_dump() const {
+	// One entry per call site: [file or tag, line, allocations, bytes, live allocations, live bytes, live bytes histogram].
+	// Empty unless built with allocation tracking.
+	Array dump;
+#ifdef ALLOCATION_TRACKING_ENABLED
+	uint32_t site_count = AllocationTracker::get_site_count();
+	for (uint32_t i = 0; i < site_count; i++) {
+		AllocationTracker::SiteInfo info;
+		AllocationTracker::get_site_info(i, info);
+
+		PackedInt64Array histogram;
+		histogram.resize(AllocationTracker::HISTOGRAM_BUCKETS);
+		for (int j = 0; j < AllocationTracker::HISTOGRAM_BUCKETS; j++) {
+			histogram.set(j, info.live_histogram[j]);
+		}
+
+		Array site;
+		site.push_back(String(info.file));
+		site.push_back(info.line);
+		site.push_back(info.allocations);
+		site.push_back(info.bytes);
+		site.push_back(info.live_allocations);
+		site.push_back(info.live_bytes);
+		site.push_back(histogram);
+		dump.push_back(site);
+	}
+#endif
+	return dump;
+}
+
 Error RemoteDebugger::_profiler_capture(const String &p_cmd, const Array &p_data, bool &r_captured) {
 	r_captured = false;
 	ERR_FAIL_COND_V(p_data.size() < 1, ERR_INVALID_DATA);
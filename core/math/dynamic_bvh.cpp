@@ -284,6 +284,7 @@ DynamicBVH::Node *DynamicBVH::_node_sort(Node *n, Node *&r) {
 }
 
 void DynamicBVH::clear() {
+	pending_refits.clear();
 	if (bvh_root) {
 		_recurse_delete_node(bvh_root);
 	}
@@ -292,6 +293,7 @@ void DynamicBVH::clear() {
 }
 
 void DynamicBVH::optimize_bottom_up() {
+	flush_refits();
 	if (bvh_root) {
 		LocalVector<Node *> leaves;
 		_fetch_leaves(bvh_root, leaves);
@@ -301,6 +303,7 @@ void DynamicBVH::optimize_bottom_up() {
 }
 
 void DynamicBVH::optimize_top_down(int bu_threshold) {
+	flush_refits();
 	if (bvh_root) {
 		LocalVector<Node *> leaves;
 		_fetch_leaves(bvh_root, leaves);
@@ -309,6 +312,7 @@ void DynamicBVH::optimize_top_down(int bu_threshold) {
 }
 
 void DynamicBVH::optimize_incremental(int passes) {
+	flush_refits();
 	if (passes < 0) {
 		passes = total_leaves;
 	}
@@ -330,6 +334,8 @@ void DynamicBVH::optimize_incremental(int passes) {
 }
 
 DynamicBVH::ID DynamicBVH::insert(const AABB &p_box, void *p_userdata) {
+	flush_refits();
+
 	Volume volume;
 	volume.min = p_box.position;
 	volume.max = p_box.position + p_box.size;
@@ -371,6 +377,9 @@ bool DynamicBVH::update(const ID &p_id, const AABB &p_box) {
 		return false;
 	}
 
+	// Pending nodes may be deleted when removing the leaf.
+	flush_refits();
+
 	Node *base = _remove_leaf(leaf);
 	if (base) {
 		if (lkhd >= 0) {
@@ -386,8 +395,49 @@ bool DynamicBVH::update(const ID &p_id, const AABB &p_box) {
 	return true;
 }
 
+bool DynamicBVH::refit(const ID &p_id, const AABB &p_box) {
+	ERR_FAIL_COND_V(!p_id.is_valid(), false);
+	Node *leaf = p_id.node;
+
+	Volume volume;
+	volume.min = p_box.position;
+	volume.max = p_box.position + p_box.size;
+
+	if (leaf->volume.min.is_equal_approx(volume.min) && leaf->volume.max.is_equal_approx(volume.max)) {
+		// noop
+		return false;
+	}
+
+	Node *parent = leaf->parent;
+	if (!parent || !parent->volume.contains(volume)) {
+		// Moved out of its branch, re-insert it.
+		return update(p_id, p_box);
+	}
+
+	leaf->volume = volume;
+	pending_refits.push_back(parent);
+	return true;
+}
+
+void DynamicBVH::flush_refits() {
+	// Leaves only shrunk within their parents, so ancestors can only get tighter.
+	// Stop walking up as soon as a volume is unchanged, shared ancestors are visited once in practice.
+	for (Node *node : pending_refits) {
+		while (node) {
+			const Volume previous = node->volume;
+			node->volume = node->children[0]->volume.merge(node->children[1]->volume);
+			if (!previous.is_not_equal_to(node->volume)) {
+				break;
+			}
+			node = node->parent;
+		}
+	}
+	pending_refits.clear();
+}
+
 void DynamicBVH::remove(const ID &p_id) {
 	ERR_FAIL_COND(!p_id.is_valid());
+	flush_refits();
 	Node *leaf = p_id.node;
 	_remove_leaf(leaf);
 	_delete_node(leaf);
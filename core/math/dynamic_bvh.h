@@ -228,6 +228,7 @@ private:
 	int total_leaves = 0;
 	uint32_t opath = 0;
 	uint32_t index = 0;
+	LocalVector<Node *> pending_refits;
 
 	enum {
 		ALLOCA_STACK_SIZE = 128
@@ -293,6 +294,11 @@ public:
 	void optimize_incremental(int passes);
 	ID insert(const AABB &p_box, void *p_userdata);
 	bool update(const ID &p_id, const AABB &p_box);
+	// Like update(), but when the new box still fits inside the parent volume, the leaf is kept
+	// in place and its ancestors are only refit on flush_refits(). Ancestor volumes stay
+	// conservative until then, so queries remain correct in the meantime.
+	bool refit(const ID &p_id, const AABB &p_box);
+	void flush_refits();
 	void remove(const ID &p_id);
 	void get_elements(List<ID> *r_elements);
 
@@ -0,0 +1,304 @@
+/**************************************************************************/
+/*  simd_batch.cpp                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "simd_batch.h"
+
+#ifndef REAL_T_IS_DOUBLE
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIMD_BATCH_SSE2
+#if defined(__GNUC__) || defined(_MSC_VER)
+#define SIMD_BATCH_AVX2
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define SIMD_BATCH_NEON
+#endif
+#endif // REAL_T_IS_DOUBLE
+
+#if defined(SIMD_BATCH_AVX2)
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#elif defined(SIMD_BATCH_SSE2)
+#include <emmintrin.h>
+#elif defined(SIMD_BATCH_NEON)
+#include <arm_neon.h>
+#endif
+
+struct SIMDBatchKernels {
+	uint32_t width;
+	void (*transform_compose)(const SIMDBatch::TransformSoA &, const SIMDBatch::TransformSoA &, const SIMDBatch::TransformSoA &, uint32_t, uint32_t);
+	void (*transform_points)(const SIMDBatch::TransformSoA &, const SIMDBatch::Vector3SoA &, const SIMDBatch::Vector3SoA &, uint32_t, uint32_t);
+	void (*transform_points_uniform)(const Transform3D &, const SIMDBatch::Vector3SoA &, const SIMDBatch::Vector3SoA &, uint32_t, uint32_t);
+	void (*transform_aabbs)(const SIMDBatch::TransformSoA &, const SIMDBatch::AABBSoA &, const SIMDBatch::AABBSoA &, uint32_t, uint32_t);
+	uint32_t (*cull_aabbs)(const Plane *, int, const SIMDBatch::AABBSoA &, uint8_t *, uint32_t, uint32_t);
+};
+
+namespace SIMDBatchScalar {
+
+struct Lanes {
+	typedef real_t Value;
+	static constexpr uint32_t WIDTH = 1;
+	static constexpr uint32_t FULL_MASK = 0x1;
+
+	static _FORCE_INLINE_ Value load(const real_t *p_ptr) { return *p_ptr; }
+	static _FORCE_INLINE_ void store(real_t *p_ptr, Value p_value) { *p_ptr = p_value; }
+	static _FORCE_INLINE_ Value splat(real_t p_value) { return p_value; }
+	static _FORCE_INLINE_ Value add(Value p_a, Value p_b) { return p_a + p_b; }
+	static _FORCE_INLINE_ Value sub(Value p_a, Value p_b) { return p_a - p_b; }
+	static _FORCE_INLINE_ Value mul(Value p_a, Value p_b) { return p_a * p_b; }
+	static _FORCE_INLINE_ Value min(Value p_a, Value p_b) { return p_a < p_b ? p_a : p_b; }
+	static _FORCE_INLINE_ Value max(Value p_a, Value p_b) { return p_a < p_b ? p_b : p_a; }
+	static _FORCE_INLINE_ uint32_t greater_mask(Value p_a, Value p_b) { return p_a > p_b ? 1 : 0; }
+};
+
+#include "simd_batch_kernels.inc"
+
+} // namespace SIMDBatchScalar
+
+#ifdef SIMD_BATCH_SSE2
+namespace SIMDBatchSSE2 {
+
+struct Lanes {
+	typedef __m128 Value;
+	static constexpr uint32_t WIDTH = 4;
+	static constexpr uint32_t FULL_MASK = 0xF;
+
+	static _FORCE_INLINE_ Value load(const real_t *p_ptr) { return _mm_loadu_ps(p_ptr); }
+	static _FORCE_INLINE_ void store(real_t *p_ptr, Value p_value) { _mm_storeu_ps(p_ptr, p_value); }
+	static _FORCE_INLINE_ Value splat(real_t p_value) { return _mm_set1_ps(p_value); }
+	static _FORCE_INLINE_ Value add(Value p_a, Value p_b) { return _mm_add_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Value sub(Value p_a, Value p_b) { return _mm_sub_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Value mul(Value p_a, Value p_b) { return _mm_mul_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Value min(Value p_a, Value p_b) { return _mm_min_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Value max(Value p_a, Value p_b) { return _mm_max_ps(p_a, p_b); }
+	static _FORCE_INLINE_ uint32_t greater_mask(Value p_a, Value p_b) { return _mm_movemask_ps(_mm_cmpgt_ps(p_a, p_b)); }
+};
+
+#include "simd_batch_kernels.inc"
+
+} // namespace SIMDBatchSSE2
+#endif // SIMD_BATCH_SSE2
+
+#ifdef SIMD_BATCH_AVX2
+// Compiled for AVX2 regardless of the global build flags, and only used when
+// the CPU supports it.
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace SIMDBatchAVX2 {
+
+struct Lanes {
+	typedef __m256 Value;
+	static constexpr uint32_t WIDTH = 8;
+	static constexpr uint32_t FULL_MASK = 0xFF;
+
+	static _FORCE_INLINE_ Value load(const real_t *p_ptr) { return _mm256_loadu_ps(p_ptr); }
+	static _FORCE_INLINE_ void store(real_t *p_ptr, Value p_value) { _mm256_storeu_ps(p_ptr, p_value); }
+	static _FORCE_INLINE_ Value splat(real_t p_value) { return _mm256_set1_ps(p_value); }
+	static _FORCE_INLINE_ Value add(Value p_a, Value p_b) { return _mm256_add_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Value sub(Value p_a, Value p_b) { return _mm256_sub_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Value mul(Value p_a, Value p_b) { return _mm256_mul_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Value min(Value p_a, Value p_b) { return _mm256_min_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Value max(Value p_a, Value p_b) { return _mm256_max_ps(p_a, p_b); }
+	static _FORCE_INLINE_ uint32_t greater_mask(Value p_a, Value p_b) { return _mm256_movemask_ps(_mm256_cmp_ps(p_a, p_b, _CMP_GT_OQ)); }
+};
+
+#include "simd_batch_kernels.inc"
+
+} // namespace SIMDBatchAVX2
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+static bool _cpu_has_avx2() {
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7) {
+		return false;
+	}
+	__cpuid(info, 1);
+	const bool osxsave = (info[2] & (1 << 27)) != 0;
+	const bool avx = (info[2] & (1 << 28)) != 0;
+	if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+		return false; // The OS doesn't save the YMM registers.
+	}
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif // SIMD_BATCH_AVX2
+
+#ifdef SIMD_BATCH_NEON
+namespace SIMDBatchNEON {
+
+struct Lanes {
+	typedef float32x4_t Value;
+	static constexpr uint32_t WIDTH = 4;
+	static constexpr uint32_t FULL_MASK = 0xF;
+
+	static _FORCE_INLINE_ Value load(const real_t *p_ptr) { return vld1q_f32(p_ptr); }
+	static _FORCE_INLINE_ void store(real_t *p_ptr, Value p_value) { vst1q_f32(p_ptr, p_value); }
+	static _FORCE_INLINE_ Value splat(real_t p_value) { return vdupq_n_f32(p_value); }
+	static _FORCE_INLINE_ Value add(Value p_a, Value p_b) { return vaddq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ Value sub(Value p_a, Value p_b) { return vsubq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ Value mul(Value p_a, Value p_b) { return vmulq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ Value min(Value p_a, Value p_b) { return vminq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ Value max(Value p_a, Value p_b) { return vmaxq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ uint32_t greater_mask(Value p_a, Value p_b) {
+		uint32x4_t gt = vcgtq_f32(p_a, p_b);
+		return (vgetq_lane_u32(gt, 0) & 1) | (vgetq_lane_u32(gt, 1) & 2) | (vgetq_lane_u32(gt, 2) & 4) | (vgetq_lane_u32(gt, 3) & 8);
+	}
+};
+
+#include "simd_batch_kernels.inc"
+
+} // namespace SIMDBatchNEON
+#endif // SIMD_BATCH_NEON
+
+struct SIMDBatchBackends {
+	const SIMDBatchKernels *kernels[SIMDBatch::BACKEND_MAX] = {};
+	SIMDBatch::Backend current = SIMDBatch::BACKEND_SCALAR;
+
+	SIMDBatchBackends() {
+		kernels[SIMDBatch::BACKEND_SCALAR] = &SIMDBatchScalar::kernels;
+#ifdef SIMD_BATCH_SSE2
+		kernels[SIMDBatch::BACKEND_SSE2] = &SIMDBatchSSE2::kernels;
+#endif
+#ifdef SIMD_BATCH_AVX2
+		if (_cpu_has_avx2()) {
+			kernels[SIMDBatch::BACKEND_AVX2] = &SIMDBatchAVX2::kernels;
+		}
+#endif
+#ifdef SIMD_BATCH_NEON
+		kernels[SIMDBatch::BACKEND_NEON] = &SIMDBatchNEON::kernels;
+#endif
+
+		for (int i = SIMDBatch::BACKEND_MAX - 1; i >= 0; i--) {
+			if (kernels[i]) {
+				current = SIMDBatch::Backend(i);
+				break;
+			}
+		}
+	}
+};
+
+// The first use may come from several worker threads at once (e.g. scene culling),
+// the function-local static makes sure the detection runs exactly once.
+static SIMDBatchBackends &_get_backends() {
+	static SIMDBatchBackends backends;
+	return backends;
+}
+
+static _FORCE_INLINE_ const SIMDBatchKernels *_get_kernels() {
+	const SIMDBatchBackends &backends = _get_backends();
+	return backends.kernels[backends.current];
+}
+
+// Number of leading elements the backend processes; the rest goes through the scalar kernels.
+static _FORCE_INLINE_ uint32_t _simd_end(const SIMDBatchKernels *p_kernels, uint32_t p_count) {
+	return p_count - (p_count % p_kernels->width);
+}
+
+void SIMDBatch::transform_compose(const TransformSoA &p_a, const TransformSoA &p_b, const TransformSoA &r_result, uint32_t p_count) {
+	const SIMDBatchKernels *k = _get_kernels();
+	uint32_t end = _simd_end(k, p_count);
+	k->transform_compose(p_a, p_b, r_result, 0, end);
+	SIMDBatchScalar::transform_compose(p_a, p_b, r_result, end, p_count);
+}
+
+void SIMDBatch::transform_points(const TransformSoA &p_transforms, const Vector3SoA &p_points, const Vector3SoA &r_points, uint32_t p_count) {
+	const SIMDBatchKernels *k = _get_kernels();
+	uint32_t end = _simd_end(k, p_count);
+	k->transform_points(p_transforms, p_points, r_points, 0, end);
+	SIMDBatchScalar::transform_points(p_transforms, p_points, r_points, end, p_count);
+}
+
+void SIMDBatch::transform_points(const Transform3D &p_transform, const Vector3SoA &p_points, const Vector3SoA &r_points, uint32_t p_count) {
+	const SIMDBatchKernels *k = _get_kernels();
+	uint32_t end = _simd_end(k, p_count);
+	k->transform_points_uniform(p_transform, p_points, r_points, 0, end);
+	SIMDBatchScalar::transform_points_uniform(p_transform, p_points, r_points, end, p_count);
+}
+
+void SIMDBatch::transform_aabbs(const TransformSoA &p_transforms, const AABBSoA &p_aabbs, const AABBSoA &r_aabbs, uint32_t p_count) {
+	const SIMDBatchKernels *k = _get_kernels();
+	uint32_t end = _simd_end(k, p_count);
+	k->transform_aabbs(p_transforms, p_aabbs, r_aabbs, 0, end);
+	SIMDBatchScalar::transform_aabbs(p_transforms, p_aabbs, r_aabbs, end, p_count);
+}
+
+uint32_t SIMDBatch::cull_aabbs(const Plane *p_planes, int p_plane_count, const AABBSoA &p_aabbs, uint8_t *r_inside, uint32_t p_count) {
+	const SIMDBatchKernels *k = _get_kernels();
+	uint32_t end = _simd_end(k, p_count);
+	uint32_t inside = k->cull_aabbs(p_planes, p_plane_count, p_aabbs, r_inside, 0, end);
+	return inside + SIMDBatchScalar::cull_aabbs(p_planes, p_plane_count, p_aabbs, r_inside, end, p_count);
+}
+
+bool SIMDBatch::is_backend_supported(Backend p_backend) {
+	ERR_FAIL_INDEX_V(p_backend, BACKEND_MAX, false);
+	return _get_backends().kernels[p_backend] != nullptr;
+}
+
+bool SIMDBatch::set_backend(Backend p_backend) {
+	ERR_FAIL_INDEX_V(p_backend, BACKEND_MAX, false);
+	SIMDBatchBackends &backends = _get_backends();
+	if (!backends.kernels[p_backend]) {
+		return false;
+	}
+	backends.current = p_backend;
+	return true;
+}
+
+SIMDBatch::Backend SIMDBatch::get_backend() {
+	return _get_backends().current;
+}
+
+const char *SIMDBatch::get_backend_name(Backend p_backend) {
+	static const char *names[BACKEND_MAX] = {
+		"Scalar",
+		"SSE2",
+		"AVX2",
+		"NEON",
+	};
+	ERR_FAIL_INDEX_V(p_backend, BACKEND_MAX, "");
+	return names[p_backend];
+}
@@ -0,0 +1,96 @@
+/**************************************************************************/
+/*  simd_batch.h                                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SIMD_BATCH_H
+#define SIMD_BATCH_H
+
+#include "core/math/plane.h"
+#include "core/math/transform_3d.h"
+
+// Batch kernels operating on structure-of-arrays (SoA) data, so hot loops can
+// process several transforms, points or boxes per instruction. Every pointer
+// in a SoA view addresses `p_count` consecutive values.
+//
+// The fastest backend supported by the CPU is picked on first use (AVX2 is
+// detected at runtime, SSE2 and NEON at compile time). All backends produce
+// the same results as the scalar one, up to floating point rounding. Builds
+// with double precision `real_t` always use the scalar backend.
+//
+// Outputs may alias inputs of the same element (in-place updates), but not
+// overlap them at an offset.
+
+class SIMDBatch {
+public:
+	enum Backend {
+		BACKEND_SCALAR,
+		BACKEND_SSE2,
+		BACKEND_AVX2,
+		BACKEND_NEON,
+		BACKEND_MAX
+	};
+
+	struct Vector3SoA {
+		real_t *x = nullptr;
+		real_t *y = nullptr;
+		real_t *z = nullptr;
+	};
+
+	// Same layout as Transform3D: basis[row][column], then the origin.
+	struct TransformSoA {
+		real_t *basis[3][3] = {};
+		real_t *origin[3] = {};
+	};
+
+	struct AABBSoA {
+		real_t *position[3] = {};
+		real_t *size[3] = {};
+	};
+
+	// r_result[i] = p_a[i] * p_b[i]
+	static void transform_compose(const TransformSoA &p_a, const TransformSoA &p_b, const TransformSoA &r_result, uint32_t p_count);
+	// r_points[i] = p_transforms[i].xform(p_points[i])
+	static void transform_points(const TransformSoA &p_transforms, const Vector3SoA &p_points, const Vector3SoA &r_points, uint32_t p_count);
+	// r_points[i] = p_transform.xform(p_points[i])
+	static void transform_points(const Transform3D &p_transform, const Vector3SoA &p_points, const Vector3SoA &r_points, uint32_t p_count);
+	// r_aabbs[i] = p_transforms[i].xform(p_aabbs[i])
+	static void transform_aabbs(const TransformSoA &p_transforms, const AABBSoA &p_aabbs, const AABBSoA &r_aabbs, uint32_t p_count);
+	// r_inside[i] = 1 unless p_aabbs[i] is fully over one of the planes (as in AABB::intersects_convex_shape()).
+	// Returns the number of boxes that were not culled.
+	static uint32_t cull_aabbs(const Plane *p_planes, int p_plane_count, const AABBSoA &p_aabbs, uint8_t *r_inside, uint32_t p_count);
+
+	static bool is_backend_supported(Backend p_backend);
+	// Mostly for testing and benchmarking. Returns false if the backend can't be used.
+	// Main thread only, and not while batch operations may be running on other threads.
+	static bool set_backend(Backend p_backend);
+	static Backend get_backend();
+	static const char *get_backend_name(Backend p_backend);
+};
+
+#endif // SIMD_BATCH_H
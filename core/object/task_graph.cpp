@@ -0,0 +1,289 @@
+/**************************************************************************/
+/*  task_graph.cpp                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "task_graph.h"
+
+void TaskGraph::_node_task_func(void *p_userdata) {
+	Node *node = (Node *)p_userdata;
+	if (node->native_func) {
+		node->native_func(node->native_func_userdata);
+	} else {
+		node->callable.call();
+	}
+	node->graph->_node_finished(node);
+}
+
+void TaskGraph::_node_group_func(void *p_userdata, uint32_t p_index) {
+	Node *node = (Node *)p_userdata;
+	if (node->native_group_func) {
+		node->native_group_func(node->native_func_userdata, p_index);
+	} else {
+		node->callable.call(p_index);
+	}
+	if (node->pending_elements.decrement() == 0) {
+		// Last element of the group, the node is done even if other group tasks are still winding down.
+		node->graph->_node_finished(node);
+	}
+}
+
+TaskGraph::NodeID TaskGraph::_add_node(const Callable &p_callable, void (*p_func)(void *), void (*p_group_func)(void *, uint32_t), void *p_userdata, bool p_is_group, int p_elements, int p_tasks, const String &p_description) {
+	ERR_FAIL_COND_V_MSG(running, INVALID_NODE_ID, "Can't add nodes to a TaskGraph while it's running.");
+	ERR_FAIL_COND_V(p_is_group && p_elements < 0, INVALID_NODE_ID);
+
+	Node *node = memnew(Node);
+	node->graph = this;
+	node->callable = p_callable;
+	node->native_func = p_func;
+	node->native_group_func = p_group_func;
+	node->native_func_userdata = p_userdata;
+	node->description = p_description;
+	node->is_group = p_is_group;
+	node->elements = p_elements;
+	node->tasks = p_tasks;
+	nodes.push_back(node);
+	return nodes.size() - 1;
+}
+
+void TaskGraph::_release_node(Node *p_node) {
+	if (p_node->is_group) {
+		if (p_node->elements == 0) {
+			// Nothing to run, so no pool task either.
+			p_node->pool_id = WorkerThreadPool::INVALID_TASK_ID;
+			_operation_done();
+			_node_finished(p_node);
+			return;
+		}
+		p_node->pending_elements.set(p_node->elements);
+		p_node->pool_id = WorkerThreadPool::get_singleton()->add_native_group_task(_node_group_func, p_node, p_node->elements, p_node->tasks, high_priority, p_node->description);
+	} else {
+		p_node->pool_id = WorkerThreadPool::get_singleton()->add_native_task(_node_task_func, p_node, high_priority, p_node->description);
+	}
+	// The node may have finished already, but the pool ID is only known now.
+	_operation_done();
+}
+
+void TaskGraph::_node_finished(Node *p_node) {
+	for (NodeID successor_id : p_node->successors) {
+		Node *successor = nodes[successor_id];
+		if (successor->pending_predecessors.decrement() == 0) {
+			_release_node(successor);
+		}
+	}
+	_operation_done();
+}
+
+void TaskGraph::_operation_done() {
+	if (pending_operations.decrement() > 0) {
+		return;
+	}
+
+	if (native_continuation) {
+		native_continuation(native_continuation_userdata);
+	} else if (continuation.is_valid()) {
+		continuation.call();
+	}
+
+	completed.set();
+	done_semaphore.post();
+}
+
+bool TaskGraph::_has_cycles() const {
+	// Kahn's algorithm, every node must be reachable from the roots.
+	LocalVector<uint32_t> in_degree;
+	LocalVector<NodeID> ready;
+	in_degree.resize(nodes.size());
+	for (uint32_t i = 0; i < nodes.size(); i++) {
+		in_degree[i] = nodes[i]->predecessor_count;
+		if (in_degree[i] == 0) {
+			ready.push_back(i);
+		}
+	}
+
+	uint32_t visited = 0;
+	while (ready.size()) {
+		NodeID id = ready[ready.size() - 1];
+		ready.resize(ready.size() - 1);
+		visited++;
+		for (NodeID successor_id : nodes[id]->successors) {
+			if (--in_degree[successor_id] == 0) {
+				ready.push_back(successor_id);
+			}
+		}
+	}
+
+	return visited != nodes.size();
+}
+
+TaskGraph::NodeID TaskGraph::add_native_task(void (*p_func)(void *), void *p_userdata, const String &p_description) {
+	return _add_node(Callable(), p_func, nullptr, p_userdata, false, 0, -1, p_description);
+}
+
+TaskGraph::NodeID TaskGraph::add_task(const Callable &p_action, const String &p_description) {
+	return _add_node(p_action, nullptr, nullptr, nullptr, false, 0, -1, p_description);
+}
+
+TaskGraph::NodeID TaskGraph::add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, const String &p_description) {
+	return _add_node(Callable(), nullptr, p_func, p_userdata, true, p_elements, p_tasks, p_description);
+}
+
+TaskGraph::NodeID TaskGraph::add_group_task(const Callable &p_action, int p_elements, int p_tasks, const String &p_description) {
+	return _add_node(p_action, nullptr, nullptr, nullptr, true, p_elements, p_tasks, p_description);
+}
+
+Error TaskGraph::add_dependency(NodeID p_node, NodeID p_depends_on) {
+	ERR_FAIL_COND_V_MSG(running, ERR_BUSY, "Can't add dependencies to a TaskGraph while it's running.");
+	ERR_FAIL_INDEX_V(p_node, (NodeID)nodes.size(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_INDEX_V(p_depends_on, (NodeID)nodes.size(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(p_node == p_depends_on, ERR_CYCLIC_LINK, "A TaskGraph node can't depend on itself.");
+
+	Node *predecessor = nodes[p_depends_on];
+	if (predecessor->successors.find(p_node) != -1) {
+		return OK; // Already linked.
+	}
+	predecessor->successors.push_back(p_node);
+	nodes[p_node]->predecessor_count++;
+	return OK;
+}
+
+int TaskGraph::get_node_count() const {
+	return nodes.size();
+}
+
+void TaskGraph::set_native_continuation(void (*p_func)(void *), void *p_userdata) {
+	ERR_FAIL_COND_MSG(running, "Can't change the continuation of a TaskGraph while it's running.");
+	native_continuation = p_func;
+	native_continuation_userdata = p_userdata;
+}
+
+void TaskGraph::set_continuation(const Callable &p_action) {
+	ERR_FAIL_COND_MSG(running, "Can't change the continuation of a TaskGraph while it's running.");
+	continuation = p_action;
+}
+
+Callable TaskGraph::get_continuation() const {
+	return continuation;
+}
+
+Error TaskGraph::submit(bool p_high_priority) {
+	ERR_FAIL_COND_V_MSG(running, ERR_BUSY, "TaskGraph is already running, wait for it before submitting it again.");
+	ERR_FAIL_COND_V_MSG(_has_cycles(), ERR_CYCLIC_LINK, "TaskGraph has cyclic dependencies.");
+
+	running = true;
+	high_priority = p_high_priority;
+	completed.clear();
+
+	LocalVector<Node *> roots;
+	for (Node *node : nodes) {
+		node->pending_predecessors.set(node->predecessor_count);
+		node->pool_id = WorkerThreadPool::INVALID_TASK_ID;
+		if (node->predecessor_count == 0) {
+			roots.push_back(node);
+		}
+	}
+
+	// One extra operation for the submission itself, so an empty graph or
+	// very fast roots can't complete the graph while roots are still being released.
+	pending_operations.set(nodes.size() * 2 + 1);
+	for (Node *node : roots) {
+		_release_node(node);
+	}
+	_operation_done();
+
+	return OK;
+}
+
+bool TaskGraph::is_running() const {
+	return running;
+}
+
+bool TaskGraph::is_completed() const {
+	return completed.is_set();
+}
+
+void TaskGraph::wait() {
+	ERR_FAIL_COND_MSG(!running, "TaskGraph was not submitted.");
+
+	done_semaphore.wait();
+
+	// Everything finished already, this only lets the pool dispose of the tasks.
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	for (Node *node : nodes) {
+		if (node->pool_id == WorkerThreadPool::INVALID_TASK_ID) {
+			continue;
+		}
+		if (node->is_group) {
+			pool->wait_for_group_task_completion(node->pool_id);
+		} else {
+			pool->wait_for_task_completion(node->pool_id);
+		}
+		node->pool_id = WorkerThreadPool::INVALID_TASK_ID;
+	}
+
+	running = false;
+}
+
+void TaskGraph::clear() {
+	ERR_FAIL_COND_MSG(running, "Can't clear a TaskGraph while it's running.");
+	for (Node *node : nodes) {
+		memdelete(node);
+	}
+	nodes.clear();
+	continuation = Callable();
+	native_continuation = nullptr;
+	native_continuation_userdata = nullptr;
+}
+
+void TaskGraph::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("add_task", "action", "description"), &TaskGraph::add_task, DEFVAL(String()));
+	ClassDB::bind_method(D_METHOD("add_group_task", "action", "elements", "tasks_needed", "description"), &TaskGraph::add_group_task, DEFVAL(-1), DEFVAL(String()));
+	ClassDB::bind_method(D_METHOD("add_dependency", "node_id", "depends_on_id"), &TaskGraph::add_dependency);
+	ClassDB::bind_method(D_METHOD("get_node_count"), &TaskGraph::get_node_count);
+
+	ClassDB::bind_method(D_METHOD("set_continuation", "action"), &TaskGraph::set_continuation);
+	ClassDB::bind_method(D_METHOD("get_continuation"), &TaskGraph::get_continuation);
+
+	ClassDB::bind_method(D_METHOD("submit", "high_priority"), &TaskGraph::submit, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("is_running"), &TaskGraph::is_running);
+	ClassDB::bind_method(D_METHOD("is_completed"), &TaskGraph::is_completed);
+	ClassDB::bind_method(D_METHOD("wait"), &TaskGraph::wait);
+	ClassDB::bind_method(D_METHOD("clear"), &TaskGraph::clear);
+
+	BIND_CONSTANT(INVALID_NODE_ID);
+}
+
+TaskGraph::TaskGraph() {
+}
+
+TaskGraph::~TaskGraph() {
+	if (running) {
+		wait();
+	}
+	clear();
+}
@@ -0,0 +1,125 @@
+/**************************************************************************/
+/*  task_graph.h                                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TASK_GRAPH_H
+#define TASK_GRAPH_H
+
+#include "core/object/ref_counted.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/semaphore.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+// A set of WorkerThreadPool tasks and group tasks with explicit predecessor edges.
+// Nodes are submitted to the pool only once all their predecessors are done, from the
+// worker thread that completed the last one, so no worker thread is ever parked waiting
+// for another task. Only the thread calling wait() blocks.
+// A graph can be submitted again once it has been waited for.
+
+class TaskGraph : public RefCounted {
+	GDCLASS(TaskGraph, RefCounted);
+
+public:
+	enum {
+		INVALID_NODE_ID = -1
+	};
+
+	typedef int32_t NodeID;
+
+private:
+	struct Node {
+		TaskGraph *graph = nullptr;
+
+		Callable callable;
+		void (*native_func)(void *) = nullptr;
+		void (*native_group_func)(void *, uint32_t) = nullptr;
+		void *native_func_userdata = nullptr;
+		String description;
+
+		bool is_group = false;
+		int elements = 0;
+		int tasks = -1;
+
+		LocalVector<NodeID> successors;
+		uint32_t predecessor_count = 0;
+
+		SafeNumeric<uint32_t> pending_predecessors;
+		SafeNumeric<uint32_t> pending_elements;
+		int64_t pool_id = WorkerThreadPool::INVALID_TASK_ID;
+	};
+
+	LocalVector<Node *> nodes;
+
+	Callable continuation;
+	void (*native_continuation)(void *) = nullptr;
+	void *native_continuation_userdata = nullptr;
+
+	bool high_priority = true;
+	bool running = false;
+	// Each node counts twice: once when its pool task ID has been stored, once when it has finished.
+	SafeNumeric<uint32_t> pending_operations;
+	SafeFlag completed;
+	Semaphore done_semaphore;
+
+	static void _node_task_func(void *p_userdata);
+	static void _node_group_func(void *p_userdata, uint32_t p_index);
+
+	NodeID _add_node(const Callable &p_callable, void (*p_func)(void *), void (*p_group_func)(void *, uint32_t), void *p_userdata, bool p_is_group, int p_elements, int p_tasks, const String &p_description);
+	void _release_node(Node *p_node);
+	void _node_finished(Node *p_node);
+	void _operation_done();
+	bool _has_cycles() const;
+
+protected:
+	static void _bind_methods();
+
+public:
+	NodeID add_native_task(void (*p_func)(void *), void *p_userdata, const String &p_description = String());
+	NodeID add_task(const Callable &p_action, const String &p_description = String());
+	NodeID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, const String &p_description = String());
+	NodeID add_group_task(const Callable &p_action, int p_elements, int p_tasks = -1, const String &p_description = String());
+	Error add_dependency(NodeID p_node, NodeID p_depends_on);
+	int get_node_count() const;
+
+	void set_native_continuation(void (*p_func)(void *), void *p_userdata);
+	void set_continuation(const Callable &p_action);
+	Callable get_continuation() const;
+
+	Error submit(bool p_high_priority = true);
+	bool is_running() const;
+	bool is_completed() const;
+	void wait();
+	void clear();
+
+	TaskGraph();
+	~TaskGraph();
+};
+
+#endif // TASK_GRAPH_H
@@ -43,11 +43,48 @@ void WorkerThreadPool::Task::free_template_userdata() {
 WorkerThreadPool *WorkerThreadPool::singleton = nullptr;
 
 void WorkerThreadPool::_process_task_queue() {
+	// Only called from pool threads which have already claimed a unit from task_available_semaphore,
+	// so there is a task available somewhere (own queue, shared queue or another thread's queue).
+	Task *task = _take_task(thread_ids[Thread::get_caller_id()]);
+	if (unlikely(!task)) {
+		// Lost every race for the available tasks. The task our unit stands for is still queued,
+		// so give the unit back and let the caller park on the semaphore again.
+		task_available_semaphore.post();
+		return;
+	}
+	_process_task(task);
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_take_task(uint32_t p_thread_index) {
+	Task *task = nullptr;
+	uint32_t thread_count = threads.size();
+
+	// Own queue first, most recently posted (and most likely cache hot) task first.
+	if (threads[p_thread_index].work_queue.pop(task)) {
+		return task;
+	}
+
 	task_mutex.lock();
-	Task *task = task_queue.first()->self();
-	task_queue.remove(task_queue.first());
+	if (task_queue.first()) {
+		task = task_queue.first()->self();
+		task_queue.remove(task_queue.first());
+		task_mutex.unlock();
+		return task;
+	}
 	task_mutex.unlock();
-	_process_task(task);
+
+	// Steal the oldest task from the other threads. A failed steal on a non-empty queue only
+	// means another thread won that element, so keep trying the same queue until it drains.
+	for (uint32_t i = 1; i < thread_count; i++) {
+		WorkStealingQueue<Task *> &work_queue = threads[(p_thread_index + i) % thread_count].work_queue;
+		while (!work_queue.is_empty()) {
+			if (work_queue.steal(task)) {
+				return task;
+			}
+		}
+	}
+
+	return nullptr;
 }
 
 void WorkerThreadPool::_process_task(Task *p_task) {
@@ -192,19 +229,64 @@ void WorkerThreadPool::_native_low_priority_thread_function(void *p_user) {
 	singleton->_process_task(task);
 }
 
-void WorkerThreadPool::_post_task(Task *p_task, bool p_high_priority) {
+void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority) {
 	// Fall back to processing on the calling thread if there are no worker threads.
 	// Separated into its own variable to make it easier to extend this logic
 	// in custom builds.
 	bool process_on_calling_thread = threads.size() == 0;
 	if (process_on_calling_thread) {
-		_process_task(p_task);
+		for (uint32_t i = 0; i < p_count; i++) {
+			_process_task(p_tasks[i]);
+		}
+		return;
+	}
+
+	if (!p_high_priority) {
+		for (uint32_t i = 0; i < p_count; i++) {
+			_post_low_priority_task(p_tasks[i]);
+		}
 		return;
 	}
 
+	if (!work_stealing_enabled.is_set()) {
+		// Previous behavior, kept for benchmarking: one lock and one semaphore post per task.
+		for (uint32_t i = 0; i < p_count; i++) {
+			task_mutex.lock();
+			task_queue.add_last(&p_tasks[i]->task_elem);
+			task_mutex.unlock();
+			task_available_semaphore.post();
+		}
+		return;
+	}
+
+	// Tasks posted from a pool thread (nested tasks, group tasks spawned by tasks) go to its
+	// own queue, so it can pop them without locking and idle threads can steal them.
+	uint32_t posted = 0;
+	const int *caller_pool_th_index = thread_ids.getptr(Thread::get_caller_id());
+	if (caller_pool_th_index) {
+		WorkStealingQueue<Task *> &work_queue = threads[*caller_pool_th_index].work_queue;
+		while (posted < p_count && work_queue.push(p_tasks[posted])) {
+			posted++;
+		}
+	}
+
+	// Everything else (posted from outside the pool, or overflowing the local queue) is
+	// added to the shared queue at once, so fan-outs take the lock only once.
+	if (posted < p_count) {
+		task_mutex.lock();
+		for (uint32_t i = posted; i < p_count; i++) {
+			task_queue.add_last(&p_tasks[i]->task_elem);
+		}
+		task_mutex.unlock();
+	}
+
+	task_available_semaphore.post(p_count);
+}
+
+void WorkerThreadPool::_post_low_priority_task(Task *p_task) {
 	task_mutex.lock();
-	p_task->low_priority = !p_high_priority;
-	if (!p_high_priority && use_native_low_priority_threads) {
+	p_task->low_priority = true;
+	if (use_native_low_priority_threads) {
 		p_task->low_priority_thread = native_thread_allocator.alloc();
 		task_mutex.unlock();
 
@@ -212,11 +294,9 @@ void WorkerThreadPool::_post_task(Task *p_task, bool p_high_priority) {
 			p_task->group->low_priority_native_tasks.push_back(p_task);
 		}
 		p_task->low_priority_thread->start(_native_low_priority_thread_function, p_task); // Pask task directly to thread.
-	} else if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
+	} else if (low_priority_threads_used < max_low_priority_threads) {
 		task_queue.add_last(&p_task->task_elem);
-		if (!p_high_priority) {
-			low_priority_threads_used++;
-		}
+		low_priority_threads_used++;
 		task_mutex.unlock();
 		task_available_semaphore.post();
 	} else {
@@ -272,7 +352,7 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 	tasks.insert(id, task);
 	task_mutex.unlock();
 
-	_post_task(task, p_high_priority);
+	_post_tasks(&task, 1, p_high_priority);
 
 	return id;
 }
@@ -448,9 +528,7 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 	groups[id] = group;
 	task_mutex.unlock();
 
-	for (int i = 0; i < p_tasks; i++) {
-		_post_task(tasks_posted[i], p_high_priority);
-	}
+	_post_tasks(tasks_posted, p_tasks, p_high_priority);
 
 	return id;
 }
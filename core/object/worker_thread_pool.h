@@ -39,6 +39,7 @@
 #include "core/templates/paged_allocator.h"
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_queue.h"
 
 class WorkerThreadPool : public Object {
 	GDCLASS(WorkerThreadPool, Object)
@@ -106,6 +107,9 @@ private:
 		uint32_t index;
 		Thread thread;
 		Task *current_low_prio_task = nullptr;
+		// High priority tasks posted from this thread. Only this thread pushes and pops,
+		// the rest of the pool steals from it when idle.
+		WorkStealingQueue<Task *> work_queue;
 	};
 
 	TightLocalVector<ThreadData> threads;
@@ -116,6 +120,7 @@ private:
 	HashMap<GroupID, Group *> groups;
 
 	bool use_native_low_priority_threads = false;
+	SafeFlag work_stealing_enabled{ true };
 	uint32_t max_low_priority_threads = 0;
 	uint32_t low_priority_threads_used = 0;
 	uint32_t low_priority_tasks_running = 0;
@@ -129,7 +134,9 @@ private:
 	void _process_task_queue();
 	void _process_task(Task *task);
 
-	void _post_task(Task *p_task, bool p_high_priority);
+	Task *_take_task(uint32_t p_thread_index);
+	void _post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority);
+	void _post_low_priority_task(Task *p_task);
 
 	bool _try_promote_low_priority_task();
 	void _prevent_low_prio_saturation_deadlock();
@@ -195,6 +202,10 @@ public:
 
 	_FORCE_INLINE_ int get_thread_count() const { return threads.size(); }
 
+	// Only meant for benchmarking against the shared queue only pool. Tasks already posted are still taken from the per-thread queues.
+	void set_work_stealing_enabled(bool p_enabled) { work_stealing_enabled.set_to(p_enabled); }
+	bool is_work_stealing_enabled() const { return work_stealing_enabled.is_set(); }
+
 	static WorkerThreadPool *get_singleton() { return singleton; }
 	void init(int p_thread_count = -1, bool p_use_native_threads_low_priority = true, float p_low_priority_task_ratio = 0.3);
 	void finish();
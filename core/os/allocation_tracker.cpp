@@ -0,0 +1,244 @@
+/**************************************************************************/
+/*  allocation_tracker.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "allocation_tracker.h"
+
+#ifdef ALLOCATION_TRACKING_ENABLED
+
+#include "core/error/error_macros.h"
+#include "core/os/spin_lock.h"
+
+#include <atomic>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <type_traits>
+
+// Nothing in here may allocate through Memory, as it's called from within it.
+
+namespace {
+
+// Only plain members and atomics, so the table is zero-initialized before any dynamic initialization runs.
+// SafeNumeric can't be used here, its constructor would reset the counters of sites registered during static initialization.
+struct Site {
+	const char *file;
+	int line;
+	std::atomic<uint64_t> allocations;
+	std::atomic<uint64_t> bytes;
+	std::atomic<uint64_t> live_allocations;
+	std::atomic<uint64_t> live_bytes;
+	std::atomic<uint64_t> live_histogram[AllocationTracker::HISTOGRAM_BUCKETS];
+};
+static_assert(std::is_trivially_default_constructible_v<Site>);
+
+constexpr uint32_t SITE_TABLE_SIZE = AllocationTracker::MAX_SITES * 2; // Power of two, at most half full.
+
+Site sites[AllocationTracker::MAX_SITES];
+std::atomic<uint32_t> site_table[SITE_TABLE_SIZE]; // Site index + 1, 0 means empty.
+// Constant-initialized, since allocations happen during static initialization too.
+// Site 0 (UNKNOWN_SITE) collects whatever can't be attributed.
+std::atomic<uint32_t> site_count{ 1 };
+SpinLock site_insert_lock;
+
+thread_local const char *next_file = nullptr;
+thread_local int next_line = 0;
+thread_local const char *current_tag = nullptr;
+
+char dump_path[4096] = "allocations.csv";
+
+_FORCE_INLINE_ uint32_t _histogram_bucket(uint64_t p_bytes) {
+	uint32_t bucket = 0;
+	while (p_bytes && bucket < AllocationTracker::HISTOGRAM_BUCKETS - 1) {
+		p_bytes >>= 1;
+		bucket++;
+	}
+	return bucket;
+}
+
+uint32_t _find_or_add_site(const char *p_file, int p_line) {
+	uint32_t hash = uint32_t(((uintptr_t)p_file >> 3) * 2654435761u) ^ uint32_t(p_line * 40503u);
+	uint32_t pos = hash & (SITE_TABLE_SIZE - 1);
+
+	while (true) {
+		uint32_t entry = site_table[pos].load(std::memory_order_acquire);
+		if (entry == 0) {
+			break;
+		}
+		const Site &site = sites[entry - 1];
+		if (site.file == p_file && site.line == p_line) {
+			return entry - 1;
+		}
+		pos = (pos + 1) & (SITE_TABLE_SIZE - 1);
+	}
+
+	site_insert_lock.lock();
+	// Another thread may have inserted it (or anything else) in the meantime.
+	while (true) {
+		uint32_t entry = site_table[pos].load(std::memory_order_acquire);
+		if (entry == 0) {
+			break;
+		}
+		const Site &site = sites[entry - 1];
+		if (site.file == p_file && site.line == p_line) {
+			site_insert_lock.unlock();
+			return entry - 1;
+		}
+		pos = (pos + 1) & (SITE_TABLE_SIZE - 1);
+	}
+
+	uint32_t index = site_count.load(std::memory_order_acquire);
+	if (index >= AllocationTracker::MAX_SITES) {
+		site_insert_lock.unlock();
+		return AllocationTracker::UNKNOWN_SITE;
+	}
+	sites[index].file = p_file;
+	sites[index].line = p_line;
+	site_count.store(index + 1, std::memory_order_release);
+	site_table[pos].store(index + 1, std::memory_order_release);
+	site_insert_lock.unlock();
+	return index;
+}
+
+int _compare_live_bytes(const void *p_a, const void *p_b) {
+	uint64_t a = sites[*(const uint32_t *)p_a].live_bytes.load(std::memory_order_relaxed);
+	uint64_t b = sites[*(const uint32_t *)p_b].live_bytes.load(std::memory_order_relaxed);
+	return a < b ? 1 : (a > b ? -1 : 0);
+}
+
+} // namespace
+
+AllocationTracker::Tag::Tag(const char *p_tag) {
+	prev_tag = current_tag;
+	current_tag = p_tag;
+}
+
+AllocationTracker::Tag::~Tag() {
+	current_tag = prev_tag;
+}
+
+void AllocationTracker::set_next_site(const char *p_file, int p_line) {
+	next_file = p_file;
+	next_line = p_line;
+}
+
+uint32_t AllocationTracker::take_site() {
+	const char *file = next_file;
+	int line = next_line;
+	next_file = nullptr;
+
+	if (current_tag) {
+		return _find_or_add_site(current_tag, 0);
+	}
+	if (file) {
+		return _find_or_add_site(file, line);
+	}
+	return UNKNOWN_SITE;
+}
+
+void AllocationTracker::track_alloc(uint32_t p_site, uint64_t p_bytes) {
+	Site &site = sites[p_site];
+	site.allocations.fetch_add(1, std::memory_order_relaxed);
+	site.bytes.fetch_add(p_bytes, std::memory_order_relaxed);
+	site.live_allocations.fetch_add(1, std::memory_order_relaxed);
+	site.live_bytes.fetch_add(p_bytes, std::memory_order_relaxed);
+	site.live_histogram[_histogram_bucket(p_bytes)].fetch_add(p_bytes, std::memory_order_relaxed);
+}
+
+void AllocationTracker::track_free(uint32_t p_site, uint64_t p_bytes) {
+	Site &site = sites[p_site];
+	site.live_allocations.fetch_sub(1, std::memory_order_relaxed);
+	site.live_bytes.fetch_sub(p_bytes, std::memory_order_relaxed);
+	site.live_histogram[_histogram_bucket(p_bytes)].fetch_sub(p_bytes, std::memory_order_relaxed);
+}
+
+uint32_t AllocationTracker::get_site_count() {
+	return site_count.load(std::memory_order_acquire);
+}
+
+uint64_t AllocationTracker::get_total_allocations() {
+	uint64_t total = 0;
+	uint32_t count = get_site_count();
+	for (uint32_t i = 0; i < count; i++) {
+		total += sites[i].allocations.load(std::memory_order_relaxed);
+	}
+	return total;
+}
+
+void AllocationTracker::get_site_info(uint32_t p_site, SiteInfo &r_info) {
+	ERR_FAIL_UNSIGNED_INDEX(p_site, get_site_count());
+	const Site &site = sites[p_site];
+	r_info.file = p_site == UNKNOWN_SITE ? "<unknown>" : site.file;
+	r_info.line = site.line;
+	r_info.allocations = site.allocations.load(std::memory_order_relaxed);
+	r_info.bytes = site.bytes.load(std::memory_order_relaxed);
+	r_info.live_allocations = site.live_allocations.load(std::memory_order_relaxed);
+	r_info.live_bytes = site.live_bytes.load(std::memory_order_relaxed);
+	for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+		r_info.live_histogram[i] = site.live_histogram[i].load(std::memory_order_relaxed);
+	}
+}
+
+void AllocationTracker::set_dump_path(const char *p_path) {
+	strncpy(dump_path, p_path, sizeof(dump_path) - 1);
+	dump_path[sizeof(dump_path) - 1] = 0;
+}
+
+void AllocationTracker::dump_to_file() {
+	FILE *f = fopen(dump_path, "w");
+	ERR_FAIL_NULL_MSG(f, "Can't open allocation dump file for writing.");
+
+	uint32_t count = get_site_count();
+	uint32_t *order = (uint32_t *)malloc(sizeof(uint32_t) * count);
+	for (uint32_t i = 0; i < count; i++) {
+		order[i] = i;
+	}
+	qsort(order, count, sizeof(uint32_t), _compare_live_bytes);
+
+	fprintf(f, "site,line,allocations,bytes,live_allocations,live_bytes");
+	for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+		fprintf(f, ",live_bytes_lt_%llu", (unsigned long long)1 << i);
+	}
+	fprintf(f, "\n");
+
+	for (uint32_t i = 0; i < count; i++) {
+		SiteInfo info;
+		get_site_info(order[i], info);
+		fprintf(f, "\"%s\",%d,%llu,%llu,%llu,%llu", info.file, info.line, (unsigned long long)info.allocations, (unsigned long long)info.bytes, (unsigned long long)info.live_allocations, (unsigned long long)info.live_bytes);
+		for (int j = 0; j < HISTOGRAM_BUCKETS; j++) {
+			fprintf(f, ",%llu", (unsigned long long)info.live_histogram[j]);
+		}
+		fprintf(f, "\n");
+	}
+
+	free(order);
+	fclose(f);
+}
+
+#endif // ALLOCATION_TRACKING_ENABLED
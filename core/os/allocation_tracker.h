@@ -0,0 +1,99 @@
+/**************************************************************************/
+/*  allocation_tracker.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef ALLOCATION_TRACKER_H
+#define ALLOCATION_TRACKER_H
+
+#include "core/typedefs.h"
+
+// Per call site heap statistics, only compiled in with `use_allocation_tracking=yes`.
+//
+// The memalloc(), memrealloc(), memnew() and memnew_arr() macros record the file and
+// line they are used from. Allocations made while an AllocationTracker::Tag is alive
+// on the thread are attributed to the tag instead, which is more useful for code that
+// allocates through generic containers.
+//
+// Statistics can be requested through the debugger ("core:allocation_dump" message) and
+// are written to a CSV file on exit (see the `--allocation-dump` command line option).
+
+#ifdef ALLOCATION_TRACKING_ENABLED
+
+class AllocationTracker {
+public:
+	enum {
+		MAX_SITES = 8192,
+		// Live bytes are also split by allocation size, bucket N holding sizes in [2^(N-1), 2^N).
+		HISTOGRAM_BUCKETS = 32,
+		UNKNOWN_SITE = 0,
+	};
+
+	struct SiteInfo {
+		const char *file = nullptr; // Tag name for tagged allocations.
+		int line = 0; // 0 for tagged allocations.
+		uint64_t allocations = 0;
+		uint64_t bytes = 0;
+		uint64_t live_allocations = 0;
+		uint64_t live_bytes = 0;
+		uint64_t live_histogram[HISTOGRAM_BUCKETS] = {};
+	};
+
+	class Tag {
+		const char *prev_tag = nullptr;
+
+	public:
+		Tag(const char *p_tag);
+		~Tag();
+	};
+
+	static void set_next_site(const char *p_file, int p_line);
+	// Site for an allocation being made now; consumes the one set with set_next_site().
+	static uint32_t take_site();
+
+	static void track_alloc(uint32_t p_site, uint64_t p_bytes);
+	static void track_free(uint32_t p_site, uint64_t p_bytes);
+
+	static uint32_t get_site_count();
+	// Allocations made so far across all sites, never decremented.
+	static uint64_t get_total_allocations();
+	static void get_site_info(uint32_t p_site, SiteInfo &r_info);
+
+	static void set_dump_path(const char *p_path);
+	static void dump_to_file();
+};
+
+#define MEMORY_TRACK_TAG(m_tag) AllocationTracker::Tag _allocation_tracker_tag_(m_tag)
+
+#else
+
+#define MEMORY_TRACK_TAG(m_tag)
+
+#endif // ALLOCATION_TRACKING_ENABLED
+
+#endif // ALLOCATION_TRACKER_H
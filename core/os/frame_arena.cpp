@@ -0,0 +1,108 @@
+/**************************************************************************/
+/*  frame_arena.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_arena.h"
+
+SafeNumeric<uint64_t> FrameArena::frame_index;
+SafeNumeric<uint64_t> FrameArena::frame_usage;
+SafeNumeric<uint64_t> FrameArena::last_frame_usage;
+SafeNumeric<uint64_t> FrameArena::max_frame_usage;
+
+thread_local FrameArena FrameArena::thread_arena;
+
+void FrameArena::_publish_usage() {
+	if (usage) {
+		frame_usage.add(usage);
+		usage = 0;
+	}
+}
+
+void FrameArena::_rewind() {
+	frame = frame_index.get();
+	used = 0;
+	_publish_usage();
+
+	if (block && block->prev) {
+		// Last frame needed more than one block; merge them so the next frames fit in one.
+		size_t total = 0;
+		while (block) {
+			Block *prev = block->prev;
+			total += block->size;
+			Memory::free_static(block);
+			block = prev;
+		}
+		block = (Block *)Memory::alloc_static(HEADER_SIZE + total);
+		block->prev = nullptr;
+		block->size = total;
+	}
+}
+
+void *FrameArena::_alloc_new_block(size_t p_bytes) {
+	size_t size = MAX(MIN_BLOCK_SIZE, p_bytes);
+	if (block) {
+		size = MAX(size, block->size * 2);
+	}
+
+	Block *new_block = (Block *)Memory::alloc_static(HEADER_SIZE + size);
+	new_block->prev = block;
+	new_block->size = size;
+	block = new_block;
+
+	used = p_bytes;
+	return _block_data(block);
+}
+
+void FrameArena::begin_frame() {
+	// The calling (main) thread is rewound lazily like the others, but its usage belongs to the frame that just ended.
+	thread_arena._publish_usage();
+
+	uint64_t usage = frame_usage.get();
+	frame_usage.sub(usage);
+	last_frame_usage.set(usage);
+	max_frame_usage.exchange_if_greater(usage);
+	frame_index.increment();
+}
+
+uint64_t FrameArena::get_last_frame_usage() {
+	return last_frame_usage.get();
+}
+
+uint64_t FrameArena::get_max_frame_usage() {
+	return max_frame_usage.get();
+}
+
+FrameArena::~FrameArena() {
+	_publish_usage();
+	while (block) {
+		Block *prev = block->prev;
+		Memory::free_static(block);
+		block = prev;
+	}
+}
@@ -0,0 +1,132 @@
+/**************************************************************************/
+/*  frame_arena.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include "core/os/memory.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+// Thread-local bump allocator for per-frame temporaries.
+//
+// Allocating is a pointer bump, freeing is a no-op. Each thread's arena is rewound
+// lazily, on its first allocation after Main::iteration() started a new frame, so
+// memory obtained from it must not be kept beyond the current frame.
+//
+// Threads whose work can straddle a frame boundary (the render thread, long-running
+// tasks) must hold a FrameArena::Scope while using arena memory; the arena of a
+// thread is never rewound while a scope is open on it.
+
+class FrameArena {
+	struct Block {
+		Block *prev = nullptr;
+		size_t size = 0; // Usable bytes after the header.
+	};
+
+	static constexpr size_t ALIGN = 16;
+	static constexpr size_t HEADER_SIZE = (sizeof(Block) + ALIGN - 1) & ~(ALIGN - 1);
+	static constexpr size_t MIN_BLOCK_SIZE = 64 * 1024;
+
+	Block *block = nullptr;
+	size_t used = 0; // In the current block.
+	uint64_t usage = 0; // Since the last rewind, published to frame_usage when rewinding.
+	uint64_t frame = 0;
+	uint32_t scope_depth = 0;
+
+	static SafeNumeric<uint64_t> frame_index;
+	static SafeNumeric<uint64_t> frame_usage;
+	static SafeNumeric<uint64_t> last_frame_usage;
+	static SafeNumeric<uint64_t> max_frame_usage;
+
+	static thread_local FrameArena thread_arena;
+
+	_FORCE_INLINE_ static uint8_t *_block_data(Block *p_block) { return (uint8_t *)p_block + HEADER_SIZE; }
+
+	void _rewind();
+	void _publish_usage();
+	void *_alloc_new_block(size_t p_bytes);
+
+	_FORCE_INLINE_ void *_alloc(size_t p_bytes) {
+		if (unlikely(frame != frame_index.get()) && scope_depth == 0) {
+			_rewind();
+		}
+		p_bytes = (p_bytes + ALIGN - 1) & ~(ALIGN - 1);
+		usage += p_bytes;
+		if (likely(block && used + p_bytes <= block->size)) {
+			void *ptr = _block_data(block) + used;
+			used += p_bytes;
+			return ptr;
+		}
+		return _alloc_new_block(p_bytes);
+	}
+
+public:
+	class Scope {
+	public:
+		_FORCE_INLINE_ Scope() { thread_arena.scope_depth++; }
+		_FORCE_INLINE_ ~Scope() { thread_arena.scope_depth--; }
+	};
+
+	_FORCE_INLINE_ static void *alloc(size_t p_bytes) { return thread_arena._alloc(p_bytes); }
+	_FORCE_INLINE_ static void free(void *p_ptr) {} // Reclaimed as a whole at the start of the next frame.
+
+	// Called by the main loop once per frame.
+	static void begin_frame();
+
+	// Usage of threads other than the main one is published when their arena is rewound,
+	// so it is reported one frame late.
+	static uint64_t get_last_frame_usage();
+	static uint64_t get_max_frame_usage();
+
+	~FrameArena();
+};
+
+// For containers taking a static allocator, such as LocalVector, List or RBMap.
+typedef FrameArena FrameArenaAllocator;
+
+// For containers taking a typed allocator, such as HashMap and HashSet elements.
+// Destructors are still run, only the memory is left to the arena.
+template <class T>
+class FrameArenaTypedAllocator {
+public:
+	template <class... Args>
+	_FORCE_INLINE_ T *new_allocation(const Args &&...p_args) { return memnew_placement(FrameArena::alloc(sizeof(T)), T(p_args...)); }
+	_FORCE_INLINE_ void delete_allocation(T *p_allocation) {
+		if constexpr (!std::is_trivially_destructible<T>::value) {
+			p_allocation->~T();
+		}
+	}
+};
+
+template <class T, class U = uint32_t, bool force_trivial = false, bool tight = false>
+using FrameLocalVector = LocalVector<T, U, force_trivial, tight, FrameArenaAllocator>;
+
+#endif // FRAME_ARENA_H
@@ -66,7 +66,7 @@ SafeNumeric<uint64_t> Memory::max_usage;
 SafeNumeric<uint64_t> Memory::alloc_count;
 
 void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(ALLOCATION_TRACKING_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -87,6 +87,11 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 #ifdef DEBUG_ENABLED
 		uint64_t new_mem_usage = mem_usage.add(p_bytes);
 		max_usage.exchange_if_greater(new_mem_usage);
+#endif
+#ifdef ALLOCATION_TRACKING_ENABLED
+		uint32_t site = AllocationTracker::take_site();
+		*(uint32_t *)(s8 + sizeof(uint64_t)) = site;
+		AllocationTracker::track_alloc(site, p_bytes);
 #endif
 		return s8 + PAD_ALIGN;
 	} else {
@@ -101,7 +106,7 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_memory;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(ALLOCATION_TRACKING_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -119,6 +124,18 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 			mem_usage.sub(*s - p_bytes);
 		}
 #endif
+#ifdef ALLOCATION_TRACKING_ENABLED
+		// Attributed to the site doing the reallocation, unless unknown.
+		uint32_t *site = (uint32_t *)(mem + sizeof(uint64_t));
+		AllocationTracker::track_free(*site, *s);
+		uint32_t new_site = AllocationTracker::take_site();
+		if (new_site != AllocationTracker::UNKNOWN_SITE) {
+			*site = new_site;
+		}
+		if (p_bytes > 0) {
+			AllocationTracker::track_alloc(*site, p_bytes);
+		}
+#endif
 
 		if (p_bytes == 0) {
 			free(mem);
@@ -149,7 +166,7 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_ptr;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(ALLOCATION_TRACKING_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -164,6 +181,9 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 		uint64_t *s = (uint64_t *)mem;
 		mem_usage.sub(*s);
 #endif
+#ifdef ALLOCATION_TRACKING_ENABLED
+		AllocationTracker::track_free(*(uint32_t *)(mem + sizeof(uint64_t)), *(uint64_t *)mem);
+#endif
 
 		free(mem);
 	} else {
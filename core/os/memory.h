@@ -32,6 +32,7 @@
 #define MEMORY_H
 
 #include "core/error/error_macros.h"
+#include "core/os/allocation_tracker.h"
 #include "core/templates/safe_refcount.h"
 
 #include <stddef.h>
@@ -39,8 +40,12 @@
 #include <type_traits>
 
 #ifndef PAD_ALIGN
+#ifdef ALLOCATION_TRACKING_ENABLED
+#define PAD_ALIGN 32 // Room for the allocation site, plus the 16 bytes containers may use.
+#else
 #define PAD_ALIGN 16 //must always be greater than this at much
 #endif
+#endif
 
 class Memory {
 #ifdef DEBUG_ENABLED
@@ -79,8 +84,13 @@ void operator delete(void *p_mem, void *(*p_allocfunc)(size_t p_size));
 void operator delete(void *p_mem, void *p_pointer, size_t check, const char *p_description);
 #endif
 
+#ifdef ALLOCATION_TRACKING_ENABLED
+#define memalloc(m_size) (AllocationTracker::set_next_site(__FILE__, __LINE__), Memory::alloc_static(m_size))
+#define memrealloc(m_mem, m_size) (AllocationTracker::set_next_site(__FILE__, __LINE__), Memory::realloc_static(m_mem, m_size))
+#else
 #define memalloc(m_size) Memory::alloc_static(m_size)
 #define memrealloc(m_mem, m_size) Memory::realloc_static(m_mem, m_size)
+#endif
 #define memfree(m_mem) Memory::free_static(m_mem)
 
 _ALWAYS_INLINE_ void postinitialize_handler(void *) {}
@@ -91,7 +101,11 @@ _ALWAYS_INLINE_ T *_post_initialize(T *p_obj) {
 	return p_obj;
 }
 
+#ifdef ALLOCATION_TRACKING_ENABLED
+#define memnew(m_class) (AllocationTracker::set_next_site(__FILE__, __LINE__), _post_initialize(new ("") m_class))
+#else
 #define memnew(m_class) _post_initialize(new ("") m_class)
+#endif
 
 #define memnew_allocator(m_class, m_allocator) _post_initialize(new (m_allocator::alloc) m_class)
 #define memnew_placement(m_placement, m_class) _post_initialize(new (m_placement) m_class)
@@ -131,7 +145,11 @@ void memdelete_allocator(T *p_class) {
 		}                      \
 	}
 
+#ifdef ALLOCATION_TRACKING_ENABLED
+#define memnew_arr(m_class, m_count) (AllocationTracker::set_next_site(__FILE__, __LINE__), memnew_arr_template<m_class>(m_count))
+#else
 #define memnew_arr(m_class, m_count) memnew_arr_template<m_class>(m_count)
+#endif
 
 template <typename T>
 T *memnew_arr_template(size_t p_elements) {
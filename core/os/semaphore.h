@@ -50,10 +50,14 @@ private:
 #endif
 
 public:
-	_ALWAYS_INLINE_ void post() const {
+	_ALWAYS_INLINE_ void post(uint32_t p_count = 1) const {
 		std::lock_guard lock(mutex);
-		count++;
-		condition.notify_one();
+		count += p_count;
+		if (p_count == 1) {
+			condition.notify_one();
+		} else {
+			condition.notify_all();
+		}
 	}
 
 	_ALWAYS_INLINE_ void wait() const {
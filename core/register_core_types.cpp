@@ -74,6 +74,7 @@
 #include "core/math/triangle_mesh.h"
 #include "core/object/class_db.h"
 #include "core/object/script_language_extension.h"
+#include "core/object/task_graph.h"
 #include "core/object/undo_redo.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/main_loop.h"
@@ -202,6 +203,7 @@ void register_core_types() {
 	GDREGISTER_CLASS(UDPServer);
 
 	GDREGISTER_ABSTRACT_CLASS(WorkerThreadPool);
+	GDREGISTER_CLASS(TaskGraph);
 
 	ClassDB::register_custom_instance_class<HTTPClient>();
 
@@ -33,12 +33,56 @@
 #include "core/config/project_settings.h"
 #include "core/os/os.h"
 
-void CommandQueueMT::lock() {
-	mutex.lock();
+CommandQueueMT::Block *CommandQueueMT::_alloc_block() {
+	block_lock.lock();
+	Block *block = nullptr;
+	if (free_blocks.size()) {
+		block = free_blocks[free_blocks.size() - 1];
+		free_blocks.resize(free_blocks.size() - 1);
+	}
+	block_lock.unlock();
+
+	if (!block) {
+		block = memnew(Block);
+		memset(block->data, 0, sizeof(block->data));
+		block_lock.lock();
+		all_blocks.push_back(block);
+		block_lock.unlock();
+	}
+
+	block->next.store(nullptr, std::memory_order_relaxed);
+	// New generation, so producers still holding this block from its previous life notice the reuse.
+	uint32_t generation = _get_generation(block->state.load(std::memory_order_relaxed)) + 1;
+	block->state.store(uint64_t(generation) << 32, std::memory_order_release);
+	return block;
 }
 
-void CommandQueueMT::unlock() {
-	mutex.unlock();
+void CommandQueueMT::_close_block(Block *p_block, uint32_t p_offset) {
+	Block *next = _alloc_block();
+	p_block->next.store(next, std::memory_order_release);
+	_get_header(p_block, p_offset)->size.store(END_OF_BLOCK, std::memory_order_release);
+	write_block.store(next, std::memory_order_release);
+}
+
+void CommandQueueMT::_recycle_blocks() {
+	for (Block *block : retired_blocks) {
+		// Headers must read as unpublished when the block is reused. The reserved
+		// counter is left past the limit, so stale producers retry on write_block.
+		uint32_t used = MIN(_get_reserved(block->state.load(std::memory_order_relaxed)), (uint32_t)BLOCK_SIZE);
+		memset(block->data, 0, used);
+	}
+
+	block_lock.lock();
+	for (Block *block : retired_blocks) {
+		free_blocks.push_back(block);
+	}
+	block_lock.unlock();
+
+	retired_blocks.clear();
+}
+
+void CommandQueueMT::_wait_for_producer() {
+	OS::get_singleton()->yield();
 }
 
 void CommandQueueMT::wait_for_flush() {
@@ -50,15 +94,13 @@ CommandQueueMT::SyncSemaphore *CommandQueueMT::_alloc_sync_sem() {
 	int idx = -1;
 
 	while (true) {
-		lock();
 		for (int i = 0; i < SYNC_SEMAPHORES; i++) {
-			if (!sync_sems[i].in_use) {
-				sync_sems[i].in_use = true;
+			bool expected = false;
+			if (sync_sems[i].in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
 				idx = i;
 				break;
 			}
 		}
-		unlock();
 
 		if (idx == -1) {
 			wait_for_flush();
@@ -71,6 +113,9 @@ CommandQueueMT::SyncSemaphore *CommandQueueMT::_alloc_sync_sem() {
 }
 
 CommandQueueMT::CommandQueueMT(bool p_sync) {
+	read_block = _alloc_block();
+	write_block.store(read_block, std::memory_order_release);
+
 	if (p_sync) {
 		sync = memnew(Semaphore);
 	}
@@ -80,4 +125,8 @@ CommandQueueMT::~CommandQueueMT() {
 	if (sync) {
 		memdelete(sync);
 	}
+
+	for (Block *block : all_blocks) {
+		memdelete(block);
+	}
 }
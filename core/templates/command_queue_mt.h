@@ -34,11 +34,14 @@
 #include "core/os/memory.h"
 #include "core/os/mutex.h"
 #include "core/os/semaphore.h"
+#include "core/os/spin_lock.h"
 #include "core/string/print_string.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/simple_type.h"
 #include "core/typedefs.h"
 
+#include <atomic>
+
 #define COMMA(N) _COMMA_##N
 #define _COMMA_0
 #define _COMMA_1 ,
@@ -250,13 +253,11 @@
 #define DECL_PUSH(N)                                                         \
 	template <class T, class M COMMA(N) COMMA_SEP_LIST(TYPE_PARAM, N)>       \
 	void push(T *p_instance, M p_method COMMA(N) COMMA_SEP_LIST(PARAM, N)) { \
-		CMD_TYPE(N) *cmd = allocate_and_lock<CMD_TYPE(N)>();                 \
+		CMD_TYPE(N) *cmd = allocate<CMD_TYPE(N)>();                          \
 		cmd->instance = p_instance;                                          \
 		cmd->method = p_method;                                              \
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                 \
-		unlock();                                                            \
-		if (sync)                                                            \
-			sync->post();                                                    \
+		commit(cmd);                                                         \
 	}
 
 #define CMD_RET_TYPE(N) CommandRet##N<T, M, COMMA_SEP_LIST(TYPE_ARG, N) COMMA(N) R>
@@ -265,15 +266,13 @@
 	template <class T, class M, COMMA_SEP_LIST(TYPE_PARAM, N) COMMA(N) class R>                \
 	void push_and_ret(T *p_instance, M p_method, COMMA_SEP_LIST(PARAM, N) COMMA(N) R *r_ret) { \
 		SyncSemaphore *ss = _alloc_sync_sem();                                                 \
-		CMD_RET_TYPE(N) *cmd = allocate_and_lock<CMD_RET_TYPE(N)>();                           \
+		CMD_RET_TYPE(N) *cmd = allocate<CMD_RET_TYPE(N)>();                                    \
 		cmd->instance = p_instance;                                                            \
 		cmd->method = p_method;                                                                \
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                                   \
 		cmd->ret = r_ret;                                                                      \
 		cmd->sync_sem = ss;                                                                    \
-		unlock();                                                                              \
-		if (sync)                                                                              \
-			sync->post();                                                                      \
+		commit(cmd);                                                                           \
 		ss->sem.wait();                                                                        \
 		ss->in_use = false;                                                                    \
 	}
@@ -284,14 +283,12 @@
 	template <class T, class M COMMA(N) COMMA_SEP_LIST(TYPE_PARAM, N)>                \
 	void push_and_sync(T *p_instance, M p_method COMMA(N) COMMA_SEP_LIST(PARAM, N)) { \
 		SyncSemaphore *ss = _alloc_sync_sem();                                        \
-		CMD_SYNC_TYPE(N) *cmd = allocate_and_lock<CMD_SYNC_TYPE(N)>();                \
+		CMD_SYNC_TYPE(N) *cmd = allocate<CMD_SYNC_TYPE(N)>();                         \
 		cmd->instance = p_instance;                                                   \
 		cmd->method = p_method;                                                       \
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                          \
 		cmd->sync_sem = ss;                                                           \
-		unlock();                                                                     \
-		if (sync)                                                                     \
-			sync->post();                                                             \
+		commit(cmd);                                                                  \
 		ss->sem.wait();                                                               \
 		ss->in_use = false;                                                           \
 	}
@@ -301,7 +298,7 @@
 class CommandQueueMT {
 	struct SyncSemaphore {
 		Semaphore sem;
-		bool in_use = false;
+		std::atomic<bool> in_use = { false };
 	};
 
 	struct CommandBase {
@@ -331,58 +328,159 @@ class CommandQueueMT {
 
 	/***** BASE *******/
 
+	// Commands are stored in a linked list of fixed-size blocks.
+	// Producers reserve space in the current block with a single atomic add
+	// and publish the command by storing its size in the header, so pushing
+	// never takes a lock. The single consumer walks the published commands in
+	// reservation order and recycles whole blocks once they are drained.
+	// Each reuse of a block bumps its generation, which is packed with the
+	// reserved offset, so a producer that raced with the recycling can tell
+	// its reservation landed in a later life of the block.
+
 	enum {
-		DEFAULT_COMMAND_MEM_SIZE_KB = 256,
+		BLOCK_SIZE = 65536,
+		HEADER_SIZE = 8,
+		BLOCK_LIMIT = BLOCK_SIZE - HEADER_SIZE, // Always leave room for the end marker.
 		SYNC_SEMAPHORES = 8
 	};
 
-	LocalVector<uint8_t> command_mem;
+	static constexpr uint32_t END_OF_BLOCK = UINT32_MAX;
+	static constexpr uint32_t SKIP_FLAG = 1u << 31; // Reserved by a stale producer, no command.
+
+	struct CommandHeader {
+		std::atomic<uint32_t> size; // 0 while the command is being written.
+		uint32_t padding;
+	};
+
+	static_assert(sizeof(CommandHeader) == HEADER_SIZE);
+
+	struct Block {
+		std::atomic<uint64_t> state = { 0 }; // Generation in the high 32 bits, reserved offset in the low 32 bits.
+		std::atomic<Block *> next = { nullptr };
+		alignas(64) uint8_t data[BLOCK_SIZE];
+	};
+
+	std::atomic<Block *> write_block = { nullptr };
+
+	// Only touched by the consumer, under flush_mutex.
+	Block *read_block = nullptr;
+	uint32_t read_offset = 0;
+	uint32_t flush_depth = 0;
+	LocalVector<Block *> retired_blocks;
+
+	SpinLock block_lock;
+	LocalVector<Block *> free_blocks;
+	LocalVector<Block *> all_blocks;
+
+	// Pending pushes not yet consumed by wait_and_flush(). Negative while the
+	// consumer sleeps, so producers only touch the semaphore to wake it up.
+	std::atomic<int32_t> sync_count = { 0 };
+
 	SyncSemaphore sync_sems[SYNC_SEMAPHORES];
-	Mutex mutex;
+	Mutex flush_mutex;
 	Semaphore *sync = nullptr;
 
+	_FORCE_INLINE_ static CommandHeader *_get_header(Block *p_block, uint32_t p_offset) {
+		return reinterpret_cast<CommandHeader *>(&p_block->data[p_offset]);
+	}
+
+	_FORCE_INLINE_ static uint32_t _get_generation(uint64_t p_state) { return p_state >> 32; }
+	_FORCE_INLINE_ static uint32_t _get_reserved(uint64_t p_state) { return p_state & UINT32_MAX; }
+
 	template <class T>
 	T *allocate() {
-		// alloc size is size+T+safeguard
-		uint32_t alloc_size = ((sizeof(T) + 8 - 1) & ~(8 - 1));
-		uint64_t size = command_mem.size();
-		command_mem.resize(size + alloc_size + 8);
-		*(uint64_t *)&command_mem[size] = alloc_size;
-		T *cmd = memnew_placement(&command_mem[size + 8], T);
-		return cmd;
+		// alloc size is header+T, aligned to the header size.
+		constexpr uint32_t alloc_size = HEADER_SIZE + ((sizeof(T) + HEADER_SIZE - 1) & ~(HEADER_SIZE - 1));
+		static_assert(alloc_size <= BLOCK_LIMIT, "Command is too large for a command queue block.");
+
+		while (true) {
+			Block *block = write_block.load(std::memory_order_acquire);
+			uint32_t generation = _get_generation(block->state.load(std::memory_order_acquire));
+			uint64_t state = block->state.fetch_add(alloc_size, std::memory_order_acq_rel);
+			uint32_t offset = _get_reserved(state);
+			if (likely(offset + alloc_size <= BLOCK_LIMIT)) {
+				if (unlikely(_get_generation(state) != generation)) {
+					// The block was recycled and reused since it was read from write_block.
+					// The space is ours now, so publish it as padding and retry on the current block.
+					_get_header(block, offset)->size.store(alloc_size | SKIP_FLAG, std::memory_order_release);
+					continue;
+				}
+				return memnew_placement(&block->data[offset + HEADER_SIZE], T);
+			}
+			if (offset <= BLOCK_LIMIT) {
+				// First producer to overflow this block, chain a new one.
+				_close_block(block, offset);
+			} else {
+				// Another producer is chaining a new block.
+				while (write_block.load(std::memory_order_acquire) == block) {
+					_wait_for_producer();
+				}
+			}
+		}
 	}
 
 	template <class T>
-	T *allocate_and_lock() {
-		lock();
-		T *ret = allocate<T>();
-		return ret;
+	void commit(T *p_cmd) {
+		constexpr uint32_t alloc_size = HEADER_SIZE + ((sizeof(T) + HEADER_SIZE - 1) & ~(HEADER_SIZE - 1));
+		CommandHeader *header = reinterpret_cast<CommandHeader *>(reinterpret_cast<uint8_t *>(p_cmd) - HEADER_SIZE);
+		header->size.store(alloc_size, std::memory_order_release);
+		if (sync && sync_count.fetch_add(1, std::memory_order_acq_rel) < 0) {
+			sync->post();
+		}
 	}
 
-	void _flush() {
-		lock();
-
-		uint64_t read_ptr = 0;
-		uint64_t limit = command_mem.size();
+	_FORCE_INLINE_ bool _has_pending() const {
+		return _get_reserved(read_block->state.load(std::memory_order_acquire)) > read_offset;
+	}
 
-		while (read_ptr < limit) {
-			uint64_t size = *(uint64_t *)&command_mem[read_ptr];
-			read_ptr += 8;
-			CommandBase *cmd = reinterpret_cast<CommandBase *>(&command_mem[read_ptr]);
+	void _flush() {
+		MutexLock lock(flush_mutex);
+		flush_depth++;
+
+		while (true) {
+			CommandHeader *header = _get_header(read_block, read_offset);
+			uint32_t size = header->size.load(std::memory_order_acquire);
+
+			if (size == 0) {
+				if (!_has_pending()) {
+					break; // Nothing else published.
+				}
+				// Space is reserved but the producer is still writing the command.
+				_wait_for_producer();
+				continue;
+			}
+
+			if (size == END_OF_BLOCK) {
+				retired_blocks.push_back(read_block);
+				read_block = read_block->next.load(std::memory_order_acquire);
+				read_offset = 0;
+				continue;
+			}
+
+			if (size & SKIP_FLAG) {
+				read_offset += size & ~SKIP_FLAG;
+				continue;
+			}
+
+			// Advance before calling, in case the command flushes recursively.
+			CommandBase *cmd = reinterpret_cast<CommandBase *>(&read_block->data[read_offset + HEADER_SIZE]);
+			read_offset += size;
 
 			cmd->call(); //execute the function
 			cmd->post(); //release in case it needs sync/ret
 			cmd->~CommandBase(); //should be done, so erase the command
-
-			read_ptr += size;
 		}
 
-		command_mem.clear();
-		unlock();
+		flush_depth--;
+		if (flush_depth == 0 && retired_blocks.size()) {
+			_recycle_blocks();
+		}
 	}
 
-	void lock();
-	void unlock();
+	Block *_alloc_block();
+	void _close_block(Block *p_block, uint32_t p_offset);
+	void _recycle_blocks();
+	void _wait_for_producer();
 	void wait_for_flush();
 	SyncSemaphore *_alloc_sync_sem();
 
@@ -400,7 +498,7 @@ public:
 	SPACE_SEP_LIST(DECL_PUSH_AND_SYNC, 15)
 
 	_FORCE_INLINE_ void flush_if_pending() {
-		if (unlikely(command_mem.size() > 0)) {
+		if (unlikely(_has_pending())) {
 			_flush();
 		}
 	}
@@ -410,7 +508,9 @@ public:
 
 	void wait_and_flush() {
 		ERR_FAIL_NULL(sync);
-		sync->wait();
+		if (sync_count.fetch_sub(1, std::memory_order_acq_rel) <= 0) {
+			sync->wait();
+		}
 		_flush();
 	}
 
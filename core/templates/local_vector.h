@@ -41,13 +41,29 @@
 
 // If tight, it grows strictly as much as needed.
 // Otherwise, it grows exponentially (the default and what you want in most cases).
-template <class T, class U = uint32_t, bool force_trivial = false, bool tight = false>
+// A custom allocator (with static alloc() and free(), see DefaultAllocator) can be
+// used to place the buffer somewhere else, e.g. in the FrameArena.
+template <class T, class U = uint32_t, bool force_trivial = false, bool tight = false, class A = DefaultAllocator>
 class LocalVector {
 private:
 	U count = 0;
 	U capacity = 0;
 	T *data = nullptr;
 
+	_FORCE_INLINE_ void _realloc_data(U p_capacity) {
+		if constexpr (std::is_same<A, DefaultAllocator>::value) {
+			data = (T *)memrealloc(data, p_capacity * sizeof(T));
+		} else {
+			T *new_data = (T *)A::alloc(p_capacity * sizeof(T));
+			if (data) {
+				memcpy((void *)new_data, (void *)data, count * sizeof(T));
+				A::free(data);
+			}
+			data = new_data;
+		}
+		CRASH_COND_MSG(!data, "Out of memory");
+	}
+
 public:
 	T *ptr() {
 		return data;
@@ -60,8 +76,7 @@ public:
 	_FORCE_INLINE_ void push_back(T p_elem) {
 		if (unlikely(count == capacity)) {
 			capacity = tight ? (capacity + 1) : MAX((U)1, capacity << 1);
-			data = (T *)memrealloc(data, capacity * sizeof(T));
-			CRASH_COND_MSG(!data, "Out of memory");
+			_realloc_data(capacity);
 		}
 
 		if constexpr (!std::is_trivially_constructible<T>::value && !force_trivial) {
@@ -114,7 +129,7 @@ public:
 	_FORCE_INLINE_ void reset() {
 		clear();
 		if (data) {
-			memfree(data);
+			A::free(data);
 			data = nullptr;
 			capacity = 0;
 		}
@@ -125,8 +140,7 @@ public:
 		p_size = tight ? p_size : nearest_power_of_2_templated(p_size);
 		if (p_size > capacity) {
 			capacity = p_size;
-			data = (T *)memrealloc(data, capacity * sizeof(T));
-			CRASH_COND_MSG(!data, "Out of memory");
+			_realloc_data(capacity);
 		}
 	}
 
@@ -142,8 +156,7 @@ public:
 		} else if (p_size > count) {
 			if (unlikely(p_size > capacity)) {
 				capacity = tight ? p_size : nearest_power_of_2_templated(p_size);
-				data = (T *)memrealloc(data, capacity * sizeof(T));
-				CRASH_COND_MSG(!data, "Out of memory");
+				_realloc_data(capacity);
 			}
 			if constexpr (!std::is_trivially_constructible<T>::value && !force_trivial) {
 				for (U i = count; i < p_size; i++) {
@@ -322,7 +335,7 @@ public:
 	}
 };
 
-template <class T, class U = uint32_t, bool force_trivial = false>
-using TightLocalVector = LocalVector<T, U, force_trivial, true>;
+template <class T, class U = uint32_t, bool force_trivial = false, class A = DefaultAllocator>
+using TightLocalVector = LocalVector<T, U, force_trivial, true, A>;
 
 #endif // LOCAL_VECTOR_H
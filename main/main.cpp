@@ -48,6 +48,7 @@
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/object/message_queue.h"
+#include "core/os/frame_arena.h"
 #include "core/os/os.h"
 #include "core/os/time.h"
 #include "core/register_core_types.h"
@@ -501,6 +502,9 @@ void Main::print_help(const char *p_binary) {
 	OS::get_singleton()->print("  --fixed-fps <fps>                 Force a fixed number of frames per second. This setting disables real-time synchronization.\n");
 	OS::get_singleton()->print("  --delta-smoothing <enable>        Enable or disable frame delta smoothing ['enable', 'disable'].\n");
 	OS::get_singleton()->print("  --print-fps                       Print the frames per second to the stdout.\n");
+#ifdef ALLOCATION_TRACKING_ENABLED
+	OS::get_singleton()->print("  --allocation-dump <path>          Write heap allocation statistics per call site to the given CSV file when the engine quits (default: 'allocations.csv').\n");
+#endif
 	OS::get_singleton()->print("\n");
 
 	OS::get_singleton()->print("Standalone tools:\n");
@@ -1547,6 +1551,16 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 				goto error;
 			}
 
+#ifdef ALLOCATION_TRACKING_ENABLED
+		} else if (I->get() == "--allocation-dump") {
+			if (I->next()) {
+				AllocationTracker::set_dump_path(I->next()->get().utf8().get_data());
+				N = I->next()->next();
+			} else {
+				OS::get_singleton()->print("Missing <path> argument for --allocation-dump <path>.\n");
+				goto error;
+			}
+#endif
 		} else if (I->get() == "--benchmark") {
 			OS::get_singleton()->set_use_benchmark(true);
 		} else if (I->get() == "--benchmark-file") {
@@ -3530,6 +3544,8 @@ bool Main::iteration() {
 
 	iterating++;
 
+	FrameArena::begin_frame();
+
 	const uint64_t ticks = OS::get_singleton()->get_ticks_usec();
 	Engine::get_singleton()->_frame_ticks = ticks;
 	main_timer_sync.set_cpu_ticks_usec(ticks);
@@ -3888,5 +3904,9 @@ void Main::cleanup(bool p_force) {
 	OS::get_singleton()->benchmark_end_measure("Main::cleanup");
 	OS::get_singleton()->benchmark_dump();
 
+#ifdef ALLOCATION_TRACKING_ENABLED
+	AllocationTracker::dump_to_file();
+#endif
+
 	OS::get_singleton()->finalize_core();
 }
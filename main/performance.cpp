@@ -31,8 +31,10 @@
 #include "performance.h"
 
 #include "core/object/message_queue.h"
+#include "core/os/frame_arena.h"
 #include "core/os/os.h"
 #include "core/variant/typed_array.h"
+#include "scene/2d/tile_map.h"
 #include "scene/main/node.h"
 #include "scene/main/scene_tree.h"
 #include "servers/audio_server.h"
@@ -40,6 +42,7 @@
 #include "servers/physics_server_2d.h"
 #include "servers/physics_server_3d.h"
 #include "servers/rendering_server.h"
+#include "servers/text_server.h"
 
 Performance *Performance::singleton = nullptr;
 
@@ -85,6 +88,14 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_MERGE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_CONNECTION_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_FREE_COUNT);
+	BIND_ENUM_CONSTANT(MEMORY_FRAME_ARENA);
+	BIND_ENUM_CONSTANT(MEMORY_FRAME_ARENA_MAX);
+	BIND_ENUM_CONSTANT(TILE_MAP_QUADRANT_REBUILD_TIME);
+	BIND_ENUM_CONSTANT(TEXT_SHAPING_CACHE_HITS);
+	BIND_ENUM_CONSTANT(TEXT_SHAPING_CACHE_MISSES);
+	BIND_ENUM_CONSTANT(NAVIGATION_PATH_QUERY_QUEUE_DEPTH);
+	BIND_ENUM_CONSTANT(NAVIGATION_PATH_QUERY_COUNT);
+	BIND_ENUM_CONSTANT(NAVIGATION_CLUSTER_BUILD_TIME);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -133,6 +144,14 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"navigation/edges_merged",
 		"navigation/edges_connected",
 		"navigation/edges_free",
+		"memory/frame_arena",
+		"memory/frame_arena_max",
+		"tile_map/quadrant_rebuild_time",
+		"text/shaping_cache_hits",
+		"text/shaping_cache_misses",
+		"navigation/path_query_queue_depth",
+		"navigation/path_queries",
+		"navigation/cluster_build_time",
 
 	};
 
@@ -207,6 +226,26 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT);
 		case NAVIGATION_EDGE_FREE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT);
+		case MEMORY_FRAME_ARENA:
+			return FrameArena::get_last_frame_usage();
+		case MEMORY_FRAME_ARENA_MAX:
+			return FrameArena::get_max_frame_usage();
+		case TILE_MAP_QUADRANT_REBUILD_TIME:
+			return TileMap::get_quadrant_rebuild_time();
+		case TEXT_SHAPING_CACHE_HITS: {
+			Ref<TextServer> ts = TextServerManager::get_singleton()->get_primary_interface();
+			return ts.is_valid() ? ts->shaping_cache_get_hit_count() : 0;
+		}
+		case TEXT_SHAPING_CACHE_MISSES: {
+			Ref<TextServer> ts = TextServerManager::get_singleton()->get_primary_interface();
+			return ts.is_valid() ? ts->shaping_cache_get_miss_count() : 0;
+		}
+		case NAVIGATION_PATH_QUERY_QUEUE_DEPTH:
+			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_PATH_QUERY_QUEUE_DEPTH);
+		case NAVIGATION_PATH_QUERY_COUNT:
+			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_PATH_QUERY_COUNT);
+		case NAVIGATION_CLUSTER_BUILD_TIME:
+			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_CLUSTER_BUILD_TIME) / 1000000.0;
 
 		default: {
 		}
@@ -252,6 +291,14 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_TIME,
 
 	};
 
@@ -100,6 +100,14 @@ public:
 		NAVIGATION_EDGE_MERGE_COUNT,
 		NAVIGATION_EDGE_CONNECTION_COUNT,
 		NAVIGATION_EDGE_FREE_COUNT,
+		MEMORY_FRAME_ARENA,
+		MEMORY_FRAME_ARENA_MAX,
+		TILE_MAP_QUADRANT_REBUILD_TIME,
+		TEXT_SHAPING_CACHE_HITS,
+		TEXT_SHAPING_CACHE_MISSES,
+		NAVIGATION_PATH_QUERY_QUEUE_DEPTH,
+		NAVIGATION_PATH_QUERY_COUNT,
+		NAVIGATION_CLUSTER_BUILD_TIME,
 		MONITOR_MAX
 	};
 
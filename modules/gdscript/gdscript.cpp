@@ -31,6 +31,7 @@
 #include "gdscript.h"
 
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
@@ -424,6 +425,7 @@ void GDScript::set_source_code(const String &p_code) {
 		return;
 	}
 	source = p_code;
+	pending_bytecode = Dictionary(); // Decoded for the previous source.
 #ifdef TOOLS_ENABLED
 	source_changed_cache = true;
 #endif
@@ -729,6 +731,25 @@ Error GDScript::reload(bool p_keep_state) {
 	}
 #endif
 
+	// The shallow script may already have decoded the cache, don't read it again.
+	Dictionary bytecode = pending_bytecode;
+	pending_bytecode = Dictionary();
+
+	if (!is_valid() && !has_instances) {
+		// Exported projects may ship the compiled script next to its source.
+		if ((!bytecode.is_empty() || GDScriptBytecodeCache::read(path, source, bytecode) == OK) && GDScriptBytecodeCache::load(this, bytecode) == OK) {
+			if (ScriptServer::is_scripting_enabled() || is_tool()) {
+				Error err = _static_init();
+				if (err) {
+					reloading = false;
+					return err;
+				}
+			}
+			reloading = false;
+			return OK;
+		}
+	}
+
 	valid = false;
 	GDScriptParser parser;
 	Error err = parser.parse(source, path, false);
@@ -84,6 +84,7 @@ class GDScript : public Script {
 	friend class GDScriptInstance;
 	friend class GDScriptFunction;
 	friend class GDScriptAnalyzer;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptCompiler;
 	friend class GDScriptDocGen;
 	friend class GDScriptLanguage;
@@ -145,6 +146,7 @@ class GDScript : public Script {
 	//exported members
 	String source;
 	String path;
+	Dictionary pending_bytecode; // Decoded from the bytecode cache by GDScriptCache, consumed by the first reload().
 	StringName local_name; // Inner class identifier or `class_name`.
 	StringName global_name; // `class_name`.
 	String fully_qualified_name;
@@ -34,6 +34,8 @@
 
 #include "core/debugger/engine_debugger.h"
 
+bool GDScriptByteCodeGenerator::peephole_enabled = true;
+
 uint32_t GDScriptByteCodeGenerator::add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) {
 	function->_argument_count++;
 	function->argument_types.push_back(p_type);
@@ -431,6 +433,81 @@ void GDScriptByteCodeGenerator::set_initial_line(int p_line) {
 #define IS_BUILTIN_TYPE(m_var, m_type) \
 	(m_var.type.has_type && m_var.type.kind == GDScriptDataType::BUILTIN && m_var.type.builtin_type == m_type)
 
+static bool _is_same_address(const GDScriptCodeGenerator::Address &p_a, const GDScriptCodeGenerator::Address &p_b) {
+	return p_a.mode == p_b.mode && p_a.address == p_b.address;
+}
+
+static bool _is_comparison(Variant::Operator p_operator) {
+	switch (p_operator) {
+		case Variant::OP_EQUAL:
+		case Variant::OP_NOT_EQUAL:
+		case Variant::OP_LESS:
+		case Variant::OP_LESS_EQUAL:
+		case Variant::OP_GREATER:
+		case Variant::OP_GREATER_EQUAL:
+			return true;
+		default:
+			return false;
+	}
+}
+
+bool GDScriptByteCodeGenerator::fuse_jump_if_not(const Address &p_condition, List<int> &r_jump_addrs) {
+	// Only fuse when the condition is the result of the operator emitted right before,
+	// and no jump lands in between (which would end up in the middle of the fused instruction).
+	if (!peephole_enabled || last_operator.position < 0 || last_operator.position + 5 != opcodes.size() || last_jump_target == opcodes.size()) {
+		return false;
+	}
+	if (p_condition.mode != Address::TEMPORARY || !_is_same_address(p_condition, last_operator.target)) {
+		return false;
+	}
+
+	const Variant::Type left_type = last_operator.left.type.builtin_type;
+	const Variant::Type right_type = last_operator.right.type.builtin_type;
+	if (Variant::get_operator_return_type(last_operator.op, left_type, right_type) != Variant::BOOL) {
+		return false;
+	}
+
+	// Keep the operator layout (left, right, target, operator) so temporaries can still be patched,
+	// and append the jump destination to it.
+	if (_is_comparison(last_operator.op) && left_type == right_type && (left_type == Variant::INT || left_type == Variant::FLOAT)) {
+		opcodes.write[last_operator.position] = left_type == Variant::INT ? GDScriptFunction::OPCODE_JUMP_IF_NOT_COMPARE_INT : GDScriptFunction::OPCODE_JUMP_IF_NOT_COMPARE_FLOAT;
+		opcodes.write[last_operator.position + 4] = last_operator.op;
+	} else {
+		opcodes.write[last_operator.position] = GDScriptFunction::OPCODE_JUMP_IF_NOT_OPERATOR_VALIDATED;
+	}
+	last_operator.position = -1;
+
+	r_jump_addrs.push_back(opcodes.size());
+	append(0); // Jump destination, will be patched.
+	return true;
+}
+
+bool GDScriptByteCodeGenerator::fuse_increment(const Address &p_target, const Address &p_source) {
+	// Turn `var op= step` on a typed int or float local into an in-place update, skipping the temporary assignment.
+	if (!peephole_enabled || last_operator.position < 0 || last_operator.position + 5 != opcodes.size() || last_jump_target == opcodes.size()) {
+		return false;
+	}
+	if (last_operator.op != Variant::OP_ADD && last_operator.op != Variant::OP_SUBTRACT) {
+		return false;
+	}
+	if (p_target.mode != Address::LOCAL_VARIABLE && p_target.mode != Address::FUNCTION_PARAMETER) {
+		return false;
+	}
+	if (p_source.mode != Address::TEMPORARY || !_is_same_address(p_source, last_operator.target) || !_is_same_address(p_target, last_operator.left)) {
+		return false;
+	}
+
+	Variant::Type type = p_target.type.builtin_type;
+	if ((type != Variant::INT && type != Variant::FLOAT) || !IS_BUILTIN_TYPE(p_target, type) || !IS_BUILTIN_TYPE(last_operator.left, type) || !IS_BUILTIN_TYPE(last_operator.right, type)) {
+		return false;
+	}
+
+	opcodes.write[last_operator.position] = type == Variant::INT ? GDScriptFunction::OPCODE_INCREMENT_INT : GDScriptFunction::OPCODE_INCREMENT_FLOAT;
+	opcodes.write[last_operator.position + 4] = last_operator.op;
+	last_operator.position = -1;
+	return true;
+}
+
 void GDScriptByteCodeGenerator::write_type_adjust(const Address &p_target, Variant::Type p_new_type) {
 	switch (p_new_type) {
 		case Variant::BOOL:
@@ -595,6 +672,12 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
+		last_operator.position = opcodes.size();
+		last_operator.op = p_operator;
+		last_operator.left = p_left_operand;
+		last_operator.right = p_right_operand;
+		last_operator.target = p_target;
+
 		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
 		append(p_left_operand);
 		append(p_right_operand);
@@ -758,6 +841,17 @@ void GDScriptByteCodeGenerator::write_end_ternary() {
 
 void GDScriptByteCodeGenerator::write_set(const Address &p_target, const Address &p_index, const Address &p_source) {
 	if (HAS_BUILTIN_TYPE(p_target)) {
+		if (peephole_enabled && p_target.type.builtin_type == Variant::ARRAY && p_target.type.has_container_element_type() && IS_BUILTIN_TYPE(p_index, Variant::INT)) {
+			// Typed array with a value of the exact element type, no validation needed on set.
+			const GDScriptDataType &element_type = p_target.type.get_container_element_type();
+			if (element_type.kind == GDScriptDataType::BUILTIN && element_type.builtin_type != Variant::OBJECT && element_type.builtin_type != Variant::NIL && IS_BUILTIN_TYPE(p_source, element_type.builtin_type)) {
+				append_opcode(GDScriptFunction::OPCODE_SET_INDEXED_TYPED_ARRAY);
+				append(p_target);
+				append(p_index);
+				append(p_source);
+				return;
+			}
+		}
 		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_setter(p_target.type.builtin_type) &&
 				IS_BUILTIN_TYPE(p_source, Variant::get_indexed_element_type(p_target.type.builtin_type))) {
 			// Use indexed setter instead.
@@ -787,6 +881,13 @@ void GDScriptByteCodeGenerator::write_set(const Address &p_target, const Address
 
 void GDScriptByteCodeGenerator::write_get(const Address &p_target, const Address &p_index, const Address &p_source) {
 	if (HAS_BUILTIN_TYPE(p_source)) {
+		if (peephole_enabled && p_source.type.builtin_type == Variant::ARRAY && IS_BUILTIN_TYPE(p_index, Variant::INT)) {
+			append_opcode(GDScriptFunction::OPCODE_GET_INDEXED_ARRAY);
+			append(p_source);
+			append(p_index);
+			append(p_target);
+			return;
+		}
 		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_getter(p_source.type.builtin_type)) {
 			// Use indexed getter instead.
 			Variant::ValidatedIndexedGetter getter = Variant::get_member_validated_indexed_getter(p_source.type.builtin_type);
@@ -924,6 +1025,10 @@ void GDScriptByteCodeGenerator::write_assign_with_conversion(const Address &p_ta
 }
 
 void GDScriptByteCodeGenerator::write_assign(const Address &p_target, const Address &p_source) {
+	if (fuse_increment(p_target, p_source)) {
+		return;
+	}
+
 	if (p_target.type.kind == GDScriptDataType::BUILTIN && p_target.type.builtin_type == Variant::ARRAY && p_target.type.has_container_element_type()) {
 		const GDScriptDataType &element_type = p_target.type.get_container_element_type();
 		append_opcode(GDScriptFunction::OPCODE_ASSIGN_TYPED_ARRAY);
@@ -1408,6 +1513,10 @@ void GDScriptByteCodeGenerator::write_await(const Address &p_target, const Addre
 }
 
 void GDScriptByteCodeGenerator::write_if(const Address &p_condition) {
+	if (fuse_jump_if_not(p_condition, if_jmp_addrs)) {
+		return;
+	}
+
 	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
 	append(p_condition);
 	if_jmp_addrs.push_back(opcodes.size());
@@ -1616,6 +1725,10 @@ void GDScriptByteCodeGenerator::start_while_condition() {
 
 void GDScriptByteCodeGenerator::write_while(const Address &p_condition) {
 	// Condition check.
+	if (fuse_jump_if_not(p_condition, while_jmp_addrs)) {
+		return;
+	}
+
 	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
 	append(p_condition);
 	while_jmp_addrs.push_back(opcodes.size());
@@ -157,6 +157,20 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	List<List<int>> current_breaks_to_patch;
 
+	// Last emitted binary validated operator, kept so the peephole pass can fuse it
+	// with the jump or assignment that immediately consumes its result.
+	struct FusableOperator {
+		int position = -1;
+		Variant::Operator op = Variant::OP_MAX;
+		Address left;
+		Address right;
+		Address target;
+	} last_operator;
+	int last_jump_target = -1;
+
+	bool fuse_jump_if_not(const Address &p_condition, List<int> &r_jump_addrs);
+	bool fuse_increment(const Address &p_target, const Address &p_source);
+
 	void add_stack_identifier(const StringName &p_id, int p_stackpos) {
 		if (locals.size() > max_locals) {
 			max_locals = locals.size();
@@ -445,9 +459,13 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	void patch_jump(int p_address) {
 		opcodes.write[p_address] = opcodes.size();
+		last_jump_target = opcodes.size();
 	}
 
 public:
+	// Fuse common instruction sequences into superinstructions. Can be disabled to compare against unfused bytecode.
+	static bool peephole_enabled;
+
 	virtual uint32_t add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local(const StringName &p_name, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local_constant(const StringName &p_name, const Variant &p_constant) override;
@@ -0,0 +1,1172 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_cache.h"
+
+#include "gdscript_cache.h"
+#include "gdscript_utility_functions.h"
+
+#include "core/config/engine.h"
+#include "core/debugger/engine_debugger.h"
+#include "core/io/file_access.h"
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+#include "core/version.h"
+
+static const uint8_t BYTECODE_MAGIC[4] = { 'G', 'D', 'B', 'C' };
+static const int BYTECODE_HEADER_SIZE = 32; // Magic, format version, engine hash, source MD5, payload size.
+
+// Compiled functions keep raw pointers to validated Variant operations and utility functions.
+// Those differ between the editor and export templates, so they are stored by name and type,
+// and resolved again when the cache is loaded.
+
+template <typename T>
+static uint64_t _pointer_id(T p_pointer) {
+	return (uint64_t)reinterpret_cast<uintptr_t>(p_pointer);
+}
+
+struct GDScriptPointerNames {
+	HashMap<uint64_t, Variant> operators;
+	HashMap<uint64_t, Variant> setters;
+	HashMap<uint64_t, Variant> getters;
+	HashMap<uint64_t, Variant> keyed_setters;
+	HashMap<uint64_t, Variant> keyed_getters;
+	HashMap<uint64_t, Variant> indexed_setters;
+	HashMap<uint64_t, Variant> indexed_getters;
+	HashMap<uint64_t, Variant> builtin_methods;
+	HashMap<uint64_t, Variant> constructors;
+	HashMap<uint64_t, Variant> utilities;
+	HashMap<uint64_t, Variant> gds_utilities;
+
+	template <typename T>
+	static void add(HashMap<uint64_t, Variant> &r_map, T p_pointer, const Variant &p_key) {
+		if (p_pointer == nullptr) {
+			return;
+		}
+		uint64_t id = _pointer_id(p_pointer);
+		if (!r_map.has(id)) {
+			r_map.insert(id, p_key);
+		}
+	}
+
+	GDScriptPointerNames() {
+		for (int type_idx = 0; type_idx < Variant::VARIANT_MAX; type_idx++) {
+			Variant::Type type = (Variant::Type)type_idx;
+
+			for (int op = 0; op < Variant::OP_MAX; op++) {
+				for (int right_idx = 0; right_idx < Variant::VARIANT_MAX; right_idx++) {
+					add(operators, Variant::get_validated_operator_evaluator((Variant::Operator)op, type, (Variant::Type)right_idx), varray(op, type_idx, right_idx));
+				}
+			}
+
+			List<StringName> members;
+			Variant::get_member_list(type, &members);
+			for (const StringName &E : members) {
+				add(setters, Variant::get_member_validated_setter(type, E), varray(type_idx, E));
+				add(getters, Variant::get_member_validated_getter(type, E), varray(type_idx, E));
+			}
+
+			add(keyed_setters, Variant::get_member_validated_keyed_setter(type), type_idx);
+			add(keyed_getters, Variant::get_member_validated_keyed_getter(type), type_idx);
+			add(indexed_setters, Variant::get_member_validated_indexed_setter(type), type_idx);
+			add(indexed_getters, Variant::get_member_validated_indexed_getter(type), type_idx);
+
+			List<StringName> methods;
+			Variant::get_builtin_method_list(type, &methods);
+			for (const StringName &E : methods) {
+				add(builtin_methods, Variant::get_validated_builtin_method(type, E), varray(type_idx, E));
+			}
+
+			for (int i = 0; i < Variant::get_constructor_count(type); i++) {
+				add(constructors, Variant::get_validated_constructor(type, i), varray(type_idx, i));
+			}
+		}
+
+		List<StringName> utility_functions;
+		Variant::get_utility_function_list(&utility_functions);
+		for (const StringName &E : utility_functions) {
+			add(utilities, Variant::get_validated_utility_function(E), E);
+		}
+
+		List<StringName> gds_utility_functions;
+		GDScriptUtilityFunctions::get_function_list(&gds_utility_functions);
+		for (const StringName &E : gds_utility_functions) {
+			add(gds_utilities, GDScriptUtilityFunctions::get_function(E), E);
+		}
+	}
+};
+
+static const GDScriptPointerNames &_get_pointer_names() {
+	static GDScriptPointerNames names;
+	return names;
+}
+
+template <typename T>
+static Array _encode_pointer_table(const Vector<T> &p_table, const HashMap<uint64_t, Variant> &p_names, Error &r_error) {
+	Array keys;
+	for (const T &E : p_table) {
+		HashMap<uint64_t, Variant>::ConstIterator name = p_names.find(_pointer_id(E));
+		if (!name) {
+			r_error = ERR_UNAVAILABLE;
+			return Array();
+		}
+		keys.push_back(name->value);
+	}
+	return keys;
+}
+
+template <typename T>
+static void _set_table_pointers(Vector<T> &p_table, int &r_count, const T *&r_ptr) {
+	r_count = p_table.size();
+	r_ptr = p_table.is_empty() ? nullptr : p_table.ptr();
+}
+
+static bool _is_valid_type(int p_type) {
+	return p_type >= 0 && p_type < Variant::VARIANT_MAX;
+}
+
+uint32_t GDScriptBytecodeCache::get_engine_hash() {
+	uint32_t hash = hash_murmur3_one_32(FORMAT_VERSION);
+	hash = hash_murmur3_one_32(String(VERSION_FULL_BUILD).hash(), hash);
+	hash = hash_murmur3_one_32(String(VERSION_HASH).hash(), hash);
+	hash = hash_murmur3_one_32(GDScriptFunction::OPCODE_END, hash);
+	hash = hash_murmur3_one_32(Variant::VARIANT_MAX, hash);
+	hash = hash_murmur3_one_32(Variant::OP_MAX, hash);
+	hash = hash_murmur3_one_32(sizeof(real_t), hash);
+	return hash_fmix32(hash);
+}
+
+String GDScriptBytecodeCache::get_cache_path(const String &p_script_path) {
+	if (!p_script_path.is_resource_file() || p_script_path.get_extension().to_lower() != "gd") {
+		return String();
+	}
+	return p_script_path.get_basename() + ".gdc";
+}
+
+/* Encoding */
+
+Variant GDScriptBytecodeCache::_encode_script_ref(Writer &p_writer, const Script *p_script) {
+	Array ref;
+
+	const GDScript *gdscript = Object::cast_to<GDScript>(p_script);
+	if (gdscript) {
+		// Classes from the cached file are stored by their inner class names,
+		// so they resolve to the new class instances when loading.
+		PackedStringArray names;
+		const GDScript *root = gdscript;
+		while (root->_owner) {
+			names.insert(0, root->local_name);
+			root = root->_owner;
+		}
+		if (root == p_writer.main_script) {
+			ref.push_back(VALUE_LOCAL_CLASS);
+			ref.push_back(names);
+			return ref;
+		}
+
+		if (!gdscript->path.is_resource_file()) {
+			p_writer.error = ERR_UNAVAILABLE;
+			return Variant();
+		}
+		ref.push_back(VALUE_GDSCRIPT);
+		ref.push_back(gdscript->path);
+		ref.push_back(gdscript->fully_qualified_name);
+		return ref;
+	}
+
+	if (p_script->is_built_in()) {
+		p_writer.error = ERR_UNAVAILABLE;
+		return Variant();
+	}
+	ref.push_back(VALUE_SCRIPT);
+	ref.push_back(p_script->get_path());
+	return ref;
+}
+
+Variant GDScriptBytecodeCache::_encode_value(Writer &p_writer, const Variant &p_value) {
+	Array encoded;
+
+	switch (p_value.get_type()) {
+		case Variant::OBJECT: {
+			Object *obj = p_value.get_validated_object();
+			if (obj == nullptr) {
+				encoded.push_back(VALUE_NULL_OBJECT);
+				break;
+			}
+
+			GDScriptNativeClass *native = Object::cast_to<GDScriptNativeClass>(obj);
+			if (native) {
+				encoded.push_back(VALUE_NATIVE_CLASS);
+				encoded.push_back(native->get_name());
+				break;
+			}
+
+			Script *script = Object::cast_to<Script>(obj);
+			if (script) {
+				return _encode_script_ref(p_writer, script);
+			}
+
+			Resource *res = Object::cast_to<Resource>(obj);
+			if (res && !res->is_built_in()) {
+				encoded.push_back(VALUE_RESOURCE);
+				encoded.push_back(res->get_path());
+				encoded.push_back(res->get_class());
+				break;
+			}
+
+			// Built-in resources and plain objects can't be referenced from the cache.
+			p_writer.error = ERR_UNAVAILABLE;
+			return Variant();
+		} break;
+		case Variant::ARRAY: {
+			Array array = p_value;
+			Ref<Script> typed_script = array.get_typed_script();
+
+			Array elements;
+			for (int i = 0; i < array.size(); i++) {
+				elements.push_back(_encode_value(p_writer, array[i]));
+			}
+
+			encoded.push_back(VALUE_ARRAY);
+			encoded.push_back(array.get_typed_builtin());
+			encoded.push_back(array.get_typed_class_name());
+			encoded.push_back(typed_script.is_valid() ? _encode_script_ref(p_writer, typed_script.ptr()) : Variant());
+			encoded.push_back(array.is_read_only());
+			encoded.push_back(elements);
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary dict = p_value;
+
+			Array pairs;
+			for (const Variant *key = dict.next(nullptr); key; key = dict.next(key)) {
+				pairs.push_back(_encode_value(p_writer, *key));
+				pairs.push_back(_encode_value(p_writer, dict[*key]));
+			}
+
+			encoded.push_back(VALUE_DICTIONARY);
+			encoded.push_back(dict.is_read_only());
+			encoded.push_back(pairs);
+		} break;
+		case Variant::RID:
+		case Variant::CALLABLE:
+		case Variant::SIGNAL: {
+			// Only meaningful within the running instance.
+			p_writer.error = ERR_UNAVAILABLE;
+			return Variant();
+		} break;
+		default: {
+			encoded.push_back(VALUE_BUILTIN);
+			encoded.push_back(p_value);
+		} break;
+	}
+
+	return encoded;
+}
+
+Variant GDScriptBytecodeCache::_encode_data_type(Writer &p_writer, const GDScriptDataType &p_type) {
+	Array encoded;
+	encoded.push_back(p_type.has_type);
+	encoded.push_back(p_type.kind);
+	encoded.push_back(p_type.builtin_type);
+	encoded.push_back(p_type.native_type);
+	encoded.push_back(p_type.script_type ? _encode_script_ref(p_writer, p_type.script_type) : Variant());
+	encoded.push_back(p_type.has_container_element_type() ? _encode_data_type(p_writer, p_type.get_container_element_type()) : Variant());
+	return encoded;
+}
+
+Dictionary GDScriptBytecodeCache::_encode_function(Writer &p_writer, const GDScriptFunction *p_function) {
+	const GDScriptPointerNames &names = _get_pointer_names();
+	Dictionary data;
+
+	data["name"] = p_function->name;
+	data["static"] = p_function->_static;
+	data["initial_line"] = p_function->_initial_line;
+	data["argument_count"] = p_function->_argument_count;
+	data["stack_size"] = p_function->_stack_size;
+	data["instruction_args_size"] = p_function->_instruction_args_size;
+	data["rpc_config"] = _encode_value(p_writer, p_function->rpc_config);
+	data["method_info"] = _encode_value(p_writer, Dictionary(p_function->method_info));
+	data["return_type"] = _encode_data_type(p_writer, p_function->return_type);
+
+	Array argument_types;
+	for (const GDScriptDataType &E : p_function->argument_types) {
+		argument_types.push_back(_encode_data_type(p_writer, E));
+	}
+	data["argument_types"] = argument_types;
+
+	data["code"] = p_function->code;
+	data["default_arguments"] = p_function->default_arguments;
+
+	Array constants;
+	for (const Variant &E : p_function->constants) {
+		constants.push_back(_encode_value(p_writer, E));
+	}
+	data["constants"] = constants;
+
+	Array global_names;
+	for (const StringName &E : p_function->global_names) {
+		global_names.push_back(E);
+	}
+	data["global_names"] = global_names;
+
+	Dictionary temporary_slots;
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		temporary_slots[E.key] = E.value;
+	}
+	data["temporary_slots"] = temporary_slots;
+
+	data["operator_funcs"] = _encode_pointer_table(p_function->operator_funcs, names.operators, p_writer.error);
+	data["setters"] = _encode_pointer_table(p_function->setters, names.setters, p_writer.error);
+	data["getters"] = _encode_pointer_table(p_function->getters, names.getters, p_writer.error);
+	data["keyed_setters"] = _encode_pointer_table(p_function->keyed_setters, names.keyed_setters, p_writer.error);
+	data["keyed_getters"] = _encode_pointer_table(p_function->keyed_getters, names.keyed_getters, p_writer.error);
+	data["indexed_setters"] = _encode_pointer_table(p_function->indexed_setters, names.indexed_setters, p_writer.error);
+	data["indexed_getters"] = _encode_pointer_table(p_function->indexed_getters, names.indexed_getters, p_writer.error);
+	data["builtin_methods"] = _encode_pointer_table(p_function->builtin_methods, names.builtin_methods, p_writer.error);
+	data["constructors"] = _encode_pointer_table(p_function->constructors, names.constructors, p_writer.error);
+	data["utilities"] = _encode_pointer_table(p_function->utilities, names.utilities, p_writer.error);
+	data["gds_utilities"] = _encode_pointer_table(p_function->gds_utilities, names.gds_utilities, p_writer.error);
+
+	Array methods;
+	for (const MethodBind *E : p_function->methods) {
+		methods.push_back(varray(E->get_instance_class(), E->get_name()));
+	}
+	data["methods"] = methods;
+
+	Array lambdas;
+	for (const GDScriptFunction *E : p_function->lambdas) {
+		lambdas.push_back(_encode_function(p_writer, E));
+	}
+	data["lambdas"] = lambdas;
+
+	Array stack_debug;
+	for (const GDScriptFunction::StackDebug &E : p_function->stack_debug) {
+		stack_debug.push_back(varray(E.line, E.pos, E.added, E.identifier));
+	}
+	data["stack_debug"] = stack_debug;
+
+#ifdef DEBUG_ENABLED
+	data["signature"] = p_function->profile.signature;
+#endif
+
+	return data;
+}
+
+Array GDScriptBytecodeCache::_encode_member(Writer &p_writer, const StringName &p_name, const GDScript::MemberInfo &p_info) {
+	Array member;
+	member.push_back(p_name);
+	member.push_back(p_info.index);
+	member.push_back(p_info.setter);
+	member.push_back(p_info.getter);
+	member.push_back(_encode_data_type(p_writer, p_info.data_type));
+	member.push_back(_encode_value(p_writer, Dictionary(p_info.property_info)));
+	return member;
+}
+
+Dictionary GDScriptBytecodeCache::_encode_class(Writer &p_writer, const GDScript *p_script) {
+	Dictionary data;
+
+	data["local_name"] = p_script->local_name;
+	data["global_name"] = p_script->global_name;
+	data["fully_qualified_name"] = p_script->fully_qualified_name;
+	data["icon_path"] = p_script->simplified_icon_path;
+	data["tool"] = p_script->tool;
+	data["native"] = p_script->native.is_valid() ? p_script->native->get_name() : StringName();
+	data["base"] = p_script->base.is_valid() ? _encode_script_ref(p_writer, p_script->base.ptr()) : Variant();
+	data["base_member_count"] = p_script->base.is_valid() ? p_script->base->member_indices.size() : 0;
+
+	Array members;
+	for (const StringName &E : p_script->members) {
+		const GDScript::MemberInfo &info = p_script->member_indices[E];
+		members.push_back(_encode_member(p_writer, E, p_script->member_indices[E]));
+	}
+	data["members"] = members;
+
+	Array static_variables;
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->static_variables_indices) {
+		static_variables.push_back(_encode_member(p_writer, E.key, E.value));
+	}
+	data["static_variables"] = static_variables;
+
+	Array constants;
+	for (const KeyValue<StringName, Variant> &E : p_script->constants) {
+		if (p_script->subclasses.has(E.key)) {
+			continue; // Inner classes are added back as constants when loading.
+		}
+		constants.push_back(varray(E.key, _encode_value(p_writer, E.value)));
+	}
+	data["constants"] = constants;
+
+	Array signals;
+	for (const KeyValue<StringName, MethodInfo> &E : p_script->_signals) {
+		signals.push_back(varray(E.key, _encode_value(p_writer, Dictionary(E.value))));
+	}
+	data["signals"] = signals;
+
+	data["rpc_config"] = _encode_value(p_writer, p_script->rpc_config);
+
+	Array functions;
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+		functions.push_back(_encode_function(p_writer, E.value));
+	}
+	data["functions"] = functions;
+
+	data["implicit_initializer"] = p_script->implicit_initializer ? Variant(_encode_function(p_writer, p_script->implicit_initializer)) : Variant();
+	data["implicit_ready"] = p_script->implicit_ready ? Variant(_encode_function(p_writer, p_script->implicit_ready)) : Variant();
+	data["static_initializer"] = p_script->static_initializer ? Variant(_encode_function(p_writer, p_script->static_initializer)) : Variant();
+
+	Array subclasses;
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		subclasses.push_back(_encode_class(p_writer, E.value.ptr()));
+	}
+	data["subclasses"] = subclasses;
+
+	return data;
+}
+
+Error GDScriptBytecodeCache::encode(const Ref<GDScript> &p_script, Vector<uint8_t> &r_buffer) {
+	ERR_FAIL_COND_V(p_script.is_null(), ERR_INVALID_PARAMETER);
+	if (!p_script->is_valid()) {
+		return ERR_INVALID_DATA;
+	}
+
+	Writer writer;
+	writer.main_script = p_script.ptr();
+
+	Dictionary data;
+	data["class"] = _encode_class(writer, p_script.ptr());
+	data["static_cache"] = GDScriptCache::singleton->static_gdscript_cache.has(p_script->fully_qualified_name);
+	// Local variable names for the debugger are only generated while a debugger is attached.
+	data["debug_info"] = EngineDebugger::is_active();
+
+	if (writer.error != OK) {
+		return writer.error;
+	}
+
+	int len = 0;
+	Error err = encode_variant(data, nullptr, len, false);
+	ERR_FAIL_COND_V(err != OK, err);
+
+	Vector<uint8_t> source_md5 = p_script->get_source_code().md5_buffer();
+	ERR_FAIL_COND_V(source_md5.size() != 16, ERR_BUG);
+
+	r_buffer.resize(BYTECODE_HEADER_SIZE + len);
+	uint8_t *w = r_buffer.ptrw();
+	memcpy(w, BYTECODE_MAGIC, 4);
+	encode_uint32(FORMAT_VERSION, w + 4);
+	encode_uint32(get_engine_hash(), w + 8);
+	memcpy(w + 12, source_md5.ptr(), 16);
+	encode_uint32(len, w + 28);
+
+	return encode_variant(data, w + BYTECODE_HEADER_SIZE, len, false);
+}
+
+/* Decoding */
+
+Error GDScriptBytecodeCache::decode(const Vector<uint8_t> &p_buffer, const String &p_source, Dictionary &r_data) {
+	ERR_FAIL_COND_V(p_buffer.size() < BYTECODE_HEADER_SIZE, ERR_FILE_CORRUPT);
+
+	const uint8_t *r = p_buffer.ptr();
+	ERR_FAIL_COND_V(memcmp(r, BYTECODE_MAGIC, 4) != 0, ERR_FILE_UNRECOGNIZED);
+
+	// Outdated caches are expected after engine updates, so fall back silently.
+	if (decode_uint32(r + 4) != FORMAT_VERSION || decode_uint32(r + 8) != get_engine_hash()) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+
+	Vector<uint8_t> source_md5 = p_source.md5_buffer();
+	if (source_md5.size() != 16 || memcmp(r + 12, source_md5.ptr(), 16) != 0) {
+		return ERR_FILE_MISSING_DEPENDENCIES;
+	}
+
+	uint32_t len = decode_uint32(r + 28);
+	ERR_FAIL_COND_V(len > uint32_t(p_buffer.size() - BYTECODE_HEADER_SIZE), ERR_FILE_CORRUPT);
+
+	Variant data;
+	Error err = decode_variant(data, r + BYTECODE_HEADER_SIZE, len, nullptr, false);
+	ERR_FAIL_COND_V(err != OK, err);
+	ERR_FAIL_COND_V(data.get_type() != Variant::DICTIONARY, ERR_FILE_CORRUPT);
+
+	r_data = data;
+
+	if (EngineDebugger::is_active() && !bool(r_data.get("debug_info", false))) {
+		// Compile from source so the debugger can show local variables.
+		return ERR_UNAVAILABLE;
+	}
+
+	return OK;
+}
+
+Error GDScriptBytecodeCache::read(const String &p_script_path, const String &p_source, Dictionary &r_data) {
+	if (Engine::get_singleton()->is_editor_hint()) {
+		return ERR_UNAVAILABLE;
+	}
+
+	String cache_path = get_cache_path(p_script_path);
+	if (cache_path.is_empty() || !FileAccess::exists(cache_path)) {
+		return ERR_FILE_NOT_FOUND;
+	}
+
+	Error err = OK;
+	Vector<uint8_t> buffer = FileAccess::get_file_as_bytes(cache_path, &err);
+	if (err == OK) {
+		err = decode(buffer, p_source, r_data);
+	}
+	if (err != OK) {
+		print_verbose(vformat(R"(GDScript: Ignoring bytecode cache "%s" (%s), compiling from source instead.)", cache_path, error_names[err]));
+	}
+	return err;
+}
+
+Ref<Script> GDScriptBytecodeCache::_decode_script_ref(Reader &p_reader, const Array &p_ref, bool &r_local) {
+	r_local = false;
+	if (p_ref.size() < 2) {
+		p_reader.error = ERR_FILE_CORRUPT;
+		return Ref<Script>();
+	}
+
+	switch (int(p_ref[0])) {
+		case VALUE_LOCAL_CLASS: {
+			PackedStringArray names = p_ref[1];
+			GDScript *script = p_reader.main_script;
+			for (const String &name : names) {
+				HashMap<StringName, Ref<GDScript>>::Iterator E = script->subclasses.find(name);
+				if (!E) {
+					p_reader.error = ERR_FILE_CORRUPT;
+					return Ref<Script>();
+				}
+				script = E->value.ptr();
+			}
+			r_local = true;
+			return Ref<Script>(script);
+		} break;
+		case VALUE_GDSCRIPT: {
+			ERR_FAIL_COND_V(p_ref.size() < 3, Ref<Script>());
+			String path = p_ref[1];
+			Error err = OK;
+			Ref<GDScript> root = GDScriptCache::get_shallow_script(path, err, p_reader.owner_path);
+			GDScript *script = root.is_valid() ? root->find_class(p_ref[2]) : nullptr;
+			if (err != OK || script == nullptr) {
+				p_reader.error = ERR_CANT_RESOLVE;
+				return Ref<Script>();
+			}
+			return Ref<Script>(script);
+		} break;
+		case VALUE_SCRIPT: {
+			Ref<Script> script = ResourceLoader::load(p_ref[1], "Script");
+			if (script.is_null()) {
+				p_reader.error = ERR_CANT_RESOLVE;
+			}
+			return script;
+		} break;
+	}
+
+	p_reader.error = ERR_FILE_CORRUPT;
+	return Ref<Script>();
+}
+
+Variant GDScriptBytecodeCache::_decode_value(Reader &p_reader, const Variant &p_value) {
+	Array encoded = p_value;
+	if (p_value.get_type() != Variant::ARRAY || encoded.is_empty()) {
+		p_reader.error = ERR_FILE_CORRUPT;
+		return Variant();
+	}
+
+	switch (int(encoded[0])) {
+		case VALUE_BUILTIN: {
+			return encoded[1];
+		} break;
+		case VALUE_NULL_OBJECT: {
+			return Variant((Object *)nullptr);
+		} break;
+		case VALUE_LOCAL_CLASS:
+		case VALUE_GDSCRIPT:
+		case VALUE_SCRIPT: {
+			bool local = false;
+			return _decode_script_ref(p_reader, encoded, local);
+		} break;
+		case VALUE_NATIVE_CLASS: {
+			GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+			HashMap<StringName, int>::ConstIterator E = language->get_global_map().find(encoded[1]);
+			if (!E) {
+				p_reader.error = ERR_CANT_RESOLVE;
+				return Variant();
+			}
+			return language->get_global_array()[E->value];
+		} break;
+		case VALUE_RESOURCE: {
+			String path = encoded[1];
+			Error err = OK;
+			Ref<Resource> res;
+			if (String(encoded[2]) == "PackedScene") {
+				res = GDScriptCache::get_packed_scene(path, err, p_reader.owner_path);
+			} else {
+				res = ResourceLoader::load(path, "", ResourceFormatLoader::CACHE_MODE_REUSE, &err);
+			}
+			if (err != OK || res.is_null()) {
+				p_reader.error = ERR_CANT_RESOLVE;
+				return Variant();
+			}
+			return res;
+		} break;
+		case VALUE_ARRAY: {
+			Array elements = encoded[5];
+			Array array;
+			Variant typed_script;
+			if (encoded[3].get_type() == Variant::ARRAY) {
+				bool local = false;
+				typed_script = _decode_script_ref(p_reader, encoded[3], local);
+			}
+			if (int(encoded[1]) != Variant::NIL) {
+				array.set_typed(encoded[1], encoded[2], typed_script);
+			}
+			for (int i = 0; i < elements.size(); i++) {
+				array.push_back(_decode_value(p_reader, elements[i]));
+			}
+			if (bool(encoded[4])) {
+				array.make_read_only();
+			}
+			return array;
+		} break;
+		case VALUE_DICTIONARY: {
+			Array pairs = encoded[2];
+			Dictionary dict;
+			for (int i = 0; i + 1 < pairs.size(); i += 2) {
+				dict[_decode_value(p_reader, pairs[i])] = _decode_value(p_reader, pairs[i + 1]);
+			}
+			if (bool(encoded[1])) {
+				dict.make_read_only();
+			}
+			return dict;
+		} break;
+	}
+
+	p_reader.error = ERR_FILE_CORRUPT;
+	return Variant();
+}
+
+GDScriptDataType GDScriptBytecodeCache::_decode_data_type(Reader &p_reader, const Variant &p_type) {
+	GDScriptDataType type;
+	Array encoded = p_type;
+	if (encoded.size() != 6 || !_is_valid_type(encoded[2])) {
+		p_reader.error = ERR_FILE_CORRUPT;
+		return type;
+	}
+
+	type.has_type = encoded[0];
+	type.kind = GDScriptDataType::Kind(int(encoded[1]));
+	type.builtin_type = Variant::Type(int(encoded[2]));
+	type.native_type = encoded[3];
+
+	if (encoded[4].get_type() == Variant::ARRAY) {
+		bool local = false;
+		Ref<Script> script = _decode_script_ref(p_reader, encoded[4], local);
+		// Same as the compiler: classes from this file are referenced weakly to avoid cycles.
+		if (!local) {
+			type.script_type_ref = script;
+		}
+		type.script_type = script.ptr();
+	}
+
+	if (encoded[5].get_type() == Variant::ARRAY) {
+		type.set_container_element_type(_decode_data_type(p_reader, encoded[5]));
+	}
+
+	return type;
+}
+
+GDScript::MemberInfo GDScriptBytecodeCache::_decode_member(Reader &p_reader, const Array &p_member) {
+	GDScript::MemberInfo minfo;
+	minfo.index = p_member[1];
+	minfo.setter = p_member[2];
+	minfo.getter = p_member[3];
+	minfo.data_type = _decode_data_type(p_reader, p_member[4]);
+	minfo.property_info = PropertyInfo::from_dict(_decode_value(p_reader, p_member[5]));
+	return minfo;
+}
+
+GDScriptFunction *GDScriptBytecodeCache::_decode_function(Reader &p_reader, GDScript *p_script, const Dictionary &p_data) {
+	GDScriptFunction *function = memnew(GDScriptFunction);
+	function->_script = p_script;
+	function->name = p_data["name"];
+	function->source = p_script->get_script_path();
+
+#ifdef DEBUG_ENABLED
+	function->func_cname = (String(function->source) + " - " + String(function->name)).utf8();
+	function->_func_cname = function->func_cname.get_data();
+	function->profile.signature = p_data.get("signature", StringName());
+#endif
+
+	function->_static = p_data["static"];
+	function->_initial_line = p_data["initial_line"];
+	function->_argument_count = p_data["argument_count"];
+	function->_stack_size = p_data["stack_size"];
+	function->_instruction_args_size = p_data["instruction_args_size"];
+	function->rpc_config = _decode_value(p_reader, p_data["rpc_config"]);
+	function->method_info = MethodInfo::from_dict(_decode_value(p_reader, p_data["method_info"]));
+	function->return_type = _decode_data_type(p_reader, p_data["return_type"]);
+
+	Array argument_types = p_data["argument_types"];
+	for (int i = 0; i < argument_types.size(); i++) {
+		function->argument_types.push_back(_decode_data_type(p_reader, argument_types[i]));
+	}
+
+	function->code = p_data["code"];
+	function->_code_size = function->code.size();
+	function->_code_ptr = function->code.is_empty() ? nullptr : function->code.ptrw();
+
+	function->default_arguments = p_data["default_arguments"];
+	function->_default_arg_count = MAX(function->default_arguments.size() - 1, 0);
+	function->_default_arg_ptr = function->default_arguments.is_empty() ? nullptr : function->default_arguments.ptr();
+
+	Array constants = p_data["constants"];
+	for (int i = 0; i < constants.size(); i++) {
+		function->constants.push_back(_decode_value(p_reader, constants[i]));
+	}
+	function->_constant_count = function->constants.size();
+	function->_constants_ptr = function->constants.is_empty() ? nullptr : function->constants.ptrw();
+
+	Array global_names = p_data["global_names"];
+	for (int i = 0; i < global_names.size(); i++) {
+		function->global_names.push_back(global_names[i]);
+	}
+	_set_table_pointers(function->global_names, function->_global_names_count, function->_global_names_ptr);
+
+	Dictionary temporary_slots = p_data["temporary_slots"];
+	for (const Variant *key = temporary_slots.next(nullptr); key; key = temporary_slots.next(key)) {
+		function->temporary_slots[*key] = Variant::Type(int(temporary_slots[*key]));
+	}
+
+	bool resolved = true;
+
+	Array operator_funcs = p_data["operator_funcs"];
+	for (int i = 0; i < operator_funcs.size(); i++) {
+		Array key = operator_funcs[i];
+		Variant::ValidatedOperatorEvaluator evaluator = nullptr;
+		if (key.size() == 3 && int(key[0]) >= 0 && int(key[0]) < Variant::OP_MAX && _is_valid_type(key[1]) && _is_valid_type(key[2])) {
+			evaluator = Variant::get_validated_operator_evaluator(Variant::Operator(int(key[0])), Variant::Type(int(key[1])), Variant::Type(int(key[2])));
+#ifdef DEBUG_ENABLED
+			function->operator_names.push_back(Variant::get_operator_name(Variant::Operator(int(key[0]))));
+#endif
+		}
+		resolved = resolved && evaluator != nullptr;
+		function->operator_funcs.push_back(evaluator);
+	}
+	_set_table_pointers(function->operator_funcs, function->_operator_funcs_count, function->_operator_funcs_ptr);
+
+	Array setters = p_data["setters"];
+	for (int i = 0; i < setters.size(); i++) {
+		Array key = setters[i];
+		Variant::ValidatedSetter setter = nullptr;
+		if (key.size() == 2 && _is_valid_type(key[0])) {
+			setter = Variant::get_member_validated_setter(Variant::Type(int(key[0])), key[1]);
+#ifdef DEBUG_ENABLED
+			function->setter_names.push_back(key[1]);
+#endif
+		}
+		resolved = resolved && setter != nullptr;
+		function->setters.push_back(setter);
+	}
+	_set_table_pointers(function->setters, function->_setters_count, function->_setters_ptr);
+
+	Array getters = p_data["getters"];
+	for (int i = 0; i < getters.size(); i++) {
+		Array key = getters[i];
+		Variant::ValidatedGetter getter = nullptr;
+		if (key.size() == 2 && _is_valid_type(key[0])) {
+			getter = Variant::get_member_validated_getter(Variant::Type(int(key[0])), key[1]);
+#ifdef DEBUG_ENABLED
+			function->getter_names.push_back(key[1]);
+#endif
+		}
+		resolved = resolved && getter != nullptr;
+		function->getters.push_back(getter);
+	}
+	_set_table_pointers(function->getters, function->_getters_count, function->_getters_ptr);
+
+	Array keyed_setters = p_data["keyed_setters"];
+	for (int i = 0; i < keyed_setters.size(); i++) {
+		Variant::ValidatedKeyedSetter setter = _is_valid_type(keyed_setters[i]) ? Variant::get_member_validated_keyed_setter(Variant::Type(int(keyed_setters[i]))) : nullptr;
+		resolved = resolved && setter != nullptr;
+		function->keyed_setters.push_back(setter);
+	}
+	_set_table_pointers(function->keyed_setters, function->_keyed_setters_count, function->_keyed_setters_ptr);
+
+	Array keyed_getters = p_data["keyed_getters"];
+	for (int i = 0; i < keyed_getters.size(); i++) {
+		Variant::ValidatedKeyedGetter getter = _is_valid_type(keyed_getters[i]) ? Variant::get_member_validated_keyed_getter(Variant::Type(int(keyed_getters[i]))) : nullptr;
+		resolved = resolved && getter != nullptr;
+		function->keyed_getters.push_back(getter);
+	}
+	_set_table_pointers(function->keyed_getters, function->_keyed_getters_count, function->_keyed_getters_ptr);
+
+	Array indexed_setters = p_data["indexed_setters"];
+	for (int i = 0; i < indexed_setters.size(); i++) {
+		Variant::ValidatedIndexedSetter setter = _is_valid_type(indexed_setters[i]) ? Variant::get_member_validated_indexed_setter(Variant::Type(int(indexed_setters[i]))) : nullptr;
+		resolved = resolved && setter != nullptr;
+		function->indexed_setters.push_back(setter);
+	}
+	_set_table_pointers(function->indexed_setters, function->_indexed_setters_count, function->_indexed_setters_ptr);
+
+	Array indexed_getters = p_data["indexed_getters"];
+	for (int i = 0; i < indexed_getters.size(); i++) {
+		Variant::ValidatedIndexedGetter getter = _is_valid_type(indexed_getters[i]) ? Variant::get_member_validated_indexed_getter(Variant::Type(int(indexed_getters[i]))) : nullptr;
+		resolved = resolved && getter != nullptr;
+		function->indexed_getters.push_back(getter);
+	}
+	_set_table_pointers(function->indexed_getters, function->_indexed_getters_count, function->_indexed_getters_ptr);
+
+	Array builtin_methods = p_data["builtin_methods"];
+	for (int i = 0; i < builtin_methods.size(); i++) {
+		Array key = builtin_methods[i];
+		Variant::ValidatedBuiltInMethod method = nullptr;
+		if (key.size() == 2 && _is_valid_type(key[0])) {
+			method = Variant::get_validated_builtin_method(Variant::Type(int(key[0])), key[1]);
+#ifdef DEBUG_ENABLED
+			function->builtin_methods_names.push_back(key[1]);
+#endif
+		}
+		resolved = resolved && method != nullptr;
+		function->builtin_methods.push_back(method);
+	}
+	_set_table_pointers(function->builtin_methods, function->_builtin_methods_count, function->_builtin_methods_ptr);
+
+	Array constructors = p_data["constructors"];
+	for (int i = 0; i < constructors.size(); i++) {
+		Array key = constructors[i];
+		Variant::ValidatedConstructor constructor = nullptr;
+		if (key.size() == 2 && _is_valid_type(key[0]) && int(key[1]) >= 0 && int(key[1]) < Variant::get_constructor_count(Variant::Type(int(key[0])))) {
+			constructor = Variant::get_validated_constructor(Variant::Type(int(key[0])), key[1]);
+#ifdef DEBUG_ENABLED
+			function->constructors_names.push_back(Variant::get_type_name(Variant::Type(int(key[0]))));
+#endif
+		}
+		resolved = resolved && constructor != nullptr;
+		function->constructors.push_back(constructor);
+	}
+	_set_table_pointers(function->constructors, function->_constructors_count, function->_constructors_ptr);
+
+	Array utilities = p_data["utilities"];
+	for (int i = 0; i < utilities.size(); i++) {
+		Variant::ValidatedUtilityFunction utility = Variant::get_validated_utility_function(utilities[i]);
+		resolved = resolved && utility != nullptr;
+		function->utilities.push_back(utility);
+#ifdef DEBUG_ENABLED
+		function->utilities_names.push_back(utilities[i]);
+#endif
+	}
+	_set_table_pointers(function->utilities, function->_utilities_count, function->_utilities_ptr);
+
+	Array gds_utilities = p_data["gds_utilities"];
+	for (int i = 0; i < gds_utilities.size(); i++) {
+		GDScriptUtilityFunctions::FunctionPtr utility = GDScriptUtilityFunctions::get_function(gds_utilities[i]);
+		resolved = resolved && utility != nullptr;
+		function->gds_utilities.push_back(utility);
+#ifdef DEBUG_ENABLED
+		function->gds_utilities_names.push_back(gds_utilities[i]);
+#endif
+	}
+	_set_table_pointers(function->gds_utilities, function->_gds_utilities_count, function->_gds_utilities_ptr);
+
+	Array methods = p_data["methods"];
+	for (int i = 0; i < methods.size(); i++) {
+		Array key = methods[i];
+		MethodBind *method = key.size() == 2 ? ClassDB::get_method(key[0], key[1]) : nullptr;
+		resolved = resolved && method != nullptr;
+		function->methods.push_back(method);
+	}
+	function->_methods_count = function->methods.size();
+	function->_methods_ptr = function->methods.is_empty() ? nullptr : function->methods.ptrw();
+
+	Array lambdas = p_data["lambdas"];
+	for (int i = 0; i < lambdas.size(); i++) {
+		GDScriptFunction *lambda = _decode_function(p_reader, p_script, lambdas[i]);
+		if (lambda == nullptr) {
+			resolved = false;
+			break;
+		}
+		function->lambdas.push_back(lambda);
+	}
+	function->_lambdas_count = function->lambdas.size();
+	function->_lambdas_ptr = function->lambdas.is_empty() ? nullptr : function->lambdas.ptrw();
+
+	Array stack_debug = p_data["stack_debug"];
+	for (int i = 0; i < stack_debug.size(); i++) {
+		Array entry = stack_debug[i];
+		if (entry.size() != 4) {
+			resolved = false;
+			break;
+		}
+		GDScriptFunction::StackDebug sd;
+		sd.line = entry[0];
+		sd.pos = entry[1];
+		sd.added = entry[2];
+		sd.identifier = entry[3];
+		function->stack_debug.push_back(sd);
+	}
+
+	if (!resolved && p_reader.error == OK) {
+		p_reader.error = ERR_CANT_RESOLVE;
+	}
+	if (p_reader.error != OK) {
+		memdelete(function);
+		return nullptr;
+	}
+
+	return function;
+}
+
+void GDScriptBytecodeCache::_make_scripts(Reader *p_reader, GDScript *p_script, const Dictionary &p_class) {
+	p_script->fully_qualified_name = p_class["fully_qualified_name"];
+	p_script->local_name = p_class["local_name"];
+	p_script->global_name = p_class["global_name"];
+	p_script->simplified_icon_path = p_class["icon_path"];
+
+	if (p_reader) {
+		p_reader->class_data[p_script] = p_class;
+	}
+
+	HashMap<StringName, Ref<GDScript>> old_subclasses = p_script->subclasses;
+	p_script->subclasses.clear();
+
+	Array subclasses = p_class["subclasses"];
+	for (int i = 0; i < subclasses.size(); i++) {
+		Dictionary inner_class = subclasses[i];
+		StringName name = inner_class["local_name"];
+
+		Ref<GDScript> subclass;
+		if (old_subclasses.has(name)) {
+			subclass = old_subclasses[name];
+		} else {
+			subclass = GDScriptLanguage::get_singleton()->get_orphan_subclass(inner_class["fully_qualified_name"]);
+		}
+
+		if (subclass.is_null()) {
+			subclass.instantiate();
+		}
+
+		subclass->_owner = p_script;
+		subclass->path = p_script->path;
+		p_script->subclasses.insert(name, subclass);
+
+		_make_scripts(p_reader, subclass.ptr(), inner_class);
+	}
+}
+
+Error GDScriptBytecodeCache::_prepare_class(Reader &p_reader, GDScript *p_script) {
+	if (p_reader.prepared_classes.has(p_script)) {
+		return OK;
+	}
+	ERR_FAIL_COND_V(p_reader.preparing_classes.has(p_script), ERR_CYCLIC_LINK);
+	ERR_FAIL_COND_V(!p_reader.class_data.has(p_script), ERR_BUG);
+
+	p_reader.preparing_classes.insert(p_script);
+	const Dictionary data = p_reader.class_data[p_script];
+
+	p_script->tool = data["tool"];
+	p_script->native = Ref<GDScriptNativeClass>();
+	p_script->base = Ref<GDScript>();
+	p_script->_base = nullptr;
+	p_script->members.clear();
+	p_script->member_indices.clear();
+	p_script->static_variables_indices.clear();
+	p_script->static_variables.clear();
+	p_script->constants.clear();
+	p_script->_signals.clear();
+
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	HashMap<StringName, int>::ConstIterator native_idx = language->get_global_map().find(data["native"]);
+	if (!native_idx) {
+		return ERR_CANT_RESOLVE;
+	}
+	p_script->native = language->get_global_array()[native_idx->value];
+	ERR_FAIL_COND_V(p_script->native.is_null(), ERR_BUG);
+
+	if (data["base"].get_type() == Variant::ARRAY) {
+		Array base_ref = data["base"];
+		Ref<GDScript> base;
+		if (!base_ref.is_empty() && int(base_ref[0]) == VALUE_GDSCRIPT) {
+			// The member layout of bases from other files is only known once they are compiled.
+			Error err = OK;
+			Ref<GDScript> base_root = GDScriptCache::get_full_script(base_ref[1], err, p_reader.owner_path);
+			if (err != OK || base_root.is_null()) {
+				return ERR_CANT_RESOLVE;
+			}
+			base = Ref<GDScript>(base_root->find_class(base_ref[2]));
+		} else {
+			bool local = false;
+			base = _decode_script_ref(p_reader, base_ref, local);
+			if (base.is_valid() && local) {
+				Error err = _prepare_class(p_reader, base.ptr());
+				if (err != OK) {
+					return err;
+				}
+			}
+		}
+
+		if (base.is_null() || p_reader.error != OK) {
+			return ERR_CANT_RESOLVE;
+		}
+		if (base->member_indices.size() != int(data["base_member_count"])) {
+			// The base class changed since the cache was written, so member indices can't be trusted.
+			return ERR_FILE_MISSING_DEPENDENCIES;
+		}
+
+		p_script->base = base;
+		p_script->_base = base.ptr();
+		p_script->member_indices = base->member_indices;
+	}
+
+	Array members = data["members"];
+	for (int i = 0; i < members.size(); i++) {
+		Array member = members[i];
+		ERR_FAIL_COND_V(member.size() != 6, ERR_FILE_CORRUPT);
+		p_script->member_indices[member[0]] = _decode_member(p_reader, member);
+		p_script->members.insert(member[0]);
+	}
+
+	Array static_variables = data["static_variables"];
+	for (int i = 0; i < static_variables.size(); i++) {
+		Array member = static_variables[i];
+		ERR_FAIL_COND_V(member.size() != 6, ERR_FILE_CORRUPT);
+		p_script->static_variables_indices[member[0]] = _decode_member(p_reader, member);
+	}
+	p_script->static_variables.resize(p_script->static_variables_indices.size());
+
+	Array constants = data["constants"];
+	for (int i = 0; i < constants.size(); i++) {
+		Array constant = constants[i];
+		ERR_FAIL_COND_V(constant.size() != 2, ERR_FILE_CORRUPT);
+		p_script->constants.insert(constant[0], _decode_value(p_reader, constant[1]));
+	}
+
+	Array signals = data["signals"];
+	for (int i = 0; i < signals.size(); i++) {
+		Array signal = signals[i];
+		ERR_FAIL_COND_V(signal.size() != 2, ERR_FILE_CORRUPT);
+		p_script->_signals[signal[0]] = MethodInfo::from_dict(_decode_value(p_reader, signal[1]));
+	}
+
+	p_script->rpc_config = _decode_value(p_reader, data["rpc_config"]);
+
+	if (p_reader.error != OK) {
+		return p_reader.error;
+	}
+
+	p_reader.prepared_classes.insert(p_script);
+	p_reader.preparing_classes.erase(p_script);
+
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		if (!p_reader.preparing_classes.has(E.value.ptr())) {
+			Error err = _prepare_class(p_reader, E.value.ptr());
+			if (err != OK) {
+				return err;
+			}
+		}
+		p_script->constants.insert(E.key, E.value);
+	}
+
+	return OK;
+}
+
+Error GDScriptBytecodeCache::_load_class(Reader &p_reader, GDScript *p_script) {
+	const Dictionary data = p_reader.class_data[p_script];
+
+	Array functions = data["functions"];
+	for (int i = 0; i < functions.size(); i++) {
+		GDScriptFunction *function = _decode_function(p_reader, p_script, functions[i]);
+		if (function == nullptr) {
+			return p_reader.error;
+		}
+		p_script->member_functions[function->name] = function;
+		if (function->name == GDScriptLanguage::get_singleton()->strings._init) {
+			p_script->initializer = function;
+		}
+	}
+
+	if (data["implicit_initializer"].get_type() == Variant::DICTIONARY) {
+		p_script->implicit_initializer = _decode_function(p_reader, p_script, data["implicit_initializer"]);
+	}
+	if (data["implicit_ready"].get_type() == Variant::DICTIONARY) {
+		p_script->implicit_ready = _decode_function(p_reader, p_script, data["implicit_ready"]);
+	}
+	if (data["static_initializer"].get_type() == Variant::DICTIONARY) {
+		p_script->static_initializer = _decode_function(p_reader, p_script, data["static_initializer"]);
+	}
+	if (p_reader.error != OK) {
+		return p_reader.error;
+	}
+
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		Error err = _load_class(p_reader, E.value.ptr());
+		if (err != OK) {
+			return err;
+		}
+	}
+
+	p_script->valid = true;
+	return OK;
+}
+
+void GDScriptBytecodeCache::make_scripts(GDScript *p_script, const Dictionary &p_data) {
+	_make_scripts(nullptr, p_script, p_data["class"]);
+	// Kept for the first reload(), so the file isn't read and decoded twice.
+	p_script->pending_bytecode = p_data;
+}
+
+Error GDScriptBytecodeCache::load(GDScript *p_script, const Dictionary &p_data) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+	if (p_script->is_valid() || !p_script->member_functions.is_empty() || p_script->implicit_initializer) {
+		return ERR_ALREADY_IN_USE; // Only fresh scripts are loaded from the cache.
+	}
+
+	Reader reader;
+	reader.main_script = p_script;
+	reader.owner_path = p_script->path;
+
+	_make_scripts(&reader, p_script, p_data["class"]);
+	p_script->_owner = nullptr;
+
+	Error err = _prepare_class(reader, p_script);
+	if (err != OK) {
+		return err;
+	}
+
+	err = _load_class(reader, p_script);
+	if (err != OK) {
+		return err;
+	}
+
+	if (bool(p_data["static_cache"])) {
+		GDScriptCache::add_static_script(p_script);
+	}
+
+	return GDScriptCache::finish_compiling(p_script->path);
+}
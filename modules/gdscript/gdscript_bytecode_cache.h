@@ -0,0 +1,101 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_BYTECODE_CACHE_H
+#define GDSCRIPT_BYTECODE_CACHE_H
+
+#include "gdscript.h"
+#include "gdscript_function.h"
+
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+
+// Serializes compiled scripts so exported projects can skip parsing, analysis,
+// and code generation at load time. The cache is written next to the source
+// file on export and is only trusted when both the engine version hash and the
+// source hash match; otherwise the script is compiled from source as usual.
+class GDScriptBytecodeCache {
+	static constexpr uint32_t FORMAT_VERSION = 1;
+
+	enum ValueKind {
+		VALUE_BUILTIN,
+		VALUE_NULL_OBJECT,
+		VALUE_LOCAL_CLASS,
+		VALUE_GDSCRIPT,
+		VALUE_SCRIPT,
+		VALUE_NATIVE_CLASS,
+		VALUE_RESOURCE,
+		VALUE_ARRAY,
+		VALUE_DICTIONARY,
+	};
+
+	struct Writer {
+		const GDScript *main_script = nullptr;
+		Error error = OK;
+	};
+
+	struct Reader {
+		GDScript *main_script = nullptr;
+		String owner_path;
+		HashMap<GDScript *, Dictionary> class_data;
+		HashSet<GDScript *> prepared_classes;
+		HashSet<GDScript *> preparing_classes;
+		Error error = OK;
+	};
+
+	static Variant _encode_script_ref(Writer &p_writer, const Script *p_script);
+	static Variant _encode_value(Writer &p_writer, const Variant &p_value);
+	static Variant _encode_data_type(Writer &p_writer, const GDScriptDataType &p_type);
+	static Dictionary _encode_function(Writer &p_writer, const GDScriptFunction *p_function);
+	static Array _encode_member(Writer &p_writer, const StringName &p_name, const GDScript::MemberInfo &p_info);
+	static Dictionary _encode_class(Writer &p_writer, const GDScript *p_script);
+
+	static Ref<Script> _decode_script_ref(Reader &p_reader, const Array &p_ref, bool &r_local);
+	static Variant _decode_value(Reader &p_reader, const Variant &p_value);
+	static GDScriptDataType _decode_data_type(Reader &p_reader, const Variant &p_type);
+	static GDScript::MemberInfo _decode_member(Reader &p_reader, const Array &p_member);
+	static GDScriptFunction *_decode_function(Reader &p_reader, GDScript *p_script, const Dictionary &p_data);
+	static void _make_scripts(Reader *p_reader, GDScript *p_script, const Dictionary &p_class);
+	static Error _prepare_class(Reader &p_reader, GDScript *p_script);
+	static Error _load_class(Reader &p_reader, GDScript *p_script);
+
+public:
+	static uint32_t get_engine_hash();
+	static String get_cache_path(const String &p_script_path);
+
+	static Error encode(const Ref<GDScript> &p_script, Vector<uint8_t> &r_buffer);
+	static Error decode(const Vector<uint8_t> &p_buffer, const String &p_source, Dictionary &r_data);
+	static Error read(const String &p_script_path, const String &p_source, Dictionary &r_data);
+
+	static void make_scripts(GDScript *p_script, const Dictionary &p_data);
+	static Error load(GDScript *p_script, const Dictionary &p_data);
+};
+
+#endif // GDSCRIPT_BYTECODE_CACHE_H
@@ -85,6 +85,7 @@ class GDScriptCache {
 	HashMap<String, HashSet<String>> packed_scene_dependencies;
 
 	friend class GDScript;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptParserRef;
 	friend class GDScriptInstance;
 
@@ -141,6 +141,15 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_INCREMENT_INT:
+			case OPCODE_INCREMENT_FLOAT: {
+				text += "increment ";
+				text += DADDR(1);
+				text += _code_ptr[ip + 4] == Variant::OP_SUBTRACT ? " -= " : " += ";
+				text += DADDR(2);
+
+				incr += 5;
+			} break;
 			case OPCODE_TYPE_TEST_BUILTIN: {
 				text += "type test ";
 				text += DADDR(1);
@@ -226,6 +235,16 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_SET_INDEXED_TYPED_ARRAY: {
+				text += "set indexed typed array ";
+				text += DADDR(1);
+				text += "[";
+				text += DADDR(2);
+				text += "] = ";
+				text += DADDR(3);
+
+				incr += 4;
+			} break;
 			case OPCODE_GET_KEYED: {
 				text += "get keyed ";
 				text += DADDR(3);
@@ -259,6 +278,17 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_GET_INDEXED_ARRAY: {
+				text += "get indexed array ";
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += "[";
+				text += DADDR(2);
+				text += "]";
+
+				incr += 4;
+			} break;
 			case OPCODE_SET_NAMED: {
 				text += "set_named ";
 				text += DADDR(1);
@@ -894,6 +924,35 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr = 3;
 			} break;
+			case OPCODE_JUMP_IF_NOT_OPERATOR_VALIDATED: {
+				text += "jump-if-not validated operator ";
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+				text += " to ";
+				text += itos(_code_ptr[ip + 5]);
+
+				incr = 6;
+			} break;
+			case OPCODE_JUMP_IF_NOT_COMPARE_INT:
+			case OPCODE_JUMP_IF_NOT_COMPARE_FLOAT: {
+				text += "jump-if-not compare ";
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += Variant::get_operator_name(Variant::Operator(_code_ptr[ip + 4]));
+				text += " ";
+				text += DADDR(2);
+				text += " to ";
+				text += itos(_code_ptr[ip + 5]);
+
+				incr = 6;
+			} break;
 			case OPCODE_JUMP_TO_DEF_ARGUMENT: {
 				text += "jump-to-default-argument ";
 
@@ -191,6 +191,8 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = {          \
 		&&OPCODE_OPERATOR,                             \
 		&&OPCODE_OPERATOR_VALIDATED,                   \
+		&&OPCODE_INCREMENT_INT,                        \
+		&&OPCODE_INCREMENT_FLOAT,                      \
 		&&OPCODE_TYPE_TEST_BUILTIN,                    \
 		&&OPCODE_TYPE_TEST_ARRAY,                      \
 		&&OPCODE_TYPE_TEST_NATIVE,                     \
@@ -198,9 +200,11 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_SET_KEYED,                            \
 		&&OPCODE_SET_KEYED_VALIDATED,                  \
 		&&OPCODE_SET_INDEXED_VALIDATED,                \
+		&&OPCODE_SET_INDEXED_TYPED_ARRAY,              \
 		&&OPCODE_GET_KEYED,                            \
 		&&OPCODE_GET_KEYED_VALIDATED,                  \
 		&&OPCODE_GET_INDEXED_VALIDATED,                \
+		&&OPCODE_GET_INDEXED_ARRAY,                    \
 		&&OPCODE_SET_NAMED,                            \
 		&&OPCODE_SET_NAMED_VALIDATED,                  \
 		&&OPCODE_GET_NAMED,                            \
@@ -245,6 +249,9 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_JUMP,                                 \
 		&&OPCODE_JUMP_IF,                              \
 		&&OPCODE_JUMP_IF_NOT,                          \
+		&&OPCODE_JUMP_IF_NOT_OPERATOR_VALIDATED,       \
+		&&OPCODE_JUMP_IF_NOT_COMPARE_INT,              \
+		&&OPCODE_JUMP_IF_NOT_COMPARE_FLOAT,            \
 		&&OPCODE_JUMP_TO_DEF_ARGUMENT,                 \
 		&&OPCODE_JUMP_IF_SHARED,                       \
 		&&OPCODE_RETURN,                               \
@@ -743,6 +750,40 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_INCREMENT_INT) {
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(dst, 0);
+				GET_VARIANT_PTR(step, 1);
+
+				int64_t *value = VariantInternal::get_int(dst);
+				if (_code_ptr[ip + 4] == Variant::OP_SUBTRACT) {
+					*value -= *VariantInternal::get_int(step);
+				} else {
+					*value += *VariantInternal::get_int(step);
+				}
+
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_INCREMENT_FLOAT) {
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(dst, 0);
+				GET_VARIANT_PTR(step, 1);
+
+				double *value = VariantInternal::get_float(dst);
+				if (_code_ptr[ip + 4] == Variant::OP_SUBTRACT) {
+					*value -= *VariantInternal::get_float(step);
+				} else {
+					*value += *VariantInternal::get_float(step);
+				}
+
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -933,6 +974,42 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_SET_INDEXED_TYPED_ARRAY) {
+				CHECK_SPACE(4);
+
+				GET_VARIANT_PTR(dst, 0);
+				GET_VARIANT_PTR(index, 1);
+				GET_VARIANT_PTR(value, 2);
+
+				// The compiler guarantees the value matches the array element type, so skip the typed validation.
+				Array *array = VariantInternal::get_array(dst);
+				int64_t int_index = *VariantInternal::get_int(index);
+				int64_t size = array->size();
+				if (int_index < 0) {
+					int_index += size;
+				}
+
+				bool valid = !array->is_read_only() && int_index >= 0 && int_index < size;
+				if (likely(valid)) {
+					(*array)[int_index] = *value;
+				}
+
+#ifdef DEBUG_ENABLED
+				if (!valid) {
+					String v = index->operator String();
+					if (!v.is_empty()) {
+						v = "'" + v + "'";
+					} else {
+						v = "of type '" + _get_var_type(index) + "'";
+					}
+					err_text = "Invalid set index " + v + " (on base: '" + _get_var_type(dst) + "') with value of type '" + _get_var_type(value) + "'";
+					OPCODE_BREAK;
+				}
+#endif
+				ip += 4;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_GET_KEYED) {
 				CHECK_SPACE(3);
 
@@ -1033,6 +1110,41 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_GET_INDEXED_ARRAY) {
+				CHECK_SPACE(4);
+
+				GET_VARIANT_PTR(src, 0);
+				GET_VARIANT_PTR(index, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				const Array *array = VariantInternal::get_array(src);
+				int64_t int_index = *VariantInternal::get_int(index);
+				int64_t size = array->size();
+				if (int_index < 0) {
+					int_index += size;
+				}
+
+				bool oob = int_index < 0 || int_index >= size;
+				if (likely(!oob)) {
+					*dst = (*array)[int_index];
+				}
+
+#ifdef DEBUG_ENABLED
+				if (oob) {
+					String v = index->operator String();
+					if (!v.is_empty()) {
+						v = "'" + v + "'";
+					} else {
+						v = "of type '" + _get_var_type(index) + "'";
+					}
+					err_text = "Out of bounds get index " + v + " (on base: '" + _get_var_type(src) + "')";
+					OPCODE_BREAK;
+				}
+#endif
+				ip += 4;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_SET_NAMED) {
 				CHECK_SPACE(3);
 
@@ -2416,6 +2528,73 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_JUMP_IF_NOT_OPERATOR_VALIDATED) {
+				CHECK_SPACE(6);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				if (!*VariantInternal::get_bool(dst)) {
+					int to = _code_ptr[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
+#define OPCODE_JUMP_IF_NOT_COMPARE(m_type, m_get_func)      \
+	OPCODE(OPCODE_JUMP_IF_NOT_COMPARE_##m_type) {           \
+		CHECK_SPACE(6);                                     \
+		GET_VARIANT_PTR(a, 0);                              \
+		GET_VARIANT_PTR(b, 1);                              \
+		GET_VARIANT_PTR(dst, 2);                            \
+		const auto left = *VariantInternal::m_get_func(a);  \
+		const auto right = *VariantInternal::m_get_func(b); \
+		bool result;                                        \
+		switch (_code_ptr[ip + 4]) {                        \
+			case Variant::OP_EQUAL:                         \
+				result = left == right;                     \
+				break;                                      \
+			case Variant::OP_NOT_EQUAL:                     \
+				result = left != right;                     \
+				break;                                      \
+			case Variant::OP_LESS:                          \
+				result = left < right;                      \
+				break;                                      \
+			case Variant::OP_LESS_EQUAL:                    \
+				result = left <= right;                     \
+				break;                                      \
+			case Variant::OP_GREATER:                       \
+				result = left > right;                      \
+				break;                                      \
+			default:                                        \
+				result = left >= right;                     \
+				break;                                      \
+		}                                                   \
+		VariantTypeChanger<bool>::change(dst);              \
+		*VariantInternal::get_bool(dst) = result;           \
+		if (!result) {                                      \
+			int to = _code_ptr[ip + 5];                     \
+			GD_ERR_BREAK(to < 0 || to > _code_size);        \
+			ip = to;                                        \
+		} else {                                            \
+			ip += 6;                                        \
+		}                                                   \
+	}                                                       \
+	DISPATCH_OPCODE
+
+			OPCODE_JUMP_IF_NOT_COMPARE(INT, get_int);
+			OPCODE_JUMP_IF_NOT_COMPARE(FLOAT, get_float);
+
 			OPCODE(OPCODE_JUMP_TO_DEF_ARGUMENT) {
 				CHECK_SPACE(2);
 				ip = _default_arg_ptr[defarg];
@@ -32,6 +32,7 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_tokenizer.h"
 #include "gdscript_utility_functions.h"
@@ -49,6 +50,7 @@
 #include "tests/test_gdscript.h"
 #endif
 
+#include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
 #include "core/io/file_access_encrypted.h"
@@ -81,6 +83,28 @@ Ref<GDScriptEditorTranslationParserPlugin> gdscript_translation_parser_plugin;
 class EditorExportGDScript : public EditorExportPlugin {
 	GDCLASS(EditorExportGDScript, EditorExportPlugin);
 
+	void _add_bytecode_cache(const String &p_path) {
+		Ref<GDScript> scr = ResourceLoader::load(p_path);
+		if (scr.is_null()) {
+			return;
+		}
+
+		// Unsaved editor changes are not exported, so don't cache them either.
+		if (scr->get_source_code() != GDScriptCache::get_source_code(p_path)) {
+			print_verbose(vformat(R"(GDScript: Not caching bytecode for "%s", the script has unsaved changes.)", p_path));
+			return;
+		}
+
+		Vector<uint8_t> buffer;
+		Error err = GDScriptBytecodeCache::encode(scr, buffer);
+		if (err != OK) {
+			print_verbose(vformat(R"(GDScript: Not caching bytecode for "%s" (%s).)", p_path, error_names[err]));
+			return;
+		}
+
+		add_file(GDScriptBytecodeCache::get_cache_path(p_path), buffer, false);
+	}
+
 public:
 	virtual void _export_file(const String &p_path, const String &p_type, const HashSet<String> &p_features) override {
 		String script_key;
@@ -95,6 +119,10 @@ public:
 			return;
 		}
 
+		if (GLOBAL_GET("editor/export/gdscript_bytecode_cache")) {
+			_add_bytecode_cache(p_path);
+		}
+
 		return;
 	}
 
@@ -144,6 +172,8 @@ void initialize_gdscript_module(ModuleInitializationLevel p_level) {
 	if (p_level == MODULE_INITIALIZATION_LEVEL_SERVERS) {
 		EditorNode::add_init_callback(_editor_init);
 
+		GLOBAL_DEF("editor/export/gdscript_bytecode_cache", false);
+
 		gdscript_translation_parser_plugin.instantiate();
 		EditorTranslationParser::get_singleton()->add_parser(gdscript_translation_parser_plugin, EditorTranslationParser::STANDARD);
 	}
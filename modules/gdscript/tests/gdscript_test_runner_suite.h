@@ -33,6 +33,9 @@
 
 #include "gdscript_test_runner.h"
 
+#include "../gdscript_bytecode_cache.h"
+
+#include "core/io/marshalls.h"
 #include "tests/test_macros.h"
 
 namespace GDScriptTests {
@@ -71,6 +74,68 @@ func _init():
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
 
+TEST_CASE("[Modules][GDScript] Load compiled script from bytecode cache") {
+	const String source = R"(
+extends RefCounted
+
+signal done(value)
+
+const SCALE = 3
+enum Mode { A, B = 5 }
+
+class Inner:
+	var items: Array[int] = [1, 2, 3]
+
+	func total() -> int:
+		var sum := 0
+		for item in items:
+			sum += item
+		return sum
+
+var inner := Inner.new()
+var label := "value"
+
+func compute(x: int) -> int:
+	var doubled := func(v): return v * 2
+	return doubled.call(x) * SCALE + inner.total() + Mode.B + label.length()
+)";
+
+	Ref<GDScript> compiled = memnew(GDScript);
+	compiled->set_source_code(source);
+	ERR_PRINT_OFF;
+	const Error error = compiled->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should compile successfully.");
+
+	Vector<uint8_t> buffer;
+	REQUIRE_MESSAGE(GDScriptBytecodeCache::encode(compiled, buffer) == OK, "The compiled script should be serializable.");
+
+	Dictionary data;
+	REQUIRE(GDScriptBytecodeCache::decode(buffer, source, data) == OK);
+
+	Ref<GDScript> cached = memnew(GDScript);
+	cached->set_source_code(source);
+	REQUIRE_MESSAGE(GDScriptBytecodeCache::load(cached.ptr(), data) == OK, "The script should load from the cached bytecode.");
+	CHECK(cached->is_valid());
+	CHECK(cached->has_script_signal("done"));
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(cached);
+	CHECK_MESSAGE(int(ref_counted->call("compute", 4)) == 40, "The cached bytecode should run like the compiled script.");
+
+	SUBCASE("Changed sources are compiled instead") {
+		Dictionary outdated_data;
+		CHECK(GDScriptBytecodeCache::decode(buffer, source + "\n", outdated_data) != OK);
+	}
+
+	SUBCASE("Caches from other engine versions are compiled instead") {
+		Vector<uint8_t> outdated = buffer;
+		encode_uint32(GDScriptBytecodeCache::get_engine_hash() + 1, outdated.ptrw() + 8);
+		Dictionary outdated_data;
+		CHECK(GDScriptBytecodeCache::decode(outdated, source, outdated_data) != OK);
+	}
+}
+
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
 	GDScriptLanguage *lang = GDScriptLanguage::get_singleton();
 
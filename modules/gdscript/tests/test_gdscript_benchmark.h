@@ -0,0 +1,163 @@
+/**************************************************************************/
+/*  test_gdscript_benchmark.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GDSCRIPT_BENCHMARK_H
+#define TEST_GDSCRIPT_BENCHMARK_H
+
+#include "../gdscript.h"
+#include "../gdscript_byte_codegen.h"
+
+#include "core/os/os.h"
+#include "tests/test_macros.h"
+
+namespace GDScriptTests {
+
+// Small kernels exercising the instruction sequences fused by the bytecode generator:
+// compare-and-branch, in-place increments, and typed array indexing.
+const String benchmark_source = R"(
+extends RefCounted
+
+func count_loop(n: int) -> int:
+	var i := 0
+	var sum := 0
+	while i < n:
+		sum += i
+		i += 1
+	return sum
+
+func float_loop(n: int) -> float:
+	var x := 0.0
+	var step := 0.5
+	var i := 0
+	while i < n:
+		x += step
+		x -= 0.25
+		i += 1
+	return x
+
+func typed_array_loop(n: int) -> int:
+	var values: Array[int] = []
+	values.resize(64)
+	values.fill(1)
+	var total := 0
+	var i := 0
+	while i < n:
+		var index := i % 64
+		values[index] = values[index] + 1
+		total += values[index]
+		i += 1
+	return total
+
+func branch_loop(n: int) -> int:
+	var hits := 0
+	var half := n / 2
+	for i in n:
+		if i < half:
+			hits += 1
+		elif i != 7:
+			hits -= 1
+	return hits
+)";
+
+static Ref<RefCounted> _make_benchmark_instance(bool p_peephole) {
+	const bool was_enabled = GDScriptByteCodeGenerator::peephole_enabled;
+	GDScriptByteCodeGenerator::peephole_enabled = p_peephole;
+	Ref<GDScript> script = memnew(GDScript);
+	script->set_source_code(benchmark_source);
+	const Error error = script->reload();
+	GDScriptByteCodeGenerator::peephole_enabled = was_enabled;
+	if (error != OK) {
+		return Ref<RefCounted>();
+	}
+
+	Ref<RefCounted> instance = memnew(RefCounted);
+	instance->set_script(script);
+	return instance;
+}
+
+TEST_CASE("[Modules][GDScript] Superinstructions match unfused bytecode") {
+	Ref<RefCounted> fused = _make_benchmark_instance(true);
+	Ref<RefCounted> unfused = _make_benchmark_instance(false);
+	REQUIRE(fused.is_valid());
+	REQUIRE(unfused.is_valid());
+
+	const int n = 1000;
+	CHECK(int64_t(fused->call("count_loop", n)) == int64_t(n) * (n - 1) / 2);
+	CHECK(double(fused->call("float_loop", n)) == doctest::Approx(n * 0.25));
+
+	for (const StringName &function : { StringName("count_loop"), StringName("float_loop"), StringName("typed_array_loop"), StringName("branch_loop") }) {
+		CHECK_MESSAGE(fused->call(function, n) == unfused->call(function, n), vformat("Fused and unfused bytecode should agree on `%s`.", function));
+	}
+
+	// Out of bounds accesses should still be reported on the typed array fast paths.
+	Ref<GDScript> oob_script = memnew(GDScript);
+	oob_script->set_source_code(R"(
+extends RefCounted
+
+func read(values: Array[int], index: int) -> int:
+	return values[index]
+)");
+	REQUIRE(oob_script->reload() == OK);
+	Ref<RefCounted> oob = memnew(RefCounted);
+	oob->set_script(oob_script);
+	Array values;
+	values.set_typed(Variant::INT, StringName(), Variant());
+	values.push_back(3);
+	values.push_back(4);
+	CHECK(int(oob->call("read", values, -1)) == 4);
+	ERR_PRINT_OFF;
+	CHECK(oob->call("read", values, 2).get_type() == Variant::NIL);
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[Modules][GDScript][Benchmark] Superinstructions" * doctest::skip()) {
+	Ref<RefCounted> fused = _make_benchmark_instance(true);
+	Ref<RefCounted> unfused = _make_benchmark_instance(false);
+	REQUIRE(fused.is_valid());
+	REQUIRE(unfused.is_valid());
+
+	const int n = 2000000;
+	for (const StringName &function : { StringName("count_loop"), StringName("float_loop"), StringName("typed_array_loop"), StringName("branch_loop") }) {
+		double ops_per_second[2];
+		Ref<RefCounted> instances[2] = { unfused, fused };
+		for (int i = 0; i < 2; i++) {
+			instances[i]->call(function, 1000); // Warm up.
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			instances[i]->call(function, n);
+			uint64_t usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, uint64_t(1));
+			ops_per_second[i] = double(n) * 1000000.0 / double(usec);
+		}
+		MESSAGE(String(function), ": ", ops_per_second[0], " iterations/sec before, ", ops_per_second[1], " iterations/sec after (", ops_per_second[1] / ops_per_second[0], "x)");
+	}
+}
+
+} // namespace GDScriptTests
+
+#endif // TEST_GDSCRIPT_BENCHMARK_H
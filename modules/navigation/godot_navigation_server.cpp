@@ -34,6 +34,7 @@
 #include "nav_mesh_generator_3d.h"
 #endif // _3D_DISABLED
 
+#include "core/config/project_settings.h"
 #include "core/os/mutex.h"
 
 using namespace NavigationUtilities;
@@ -81,7 +82,10 @@ using namespace NavigationUtilities;
 	}                                                               \
 	void GodotNavigationServer::MERGE(_cmd_, F_NAME)(T_0 D_0, T_1 D_1)
 
-GodotNavigationServer::GodotNavigationServer() {}
+GodotNavigationServer::GodotNavigationServer() {
+	path_queries_use_multiple_threads = GLOBAL_GET("navigation/pathfinding/thread_model/path_queries_use_multiple_threads");
+	max_async_path_queries_per_frame = MAX(1, (int)GLOBAL_GET("navigation/pathfinding/max_async_path_queries_per_frame"));
+}
 
 GodotNavigationServer::~GodotNavigationServer() {
 	flush_queries();
@@ -1070,6 +1074,9 @@ void GodotNavigationServer::flush_queries() {
 	MutexLock lock(commands_mutex);
 	MutexLock lock2(operations_mutex);
 
+	// Commands may free what the running path queries read.
+	_wait_for_path_queries();
+
 	for (SetCommand *command : commands) {
 		command->exec(this);
 		memdelete(command);
@@ -1097,7 +1104,13 @@ void GodotNavigationServer::sync() {
 void GodotNavigationServer::process(real_t p_delta_time) {
 	flush_queries();
 
+	// Queries started in the previous step are delivered even when the server was deactivated since.
+	_dispatch_path_queries();
+
 	if (!active) {
+		// New queries stay queued, the maps are not synced while inactive.
+		MutexLock lock(path_queries_mutex);
+		pm_path_query_queue_depth = path_queries_queued.size();
 		return;
 	}
 
@@ -1109,6 +1122,7 @@ void GodotNavigationServer::process(real_t p_delta_time) {
 	int _new_pm_edge_merge_count = 0;
 	int _new_pm_edge_connection_count = 0;
 	int _new_pm_edge_free_count = 0;
+	int _new_pm_cluster_build_time = 0;
 
 	// In c++ we can't be sure that this is performed in the main thread
 	// even with mutable functions.
@@ -1126,6 +1140,7 @@ void GodotNavigationServer::process(real_t p_delta_time) {
 		_new_pm_edge_merge_count += active_maps[i]->get_pm_edge_merge_count();
 		_new_pm_edge_connection_count += active_maps[i]->get_pm_edge_connection_count();
 		_new_pm_edge_free_count += active_maps[i]->get_pm_edge_free_count();
+		_new_pm_cluster_build_time += active_maps[i]->get_pm_cluster_build_time();
 
 		// Emit a signal if a map changed.
 		const uint32_t new_map_update_id = active_maps[i]->get_map_update_id();
@@ -1135,6 +1150,9 @@ void GodotNavigationServer::process(real_t p_delta_time) {
 		}
 	}
 
+	// The maps are synced, start the queries for this step.
+	_start_path_queries();
+
 	pm_region_count = _new_pm_region_count;
 	pm_agent_count = _new_pm_agent_count;
 	pm_link_count = _new_pm_link_count;
@@ -1143,6 +1161,7 @@ void GodotNavigationServer::process(real_t p_delta_time) {
 	pm_edge_merge_count = _new_pm_edge_merge_count;
 	pm_edge_connection_count = _new_pm_edge_connection_count;
 	pm_edge_free_count = _new_pm_edge_free_count;
+	pm_cluster_build_time = _new_pm_cluster_build_time;
 }
 
 void GodotNavigationServer::init() {
@@ -1153,6 +1172,11 @@ void GodotNavigationServer::init() {
 
 void GodotNavigationServer::finish() {
 	flush_queries();
+	path_queries_running.clear();
+	{
+		MutexLock lock(path_queries_mutex);
+		path_queries_queued.clear();
+	}
 #ifndef _3D_DISABLED
 	if (navmesh_generator_3d) {
 		navmesh_generator_3d->finish();
@@ -1163,17 +1187,21 @@ void GodotNavigationServer::finish() {
 }
 
 PathQueryResult GodotNavigationServer::_query_path(const PathQueryParameters &p_parameters) const {
-	PathQueryResult r_query_result;
-
 	const NavMap *map = map_owner.get_or_null(p_parameters.map);
-	ERR_FAIL_NULL_V(map, r_query_result);
+	ERR_FAIL_NULL_V(map, PathQueryResult());
+
+	return _query_map_path(map, p_parameters);
+}
+
+PathQueryResult GodotNavigationServer::_query_map_path(const NavMap *p_map, const PathQueryParameters &p_parameters) const {
+	PathQueryResult r_query_result;
 
 	// run the pathfinding
 
 	if (p_parameters.pathfinding_algorithm == PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR) {
 		// while postprocessing is still part of map.get_path() need to check and route it here for the correct "optimize" post-processing
 		if (p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL) {
-			r_query_result.path = map->get_path(
+			r_query_result.path = p_map->get_path(
 					p_parameters.start_position,
 					p_parameters.target_position,
 					true,
@@ -1182,7 +1210,7 @@ PathQueryResult GodotNavigationServer::_query_path(const PathQueryParameters &p_
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_RIDS) ? &r_query_result.path_rids : nullptr,
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_OWNERS) ? &r_query_result.path_owner_ids : nullptr);
 		} else if (p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED) {
-			r_query_result.path = map->get_path(
+			r_query_result.path = p_map->get_path(
 					p_parameters.start_position,
 					p_parameters.target_position,
 					false,
@@ -1202,6 +1230,88 @@ PathQueryResult GodotNavigationServer::_query_path(const PathQueryParameters &p_
 	return r_query_result;
 }
 
+void GodotNavigationServer::query_path_async(const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback) {
+	ERR_FAIL_COND(!p_query_parameters.is_valid());
+	ERR_FAIL_COND(!p_query_result.is_valid());
+
+	AsyncPathQuery query;
+	query.parameters = p_query_parameters->get_parameters();
+	query.query_result = p_query_result;
+	query.callback = p_callback;
+
+	MutexLock lock(path_queries_mutex);
+	path_queries_queued.push_back(query);
+}
+
+void GodotNavigationServer::_process_path_query(uint32_t p_index, AsyncPathQuery *p_queries) {
+	AsyncPathQuery &query = p_queries[p_index];
+	if (query.map) {
+		query.result = _query_map_path(query.map, query.parameters);
+	}
+}
+
+void GodotNavigationServer::_start_path_queries() {
+	{
+		MutexLock lock(path_queries_mutex);
+
+		// Oldest queries first, the others wait for the next steps.
+		const uint32_t count = MIN(path_queries_queued.size(), max_async_path_queries_per_frame);
+		path_queries_running.resize(count);
+		for (uint32_t i = 0; i < count; i++) {
+			path_queries_running[i] = path_queries_queued[i];
+		}
+		for (uint32_t i = count; i < path_queries_queued.size(); i++) {
+			path_queries_queued[i - count] = path_queries_queued[i];
+		}
+		path_queries_queued.resize(path_queries_queued.size() - count);
+
+		pm_path_query_queue_depth = path_queries_queued.size();
+	}
+
+	if (path_queries_running.is_empty()) {
+		return;
+	}
+
+	// Resolved here, the workers can't read map_owner while maps are created on other threads.
+	for (AsyncPathQuery &query : path_queries_running) {
+		query.map = map_owner.get_or_null(query.parameters.map);
+		ERR_CONTINUE_MSG(!query.map, "Path query map is not valid, the query returns an empty path.");
+	}
+
+	if (path_queries_use_multiple_threads) {
+		path_queries_group_id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotNavigationServer::_process_path_query, path_queries_running.ptr(), path_queries_running.size(), -1, true, SNAME("NavigationPathQueries"));
+	} else {
+		for (uint32_t i = 0; i < path_queries_running.size(); i++) {
+			_process_path_query(i, path_queries_running.ptr());
+		}
+	}
+}
+
+void GodotNavigationServer::_wait_for_path_queries() {
+	if (path_queries_group_id != -1) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(path_queries_group_id);
+		path_queries_group_id = -1;
+	}
+}
+
+void GodotNavigationServer::_dispatch_path_queries() {
+	_wait_for_path_queries();
+
+	pm_path_query_count = path_queries_running.size();
+
+	for (AsyncPathQuery &query : path_queries_running) {
+		query.query_result->set_path(query.result.path);
+		query.query_result->set_path_types(query.result.path_types);
+		query.query_result->set_path_rids(query.result.path_rids);
+		query.query_result->set_path_owner_ids(query.result.path_owner_ids);
+
+		if (query.callback.is_valid()) {
+			query.callback.call();
+		}
+	}
+	path_queries_running.clear();
+}
+
 int GodotNavigationServer::get_process_info(ProcessInfo p_info) const {
 	switch (p_info) {
 		case INFO_ACTIVE_MAPS: {
@@ -1231,6 +1341,15 @@ int GodotNavigationServer::get_process_info(ProcessInfo p_info) const {
 		case INFO_EDGE_FREE_COUNT: {
 			return pm_edge_free_count;
 		} break;
+		case INFO_PATH_QUERY_QUEUE_DEPTH: {
+			return pm_path_query_queue_depth;
+		} break;
+		case INFO_PATH_QUERY_COUNT: {
+			return pm_path_query_count;
+		} break;
+		case INFO_CLUSTER_BUILD_TIME: {
+			return pm_cluster_build_time;
+		} break;
 	}
 
 	return 0;
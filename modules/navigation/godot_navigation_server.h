@@ -37,6 +37,7 @@
 #include "nav_obstacle.h"
 #include "nav_region.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/rid.h"
 #include "core/templates/rid_owner.h"
@@ -82,6 +83,23 @@ class GodotNavigationServer : public NavigationServer3D {
 	LocalVector<NavMap *> active_maps;
 	LocalVector<uint32_t> active_maps_update_id;
 
+	struct AsyncPathQuery {
+		NavigationUtilities::PathQueryParameters parameters;
+		const NavMap *map = nullptr; // Resolved on the main thread, nullptr if the map is invalid.
+		NavigationUtilities::PathQueryResult result;
+		Ref<NavigationPathQueryResult3D> query_result;
+		Callable callback;
+	};
+
+	Mutex path_queries_mutex;
+	LocalVector<AsyncPathQuery> path_queries_queued;
+	/// Queries running on the worker threads between two `process` calls.
+	/// They only read the maps, so they are waited for before any command or sync.
+	LocalVector<AsyncPathQuery> path_queries_running;
+	WorkerThreadPool::GroupID path_queries_group_id = -1;
+	bool path_queries_use_multiple_threads = true;
+	uint32_t max_async_path_queries_per_frame = 128;
+
 #ifndef _3D_DISABLED
 	NavMeshGenerator3D *navmesh_generator_3d = nullptr;
 #endif // _3D_DISABLED
@@ -95,6 +113,9 @@ class GodotNavigationServer : public NavigationServer3D {
 	int pm_edge_merge_count = 0;
 	int pm_edge_connection_count = 0;
 	int pm_edge_free_count = 0;
+	int pm_path_query_queue_depth = 0;
+	int pm_path_query_count = 0;
+	int pm_cluster_build_time = 0;
 
 public:
 	GodotNavigationServer();
@@ -247,12 +268,19 @@ public:
 	virtual void finish() override;
 
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const override;
+	virtual void query_path_async(const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback = Callable()) override;
 
 	int get_process_info(ProcessInfo p_info) const override;
 
 private:
 	void internal_free_agent(RID p_object);
 	void internal_free_obstacle(RID p_object);
+
+	NavigationUtilities::PathQueryResult _query_map_path(const NavMap *p_map, const NavigationUtilities::PathQueryParameters &p_parameters) const;
+	void _process_path_query(uint32_t p_index, AsyncPathQuery *p_queries);
+	void _start_path_queries();
+	void _wait_for_path_queries();
+	void _dispatch_path_queries();
 };
 
 #undef COMMAND_1
@@ -37,11 +37,16 @@
 
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "core/templates/sort_array.h"
 
 #include <Obstacle2d.h>
 
 #define THREE_POINTS_CROSS_PRODUCT(m_a, m_b, m_c) (((m_c) - (m_a)).cross((m_b) - (m_a)))
 
+// Maximum number of polygons in a leaf of the polygons BVH.
+#define POLYGON_BVH_LEAF_SIZE 4
+
 // Helper macro
 #define APPEND_METADATA(poly)                                  \
 	if (r_path_types) {                                        \
@@ -129,40 +134,12 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	}
 
 	// Find the start poly and the end poly on this map.
-	const gd::Polygon *begin_poly = nullptr;
-	const gd::Polygon *end_poly = nullptr;
+	// Only consider the polygons in regions with compatible layers.
 	Vector3 begin_point;
 	Vector3 end_point;
-	real_t begin_d = FLT_MAX;
+	const gd::Polygon *begin_poly = _get_closest_polygon(p_origin, p_navigation_layers, true, FLT_MAX, begin_point);
+	const gd::Polygon *end_poly = _get_closest_polygon(p_destination, p_navigation_layers, true, FLT_MAX, end_point);
 	real_t end_d = FLT_MAX;
-	// Find the initial poly and the end poly on this map.
-	for (const gd::Polygon &p : polygons) {
-		// Only consider the polygon if it in a region with compatible layers.
-		if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
-			continue;
-		}
-
-		// For each face check the distance between the origin/destination
-		for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
-			const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-
-			Vector3 point = face.get_closest_point_to(p_origin);
-			real_t distance_to_point = point.distance_to(p_origin);
-			if (distance_to_point < begin_d) {
-				begin_d = distance_to_point;
-				begin_poly = &p;
-				begin_point = point;
-			}
-
-			point = face.get_closest_point_to(p_destination);
-			distance_to_point = point.distance_to(p_destination);
-			if (distance_to_point < end_d) {
-				end_d = distance_to_point;
-				end_poly = &p;
-				end_point = point;
-			}
-		}
-	}
 
 	// Check for trivial cases
 	if (!begin_poly || !end_poly) {
@@ -194,10 +171,17 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		return path;
 	}
 
+	// Between clusters, plan the path over the cluster portals first, then only search the polygons of the clusters it crosses.
+	LocalVector<bool> corridor;
+	bool use_corridor = !clusters.is_empty() && _get_cluster_corridor(_get_polygon_index(begin_poly), _get_polygon_index(end_poly), end_point, p_navigation_layers, corridor);
+
 	// List of all reachable navigation polys.
 	LocalVector<gd::NavigationPoly> navigation_polys;
 	navigation_polys.reserve(polygons.size() * 0.75);
 
+	// The index of each reached polygon in the reachable navigation polys.
+	HashMap<const gd::Polygon *, uint32_t> navigation_poly_ids;
+
 	// Add the start polygon to the reachable navigation polygons.
 	gd::NavigationPoly begin_navigation_poly = gd::NavigationPoly(begin_poly);
 	begin_navigation_poly.self_id = 0;
@@ -205,10 +189,14 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	begin_navigation_poly.back_navigation_edge_pathway_start = begin_point;
 	begin_navigation_poly.back_navigation_edge_pathway_end = begin_point;
 	navigation_polys.push_back(begin_navigation_poly);
+	navigation_poly_ids.insert(begin_poly, 0);
 
-	// List of polygon IDs to visit.
-	List<uint32_t> to_visit;
-	to_visit.push_back(0);
+	// Heap of polygon IDs to visit, the one with the least estimated total cost on top.
+	gd::NavPolyTravelCostGreaterThan travel_cost_greater_than;
+	travel_cost_greater_than.navigation_polys = &navigation_polys;
+	gd::NavPolyHeapIndexer heap_indexer;
+	heap_indexer.navigation_polys = &navigation_polys;
+	gd::Heap<uint32_t, gd::NavPolyTravelCostGreaterThan, gd::NavPolyHeapIndexer> to_visit(travel_cost_greater_than, heap_indexer);
 
 	// This is an implementation of the A* algorithm.
 	int least_cost_id = 0;
@@ -231,6 +219,10 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 					continue;
 				}
 
+				if (use_corridor && !corridor[polygon_clusters[_get_polygon_index(connection.polygon)]]) {
+					continue;
+				}
+
 				const gd::NavigationPoly &least_cost_poly = navigation_polys[least_cost_id];
 				real_t poly_enter_cost = 0.0;
 				real_t poly_travel_cost = least_cost_poly.poly->owner->get_travel_cost();
@@ -244,18 +236,24 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 				const Vector3 new_entry = Geometry3D::get_closest_point_to_segment(least_cost_poly.entry, pathway);
 				const real_t new_distance = (least_cost_poly.entry.distance_to(new_entry) * poly_travel_cost) + poly_enter_cost + least_cost_poly.traveled_distance;
 
-				int64_t already_visited_polygon_index = navigation_polys.find(gd::NavigationPoly(connection.polygon));
+				HashMap<const gd::Polygon *, uint32_t>::ConstIterator already_visited_polygon = navigation_poly_ids.find(connection.polygon);
 
-				if (already_visited_polygon_index != -1) {
+				if (already_visited_polygon) {
 					// Polygon already visited, check if we can reduce the travel cost.
-					gd::NavigationPoly &avp = navigation_polys[already_visited_polygon_index];
+					gd::NavigationPoly &avp = navigation_polys[already_visited_polygon->value];
 					if (new_distance < avp.traveled_distance) {
 						avp.back_navigation_poly_id = least_cost_id;
 						avp.back_navigation_edge = connection.edge;
 						avp.back_navigation_edge_pathway_start = connection.pathway_start;
 						avp.back_navigation_edge_pathway_end = connection.pathway_end;
 						avp.traveled_distance = new_distance;
+						avp.distance_to_destination = new_entry.distance_to(end_point) * avp.poly->owner->get_travel_cost();
 						avp.entry = new_entry;
+
+						// Move it up in the polygons to visit, if it wasn't visited yet.
+						if (avp.traversable_poly_index != UINT32_MAX) {
+							to_visit.shift(avp.traversable_poly_index);
+						}
 					}
 				} else {
 					// Add the neighbor polygon to the reachable ones.
@@ -266,20 +264,34 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 					new_navigation_poly.back_navigation_edge_pathway_start = connection.pathway_start;
 					new_navigation_poly.back_navigation_edge_pathway_end = connection.pathway_end;
 					new_navigation_poly.traveled_distance = new_distance;
+					new_navigation_poly.distance_to_destination = new_entry.distance_to(end_point) * connection.polygon->owner->get_travel_cost();
 					new_navigation_poly.entry = new_entry;
 					navigation_polys.push_back(new_navigation_poly);
+					navigation_poly_ids.insert(connection.polygon, new_navigation_poly.self_id);
 
 					// Add the neighbor polygon to the polygons to visit.
-					to_visit.push_back(navigation_polys.size() - 1);
+					to_visit.push(new_navigation_poly.self_id);
 				}
 			}
 		}
 
-		// Removes the least cost polygon from the list of polygons to visit so we can advance.
-		to_visit.erase(least_cost_id);
-
 		// When the list of polygons to visit is empty at this point it means the End Polygon is not reachable
-		if (to_visit.size() == 0) {
+		if (to_visit.is_empty()) {
+			if (use_corridor) {
+				// The corridor always leads to the end polygon, but search the whole map rather than give up.
+				use_corridor = false;
+				gd::NavigationPoly np = navigation_polys[0];
+				navigation_polys.clear();
+				navigation_polys.push_back(np);
+				navigation_poly_ids.clear();
+				navigation_poly_ids.insert(begin_poly, 0);
+				least_cost_id = 0;
+				prev_least_cost_id = -1;
+				reachable_end = nullptr;
+				reachable_d = FLT_MAX;
+				continue;
+			}
+
 			// Thus use the further reachable polygon
 			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
 			is_reachable = false;
@@ -342,11 +354,12 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 			}
 
 			// Reset open and navigation_polys
+			to_visit.clear();
 			gd::NavigationPoly np = navigation_polys[0];
 			navigation_polys.clear();
 			navigation_polys.push_back(np);
-			to_visit.clear();
-			to_visit.push_back(0);
+			navigation_poly_ids.clear();
+			navigation_poly_ids.insert(begin_poly, 0);
 			least_cost_id = 0;
 			prev_least_cost_id = -1;
 
@@ -355,20 +368,8 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 			continue;
 		}
 
-		// Find the polygon with the minimum cost from the list of polygons to visit.
-		least_cost_id = -1;
-		real_t least_cost = FLT_MAX;
-		for (List<uint32_t>::Element *element = to_visit.front(); element != nullptr; element = element->next()) {
-			gd::NavigationPoly *np = &navigation_polys[element->get()];
-			real_t cost = np->traveled_distance;
-			cost += (np->entry.distance_to(end_point) * np->poly->owner->get_travel_cost());
-			if (cost < least_cost) {
-				least_cost_id = np->self_id;
-				least_cost = cost;
-			}
-		}
-
-		ERR_BREAK(least_cost_id == -1);
+		// Take the polygon with the minimum cost from the polygons to visit.
+		least_cost_id = to_visit.pop();
 
 		// Stores the further reachable end polygon, in case our goal is not reachable.
 		if (is_reachable) {
@@ -643,24 +644,478 @@ RID NavMap::get_closest_point_owner(const Vector3 &p_point) const {
 
 gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_point) const {
 	gd::ClosestPointQueryResult result;
-	real_t closest_point_ds = FLT_MAX;
+	const gd::Polygon *closest_polygon = _get_closest_polygon(p_point, 0, false, FLT_MAX, result.point, &result.normal);
+	if (closest_polygon) {
+		result.owner = closest_polygon->owner->get_self();
+	}
 
-	for (const gd::Polygon &p : polygons) {
-		// For each face check the distance to the point
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			const Vector3 inters = f.get_closest_point_to(p_point);
-			const real_t ds = inters.distance_squared_to(p_point);
-			if (ds < closest_point_ds) {
-				result.point = inters;
-				result.normal = f.get_plane().normal;
-				result.owner = p.owner->get_self();
-				closest_point_ds = ds;
+	return result;
+}
+
+void NavMap::_build_polygons_bvh() {
+	polygons_bvh.clear();
+	polygons_bvh_indices.clear();
+
+	LocalVector<AABB> aabbs;
+	aabbs.resize(polygons.size());
+	for (uint32_t i = 0; i < polygons.size(); i++) {
+		const gd::Polygon &polygon = polygons[i];
+		// Polygons without faces are never the closest.
+		if (polygon.points.size() < 3) {
+			continue;
+		}
+		aabbs[i] = AABB(polygon.points[0].pos, Vector3());
+		for (uint32_t j = 1; j < polygon.points.size(); j++) {
+			aabbs[i].expand_to(polygon.points[j].pos);
+		}
+		polygons_bvh_indices.push_back(i);
+	}
+
+	if (polygons_bvh_indices.is_empty()) {
+		return;
+	}
+	polygons_bvh.reserve(polygons_bvh_indices.size() / POLYGON_BVH_LEAF_SIZE * 2 + 1);
+	_build_polygons_bvh_node(aabbs, 0, polygons_bvh_indices.size());
+}
+
+uint32_t NavMap::_build_polygons_bvh_node(const LocalVector<AABB> &p_aabbs, uint32_t p_begin, uint32_t p_end) {
+	const uint32_t node_index = polygons_bvh.size();
+	polygons_bvh.push_back(PolygonBVHNode());
+
+	AABB aabb = p_aabbs[polygons_bvh_indices[p_begin]];
+	AABB centers(aabb.get_center(), Vector3());
+	for (uint32_t i = p_begin + 1; i < p_end; i++) {
+		const AABB &polygon_aabb = p_aabbs[polygons_bvh_indices[i]];
+		aabb.merge_with(polygon_aabb);
+		centers.expand_to(polygon_aabb.get_center());
+	}
+	polygons_bvh[node_index].aabb = aabb;
+
+	if (p_end - p_begin <= POLYGON_BVH_LEAF_SIZE) {
+		polygons_bvh[node_index].index = p_begin;
+		polygons_bvh[node_index].count = p_end - p_begin;
+		return node_index;
+	}
+
+	// Split at the median of the polygon centers along the longest axis, it keeps the tree balanced.
+	struct CenterCompare {
+		const LocalVector<AABB> *aabbs = nullptr;
+		int axis = 0;
+		_FORCE_INLINE_ bool operator()(uint32_t p_a, uint32_t p_b) const {
+			return (*aabbs)[p_a].get_center()[axis] < (*aabbs)[p_b].get_center()[axis];
+		}
+	};
+	SortArray<uint32_t, CenterCompare> sorter;
+	sorter.compare.aabbs = &p_aabbs;
+	sorter.compare.axis = centers.get_longest_axis_index();
+	const uint32_t middle = (p_begin + p_end) / 2;
+	sorter.nth_element(p_begin, p_end, middle, polygons_bvh_indices.ptr());
+
+	_build_polygons_bvh_node(p_aabbs, p_begin, middle);
+	polygons_bvh[node_index].index = _build_polygons_bvh_node(p_aabbs, middle, p_end);
+	return node_index;
+}
+
+static _FORCE_INLINE_ real_t _get_aabb_distance_squared(const AABB &p_aabb, const Vector3 &p_point) {
+	const Vector3 d = (p_aabb.position - p_point).max(p_point - (p_aabb.position + p_aabb.size)).max(Vector3());
+	return d.length_squared();
+}
+
+const gd::Polygon *NavMap::_get_closest_polygon(const Vector3 &p_point, uint32_t p_navigation_layers, bool p_use_layers, real_t p_max_distance, Vector3 &r_closest_point, Vector3 *r_normal) const {
+	const gd::Polygon *closest_polygon = nullptr;
+	uint32_t closest_polygon_index = UINT32_MAX;
+	real_t closest_point_ds = p_max_distance < FLT_MAX ? p_max_distance * p_max_distance : FLT_MAX;
+
+	if (polygons_bvh.is_empty()) {
+		return nullptr;
+	}
+
+	// The tree is balanced, so its depth stays far below the stack size.
+	uint32_t stack[64];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = 0;
+
+	while (stack_size > 0) {
+		const uint32_t node_index = stack[--stack_size];
+		const PolygonBVHNode &node = polygons_bvh[node_index];
+		if (_get_aabb_distance_squared(node.aabb, p_point) > closest_point_ds) {
+			continue;
+		}
+
+		if (node.count == 0) {
+			// Visit the closest child first, it likely shrinks the search radius for the other one.
+			const uint32_t first = node_index + 1;
+			const uint32_t second = node.index;
+			if (_get_aabb_distance_squared(polygons_bvh[first].aabb, p_point) < _get_aabb_distance_squared(polygons_bvh[second].aabb, p_point)) {
+				stack[stack_size++] = second;
+				stack[stack_size++] = first;
+			} else {
+				stack[stack_size++] = first;
+				stack[stack_size++] = second;
+			}
+			continue;
+		}
+
+		for (uint32_t i = node.index; i < node.index + node.count; i++) {
+			const uint32_t polygon_index = polygons_bvh_indices[i];
+			const gd::Polygon &p = polygons[polygon_index];
+			if (p_use_layers && (p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
+				continue;
+			}
+
+			// For each face check the distance to the point.
+			for (uint32_t point_id = 2; point_id < p.points.size(); point_id++) {
+				const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+				const Vector3 inters = f.get_closest_point_to(p_point);
+				const real_t ds = inters.distance_squared_to(p_point);
+				// On ties, prefer the first polygon of the map, as a linear search would.
+				if (ds < closest_point_ds || (ds == closest_point_ds && closest_polygon && polygon_index < closest_polygon_index)) {
+					closest_point_ds = ds;
+					closest_polygon = &p;
+					closest_polygon_index = polygon_index;
+					r_closest_point = inters;
+					if (r_normal) {
+						*r_normal = f.get_plane().normal;
+					}
+				}
 			}
 		}
 	}
 
-	return result;
+	return closest_polygon;
+}
+
+uint32_t NavMap::_get_polygon_index(const gd::Polygon *p_polygon) const {
+	if (p_polygon >= polygons.ptr() && p_polygon < polygons.ptr() + polygons.size()) {
+		return p_polygon - polygons.ptr();
+	}
+	return polygons.size() + (p_polygon - link_polygons.ptr());
+}
+
+const gd::Polygon &NavMap::_get_polygon(uint32_t p_index) const {
+	if (p_index < polygons.size()) {
+		return polygons[p_index];
+	}
+	return link_polygons[p_index - polygons.size()];
+}
+
+void NavMap::_build_clusters() {
+	clusters.clear();
+	polygon_clusters.clear();
+	polygon_portals.clear();
+	cluster_portals.clear();
+	cluster_portal_distances.clear();
+	portal_connection_offsets.clear();
+	portal_connections.clear();
+
+	if (!use_clusters) {
+		pm_cluster_build_time = 0;
+		return;
+	}
+
+	const uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+	const real_t size = cluster_size * cell_size;
+	const uint32_t polygon_count = polygons.size() + link_polygons.size();
+	polygon_clusters.resize(polygon_count);
+
+	// The regions keep the clusters of their polygons until they change.
+	LocalVector<NavRegion *> cluster_regions;
+	LocalVector<uint32_t> cluster_polygon_offsets;
+	uint32_t polygon_offset = 0;
+	for (NavRegion *region : regions) {
+		if (!region->get_enabled()) {
+			continue;
+		}
+		const LocalVector<gd::Polygon> &region_polygons = region->get_polygons();
+		gd::RegionClusters &region_clusters = region->get_clusters();
+		if (region_clusters.cluster_size != size || region_clusters.polygon_clusters.size() != region_polygons.size()) {
+			region_clusters.clear();
+			region_clusters.cluster_size = size;
+
+			HashMap<Vector3i, uint32_t> cells;
+			for (const gd::Polygon &polygon : region_polygons) {
+				const Vector3i cell(Math::floor(polygon.center.x / size), Math::floor(polygon.center.y / size), Math::floor(polygon.center.z / size));
+				HashMap<Vector3i, uint32_t>::Iterator E = cells.find(cell);
+				if (!E) {
+					E = cells.insert(cell, cells.size());
+				}
+				region_clusters.polygon_clusters.push_back(E->value);
+			}
+			region_clusters.cluster_portals.resize(cells.size());
+			region_clusters.cluster_distances.resize(cells.size());
+		}
+
+		for (uint32_t i = 0; i < region_polygons.size(); i++) {
+			polygon_clusters[polygon_offset + i] = clusters.size() + region_clusters.polygon_clusters[i];
+		}
+		for (uint32_t i = 0; i < region_clusters.cluster_portals.size(); i++) {
+			PolygonCluster cluster;
+			cluster.owner = region;
+			clusters.push_back(cluster);
+			cluster_regions.push_back(region);
+			cluster_polygon_offsets.push_back(polygon_offset);
+		}
+		polygon_offset += region_polygons.size();
+	}
+
+	// Each link is a cluster of its own.
+	for (uint32_t i = 0; i < link_polygons.size(); i++) {
+		polygon_clusters[polygons.size() + i] = clusters.size();
+		PolygonCluster cluster;
+		cluster.owner = link_polygons[i].owner;
+		clusters.push_back(cluster);
+	}
+
+	// Portals are the polygons on both sides of the connections between clusters.
+	polygon_portals.resize(polygon_count);
+	for (uint32_t i = 0; i < polygon_count; i++) {
+		polygon_portals[i] = UINT32_MAX;
+	}
+	for (uint32_t i = 0; i < polygon_count; i++) {
+		for (const gd::Edge &edge : _get_polygon(i).edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				const uint32_t other = _get_polygon_index(connection.polygon);
+				if (polygon_clusters[other] != polygon_clusters[i]) {
+					polygon_portals[i] = 0;
+					polygon_portals[other] = 0;
+				}
+			}
+		}
+	}
+
+	// Group the portals per cluster, in polygon order.
+	for (uint32_t i = 0; i < polygon_count; i++) {
+		if (polygon_portals[i] != UINT32_MAX) {
+			clusters[polygon_clusters[i]].portal_count++;
+		}
+	}
+	uint32_t portal_count = 0;
+	for (PolygonCluster &cluster : clusters) {
+		cluster.portal_begin = portal_count;
+		portal_count += cluster.portal_count;
+		cluster.portal_count = 0;
+	}
+	cluster_portals.resize(portal_count);
+	for (uint32_t i = 0; i < polygon_count; i++) {
+		if (polygon_portals[i] != UINT32_MAX) {
+			PolygonCluster &cluster = clusters[polygon_clusters[i]];
+			polygon_portals[i] = cluster.portal_begin + cluster.portal_count++;
+			cluster_portals[polygon_portals[i]] = i;
+		}
+	}
+
+	portal_connection_offsets.resize(portal_count + 1);
+	for (uint32_t portal = 0; portal < portal_count; portal++) {
+		portal_connection_offsets[portal] = portal_connections.size();
+		const gd::Polygon &polygon = _get_polygon(cluster_portals[portal]);
+		for (const gd::Edge &edge : polygon.edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				const uint32_t other = _get_polygon_index(connection.polygon);
+				if (polygon_clusters[other] != polygon_clusters[cluster_portals[portal]]) {
+					PortalConnection portal_connection;
+					portal_connection.portal = polygon_portals[other];
+					portal_connection.distance = polygon.center.distance_to(connection.polygon->center);
+					portal_connections.push_back(portal_connection);
+				}
+			}
+		}
+	}
+	portal_connection_offsets[portal_count] = portal_connections.size();
+
+	// Distances between the portals of each cluster, only searched again when its region or its portals changed.
+	LocalVector<uint32_t> portals;
+	LocalVector<real_t> portal_distances;
+	for (uint32_t i = 0; i < clusters.size(); i++) {
+		PolygonCluster &cluster = clusters[i];
+		cluster.distance_begin = cluster_portal_distances.size();
+
+		if (i >= cluster_regions.size()) {
+			// A link cluster is a single polygon.
+			for (uint32_t j = 0; j < cluster.portal_count * cluster.portal_count; j++) {
+				cluster_portal_distances.push_back(0.0);
+			}
+			continue;
+		}
+		if (cluster.portal_count == 0) {
+			continue;
+		}
+
+		gd::RegionClusters &region_clusters = cluster_regions[i]->get_clusters();
+		const uint32_t region_cluster = region_clusters.polygon_clusters[cluster_portals[cluster.portal_begin] - cluster_polygon_offsets[i]];
+		portals.clear();
+		for (uint32_t j = 0; j < cluster.portal_count; j++) {
+			portals.push_back(cluster_portals[cluster.portal_begin + j] - cluster_polygon_offsets[i]);
+		}
+
+		LocalVector<uint32_t> &cached_portals = region_clusters.cluster_portals[region_cluster];
+		LocalVector<real_t> &cached_distances = region_clusters.cluster_distances[region_cluster];
+		bool cache_valid = cached_portals.size() == portals.size();
+		for (uint32_t j = 0; cache_valid && j < portals.size(); j++) {
+			cache_valid = cached_portals[j] == portals[j];
+		}
+		if (!cache_valid) {
+			cached_portals = portals;
+			cached_distances.clear();
+			for (uint32_t j = 0; j < cluster.portal_count; j++) {
+				_get_cluster_portal_distances(cluster_portals[cluster.portal_begin + j], portal_distances);
+				for (const real_t &distance : portal_distances) {
+					cached_distances.push_back(distance);
+				}
+			}
+		}
+		for (const real_t &distance : cached_distances) {
+			cluster_portal_distances.push_back(distance);
+		}
+	}
+
+	pm_cluster_build_time = OS::get_singleton()->get_ticks_usec() - begin_usec;
+}
+
+void NavMap::_get_cluster_portal_distances(uint32_t p_polygon, LocalVector<real_t> &r_distances) const {
+	const uint32_t cluster_index = polygon_clusters[p_polygon];
+	const PolygonCluster &cluster = clusters[cluster_index];
+	r_distances.resize(cluster.portal_count);
+	for (uint32_t i = 0; i < cluster.portal_count; i++) {
+		r_distances[i] = FLT_MAX;
+	}
+
+	// Dijkstra search from the polygon center, through the polygons of its cluster.
+	HashMap<uint32_t, real_t> distances;
+	gd::ClusterSearchHeap to_visit = gd::ClusterSearchHeap(gd::ClusterSearchNodeGreaterThan(), gd::ClusterSearchNodeIndexer());
+	distances.insert(p_polygon, 0.0);
+	to_visit.push({ 0.0, p_polygon });
+
+	uint32_t remaining_portals = cluster.portal_count;
+	while (!to_visit.is_empty() && remaining_portals > 0) {
+		const gd::ClusterSearchNode node = to_visit.pop();
+		if (node.cost > distances[node.index]) {
+			continue; // Reached with a shorter distance since it was added.
+		}
+
+		const uint32_t portal = polygon_portals[node.index];
+		if (portal != UINT32_MAX) {
+			r_distances[portal - cluster.portal_begin] = node.cost;
+			remaining_portals--;
+		}
+
+		const gd::Polygon &polygon = _get_polygon(node.index);
+		for (const gd::Edge &edge : polygon.edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				const uint32_t other = _get_polygon_index(connection.polygon);
+				if (polygon_clusters[other] != cluster_index) {
+					continue;
+				}
+				const real_t distance = node.cost + polygon.center.distance_to(connection.polygon->center);
+				HashMap<uint32_t, real_t>::Iterator E = distances.find(other);
+				if (!E) {
+					distances.insert(other, distance);
+				} else if (distance < E->value) {
+					E->value = distance;
+				} else {
+					continue;
+				}
+				to_visit.push({ distance, other });
+			}
+		}
+	}
+}
+
+bool NavMap::_get_cluster_corridor(uint32_t p_begin_polygon, uint32_t p_end_polygon, const Vector3 &p_end_point, uint32_t p_navigation_layers, LocalVector<bool> &r_corridor) const {
+	const uint32_t begin_cluster = polygon_clusters[p_begin_polygon];
+	const uint32_t end_cluster = polygon_clusters[p_end_polygon];
+	if (begin_cluster == end_cluster) {
+		return false;
+	}
+
+	LocalVector<real_t> begin_distances;
+	LocalVector<real_t> end_distances;
+	_get_cluster_portal_distances(p_begin_polygon, begin_distances);
+	_get_cluster_portal_distances(p_end_polygon, end_distances);
+
+	// A* over the portals, the begin and end polygons are the last two nodes.
+	const uint32_t begin_node = cluster_portals.size();
+	const uint32_t end_node = begin_node + 1;
+	LocalVector<real_t> costs;
+	LocalVector<uint32_t> previous;
+	costs.resize(end_node + 1);
+	previous.resize(end_node + 1);
+	for (uint32_t i = 0; i <= end_node; i++) {
+		costs[i] = FLT_MAX;
+		previous[i] = UINT32_MAX;
+	}
+
+	gd::ClusterSearchHeap to_visit = gd::ClusterSearchHeap(gd::ClusterSearchNodeGreaterThan(), gd::ClusterSearchNodeIndexer());
+	costs[begin_node] = 0.0;
+	to_visit.push({ 0.0, begin_node });
+
+	bool found = false;
+	while (!to_visit.is_empty()) {
+		const gd::ClusterSearchNode node = to_visit.pop();
+		if (node.index == end_node) {
+			found = true;
+			break;
+		}
+
+		const real_t cost = costs[node.index];
+		const uint32_t polygon_index = node.index == begin_node ? p_begin_polygon : cluster_portals[node.index];
+		const Vector3 &center = _get_polygon(polygon_index).center;
+		if (node.cost > cost + center.distance_to(p_end_point)) {
+			continue; // Reached with a lower cost since it was added.
+		}
+
+		const uint32_t cluster_index = polygon_clusters[polygon_index];
+		const PolygonCluster &cluster = clusters[cluster_index];
+		const real_t travel_cost = cluster.owner->get_travel_cost();
+
+		auto visit = [&](uint32_t p_node, real_t p_cost) {
+			if (p_cost >= costs[p_node]) {
+				return;
+			}
+			costs[p_node] = p_cost;
+			previous[p_node] = node.index;
+			const real_t estimate = p_node == end_node ? 0.0 : _get_polygon(cluster_portals[p_node]).center.distance_to(p_end_point);
+			to_visit.push({ p_cost + estimate, p_node });
+		};
+
+		// Through the cluster.
+		const real_t *distances = node.index == begin_node ? begin_distances.ptr() : &cluster_portal_distances[cluster.distance_begin + (node.index - cluster.portal_begin) * cluster.portal_count];
+		for (uint32_t i = 0; i < cluster.portal_count; i++) {
+			if (distances[i] < FLT_MAX) {
+				visit(cluster.portal_begin + i, cost + distances[i] * travel_cost);
+			}
+		}
+		if (node.index == begin_node) {
+			continue;
+		}
+		if (cluster_index == end_cluster && end_distances[node.index - cluster.portal_begin] < FLT_MAX) {
+			visit(end_node, cost + end_distances[node.index - cluster.portal_begin] * travel_cost);
+		}
+
+		// To the other clusters.
+		for (uint32_t i = portal_connection_offsets[node.index]; i < portal_connection_offsets[node.index + 1]; i++) {
+			const PortalConnection &connection = portal_connections[i];
+			const NavBase *owner = clusters[polygon_clusters[cluster_portals[connection.portal]]].owner;
+			if ((p_navigation_layers & owner->get_navigation_layers()) == 0) {
+				continue;
+			}
+			const real_t enter_cost = owner != cluster.owner ? owner->get_enter_cost() : 0.0;
+			visit(connection.portal, cost + connection.distance * travel_cost + enter_cost);
+		}
+	}
+
+	if (!found) {
+		return false;
+	}
+
+	r_corridor.resize(clusters.size());
+	for (uint32_t i = 0; i < clusters.size(); i++) {
+		r_corridor[i] = false;
+	}
+	r_corridor[begin_cluster] = true;
+	for (uint32_t i = previous[end_node]; i != begin_node; i = previous[i]) {
+		r_corridor[polygon_clusters[cluster_portals[i]]] = true;
+	}
+	return true;
 }
 
 void NavMap::add_region(NavRegion *p_region) {
@@ -837,6 +1292,8 @@ void NavMap::sync() {
 
 		_new_pm_polygon_count = polygons.size();
 
+		_build_polygons_bvh();
+
 		// Group all edges per key.
 		HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey> connections;
 		for (gd::Polygon &poly : polygons) {
@@ -956,49 +1413,12 @@ void NavMap::sync() {
 			const Vector3 start = link->get_start_position();
 			const Vector3 end = link->get_end_position();
 
-			gd::Polygon *closest_start_polygon = nullptr;
-			real_t closest_start_distance = link_connection_radius;
+			// Pick the polygons closest to the start and end points within our radius.
 			Vector3 closest_start_point;
+			gd::Polygon *closest_start_polygon = const_cast<gd::Polygon *>(_get_closest_polygon(start, 0, false, link_connection_radius, closest_start_point));
 
-			gd::Polygon *closest_end_polygon = nullptr;
-			real_t closest_end_distance = link_connection_radius;
 			Vector3 closest_end_point;
-
-			// Create link to any polygons within the search radius of the start point.
-			for (uint32_t start_index = 0; start_index < polygons.size(); start_index++) {
-				gd::Polygon &start_poly = polygons[start_index];
-
-				// For each face check the distance to the start
-				for (uint32_t start_point_id = 2; start_point_id < start_poly.points.size(); start_point_id += 1) {
-					const Face3 start_face(start_poly.points[0].pos, start_poly.points[start_point_id - 1].pos, start_poly.points[start_point_id].pos);
-					const Vector3 start_point = start_face.get_closest_point_to(start);
-					const real_t start_distance = start_point.distance_to(start);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (start_distance <= link_connection_radius && start_distance < closest_start_distance) {
-						closest_start_distance = start_distance;
-						closest_start_point = start_point;
-						closest_start_polygon = &start_poly;
-					}
-				}
-			}
-
-			// Find any polygons within the search radius of the end point.
-			for (gd::Polygon &end_poly : polygons) {
-				// For each face check the distance to the end
-				for (uint32_t end_point_id = 2; end_point_id < end_poly.points.size(); end_point_id += 1) {
-					const Face3 end_face(end_poly.points[0].pos, end_poly.points[end_point_id - 1].pos, end_poly.points[end_point_id].pos);
-					const Vector3 end_point = end_face.get_closest_point_to(end);
-					const real_t end_distance = end_point.distance_to(end);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (end_distance <= link_connection_radius && end_distance < closest_end_distance) {
-						closest_end_distance = end_distance;
-						closest_end_point = end_point;
-						closest_end_polygon = &end_poly;
-					}
-				}
-			}
+			gd::Polygon *closest_end_polygon = const_cast<gd::Polygon *>(_get_closest_polygon(end, 0, false, link_connection_radius, closest_end_point));
 
 			// If we have both a start and end point, then create a synthetic polygon to route through.
 			if (closest_start_polygon && closest_end_polygon) {
@@ -1058,6 +1478,10 @@ void NavMap::sync() {
 				}
 			}
 		}
+		// Drop the polygons of the links that could not be connected, they may still hold old connections.
+		link_polygons.resize(link_poly_idx);
+
+		_build_clusters();
 
 		// Update the update ID.
 		// Some code treats 0 as a failure case, so we avoid returning 0.
@@ -1070,11 +1494,9 @@ void NavMap::sync() {
 			obstacles_dirty = true;
 		}
 	}
-	// Do we have modified agent arrays?
+	// Moved agents are updated in the avoidance grids every step, only their properties are cleared here.
 	for (NavAgent *agent : agents) {
-		if (agent->check_dirty()) {
-			agents_dirty = true;
-		}
+		agent->check_dirty();
 	}
 
 	// Update avoidance worlds.
@@ -1161,48 +1583,226 @@ void NavMap::_update_rvo_obstacles_tree_2d() {
 	rvo_simulation_2d.kdTree_->buildObstacleTree(raw_obstacles);
 }
 
-void NavMap::_update_rvo_agents_tree_2d() {
-	// Cannot use LocalVector here as RVO library expects std::vector to build KdTree.
-	std::vector<RVO2D::Agent2D *> raw_agents;
-	raw_agents.reserve(active_2d_avoidance_agents.size());
-	for (NavAgent *agent : active_2d_avoidance_agents) {
-		raw_agents.push_back(agent->get_rvo_agent_2d());
+void NavMap::_update_rvo_simulation() {
+	if (obstacles_dirty) {
+		_update_rvo_obstacles_tree_2d();
+	}
+	if (agents_dirty) {
+		avoidance_grid_2d.dirty = true;
+		avoidance_grid_3d.dirty = true;
 	}
-	rvo_simulation_2d.kdTree_->buildAgentTree(raw_agents);
 }
 
-void NavMap::_update_rvo_agents_tree_3d() {
-	// Cannot use LocalVector here as RVO library expects std::vector to build KdTree.
-	std::vector<RVO3D::Agent3D *> raw_agents;
-	raw_agents.reserve(active_3d_avoidance_agents.size());
-	for (NavAgent *agent : active_3d_avoidance_agents) {
-		raw_agents.push_back(agent->get_rvo_agent_3d());
+Vector3i NavMap::_get_avoidance_cell(const AvoidanceGrid &p_grid, const Vector3 &p_position) const {
+	return Vector3i(
+			(int)Math::floor(p_position.x / p_grid.cell_size),
+			p_grid.use_height ? (int)Math::floor(p_position.y / p_grid.cell_size) : 0,
+			(int)Math::floor(p_position.z / p_grid.cell_size));
+}
+
+void NavMap::_update_avoidance_grid(AvoidanceGrid &r_grid, float p_max_neighbor_distance) {
+	// Cells at least as large as the neighbor distances, so queries only visit the adjacent cells.
+	const float cell_size = MAX(p_max_neighbor_distance, 0.01f);
+	if (cell_size > r_grid.cell_size || cell_size < r_grid.cell_size * 0.5f) {
+		r_grid.cell_size = cell_size;
+		r_grid.dirty = true;
+	}
+
+	const uint32_t agent_count = avoidance_positions.size();
+	if (r_grid.dirty || r_grid.agent_cells.size() != agent_count) {
+		r_grid.cells.clear();
+		r_grid.agent_cells.resize(agent_count);
+		r_grid.agent_slots.resize(agent_count);
+		for (uint32_t i = 0; i < agent_count; i++) {
+			const Vector3 &position = avoidance_positions[i];
+			r_grid.agent_cells[i] = _get_avoidance_cell(r_grid, position);
+			AvoidanceCell &cell = r_grid.cells[r_grid.agent_cells[i]];
+			r_grid.agent_slots[i] = cell.agents.size();
+			cell.agents.push_back(i);
+			cell.positions_x.push_back(position.x);
+			cell.positions_y.push_back(position.y);
+			cell.positions_z.push_back(position.z);
+		}
+		r_grid.dirty = false;
+	} else {
+		for (uint32_t i = 0; i < agent_count; i++) {
+			const Vector3 &position = avoidance_positions[i];
+			const Vector3i cell_key = _get_avoidance_cell(r_grid, position);
+			if (cell_key == r_grid.agent_cells[i]) {
+				AvoidanceCell &cell = r_grid.cells[cell_key];
+				const uint32_t slot = r_grid.agent_slots[i];
+				cell.positions_x[slot] = position.x;
+				cell.positions_y[slot] = position.y;
+				cell.positions_z[slot] = position.z;
+				continue;
+			}
+
+			// Swap the last agent of the previous cell into the freed slot.
+			AvoidanceCell &previous_cell = r_grid.cells[r_grid.agent_cells[i]];
+			const uint32_t slot = r_grid.agent_slots[i];
+			const uint32_t last_slot = previous_cell.agents.size() - 1;
+			if (slot != last_slot) {
+				const uint32_t moved_agent = previous_cell.agents[last_slot];
+				previous_cell.agents[slot] = moved_agent;
+				previous_cell.positions_x[slot] = previous_cell.positions_x[last_slot];
+				previous_cell.positions_y[slot] = previous_cell.positions_y[last_slot];
+				previous_cell.positions_z[slot] = previous_cell.positions_z[last_slot];
+				r_grid.agent_slots[moved_agent] = slot;
+			}
+			if (last_slot == 0) {
+				r_grid.cells.erase(r_grid.agent_cells[i]);
+			} else {
+				previous_cell.agents.resize(last_slot);
+				previous_cell.positions_x.resize(last_slot);
+				previous_cell.positions_y.resize(last_slot);
+				previous_cell.positions_z.resize(last_slot);
+			}
+
+			AvoidanceCell &cell = r_grid.cells[cell_key];
+			r_grid.agent_cells[i] = cell_key;
+			r_grid.agent_slots[i] = cell.agents.size();
+			cell.agents.push_back(i);
+			cell.positions_x.push_back(position.x);
+			cell.positions_y.push_back(position.y);
+			cell.positions_z.push_back(position.z);
+		}
+	}
+
+	r_grid.order.clear();
+	for (const KeyValue<Vector3i, AvoidanceCell> &E : r_grid.cells) {
+		for (const uint32_t &agent_index : E.value.agents) {
+			r_grid.order.push_back(agent_index);
+		}
 	}
-	rvo_simulation_3d.kdTree_->buildAgentTree(raw_agents);
 }
 
-void NavMap::_update_rvo_simulation() {
-	if (obstacles_dirty) {
-		_update_rvo_obstacles_tree_2d();
+template <typename F>
+void NavMap::_query_avoidance_grid(const AvoidanceGrid &p_grid, const Vector3 &p_position, float &r_range_sq, F p_callback) const {
+	const Vector3i center = _get_avoidance_cell(p_grid, p_position);
+	const int height_reach = p_grid.use_height ? 1 : 0;
+	const float position_x = p_position.x;
+	const float position_y = p_position.y;
+	const float position_z = p_position.z;
+
+	for (int z = -1; z <= 1; z++) {
+		for (int y = -height_reach; y <= height_reach; y++) {
+			for (int x = -1; x <= 1; x++) {
+				const AvoidanceCell *cell = p_grid.cells.getptr(center + Vector3i(x, y, z));
+				if (cell == nullptr) {
+					continue;
+				}
+				const uint32_t agent_count = cell->agents.size();
+				const float *positions_x = cell->positions_x.ptr();
+				const float *positions_y = cell->positions_y.ptr();
+				const float *positions_z = cell->positions_z.ptr();
+
+				// Distances are computed in blocks without branches so the loop vectorizes, the range shrinks as neighbors are found.
+				float distances_sq[16];
+				for (uint32_t begin = 0; begin < agent_count; begin += 16) {
+					const uint32_t block_size = MIN(16u, agent_count - begin);
+					for (uint32_t i = 0; i < block_size; i++) {
+						const float dx = positions_x[begin + i] - position_x;
+						const float dy = positions_y[begin + i] - position_y;
+						const float dz = positions_z[begin + i] - position_z;
+						distances_sq[i] = dx * dx + dy * dy + dz * dz;
+					}
+					for (uint32_t i = 0; i < block_size; i++) {
+						if (distances_sq[i] < r_range_sq) {
+							p_callback(cell->agents[begin + i]);
+						}
+					}
+				}
+			}
+		}
 	}
-	if (agents_dirty) {
-		_update_rvo_agents_tree_2d();
-		_update_rvo_agents_tree_3d();
+}
+
+void NavMap::compute_avoidance_chunk_2d(uint32_t p_chunk, AvoidancePass p_pass) {
+	const uint32_t begin = p_chunk * avoidance_chunk_size;
+	const uint32_t end = MIN(begin + avoidance_chunk_size, avoidance_grid_2d.order.size());
+
+	for (uint32_t i = begin; i < end; i++) {
+		NavAgent *agent = active_2d_avoidance_agents[avoidance_grid_2d.order[i]];
+		RVO2D::Agent2D *rvo_agent = agent->get_rvo_agent_2d();
+
+		if (p_pass != AVOIDANCE_PASS_UPDATE) {
+			// Same as RVO2D::Agent2D::computeNeighbors(), with the agent neighbors from the spatial hash.
+			rvo_agent->obstacleNeighbors_.clear();
+			float range_sq = rvo_agent->timeHorizonObst_ * rvo_agent->maxSpeed_ + rvo_agent->radius_;
+			range_sq *= range_sq;
+			rvo_simulation_2d.kdTree_->computeObstacleNeighbors(rvo_agent, range_sq);
+
+			rvo_agent->agentNeighbors_.clear();
+			if (rvo_agent->maxNeighbors_ > 0) {
+				range_sq = rvo_agent->neighborDist_ * rvo_agent->neighborDist_;
+				const Vector3 position = Vector3(rvo_agent->position_.x(), 0.0, rvo_agent->position_.y());
+				_query_avoidance_grid(avoidance_grid_2d, position, range_sq, [&](uint32_t p_agent_index) {
+					rvo_agent->insertAgentNeighbor(active_2d_avoidance_agents[p_agent_index]->get_rvo_agent_2d(), range_sq);
+				});
+			}
+
+			rvo_agent->computeNewVelocity(&rvo_simulation_2d);
+		}
+
+		if (p_pass != AVOIDANCE_PASS_VELOCITIES) {
+			rvo_agent->update(&rvo_simulation_2d);
+			agent->update();
+		}
 	}
 }
 
-void NavMap::compute_single_avoidance_step_2d(uint32_t index, NavAgent **agent) {
-	(*(agent + index))->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
-	(*(agent + index))->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
-	(*(agent + index))->get_rvo_agent_2d()->update(&rvo_simulation_2d);
-	(*(agent + index))->update();
+void NavMap::compute_avoidance_chunk_3d(uint32_t p_chunk, AvoidancePass p_pass) {
+	const uint32_t begin = p_chunk * avoidance_chunk_size;
+	const uint32_t end = MIN(begin + avoidance_chunk_size, avoidance_grid_3d.order.size());
+
+	for (uint32_t i = begin; i < end; i++) {
+		NavAgent *agent = active_3d_avoidance_agents[avoidance_grid_3d.order[i]];
+		RVO3D::Agent3D *rvo_agent = agent->get_rvo_agent_3d();
+
+		if (p_pass != AVOIDANCE_PASS_UPDATE) {
+			// Same as RVO3D::Agent3D::computeNeighbors(), with the agent neighbors from the spatial hash.
+			rvo_agent->agentNeighbors_.clear();
+			if (rvo_agent->maxNeighbors_ > 0) {
+				float range_sq = rvo_agent->neighborDist_ * rvo_agent->neighborDist_;
+				const Vector3 position = Vector3(rvo_agent->position_.x(), rvo_agent->position_.y(), rvo_agent->position_.z());
+				_query_avoidance_grid(avoidance_grid_3d, position, range_sq, [&](uint32_t p_agent_index) {
+					rvo_agent->insertAgentNeighbor(active_3d_avoidance_agents[p_agent_index]->get_rvo_agent_3d(), range_sq);
+				});
+			}
+
+			rvo_agent->computeNewVelocity(&rvo_simulation_3d);
+		}
+
+		if (p_pass != AVOIDANCE_PASS_VELOCITIES) {
+			rvo_agent->update(&rvo_simulation_3d);
+			agent->update();
+		}
+	}
 }
 
-void NavMap::compute_single_avoidance_step_3d(uint32_t index, NavAgent **agent) {
-	(*(agent + index))->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
-	(*(agent + index))->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
-	(*(agent + index))->get_rvo_agent_3d()->update(&rvo_simulation_3d);
-	(*(agent + index))->update();
+void NavMap::_step_avoidance(AvoidanceGrid &p_grid, uint32_t p_agent_count, void (NavMap::*p_compute_chunk)(uint32_t, AvoidancePass), const StringName &p_description) {
+	const uint32_t chunk_count = (p_agent_count + avoidance_chunk_size - 1) / avoidance_chunk_size;
+
+	// In deterministic steps all the velocities are computed from the same agent positions and velocities before any agent moves,
+	// so the results do not depend on the threads and their scheduling.
+	LocalVector<AvoidancePass> passes;
+	if (avoidance_use_deterministic_steps) {
+		passes.push_back(AVOIDANCE_PASS_VELOCITIES);
+		passes.push_back(AVOIDANCE_PASS_UPDATE);
+	} else {
+		passes.push_back(AVOIDANCE_PASS_FULL);
+	}
+
+	for (const AvoidancePass &pass : passes) {
+		if (use_threads && avoidance_use_multiple_threads && chunk_count > 1) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, p_compute_chunk, pass, chunk_count, -1, true, p_description);
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			for (uint32_t i = 0; i < chunk_count; i++) {
+				(this->*p_compute_chunk)(i, pass);
+			}
+		}
+	}
 }
 
 void NavMap::step(real_t p_deltatime) {
@@ -1212,31 +1812,27 @@ void NavMap::step(real_t p_deltatime) {
 	rvo_simulation_3d.setTimeStep(float(deltatime));
 
 	if (active_2d_avoidance_agents.size() > 0) {
-		if (use_threads && avoidance_use_multiple_threads) {
-			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::compute_single_avoidance_step_2d, active_2d_avoidance_agents.ptr(), active_2d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents2D"));
-			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
-		} else {
-			for (NavAgent *agent : active_2d_avoidance_agents) {
-				agent->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
-				agent->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
-				agent->get_rvo_agent_2d()->update(&rvo_simulation_2d);
-				agent->update();
-			}
+		float max_neighbor_distance = 0.0;
+		avoidance_positions.resize(active_2d_avoidance_agents.size());
+		for (uint32_t i = 0; i < active_2d_avoidance_agents.size(); i++) {
+			const RVO2D::Agent2D *rvo_agent = active_2d_avoidance_agents[i]->get_rvo_agent_2d();
+			avoidance_positions[i] = Vector3(rvo_agent->position_.x(), 0.0, rvo_agent->position_.y());
+			max_neighbor_distance = MAX(max_neighbor_distance, rvo_agent->neighborDist_);
 		}
+		_update_avoidance_grid(avoidance_grid_2d, max_neighbor_distance);
+		_step_avoidance(avoidance_grid_2d, active_2d_avoidance_agents.size(), &NavMap::compute_avoidance_chunk_2d, SNAME("RVOAvoidanceAgents2D"));
 	}
 
 	if (active_3d_avoidance_agents.size() > 0) {
-		if (use_threads && avoidance_use_multiple_threads) {
-			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::compute_single_avoidance_step_3d, active_3d_avoidance_agents.ptr(), active_3d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents3D"));
-			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
-		} else {
-			for (NavAgent *agent : active_3d_avoidance_agents) {
-				agent->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
-				agent->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
-				agent->get_rvo_agent_3d()->update(&rvo_simulation_3d);
-				agent->update();
-			}
+		float max_neighbor_distance = 0.0;
+		avoidance_positions.resize(active_3d_avoidance_agents.size());
+		for (uint32_t i = 0; i < active_3d_avoidance_agents.size(); i++) {
+			const RVO3D::Agent3D *rvo_agent = active_3d_avoidance_agents[i]->get_rvo_agent_3d();
+			avoidance_positions[i] = Vector3(rvo_agent->position_.x(), rvo_agent->position_.y(), rvo_agent->position_.z());
+			max_neighbor_distance = MAX(max_neighbor_distance, rvo_agent->neighborDist_);
 		}
+		_update_avoidance_grid(avoidance_grid_3d, max_neighbor_distance);
+		_step_avoidance(avoidance_grid_3d, active_3d_avoidance_agents.size(), &NavMap::compute_avoidance_chunk_3d, SNAME("RVOAvoidanceAgents3D"));
 	}
 }
 
@@ -1286,6 +1882,10 @@ void NavMap::clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys
 NavMap::NavMap() {
 	avoidance_use_multiple_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_multiple_threads");
 	avoidance_use_high_priority_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_high_priority_threads");
+	avoidance_use_deterministic_steps = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_deterministic_steps");
+	avoidance_grid_3d.use_height = true;
+	use_clusters = GLOBAL_GET("navigation/pathfinding/use_hierarchical_pathfinding");
+	cluster_size = MAX(1, (int)GLOBAL_GET("navigation/pathfinding/hierarchical_cluster_size"));
 }
 
 NavMap::~NavMap() {
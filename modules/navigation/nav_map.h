@@ -76,6 +76,50 @@ class NavMap : public NavRid {
 	/// Map polygons
 	LocalVector<gd::Polygon> polygons;
 
+	/// Bounding volume hierarchy over the map polygons, used to find the closest ones without testing them all.
+	struct PolygonBVHNode {
+		AABB aabb;
+		/// For a leaf, the first entry in `polygons_bvh_indices`. Otherwise the index of the second child, the first one directly follows its parent.
+		uint32_t index = 0;
+		/// Number of polygons in a leaf, 0 for inner nodes.
+		uint32_t count = 0;
+	};
+	LocalVector<PolygonBVHNode> polygons_bvh;
+	LocalVector<uint32_t> polygons_bvh_indices;
+
+	/// Hierarchical pathfinding. The polygons are grouped in clusters per region and grid cell,
+	/// long paths are planned over the polygons connecting the clusters, the portals, before searching the polygons.
+	bool use_clusters = false;
+	/// Size of the clusters, in cells.
+	int cluster_size = 64;
+
+	struct PolygonCluster {
+		/// Region or link of the cluster polygons.
+		const NavBase *owner = nullptr;
+		/// Range of the cluster portals in `cluster_portals`.
+		uint32_t portal_begin = 0;
+		uint32_t portal_count = 0;
+		/// Start of the travel distances between the cluster portals in `cluster_portal_distances`, one row per portal.
+		uint32_t distance_begin = 0;
+	};
+
+	struct PortalConnection {
+		/// Index of the connected portal, in another cluster.
+		uint32_t portal = 0;
+		real_t distance = 0.0;
+	};
+
+	/// The polygon indices used by the clusters are the ones in `polygons`, followed by the ones in `link_polygons`.
+	LocalVector<PolygonCluster> clusters;
+	LocalVector<uint32_t> polygon_clusters;
+	/// Index of each polygon in `cluster_portals`, or `UINT32_MAX` when it isn't a portal.
+	LocalVector<uint32_t> polygon_portals;
+	LocalVector<uint32_t> cluster_portals;
+	LocalVector<real_t> cluster_portal_distances;
+	/// Connections of each portal to the other clusters, from `portal_connection_offsets[portal]` to `portal_connection_offsets[portal + 1]`.
+	LocalVector<uint32_t> portal_connection_offsets;
+	LocalVector<PortalConnection> portal_connections;
+
 	/// RVO avoidance worlds
 	RVO2D::RVOSimulator2D rvo_simulation_2d;
 	RVO3D::RVOSimulator3D rvo_simulation_3d;
@@ -87,6 +131,38 @@ class NavMap : public NavRid {
 	/// dirty flag when one of the agent's arrays are modified
 	bool agents_dirty = true;
 
+	/// Agents of a spatial hash cell, with their positions packed for the neighbor queries.
+	struct AvoidanceCell {
+		LocalVector<uint32_t> agents;
+		LocalVector<float> positions_x;
+		LocalVector<float> positions_y;
+		LocalVector<float> positions_z;
+	};
+
+	/// Spatial hash of the avoidance agents, moved between cells as they move instead of being rebuilt every step.
+	struct AvoidanceGrid {
+		bool use_height = false;
+		bool dirty = true;
+		float cell_size = 0.0;
+		HashMap<Vector3i, AvoidanceCell> cells;
+		/// Cell and slot of each agent, indexed like the active avoidance agents.
+		LocalVector<Vector3i> agent_cells;
+		LocalVector<uint32_t> agent_slots;
+		/// Agents ordered cell by cell, the avoidance chunks process nearby agents together.
+		LocalVector<uint32_t> order;
+	};
+
+	enum AvoidancePass {
+		AVOIDANCE_PASS_FULL,
+		AVOIDANCE_PASS_VELOCITIES,
+		AVOIDANCE_PASS_UPDATE,
+	};
+
+	AvoidanceGrid avoidance_grid_2d;
+	AvoidanceGrid avoidance_grid_3d;
+	LocalVector<Vector3> avoidance_positions;
+	static constexpr uint32_t avoidance_chunk_size = 64;
+
 	/// All the Agents (even the controlled one)
 	LocalVector<NavAgent *> agents;
 
@@ -105,6 +181,7 @@ class NavMap : public NavRid {
 	bool use_threads = true;
 	bool avoidance_use_multiple_threads = true;
 	bool avoidance_use_high_priority_threads = true;
+	bool avoidance_use_deterministic_steps = false;
 
 	// Performance Monitor
 	int pm_region_count = 0;
@@ -115,6 +192,7 @@ class NavMap : public NavRid {
 	int pm_edge_merge_count = 0;
 	int pm_edge_connection_count = 0;
 	int pm_edge_free_count = 0;
+	int pm_cluster_build_time = 0;
 
 public:
 	NavMap();
@@ -203,18 +281,33 @@ public:
 	int get_pm_edge_merge_count() const { return pm_edge_merge_count; }
 	int get_pm_edge_connection_count() const { return pm_edge_connection_count; }
 	int get_pm_edge_free_count() const { return pm_edge_free_count; }
+	int get_pm_cluster_build_time() const { return pm_cluster_build_time; }
 
 private:
 	void compute_single_step(uint32_t index, NavAgent **agent);
 
-	void compute_single_avoidance_step_2d(uint32_t index, NavAgent **agent);
-	void compute_single_avoidance_step_3d(uint32_t index, NavAgent **agent);
+	void compute_avoidance_chunk_2d(uint32_t p_chunk, AvoidancePass p_pass);
+	void compute_avoidance_chunk_3d(uint32_t p_chunk, AvoidancePass p_pass);
+
+	void _build_polygons_bvh();
+	uint32_t _build_polygons_bvh_node(const LocalVector<AABB> &p_aabbs, uint32_t p_begin, uint32_t p_end);
+	const gd::Polygon *_get_closest_polygon(const Vector3 &p_point, uint32_t p_navigation_layers, bool p_use_layers, real_t p_max_distance, Vector3 &r_closest_point, Vector3 *r_normal = nullptr) const;
+
+	uint32_t _get_polygon_index(const gd::Polygon *p_polygon) const;
+	const gd::Polygon &_get_polygon(uint32_t p_index) const;
+	void _build_clusters();
+	void _get_cluster_portal_distances(uint32_t p_polygon, LocalVector<real_t> &r_distances) const;
+	bool _get_cluster_corridor(uint32_t p_begin_polygon, uint32_t p_end_polygon, const Vector3 &p_end_point, uint32_t p_navigation_layers, LocalVector<bool> &r_corridor) const;
 
 	void clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const;
 	void _update_rvo_simulation();
 	void _update_rvo_obstacles_tree_2d();
-	void _update_rvo_agents_tree_2d();
-	void _update_rvo_agents_tree_3d();
+
+	void _update_avoidance_grid(AvoidanceGrid &r_grid, float p_max_neighbor_distance);
+	_FORCE_INLINE_ Vector3i _get_avoidance_cell(const AvoidanceGrid &p_grid, const Vector3 &p_position) const;
+	template <typename F>
+	void _query_avoidance_grid(const AvoidanceGrid &p_grid, const Vector3 &p_position, float &r_range_sq, F p_callback) const;
+	void _step_avoidance(AvoidanceGrid &p_grid, uint32_t p_agent_count, void (NavMap::*p_compute_chunk)(uint32_t, AvoidancePass), const StringName &p_description);
 };
 
 #endif // NAV_MAP_H
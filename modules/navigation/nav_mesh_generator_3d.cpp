@@ -70,6 +70,8 @@ bool NavMeshGenerator3D::baking_use_multiple_threads = true;
 bool NavMeshGenerator3D::baking_use_high_priority_threads = true;
 HashSet<Ref<NavigationMesh>> NavMeshGenerator3D::baking_navmeshes;
 HashMap<WorkerThreadPool::TaskID, NavMeshGenerator3D::NavMeshGeneratorTask3D *> NavMeshGenerator3D::generator_tasks;
+Mutex NavMeshGenerator3D::tile_cache_mutex;
+HashMap<ObjectID, NavMeshGenerator3D::NavMeshTileCache3D> NavMeshGenerator3D::tile_caches;
 
 NavMeshGenerator3D *NavMeshGenerator3D::get_singleton() {
 	return singleton;
@@ -138,6 +140,10 @@ void NavMeshGenerator3D::cleanup() {
 	}
 	generator_tasks.clear();
 
+	tile_cache_mutex.lock();
+	tile_caches.clear();
+	tile_cache_mutex.unlock();
+
 	generator_task_mutex.unlock();
 	baking_navmesh_mutex.unlock();
 }
@@ -180,7 +186,7 @@ void NavMeshGenerator3D::bake_from_source_geometry_data(Ref<NavigationMesh> p_na
 	baking_navmeshes.insert(p_navigation_mesh);
 	baking_navmesh_mutex.unlock();
 
-	generator_bake_from_source_geometry_data(p_navigation_mesh, p_source_geometry_data);
+	generator_bake_from_source_geometry_data(p_navigation_mesh, p_source_geometry_data, use_threads);
 
 	baking_navmesh_mutex.lock();
 	baking_navmeshes.erase(p_navigation_mesh);
@@ -231,7 +237,8 @@ void NavMeshGenerator3D::bake_from_source_geometry_data_async(Ref<NavigationMesh
 void NavMeshGenerator3D::generator_thread_bake(void *p_arg) {
 	NavMeshGeneratorTask3D *generator_task = static_cast<NavMeshGeneratorTask3D *>(p_arg);
 
-	generator_bake_from_source_geometry_data(generator_task->navigation_mesh, generator_task->source_geometry_data);
+	// Already on a worker, tiles are not split further to not block more pool threads waiting on them.
+	generator_bake_from_source_geometry_data(generator_task->navigation_mesh, generator_task->source_geometry_data, false);
 
 	generator_task->status = NavMeshGeneratorTask3D::TaskStatus::BAKING_FINISHED;
 }
@@ -608,7 +615,7 @@ void NavMeshGenerator3D::generator_parse_source_geometry_data(const Ref<Navigati
 	}
 };
 
-void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data) {
+void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, bool p_use_threads) {
 	if (p_navigation_mesh.is_null() || p_source_geometry_data.is_null()) {
 		return;
 	}
@@ -620,13 +627,6 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		return;
 	}
 
-	rcHeightfield *hf = nullptr;
-	rcCompactHeightfield *chf = nullptr;
-	rcContourSet *cset = nullptr;
-	rcPolyMesh *poly_mesh = nullptr;
-	rcPolyMeshDetail *detail_mesh = nullptr;
-	rcContext ctx;
-
 	// added to keep track of steps, no functionality right now
 	String bake_state = "";
 
@@ -711,93 +711,184 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 				   "\nIt is advised to increase Cell Size and/or Cell Height in the NavMesh Resource bake settings or reduce the size / scale of the source geometry.");
 	}
 
-	bake_state = "Creating heightfield..."; // step #3
+	if (p_navigation_mesh->get_tile_size() > 0) {
+		generator_bake_tiles(p_navigation_mesh, cfg, verts, nverts, tris, ntris, p_use_threads);
+		return;
+	}
+
+	tile_cache_mutex.lock();
+	tile_caches.erase(p_navigation_mesh->get_instance_id());
+	tile_cache_mutex.unlock();
+
+	rcPolyMeshDetail *detail_mesh = generator_bake_detail_mesh(p_navigation_mesh, cfg, verts, nverts, tris, ntris, AABB());
+	ERR_FAIL_NULL(detail_mesh);
+
+	bake_state = "Converting to native navigation mesh..."; // step #10
+
+	Vector<Vector3> nav_vertices;
+
+	for (int i = 0; i < detail_mesh->nverts; i++) {
+		const float *v = &detail_mesh->verts[i * 3];
+		nav_vertices.push_back(Vector3(v[0], v[1], v[2]));
+	}
+	p_navigation_mesh->set_vertices(nav_vertices);
+	p_navigation_mesh->clear_polygons();
+
+	for (int i = 0; i < detail_mesh->nmeshes; i++) {
+		const unsigned int *detail_mesh_m = &detail_mesh->meshes[i * 4];
+		const unsigned int detail_mesh_bverts = detail_mesh_m[0];
+		const unsigned int detail_mesh_m_btris = detail_mesh_m[2];
+		const unsigned int detail_mesh_ntris = detail_mesh_m[3];
+		const unsigned char *detail_mesh_tris = &detail_mesh->tris[detail_mesh_m_btris * 4];
+		for (unsigned int j = 0; j < detail_mesh_ntris; j++) {
+			Vector<int> nav_indices;
+			nav_indices.resize(3);
+			// Polygon order in recast is opposite than godot's
+			nav_indices.write[0] = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 0]));
+			nav_indices.write[1] = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 2]));
+			nav_indices.write[2] = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 1]));
+			p_navigation_mesh->add_polygon(nav_indices);
+		}
+	}
+
+	bake_state = "Cleanup..."; // step #11
+
+	rcFreePolyMeshDetail(detail_mesh);
+	detail_mesh = nullptr;
+
+	bake_state = "Baking finished."; // step #12
+}
+
+rcPolyMeshDetail *NavMeshGenerator3D::generator_bake_detail_mesh(const Ref<NavigationMesh> &p_navigation_mesh, const rcConfig &p_cfg, const float *p_verts, int p_nverts, const int *p_tris, int p_ntris, const AABB &p_clip_aabb) {
+	rcHeightfield *hf = nullptr;
+	rcCompactHeightfield *chf = nullptr;
+	rcContourSet *cset = nullptr;
+	rcPolyMesh *poly_mesh = nullptr;
+	rcPolyMeshDetail *detail_mesh = nullptr;
+	rcContext ctx;
+
+	// Creating heightfield.
 	hf = rcAllocHeightfield();
 
-	ERR_FAIL_NULL(hf);
-	ERR_FAIL_COND(!rcCreateHeightfield(&ctx, *hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch));
+	ERR_FAIL_NULL_V(hf, nullptr);
+	ERR_FAIL_COND_V(!rcCreateHeightfield(&ctx, *hf, p_cfg.width, p_cfg.height, p_cfg.bmin, p_cfg.bmax, p_cfg.cs, p_cfg.ch), nullptr);
 
-	bake_state = "Marking walkable triangles..."; // step #4
+	// Marking walkable triangles.
 	{
 		Vector<unsigned char> tri_areas;
-		tri_areas.resize(ntris);
+		tri_areas.resize(p_ntris);
 
-		ERR_FAIL_COND(tri_areas.size() == 0);
+		ERR_FAIL_COND_V(tri_areas.size() == 0, nullptr);
 
-		memset(tri_areas.ptrw(), 0, ntris * sizeof(unsigned char));
-		rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, verts, nverts, tris, ntris, tri_areas.ptrw());
+		memset(tri_areas.ptrw(), 0, p_ntris * sizeof(unsigned char));
+		rcMarkWalkableTriangles(&ctx, p_cfg.walkableSlopeAngle, p_verts, p_nverts, p_tris, p_ntris, tri_areas.ptrw());
 
-		ERR_FAIL_COND(!rcRasterizeTriangles(&ctx, verts, nverts, tris, tri_areas.ptr(), ntris, *hf, cfg.walkableClimb));
+		ERR_FAIL_COND_V(!rcRasterizeTriangles(&ctx, p_verts, p_nverts, p_tris, tri_areas.ptr(), p_ntris, *hf, p_cfg.walkableClimb), nullptr);
 	}
 
 	if (p_navigation_mesh->get_filter_low_hanging_obstacles()) {
-		rcFilterLowHangingWalkableObstacles(&ctx, cfg.walkableClimb, *hf);
+		rcFilterLowHangingWalkableObstacles(&ctx, p_cfg.walkableClimb, *hf);
 	}
 	if (p_navigation_mesh->get_filter_ledge_spans()) {
-		rcFilterLedgeSpans(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf);
+		rcFilterLedgeSpans(&ctx, p_cfg.walkableHeight, p_cfg.walkableClimb, *hf);
 	}
 	if (p_navigation_mesh->get_filter_walkable_low_height_spans()) {
-		rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *hf);
+		rcFilterWalkableLowHeightSpans(&ctx, p_cfg.walkableHeight, *hf);
 	}
 
-	bake_state = "Constructing compact heightfield..."; // step #5
-
+	// Constructing compact heightfield.
 	chf = rcAllocCompactHeightfield();
 
-	ERR_FAIL_NULL(chf);
-	ERR_FAIL_COND(!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf, *chf));
+	ERR_FAIL_NULL_V(chf, nullptr);
+	ERR_FAIL_COND_V(!rcBuildCompactHeightfield(&ctx, p_cfg.walkableHeight, p_cfg.walkableClimb, *hf, *chf), nullptr);
 
 	rcFreeHeightField(hf);
 	hf = nullptr;
 
-	bake_state = "Eroding walkable area..."; // step #6
-
-	ERR_FAIL_COND(!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf));
+	if (p_clip_aabb.has_volume()) {
+		// Tiles extend past the baking AABB, remove the cells outside of it before eroding so its border is eroded too.
+		for (int z = 0; z < chf->height; z++) {
+			for (int x = 0; x < chf->width; x++) {
+				const float cell_x = chf->bmin[0] + (x + 0.5f) * chf->cs;
+				const float cell_z = chf->bmin[2] + (z + 0.5f) * chf->cs;
+				if (cell_x >= p_clip_aabb.position.x && cell_x <= p_clip_aabb.position.x + p_clip_aabb.size.x && cell_z >= p_clip_aabb.position.z && cell_z <= p_clip_aabb.position.z + p_clip_aabb.size.z) {
+					continue;
+				}
+				const rcCompactCell &cell = chf->cells[x + z * chf->width];
+				for (unsigned int i = cell.index; i < cell.index + cell.count; i++) {
+					chf->areas[i] = RC_NULL_AREA;
+				}
+			}
+		}
+	}
 
-	bake_state = "Partitioning..."; // step #7
+	// Eroding walkable area.
+	ERR_FAIL_COND_V(!rcErodeWalkableArea(&ctx, p_cfg.walkableRadius, *chf), nullptr);
 
+	// Partitioning.
 	if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
-		ERR_FAIL_COND(!rcBuildDistanceField(&ctx, *chf));
-		ERR_FAIL_COND(!rcBuildRegions(&ctx, *chf, 0, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND_V(!rcBuildDistanceField(&ctx, *chf), nullptr);
+		ERR_FAIL_COND_V(!rcBuildRegions(&ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea, p_cfg.mergeRegionArea), nullptr);
 	} else if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
-		ERR_FAIL_COND(!rcBuildRegionsMonotone(&ctx, *chf, 0, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND_V(!rcBuildRegionsMonotone(&ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea, p_cfg.mergeRegionArea), nullptr);
 	} else {
-		ERR_FAIL_COND(!rcBuildLayerRegions(&ctx, *chf, 0, cfg.minRegionArea));
+		ERR_FAIL_COND_V(!rcBuildLayerRegions(&ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea), nullptr);
 	}
 
-	bake_state = "Creating contours..."; // step #8
-
+	// Creating contours.
 	cset = rcAllocContourSet();
 
-	ERR_FAIL_NULL(cset);
-	ERR_FAIL_COND(!rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset));
-
-	bake_state = "Creating polymesh..."; // step #9
+	ERR_FAIL_NULL_V(cset, nullptr);
+	ERR_FAIL_COND_V(!rcBuildContours(&ctx, *chf, p_cfg.maxSimplificationError, p_cfg.maxEdgeLen, *cset), nullptr);
 
+	// Creating polymesh.
 	poly_mesh = rcAllocPolyMesh();
-	ERR_FAIL_NULL(poly_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMesh(&ctx, *cset, cfg.maxVertsPerPoly, *poly_mesh));
+	ERR_FAIL_NULL_V(poly_mesh, nullptr);
+	ERR_FAIL_COND_V(!rcBuildPolyMesh(&ctx, *cset, p_cfg.maxVertsPerPoly, *poly_mesh), nullptr);
 
 	detail_mesh = rcAllocPolyMeshDetail();
-	ERR_FAIL_NULL(detail_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *detail_mesh));
+	ERR_FAIL_NULL_V(detail_mesh, nullptr);
+	ERR_FAIL_COND_V(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, p_cfg.detailSampleDist, p_cfg.detailSampleMaxError, *detail_mesh), nullptr);
 
 	rcFreeCompactHeightfield(chf);
 	chf = nullptr;
 	rcFreeContourSet(cset);
 	cset = nullptr;
+	rcFreePolyMesh(poly_mesh);
+	poly_mesh = nullptr;
 
-	bake_state = "Converting to native navigation mesh..."; // step #10
+	return detail_mesh;
+}
 
-	Vector<Vector3> nav_vertices;
+void NavMeshGenerator3D::generator_bake_tile(void *p_arg, uint32_t p_index) {
+	NavMeshTileBakeTask3D *task = static_cast<NavMeshTileBakeTask3D *>(p_arg);
+	const Vector2i &coords = task->coords[p_index];
+	const LocalVector<int> &triangles = task->triangles[p_index];
+	NavMeshTile3D &tile = task->tiles[p_index];
+
+	// The heightfield covers the tile and its border, which is only sampled and cut from the resulting polygons.
+	rcConfig cfg = *task->cfg;
+	cfg.width = cfg.tileSize + cfg.borderSize * 2;
+	cfg.height = cfg.tileSize + cfg.borderSize * 2;
+	cfg.bmin[0] = (coords.x * cfg.tileSize - cfg.borderSize) * cfg.cs;
+	cfg.bmin[2] = (coords.y * cfg.tileSize - cfg.borderSize) * cfg.cs;
+	cfg.bmax[0] = cfg.bmin[0] + cfg.width * cfg.cs;
+	cfg.bmax[2] = cfg.bmin[2] + cfg.height * cfg.cs;
+
+	rcPolyMeshDetail *detail_mesh = generator_bake_detail_mesh(task->navigation_mesh, cfg, task->verts, task->nverts, triangles.ptr(), triangles.size() / 3, task->clip_aabb);
+	if (detail_mesh == nullptr) {
+		return;
+	}
 
+	tile.vertices.resize(detail_mesh->nverts);
+	Vector3 *tile_vertices = tile.vertices.ptrw();
 	for (int i = 0; i < detail_mesh->nverts; i++) {
 		const float *v = &detail_mesh->verts[i * 3];
-		nav_vertices.push_back(Vector3(v[0], v[1], v[2]));
+		tile_vertices[i] = Vector3(v[0], v[1], v[2]);
 	}
-	p_navigation_mesh->set_vertices(nav_vertices);
-	p_navigation_mesh->clear_polygons();
 
+	tile.triangles.resize(detail_mesh->ntris * 3);
+	int *tile_triangles = tile.triangles.ptrw();
 	for (int i = 0; i < detail_mesh->nmeshes; i++) {
 		const unsigned int *detail_mesh_m = &detail_mesh->meshes[i * 4];
 		const unsigned int detail_mesh_bverts = detail_mesh_m[0];
@@ -805,24 +896,315 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		const unsigned int detail_mesh_ntris = detail_mesh_m[3];
 		const unsigned char *detail_mesh_tris = &detail_mesh->tris[detail_mesh_m_btris * 4];
 		for (unsigned int j = 0; j < detail_mesh_ntris; j++) {
-			Vector<int> nav_indices;
-			nav_indices.resize(3);
 			// Polygon order in recast is opposite than godot's
-			nav_indices.write[0] = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 0]));
-			nav_indices.write[1] = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 2]));
-			nav_indices.write[2] = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 1]));
-			p_navigation_mesh->add_polygon(nav_indices);
+			int *triangle = &tile_triangles[(detail_mesh_m_btris + j) * 3];
+			triangle[0] = (int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 0]);
+			triangle[1] = (int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 2]);
+			triangle[2] = (int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 1]);
 		}
 	}
 
-	bake_state = "Cleanup..."; // step #11
-
-	rcFreePolyMesh(poly_mesh);
-	poly_mesh = nullptr;
 	rcFreePolyMeshDetail(detail_mesh);
-	detail_mesh = nullptr;
+}
 
-	bake_state = "Baking finished."; // step #12
+void NavMeshGenerator3D::generator_bake_tiles(Ref<NavigationMesh> p_navigation_mesh, const rcConfig &p_cfg, const float *p_verts, int p_nverts, const int *p_tris, int p_ntris, bool p_use_threads) {
+	rcConfig cfg = p_cfg;
+	cfg.tileSize = p_navigation_mesh->get_tile_size();
+	cfg.borderSize = cfg.walkableRadius + 3;
+
+	// Heights are quantized from a coarse aligned origin so tiles rasterize their shared borders the same way,
+	// and small changes of the source geometry height do not invalidate all tiles.
+	const float height_step = cfg.ch * 256.0f;
+	cfg.bmin[1] = Math::floor(cfg.bmin[1] / height_step) * height_step;
+	cfg.bmax[1] = (Math::floor(cfg.bmax[1] / height_step) + 1.0f) * height_step;
+
+	AABB clip_aabb = p_navigation_mesh->get_filter_baking_aabb();
+	if (clip_aabb.has_volume()) {
+		clip_aabb.position += p_navigation_mesh->get_filter_baking_aabb_offset();
+	}
+
+	uint32_t config_hash = hash_murmur3_one_32(cfg.tileSize);
+	config_hash = hash_murmur3_one_32(cfg.borderSize, config_hash);
+	config_hash = hash_murmur3_one_float(cfg.cs, config_hash);
+	config_hash = hash_murmur3_one_float(cfg.ch, config_hash);
+	config_hash = hash_murmur3_one_float(cfg.bmin[1], config_hash);
+	config_hash = hash_murmur3_one_float(cfg.bmax[1], config_hash);
+	config_hash = hash_murmur3_one_float(cfg.walkableSlopeAngle, config_hash);
+	config_hash = hash_murmur3_one_32(cfg.walkableHeight, config_hash);
+	config_hash = hash_murmur3_one_32(cfg.walkableClimb, config_hash);
+	config_hash = hash_murmur3_one_32(cfg.walkableRadius, config_hash);
+	config_hash = hash_murmur3_one_32(cfg.maxEdgeLen, config_hash);
+	config_hash = hash_murmur3_one_float(cfg.maxSimplificationError, config_hash);
+	config_hash = hash_murmur3_one_32(cfg.minRegionArea, config_hash);
+	config_hash = hash_murmur3_one_32(cfg.mergeRegionArea, config_hash);
+	config_hash = hash_murmur3_one_32(cfg.maxVertsPerPoly, config_hash);
+	config_hash = hash_murmur3_one_float(cfg.detailSampleDist, config_hash);
+	config_hash = hash_murmur3_one_float(cfg.detailSampleMaxError, config_hash);
+	config_hash = hash_murmur3_one_32(p_navigation_mesh->get_sample_partition_type(), config_hash);
+	config_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_low_hanging_obstacles(), config_hash);
+	config_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_ledge_spans(), config_hash);
+	config_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_walkable_low_height_spans(), config_hash);
+	config_hash = hash_murmur3_one_32(HashMapHasherDefault::hash(clip_aabb.position), config_hash);
+	config_hash = hash_murmur3_one_32(HashMapHasherDefault::hash(clip_aabb.size), config_hash);
+
+	// Tiles are aligned on the world origin, so growing the source geometry bounds keeps the existing tiles valid.
+	const float tile_world_size = cfg.tileSize * cfg.cs;
+	const float border_world_size = cfg.borderSize * cfg.cs;
+	const Vector2i tile_min = Vector2i((int)Math::floor(cfg.bmin[0] / tile_world_size), (int)Math::floor(cfg.bmin[2] / tile_world_size));
+	const Vector2i tile_max = Vector2i((int)Math::floor(cfg.bmax[0] / tile_world_size), (int)Math::floor(cfg.bmax[2] / tile_world_size));
+
+	// Bin the triangles in every tile their border overlaps.
+	HashMap<Vector2i, LocalVector<int>> tile_triangles;
+	for (int i = 0; i < p_ntris; i++) {
+		const int *tri = &p_tris[i * 3];
+		float tri_min[2] = { p_verts[tri[0] * 3 + 0], p_verts[tri[0] * 3 + 2] };
+		float tri_max[2] = { tri_min[0], tri_min[1] };
+		for (int j = 1; j < 3; j++) {
+			const float *v = &p_verts[tri[j] * 3];
+			tri_min[0] = MIN(tri_min[0], v[0]);
+			tri_min[1] = MIN(tri_min[1], v[2]);
+			tri_max[0] = MAX(tri_max[0], v[0]);
+			tri_max[1] = MAX(tri_max[1], v[2]);
+		}
+		const int from_x = MAX(tile_min.x, (int)Math::floor((tri_min[0] - border_world_size) / tile_world_size));
+		const int from_z = MAX(tile_min.y, (int)Math::floor((tri_min[1] - border_world_size) / tile_world_size));
+		const int to_x = MIN(tile_max.x, (int)Math::floor((tri_max[0] + border_world_size) / tile_world_size));
+		const int to_z = MIN(tile_max.y, (int)Math::floor((tri_max[1] + border_world_size) / tile_world_size));
+		for (int z = from_z; z <= to_z; z++) {
+			for (int x = from_x; x <= to_x; x++) {
+				LocalVector<int> &triangles = tile_triangles[Vector2i(x, z)];
+				triangles.push_back(tri[0]);
+				triangles.push_back(tri[1]);
+				triangles.push_back(tri[2]);
+			}
+		}
+	}
+
+	tile_cache_mutex.lock();
+	// Drop the tiles of navigation meshes freed since their last bake.
+	LocalVector<ObjectID> freed_navmeshes;
+	for (const KeyValue<ObjectID, NavMeshTileCache3D> &E : tile_caches) {
+		if (ObjectDB::get_instance(E.key) == nullptr) {
+			freed_navmeshes.push_back(E.key);
+		}
+	}
+	for (const ObjectID &navmesh_id : freed_navmeshes) {
+		tile_caches.erase(navmesh_id);
+	}
+	// Elements are not moved by later insertions and the same navigation mesh never bakes twice at once, so this is safe to use unlocked.
+	NavMeshTileCache3D &tile_cache = tile_caches[p_navigation_mesh->get_instance_id()];
+	tile_cache_mutex.unlock();
+
+	if (tile_cache.config_hash != config_hash) {
+		tile_cache.tiles.clear();
+		tile_cache.config_hash = config_hash;
+	}
+
+	LocalVector<Vector2i> removed_tiles;
+	for (const KeyValue<Vector2i, NavMeshTile3D> &E : tile_cache.tiles) {
+		if (!tile_triangles.has(E.key)) {
+			removed_tiles.push_back(E.key);
+		}
+	}
+	for (const Vector2i &coords : removed_tiles) {
+		tile_cache.tiles.erase(coords);
+	}
+
+	// Only the tiles whose overlapping source geometry changed are rebaked.
+	NavMeshTileBakeTask3D task;
+	task.navigation_mesh = p_navigation_mesh;
+	task.cfg = &cfg;
+	task.verts = p_verts;
+	task.nverts = p_nverts;
+	task.clip_aabb = clip_aabb;
+	LocalVector<uint32_t> tile_hashes;
+
+	for (KeyValue<Vector2i, LocalVector<int>> &E : tile_triangles) {
+		uint32_t tile_hash = hash_murmur3_one_32(E.key.x);
+		tile_hash = hash_murmur3_one_32(E.key.y, tile_hash);
+		for (const int &index : E.value) {
+			const float *v = &p_verts[index * 3];
+			tile_hash = hash_murmur3_one_float(v[0], tile_hash);
+			tile_hash = hash_murmur3_one_float(v[1], tile_hash);
+			tile_hash = hash_murmur3_one_float(v[2], tile_hash);
+		}
+		tile_hash = hash_fmix32(tile_hash);
+
+		const NavMeshTile3D *cached_tile = tile_cache.tiles.getptr(E.key);
+		if (cached_tile && cached_tile->hash == tile_hash) {
+			continue;
+		}
+		task.coords.push_back(E.key);
+		task.triangles.push_back(LocalVector<int>());
+		task.triangles[task.triangles.size() - 1] = std::move(E.value);
+		tile_hashes.push_back(tile_hash);
+	}
+	task.tiles.resize(task.coords.size());
+
+	if (p_use_threads && task.coords.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&NavMeshGenerator3D::generator_bake_tile, &task, task.coords.size(), -1, true, SNAME("NavMeshGeneratorBakeTiles3D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < task.coords.size(); i++) {
+			generator_bake_tile(&task, i);
+		}
+	}
+
+	for (uint32_t i = 0; i < task.coords.size(); i++) {
+		NavMeshTile3D &tile = tile_cache.tiles[task.coords[i]];
+		tile = task.tiles[i];
+		tile.hash = tile_hashes[i];
+	}
+
+	// Stitch the tiles together. Vertices on the shared tile borders are snapped to the same positions,
+	// and border edges are split on the vertices of the neighbor tile, so the navigation map merges them.
+	// A border line is shared by every layer crossing it, so edges are only split on the vertices of their own layer.
+	LocalVector<Vector2i> sorted_tiles;
+	for (const KeyValue<Vector2i, NavMeshTile3D> &E : tile_cache.tiles) {
+		sorted_tiles.push_back(E.key);
+	}
+	sorted_tiles.sort();
+
+	struct BorderVertex {
+		float offset = 0.0;
+		int index = 0;
+
+		bool operator<(const BorderVertex &p_other) const { return offset < p_other.offset; }
+	};
+
+	const float weld_distance = cfg.cs * 0.01f;
+	// At least a cell, the vertices heights are quantized to it.
+	const float max_climb = MAX(cfg.walkableClimb, 1) * cfg.ch;
+	const int no_line = INT32_MIN;
+
+	Vector<Vector3> nav_vertices;
+	LocalVector<int> nav_triangles;
+	LocalVector<int> vertex_line_x;
+	LocalVector<int> vertex_line_z;
+	HashMap<Vector2i, Vector3> welded_vertices;
+	HashMap<int, LocalVector<BorderVertex>> lines_x;
+	HashMap<int, LocalVector<BorderVertex>> lines_z;
+
+	for (const Vector2i &coords : sorted_tiles) {
+		const NavMeshTile3D &tile = tile_cache.tiles[coords];
+		const int vertex_offset = nav_vertices.size();
+
+		for (int i = 0; i < tile.vertices.size(); i++) {
+			Vector3 vertex = tile.vertices[i];
+			const int index = vertex_offset + i;
+
+			int line_x = (int)Math::round(vertex.x / tile_world_size);
+			if (Math::abs(vertex.x - line_x * tile_world_size) <= weld_distance) {
+				vertex.x = line_x * tile_world_size;
+			} else {
+				line_x = no_line;
+			}
+			int line_z = (int)Math::round(vertex.z / tile_world_size);
+			if (Math::abs(vertex.z - line_z * tile_world_size) <= weld_distance) {
+				vertex.z = line_z * tile_world_size;
+			} else {
+				line_z = no_line;
+			}
+
+			if (line_x != no_line || line_z != no_line) {
+				const Vector2i weld_key = Vector2i((int)Math::round(vertex.x / weld_distance), (int)Math::round(vertex.z / weld_distance));
+				const Vector3 *welded_vertex = welded_vertices.getptr(weld_key);
+				if (welded_vertex == nullptr) {
+					welded_vertices.insert(weld_key, vertex);
+				} else if (Math::abs(welded_vertex->y - vertex.y) <= cfg.ch) {
+					vertex = *welded_vertex;
+				}
+				if (line_x != no_line) {
+					lines_x[line_x].push_back({ (float)vertex.z, index });
+				}
+				if (line_z != no_line) {
+					lines_z[line_z].push_back({ (float)vertex.x, index });
+				}
+			}
+
+			nav_vertices.push_back(vertex);
+			vertex_line_x.push_back(line_x);
+			vertex_line_z.push_back(line_z);
+		}
+
+		for (const int &index : tile.triangles) {
+			nav_triangles.push_back(vertex_offset + index);
+		}
+	}
+
+	for (KeyValue<int, LocalVector<BorderVertex>> &E : lines_x) {
+		E.value.sort();
+	}
+	for (KeyValue<int, LocalVector<BorderVertex>> &E : lines_z) {
+		E.value.sort();
+	}
+
+	p_navigation_mesh->set_vertices(nav_vertices);
+	p_navigation_mesh->clear_polygons();
+
+	const Vector3 *nav_vertices_ptr = nav_vertices.ptr();
+	LocalVector<BorderVertex> split_vertices;
+	for (uint32_t i = 0; i < nav_triangles.size(); i += 3) {
+		Vector<int> nav_indices;
+		for (int j = 0; j < 3; j++) {
+			const int from = nav_triangles[i + j];
+			const int to = nav_triangles[i + (j + 1) % 3];
+			nav_indices.push_back(from);
+
+			const LocalVector<BorderVertex> *line = nullptr;
+			float from_offset = 0.0;
+			float to_offset = 0.0;
+			if (vertex_line_x[from] != no_line && vertex_line_x[from] == vertex_line_x[to]) {
+				line = lines_x.getptr(vertex_line_x[from]);
+				from_offset = nav_vertices_ptr[from].z;
+				to_offset = nav_vertices_ptr[to].z;
+			} else if (vertex_line_z[from] != no_line && vertex_line_z[from] == vertex_line_z[to]) {
+				line = lines_z.getptr(vertex_line_z[from]);
+				from_offset = nav_vertices_ptr[from].x;
+				to_offset = nav_vertices_ptr[to].x;
+			}
+			if (line == nullptr) {
+				continue;
+			}
+
+			const float min_offset = MIN(from_offset, to_offset) + weld_distance;
+			const float max_offset = MAX(from_offset, to_offset) - weld_distance;
+			uint32_t first = 0;
+			uint32_t last = line->size();
+			while (first < last) {
+				const uint32_t middle = (first + last) / 2;
+				if ((*line)[middle].offset < min_offset) {
+					first = middle + 1;
+				} else {
+					last = middle;
+				}
+			}
+
+			const float from_height = nav_vertices_ptr[from].y;
+			const float to_height = nav_vertices_ptr[to].y;
+			split_vertices.clear();
+			for (uint32_t k = first; k < line->size() && (*line)[k].offset <= max_offset; k++) {
+				const BorderVertex &border_vertex = (*line)[k];
+				const float edge_height = Math::lerp(from_height, to_height, (border_vertex.offset - from_offset) / (to_offset - from_offset));
+				if (Math::abs(nav_vertices_ptr[border_vertex.index].y - edge_height) > max_climb) {
+					continue; // On another layer crossing the same line.
+				}
+				if (split_vertices.is_empty() || border_vertex.offset - split_vertices[split_vertices.size() - 1].offset > weld_distance) {
+					split_vertices.push_back(border_vertex);
+				}
+			}
+			if (from_offset < to_offset) {
+				for (const BorderVertex &split_vertex : split_vertices) {
+					nav_indices.push_back(split_vertex.index);
+				}
+			} else {
+				for (int k = split_vertices.size() - 1; k >= 0; k--) {
+					nav_indices.push_back(split_vertices[k].index);
+				}
+			}
+		}
+		p_navigation_mesh->add_polygon(nav_indices);
+	}
 }
 
 bool NavMeshGenerator3D::generator_emit_callback(const Callable &p_callback) {
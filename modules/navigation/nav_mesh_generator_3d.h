@@ -41,6 +41,9 @@ class Node;
 class NavigationMesh;
 class NavigationMeshSourceGeometryData3D;
 
+struct rcConfig;
+struct rcPolyMeshDetail;
+
 class NavMeshGenerator3D : public Object {
 	static NavMeshGenerator3D *singleton;
 
@@ -73,9 +76,37 @@ class NavMeshGenerator3D : public Object {
 
 	static HashSet<Ref<NavigationMesh>> baking_navmeshes;
 
+	struct NavMeshTile3D {
+		uint32_t hash = 0;
+		Vector<Vector3> vertices;
+		Vector<int> triangles;
+	};
+
+	struct NavMeshTileCache3D {
+		uint32_t config_hash = 0;
+		HashMap<Vector2i, NavMeshTile3D> tiles;
+	};
+
+	struct NavMeshTileBakeTask3D {
+		Ref<NavigationMesh> navigation_mesh;
+		const rcConfig *cfg = nullptr;
+		const float *verts = nullptr;
+		int nverts = 0;
+		AABB clip_aabb;
+		LocalVector<Vector2i> coords;
+		LocalVector<LocalVector<int>> triangles;
+		LocalVector<NavMeshTile3D> tiles;
+	};
+
+	static Mutex tile_cache_mutex;
+	static HashMap<ObjectID, NavMeshTileCache3D> tile_caches;
+
 	static void generator_parse_geometry_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, bool p_recurse_children);
 	static void generator_parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node);
-	static void generator_bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data);
+	static void generator_bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, bool p_use_threads);
+	static rcPolyMeshDetail *generator_bake_detail_mesh(const Ref<NavigationMesh> &p_navigation_mesh, const rcConfig &p_cfg, const float *p_verts, int p_nverts, const int *p_tris, int p_ntris, const AABB &p_clip_aabb);
+	static void generator_bake_tiles(Ref<NavigationMesh> p_navigation_mesh, const rcConfig &p_cfg, const float *p_verts, int p_nverts, const int *p_tris, int p_ntris, bool p_use_threads);
+	static void generator_bake_tile(void *p_arg, uint32_t p_index);
 
 	static void generator_parse_meshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
 	static void generator_parse_multimeshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
@@ -113,6 +113,7 @@ void NavRegion::update_polygons() {
 		return;
 	}
 	polygons.clear();
+	clusters.clear();
 	polygons_dirty = false;
 
 	if (map == nullptr) {
@@ -49,6 +49,7 @@ class NavRegion : public NavBase {
 
 	/// Cache
 	LocalVector<gd::Polygon> polygons;
+	gd::RegionClusters clusters;
 
 public:
 	NavRegion() {
@@ -93,6 +94,10 @@ public:
 		return polygons;
 	}
 
+	gd::RegionClusters &get_clusters() {
+		return clusters;
+	}
+
 	bool sync();
 
 private:
@@ -129,6 +129,10 @@ struct NavigationPoly {
 	Vector3 entry;
 	/// The distance to the destination.
 	real_t traveled_distance = 0.0;
+	/// The estimated cost of the remaining travel to the destination.
+	real_t distance_to_destination = 0.0;
+	/// Position in the heap of polygons to visit, or `UINT32_MAX` when not in it.
+	uint32_t traversable_poly_index = UINT32_MAX;
 
 	NavigationPoly() { poly = nullptr; }
 
@@ -142,6 +146,165 @@ struct NavigationPoly {
 	bool operator!=(const NavigationPoly &other) const {
 		return !operator==(other);
 	}
+
+	real_t total_travel_cost() const {
+		return traveled_distance + distance_to_destination;
+	}
+};
+
+/// Orders the ids of `NavigationPoly`s so that the cheapest one ends up on top of the heap.
+struct NavPolyTravelCostGreaterThan {
+	const LocalVector<NavigationPoly> *navigation_polys = nullptr;
+
+	bool operator()(uint32_t p_a, uint32_t p_b) const {
+		return (*navigation_polys)[p_a].total_travel_cost() > (*navigation_polys)[p_b].total_travel_cost();
+	}
+};
+
+/// Keeps track of the position of each `NavigationPoly` in the heap, so its cost can be updated in place.
+struct NavPolyHeapIndexer {
+	LocalVector<NavigationPoly> *navigation_polys = nullptr;
+
+	void operator()(uint32_t p_id, uint32_t p_heap_index) const {
+		(*navigation_polys)[p_id].traversable_poly_index = p_heap_index;
+	}
+};
+
+/// A binary max-heap that reports the index of its elements as they move, so they can be shifted when their priority changes.
+template <typename T, typename LessThan, typename Indexer>
+class Heap {
+	LocalVector<T> buffer;
+
+	LessThan less_than;
+	Indexer indexer;
+
+	void _set(uint32_t p_index, const T &p_value) {
+		buffer[p_index] = p_value;
+		indexer(p_value, p_index);
+	}
+
+	bool _shift_up(uint32_t p_index) {
+		const T value = buffer[p_index];
+		uint32_t index = p_index;
+		while (index > 0) {
+			const uint32_t parent = (index - 1) / 2;
+			if (!less_than(buffer[parent], value)) {
+				break;
+			}
+			_set(index, buffer[parent]);
+			index = parent;
+		}
+		if (index == p_index) {
+			return false;
+		}
+		_set(index, value);
+		return true;
+	}
+
+	void _shift_down(uint32_t p_index) {
+		const T value = buffer[p_index];
+		const uint32_t size = buffer.size();
+		uint32_t index = p_index;
+		while (true) {
+			uint32_t child = index * 2 + 1;
+			if (child >= size) {
+				break;
+			}
+			if (child + 1 < size && less_than(buffer[child], buffer[child + 1])) {
+				child++;
+			}
+			if (!less_than(value, buffer[child])) {
+				break;
+			}
+			_set(index, buffer[child]);
+			index = child;
+		}
+		if (index != p_index) {
+			_set(index, value);
+		}
+	}
+
+public:
+	void reserve(uint32_t p_size) { buffer.reserve(p_size); }
+	uint32_t size() const { return buffer.size(); }
+	bool is_empty() const { return buffer.is_empty(); }
+
+	void push(const T &p_value) {
+		buffer.push_back(p_value);
+		indexer(p_value, buffer.size() - 1);
+		_shift_up(buffer.size() - 1);
+	}
+
+	T pop() {
+		const T top = buffer[0];
+		indexer(top, UINT32_MAX);
+		const T last = buffer[buffer.size() - 1];
+		buffer.resize(buffer.size() - 1);
+		if (!buffer.is_empty()) {
+			_set(0, last);
+			_shift_down(0);
+		}
+		return top;
+	}
+
+	/// Restores the heap order after the priority of the element at `p_index` changed.
+	void shift(uint32_t p_index) {
+		ERR_FAIL_UNSIGNED_INDEX(p_index, buffer.size());
+		if (!_shift_up(p_index)) {
+			_shift_down(p_index);
+		}
+	}
+
+	void clear() {
+		for (const T &value : buffer) {
+			indexer(value, UINT32_MAX);
+		}
+		buffer.clear();
+	}
+
+	Heap(const LessThan &p_less_than, const Indexer &p_indexer) :
+			less_than(p_less_than),
+			indexer(p_indexer) {}
+};
+
+/// A node reached by the searches over the polygon clusters, see `NavMap::_build_clusters`.
+struct ClusterSearchNode {
+	/// Estimated total cost of the path through this node.
+	real_t cost = 0.0;
+	/// Polygon or portal index, depending on the search.
+	uint32_t index = 0;
+};
+
+struct ClusterSearchNodeGreaterThan {
+	bool operator()(const ClusterSearchNode &p_a, const ClusterSearchNode &p_b) const {
+		return p_a.cost > p_b.cost;
+	}
+};
+
+/// The cluster searches skip outdated nodes when popping them instead of moving them, they don't track their position.
+struct ClusterSearchNodeIndexer {
+	void operator()(const ClusterSearchNode &p_node, uint32_t p_heap_index) const {}
+};
+
+typedef Heap<ClusterSearchNode, ClusterSearchNodeGreaterThan, ClusterSearchNodeIndexer> ClusterSearchHeap;
+
+/// The clusters of a region's polygons, kept until the region changes so only the modified regions are processed again.
+struct RegionClusters {
+	/// Size of the clusters, in world units.
+	real_t cluster_size = 0.0;
+	/// The cluster of each polygon of the region.
+	LocalVector<uint32_t> polygon_clusters;
+	/// Portals of each cluster, as region polygon indices, when their distances were computed.
+	LocalVector<LocalVector<uint32_t>> cluster_portals;
+	/// Travel distances between the portals of each cluster, one row per portal.
+	LocalVector<LocalVector<real_t>> cluster_distances;
+
+	void clear() {
+		cluster_size = 0.0;
+		polygon_clusters.clear();
+		cluster_portals.clear();
+		cluster_distances.clear();
+	}
 };
 
 struct ClosestPointQueryResult {
@@ -412,6 +412,13 @@ void RaycastOcclusionCull::Scenario::_commit_scene(void *p_ud) {
 	scenario->commit_done = true;
 }
 
+void RaycastOcclusionCull::Scenario::finish_commit() {
+	if (commit_thread && commit_thread->is_started()) {
+		commit_thread->wait_to_finish();
+		current_scene_idx = 1 - current_scene_idx;
+	}
+}
+
 void RaycastOcclusionCull::Scenario::update() {
 	ERR_FAIL_NULL(singleton);
 
@@ -557,6 +564,34 @@ void RaycastOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_
 	buffer.update_mips();
 }
 
+void RaycastOcclusionCull::scenario_finish_commit(RID p_scenario) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_NULL(scenario);
+	scenario->finish_commit();
+}
+
+void RaycastOcclusionCull::mirror_to(RendererSceneOcclusionCull *p_target) {
+	List<RID> occluders;
+	occluder_owner.get_owned_list(&occluders);
+	for (const RID &occluder_rid : occluders) {
+		const Occluder *occluder = occluder_owner.get_or_null(occluder_rid);
+		if (!occluder) {
+			continue; // Allocated but not initialized yet.
+		}
+		p_target->occluder_initialize(occluder_rid);
+		p_target->occluder_set_mesh(occluder_rid, occluder->vertices, occluder->indices);
+	}
+
+	for (const KeyValue<RID, Scenario> &E : scenarios) {
+		p_target->add_scenario(E.key);
+		for (const KeyValue<RID, OccluderInstance> &F : E.value.instances) {
+			if (!F.value.removed) {
+				p_target->scenario_set_instance(E.key, F.key, F.value.occluder, F.value.xform, F.value.enabled);
+			}
+		}
+	}
+}
+
 RaycastOcclusionCull::HZBuffer *RaycastOcclusionCull::buffer_get_ptr(RID p_buffer) {
 	if (!buffers.has(p_buffer)) {
 		return nullptr;
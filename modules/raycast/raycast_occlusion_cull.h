@@ -148,6 +148,7 @@ private:
 		static void _commit_scene(void *p_ud);
 		void free();
 		void update();
+		void finish_commit();
 
 		void _raycast(uint32_t p_thread, const RaycastThreadData *p_raycast_data) const;
 		void raycast(CameraRayTile *r_rays, const uint32_t *p_valid_masks, uint32_t p_tile_count) const;
@@ -189,6 +190,14 @@ public:
 
 	virtual void set_build_quality(RS::ViewportOcclusionCullingBuildQuality p_quality) override;
 
+	virtual void mirror_to(RendererSceneOcclusionCull *p_target) override;
+
+	// Blocks until the scenario's pending BVH commit is done, so the next buffer update sees it.
+	// The commit normally completes in the background and is picked up a few frames later.
+	void scenario_finish_commit(RID p_scenario);
+
+	static RaycastOcclusionCull *get_raycast_singleton() { return raycast_singleton; }
+
 	RaycastOcclusionCull();
 	~RaycastOcclusionCull();
 };
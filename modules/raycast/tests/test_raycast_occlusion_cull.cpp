@@ -0,0 +1,111 @@
+/**************************************************************************/
+/*  test_raycast_occlusion_cull.cpp                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "test_raycast_occlusion_cull.h"
+
+#include "../raycast_occlusion_cull.h"
+
+#include "servers/rendering/raster_occlusion_cull.h"
+
+#include "tests/servers/rendering/test_raster_occlusion_cull.h"
+#include "tests/test_macros.h"
+
+namespace TestRaycastOcclusionCull {
+
+void check_raster_matches_raycast() {
+	// Use the module's own instance, so the ray tracing device and singletons stay as they are.
+	RaycastOcclusionCull *raycast = RaycastOcclusionCull::get_raycast_singleton();
+	REQUIRE(raycast);
+	TestOcclusionCullSingletonScope singleton_scope;
+	RasterOcclusionCull *raster = memnew(RasterOcclusionCull);
+
+	RID scenario = RID::from_uint64(1);
+	RID buffer = RID::from_uint64(2);
+	LocalVector<RID> raycast_occluders;
+	LocalVector<RID> raster_occluders;
+
+	RendererSceneOcclusionCull *culls[2] = { raycast, raster };
+	LocalVector<RID> *occluders[2] = { &raycast_occluders, &raster_occluders };
+	for (int i = 0; i < 2; i++) {
+		culls[i]->add_scenario(scenario);
+		TestRasterOcclusionCull::build_reference_scene(culls[i], scenario, *occluders[i]);
+		culls[i]->add_buffer(buffer);
+		culls[i]->buffer_set_scenario(buffer, scenario);
+		culls[i]->buffer_set_size(buffer, TestRasterOcclusionCull::BUFFER_SIZE);
+	}
+
+	const Projection projection = TestRasterOcclusionCull::get_reference_projection();
+	const Transform3D cameras[3] = {
+		Transform3D(),
+		Transform3D(Basis(Vector3(0, 1, 0), 0.4) * Basis(Vector3(1, 0, 0), -0.2), Vector3(1, 0.5, 2)),
+		Transform3D(Basis(Vector3(0, 1, 0), -0.7), Vector3(-2, 3, -4)),
+	};
+
+	// The ray traced scene is committed on a thread, the first update starts it.
+	raycast->buffer_update(buffer, cameras[0], projection, false);
+	raycast->scenario_finish_commit(scenario);
+
+	for (const Transform3D &camera : cameras) {
+		raycast->buffer_update(buffer, camera, projection, false);
+		raster->buffer_update(buffer, camera, projection, false);
+
+		int probes = 0;
+		int occluded = 0;
+		int mismatches = 0;
+		for (int z = -4; z <= 40; z += 4) {
+			for (int y = -4; y <= 4; y++) {
+				for (int x = -12; x <= 12; x++) {
+					const Vector3 center(x, y, -z);
+					const bool raycast_occluded = TestRasterOcclusionCull::is_box_occluded(raycast, buffer, center, 0.25, camera);
+					const bool raster_occluded = TestRasterOcclusionCull::is_box_occluded(raster, buffer, center, 0.25, camera);
+					probes++;
+					occluded += raycast_occluded ? 1 : 0;
+					mismatches += raycast_occluded != raster_occluded ? 1 : 0;
+				}
+			}
+		}
+
+		CHECK_MESSAGE(occluded > 0, "The reference scene should occlude some probes.");
+		// Both sample pixel centers, only probes grazing an occluder silhouette may differ.
+		CHECK_MESSAGE(mismatches <= probes / 100, vformat("%d of %d probes disagree on visibility.", mismatches, probes));
+	}
+
+	for (int i = 0; i < 2; i++) {
+		culls[i]->remove_buffer(buffer);
+		for (uint32_t j = 0; j < occluders[i]->size(); j++) {
+			culls[i]->scenario_remove_instance(scenario, RID::from_uint64(0x10000 + j));
+			culls[i]->free_occluder((*occluders[i])[j]);
+		}
+		culls[i]->remove_scenario(scenario);
+	}
+	memdelete(raster);
+}
+
+} // namespace TestRaycastOcclusionCull
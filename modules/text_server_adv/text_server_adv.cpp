@@ -794,6 +794,43 @@ String TextServerAdvanced::_tag_to_name(int64_t p_tag) const {
 	return String("custom_") + String(name);
 }
 
+int64_t TextServerAdvanced::_shaping_cache_get_hit_count() const {
+#ifndef GDEXTENSION
+	return shaping_cache_hits.get();
+#else
+	return 0;
+#endif
+}
+
+int64_t TextServerAdvanced::_shaping_cache_get_miss_count() const {
+#ifndef GDEXTENSION
+	return shaping_cache_misses.get();
+#else
+	return 0;
+#endif
+}
+
+void TextServerAdvanced::_shaping_cache_set_capacity(int64_t p_capacity) {
+#ifndef GDEXTENSION
+	_THREAD_SAFE_METHOD_
+	ERR_FAIL_COND(p_capacity < 0);
+	shaping_cache_capacity = p_capacity;
+	if (p_capacity == 0) {
+		shaping_cache.clear(); // Disabled, the LRU keeps its last capacity.
+	} else {
+		shaping_cache.set_capacity(p_capacity);
+	}
+#endif
+}
+
+int64_t TextServerAdvanced::_shaping_cache_get_capacity() const {
+#ifndef GDEXTENSION
+	return shaping_cache_capacity;
+#else
+	return 0;
+#endif
+}
+
 /*************************************************************************/
 /* Font Glyph Rendering                                                  */
 /*************************************************************************/
@@ -949,14 +986,12 @@ void TextServerAdvanced::_generateMTSDF_threaded(void *p_td, uint32_t p_y) {
 	}
 }
 
-_FORCE_INLINE_ TextServerAdvanced::FontGlyph TextServerAdvanced::rasterize_msdf(FontAdvanced *p_font_data, FontForSizeAdvanced *p_data, int p_pixel_range, int p_rect_margin, FT_Outline *outline, const Vector2 &advance) const {
-	msdfgen::Shape shape;
-
-	shape.contours.clear();
-	shape.inverseYAxis = false;
+static bool _msdf_decompose_outline(FT_Outline *p_outline, msdfgen::Shape &r_shape) {
+	r_shape.contours.clear();
+	r_shape.inverseYAxis = false;
 
 	MSContext context = {};
-	context.shape = &shape;
+	context.shape = &r_shape;
 	FT_Outline_Funcs ft_functions;
 	ft_functions.move_to = &ft_move_to;
 	ft_functions.line_to = &ft_line_to;
@@ -965,20 +1000,76 @@ _FORCE_INLINE_ TextServerAdvanced::FontGlyph TextServerAdvanced::rasterize_msdf(
 	ft_functions.shift = 0;
 	ft_functions.delta = 0;
 
-	int error = FT_Outline_Decompose(outline, &ft_functions, &context);
-	ERR_FAIL_COND_V_MSG(error, FontGlyph(), "FreeType: Outline decomposition error: '" + String(FT_Error_String(error)) + "'.");
-	if (!shape.contours.empty() && shape.contours.back().edges.empty()) {
-		shape.contours.pop_back();
+	int error = FT_Outline_Decompose(p_outline, &ft_functions, &context);
+	ERR_FAIL_COND_V_MSG(error, false, "FreeType: Outline decomposition error: '" + String(FT_Error_String(error)) + "'.");
+	if (!r_shape.contours.empty() && r_shape.contours.back().edges.empty()) {
+		r_shape.contours.pop_back();
+	}
+
+	if (FT_Outline_Get_Orientation(p_outline) == 1) {
+		for (int i = 0; i < (int)r_shape.contours.size(); ++i) {
+			r_shape.contours[i].reverse();
+		}
+	}
+
+	r_shape.inverseYAxis = true;
+	r_shape.normalize();
+	return true;
+}
+
+static void _msdf_to_rgba8(const msdfgen::Bitmap<float, 4> &p_image, uint8_t *r_pixels) {
+	for (int i = 0; i < p_image.height(); i++) {
+		for (int j = 0; j < p_image.width(); j++) {
+			const float *px = p_image(j, i);
+			uint8_t *wr = r_pixels + (i * p_image.width() + j) * 4;
+			wr[0] = (uint8_t)(CLAMP(px[0] * 256.f, 0.f, 255.f));
+			wr[1] = (uint8_t)(CLAMP(px[1] * 256.f, 0.f, 255.f));
+			wr[2] = (uint8_t)(CLAMP(px[2] * 256.f, 0.f, 255.f));
+			wr[3] = (uint8_t)(CLAMP(px[3] * 256.f, 0.f, 255.f));
+		}
 	}
+}
+
+_FORCE_INLINE_ TextServerAdvanced::FontGlyph TextServerAdvanced::_store_msdf_glyph(FontForSizeAdvanced *p_data, int p_rect_margin, const uint8_t *p_pixels, int p_width, int p_height, const Vector2 &p_origin, const Vector2 &p_advance) const {
+	int mw = p_width + p_rect_margin * 4;
+	int mh = p_height + p_rect_margin * 4;
+
+	ERR_FAIL_COND_V(mw > 4096, FontGlyph());
+	ERR_FAIL_COND_V(mh > 4096, FontGlyph());
+
+	FontTexturePosition tex_pos = find_texture_pos_for_glyph(p_data, 4, Image::FORMAT_RGBA8, mw, mh, true);
+	ERR_FAIL_COND_V(tex_pos.index < 0, FontGlyph());
+	ShelfPackTexture &tex = p_data->textures.write[tex_pos.index];
 
-	if (FT_Outline_Get_Orientation(outline) == 1) {
-		for (int i = 0; i < (int)shape.contours.size(); ++i) {
-			shape.contours[i].reverse();
+	{
+		uint8_t *wr = tex.imgdata.ptrw();
+
+		for (int i = 0; i < p_height; i++) {
+			int ofs = ((i + tex_pos.y + p_rect_margin * 2) * tex.texture_w + tex_pos.x + p_rect_margin * 2) * 4;
+			ERR_FAIL_COND_V(ofs + p_width * 4 > tex.imgdata.size(), FontGlyph());
+			memcpy(wr + ofs, p_pixels + i * p_width * 4, p_width * 4);
 		}
 	}
 
-	shape.inverseYAxis = true;
-	shape.normalize();
+	tex.dirty = true;
+
+	FontGlyph chr;
+	chr.found = true;
+	chr.advance = p_advance;
+	chr.texture_idx = tex_pos.index;
+
+	chr.uv_rect = Rect2(tex_pos.x + p_rect_margin, tex_pos.y + p_rect_margin, p_width + p_rect_margin * 2, p_height + p_rect_margin * 2);
+	chr.rect.position = Vector2(p_origin.x - p_rect_margin, -p_origin.y - p_rect_margin);
+
+	chr.rect.size = chr.uv_rect.size;
+	return chr;
+}
+
+_FORCE_INLINE_ TextServerAdvanced::FontGlyph TextServerAdvanced::rasterize_msdf(FontAdvanced *p_font_data, FontForSizeAdvanced *p_data, int p_pixel_range, int p_rect_margin, FT_Outline *outline, const Vector2 &advance) const {
+	msdfgen::Shape shape;
+	if (!_msdf_decompose_outline(outline, shape)) {
+		return FontGlyph();
+	}
 
 	msdfgen::Shape::Bounds bounds = shape.getBounds(p_pixel_range);
 
@@ -990,15 +1081,8 @@ _FORCE_INLINE_ TextServerAdvanced::FontGlyph TextServerAdvanced::rasterize_msdf(
 		int w = (bounds.r - bounds.l);
 		int h = (bounds.t - bounds.b);
 
-		int mw = w + p_rect_margin * 4;
-		int mh = h + p_rect_margin * 4;
-
-		ERR_FAIL_COND_V(mw > 4096, FontGlyph());
-		ERR_FAIL_COND_V(mh > 4096, FontGlyph());
-
-		FontTexturePosition tex_pos = find_texture_pos_for_glyph(p_data, 4, Image::FORMAT_RGBA8, mw, mh, true);
-		ERR_FAIL_COND_V(tex_pos.index < 0, FontGlyph());
-		ShelfPackTexture &tex = p_data->textures.write[tex_pos.index];
+		ERR_FAIL_COND_V(w + p_rect_margin * 4 > 4096, FontGlyph());
+		ERR_FAIL_COND_V(h + p_rect_margin * 4 > 4096, FontGlyph());
 
 		edgeColoringSimple(shape, 3.0); // Max. angle.
 		msdfgen::Bitmap<float, 4> image(w, h); // Texture size.
@@ -1018,29 +1102,11 @@ _FORCE_INLINE_ TextServerAdvanced::FontGlyph TextServerAdvanced::rasterize_msdf(
 
 		msdfgen::msdfErrorCorrection(image, shape, projection, p_pixel_range, config);
 
-		{
-			uint8_t *wr = tex.imgdata.ptrw();
-
-			for (int i = 0; i < h; i++) {
-				for (int j = 0; j < w; j++) {
-					int ofs = ((i + tex_pos.y + p_rect_margin * 2) * tex.texture_w + j + tex_pos.x + p_rect_margin * 2) * 4;
-					ERR_FAIL_COND_V(ofs >= tex.imgdata.size(), FontGlyph());
-					wr[ofs + 0] = (uint8_t)(CLAMP(image(j, i)[0] * 256.f, 0.f, 255.f));
-					wr[ofs + 1] = (uint8_t)(CLAMP(image(j, i)[1] * 256.f, 0.f, 255.f));
-					wr[ofs + 2] = (uint8_t)(CLAMP(image(j, i)[2] * 256.f, 0.f, 255.f));
-					wr[ofs + 3] = (uint8_t)(CLAMP(image(j, i)[3] * 256.f, 0.f, 255.f));
-				}
-			}
-		}
-
-		tex.dirty = true;
-
-		chr.texture_idx = tex_pos.index;
-
-		chr.uv_rect = Rect2(tex_pos.x + p_rect_margin, tex_pos.y + p_rect_margin, w + p_rect_margin * 2, h + p_rect_margin * 2);
-		chr.rect.position = Vector2(bounds.l - p_rect_margin, -bounds.t - p_rect_margin);
+		LocalVector<uint8_t> pixels;
+		pixels.resize(w * h * 4);
+		_msdf_to_rgba8(image, pixels.ptr());
 
-		chr.rect.size = chr.uv_rect.size;
+		chr = _store_msdf_glyph(p_data, p_rect_margin, pixels.ptr(), w, h, Vector2(bounds.l, bounds.t), advance);
 	}
 	return chr;
 }
@@ -1163,12 +1229,338 @@ _FORCE_INLINE_ TextServerAdvanced::FontGlyph TextServerAdvanced::rasterize_bitma
 /* Font Cache                                                            */
 /*************************************************************************/
 
+#ifdef MODULE_FREETYPE_ENABLED
+_FORCE_INLINE_ int TextServerAdvanced::_load_glyph(FontAdvanced *p_font_data, FontForSizeAdvanced *p_data, int32_t p_glyph, FT_Render_Mode &r_aa_mode, bool &r_bgra, Vector2 &r_advance) const {
+	int32_t glyph_index = p_glyph & 0xffffff; // Remove subpixel shifts.
+	const Vector2i &size = p_data->size;
+
+	FT_Int32 flags = FT_LOAD_DEFAULT;
+
+	bool outline = size.y > 0;
+	switch (p_font_data->hinting) {
+		case TextServer::HINTING_NONE:
+			flags |= FT_LOAD_NO_HINTING;
+			break;
+		case TextServer::HINTING_LIGHT:
+			flags |= FT_LOAD_TARGET_LIGHT;
+			break;
+		default:
+			flags |= FT_LOAD_TARGET_NORMAL;
+			break;
+	}
+	if (p_font_data->force_autohinter) {
+		flags |= FT_LOAD_FORCE_AUTOHINT;
+	}
+	if (outline) {
+		flags |= FT_LOAD_NO_BITMAP;
+	} else if (FT_HAS_COLOR(p_data->face)) {
+		flags |= FT_LOAD_COLOR;
+	}
+
+	FT_Fixed v, h;
+	FT_Get_Advance(p_data->face, glyph_index, flags, &h);
+	FT_Get_Advance(p_data->face, glyph_index, flags | FT_LOAD_VERTICAL_LAYOUT, &v);
+	r_advance = Vector2((h + (1 << 9)) >> 10, (v + (1 << 9)) >> 10) / 64.0;
+
+	int error = FT_Load_Glyph(p_data->face, glyph_index, flags);
+	if (error) {
+		return error;
+	}
+
+	if (!p_font_data->msdf) {
+		if ((p_font_data->subpixel_positioning == SUBPIXEL_POSITIONING_ONE_QUARTER) || (p_font_data->subpixel_positioning == SUBPIXEL_POSITIONING_AUTO && size.x <= SUBPIXEL_POSITIONING_ONE_QUARTER_MAX_SIZE)) {
+			FT_Pos xshift = (int)((p_glyph >> 27) & 3) << 4;
+			FT_Outline_Translate(&p_data->face->glyph->outline, xshift, 0);
+		} else if ((p_font_data->subpixel_positioning == SUBPIXEL_POSITIONING_ONE_HALF) || (p_font_data->subpixel_positioning == SUBPIXEL_POSITIONING_AUTO && size.x <= SUBPIXEL_POSITIONING_ONE_HALF_MAX_SIZE)) {
+			FT_Pos xshift = (int)((p_glyph >> 27) & 3) << 5;
+			FT_Outline_Translate(&p_data->face->glyph->outline, xshift, 0);
+		}
+	}
+
+	if (p_font_data->embolden != 0.f) {
+		FT_Pos strength = p_font_data->embolden * size.x * 4; // 26.6 fractional units (1 / 64).
+		FT_Outline_Embolden(&p_data->face->glyph->outline, strength);
+	}
+
+	if (p_font_data->transform != Transform2D()) {
+		FT_Matrix mat = { FT_Fixed(p_font_data->transform[0][0] * 65536), FT_Fixed(p_font_data->transform[0][1] * 65536), FT_Fixed(p_font_data->transform[1][0] * 65536), FT_Fixed(p_font_data->transform[1][1] * 65536) }; // 16.16 fractional units (1 / 65536).
+		FT_Outline_Transform(&p_data->face->glyph->outline, &mat);
+	}
+
+	r_aa_mode = FT_RENDER_MODE_NORMAL;
+	r_bgra = false;
+	switch (p_font_data->antialiasing) {
+		case FONT_ANTIALIASING_NONE: {
+			r_aa_mode = FT_RENDER_MODE_MONO;
+		} break;
+		case FONT_ANTIALIASING_GRAY: {
+			r_aa_mode = FT_RENDER_MODE_NORMAL;
+		} break;
+		case FONT_ANTIALIASING_LCD: {
+			int aa_layout = (int)((p_glyph >> 24) & 7);
+			switch (aa_layout) {
+				case FONT_LCD_SUBPIXEL_LAYOUT_HRGB: {
+					r_aa_mode = FT_RENDER_MODE_LCD;
+					r_bgra = false;
+				} break;
+				case FONT_LCD_SUBPIXEL_LAYOUT_HBGR: {
+					r_aa_mode = FT_RENDER_MODE_LCD;
+					r_bgra = true;
+				} break;
+				case FONT_LCD_SUBPIXEL_LAYOUT_VRGB: {
+					r_aa_mode = FT_RENDER_MODE_LCD_V;
+					r_bgra = false;
+				} break;
+				case FONT_LCD_SUBPIXEL_LAYOUT_VBGR: {
+					r_aa_mode = FT_RENDER_MODE_LCD_V;
+					r_bgra = true;
+				} break;
+				default: {
+					r_aa_mode = FT_RENDER_MODE_NORMAL;
+				} break;
+			}
+		} break;
+	}
+	return 0;
+}
+
+struct TextServerAdvanced::GlyphRenderJob {
+	int32_t glyph = 0;
+	Vector2 advance;
+	FT_Render_Mode aa_mode = FT_RENDER_MODE_NORMAL;
+	bool bgra = false;
+	bool msdf = false;
+	bool rendered = false;
+
+	FT_Glyph ft_glyph = nullptr; // Copy of the loaded glyph, replaced by its bitmap once rendered.
+#ifdef MODULE_MSDFGEN_ENABLED
+	msdfgen::Shape *shape = nullptr;
+#endif
+
+	// MSDF output.
+	LocalVector<uint8_t> pixels;
+	Vector2 origin;
+	int width = 0;
+	int height = 0;
+};
+
+struct TextServerAdvanced::GlyphRenderBatch {
+	WorkerThreadPool::GroupID group_id = -1;
+	int pixel_range = 0;
+	LocalVector<GlyphRenderJob> jobs;
+	HashSet<int32_t> glyphs;
+};
+
+void TextServerAdvanced::_render_batch_free(GlyphRenderBatch *p_batch) {
+	if (p_batch->group_id != -1) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(p_batch->group_id);
+	}
+	for (GlyphRenderJob &job : p_batch->jobs) {
+		if (job.ft_glyph) {
+			FT_Done_Glyph(job.ft_glyph);
+		}
+#ifdef MODULE_MSDFGEN_ENABLED
+		if (job.shape) {
+			memdelete(job.shape);
+		}
+#endif
+	}
+	memdelete(p_batch);
+}
+
+void TextServerAdvanced::_render_batch_process(void *p_batch, uint32_t p_index) {
+	GlyphRenderBatch *batch = static_cast<GlyphRenderBatch *>(p_batch);
+	GlyphRenderJob &job = batch->jobs[p_index];
+
+	if (job.msdf) {
+#ifdef MODULE_MSDFGEN_ENABLED
+		msdfgen::Shape &shape = *job.shape;
+		msdfgen::Shape::Bounds bounds = shape.getBounds(batch->pixel_range);
+		if (shape.validate() && shape.contours.size() > 0) {
+			int w = (bounds.r - bounds.l);
+			int h = (bounds.t - bounds.b);
+
+			edgeColoringSimple(shape, 3.0); // Max. angle.
+			msdfgen::Bitmap<float, 4> image(w, h); // Texture size.
+
+			DistancePixelConversion distancePixelConversion(batch->pixel_range);
+			msdfgen::Projection projection(msdfgen::Vector2(1.0, 1.0), msdfgen::Vector2(-bounds.l, -bounds.b));
+			msdfgen::MSDFGeneratorConfig config(true, msdfgen::ErrorCorrectionConfig());
+
+			MSDFThreadData td;
+			td.output = &image;
+			td.shape = &shape;
+			td.projection = &projection;
+			td.distancePixelConversion = &distancePixelConversion;
+
+			// Already on a worker, glyphs are processed in parallel instead of rows.
+			for (int i = 0; i < h; i++) {
+				_generateMTSDF_threaded(&td, i);
+			}
+
+			msdfgen::msdfErrorCorrection(image, shape, projection, batch->pixel_range, config);
+
+			job.pixels.resize(w * h * 4);
+			_msdf_to_rgba8(image, job.pixels.ptr());
+			job.origin = Vector2(bounds.l, bounds.t);
+			job.width = w;
+			job.height = h;
+		}
+		job.rendered = true;
+#endif
+	} else {
+		// The glyph is a standalone copy, FreeType renderers only need the face to be exclusive.
+		if (FT_Glyph_To_Bitmap(&job.ft_glyph, job.aa_mode, nullptr, 1) == 0) {
+			job.height = ((FT_BitmapGlyph)job.ft_glyph)->bitmap.rows;
+			job.rendered = true;
+		}
+	}
+}
+
+void TextServerAdvanced::_render_batch_start(FontAdvanced *p_font_data, FontForSizeAdvanced *p_data, const LocalVector<int32_t> &p_glyphs) const {
+	if (p_data->render_batch) {
+		_render_batch_commit(p_data);
+	}
+	if (!p_data->face) {
+		return;
+	}
+
+	GlyphRenderBatch *batch = memnew(GlyphRenderBatch);
+	batch->pixel_range = p_font_data->msdf_range;
+
+	bool outline = p_data->size.y > 0;
+	FT_Stroker stroker = nullptr;
+	if (outline) {
+		if (FT_Stroker_New(ft_library, &stroker) != 0) {
+			memdelete(batch);
+			ERR_FAIL_MSG("FreeType: Failed to load glyph stroker.");
+		}
+		FT_Stroker_Set(stroker, (int)(p_data->size.y * p_data->oversampling * 16.0), FT_STROKER_LINECAP_BUTT, FT_STROKER_LINEJOIN_ROUND, 0);
+	}
+
+	// Loading uses the shared face, so it stays on this thread. Only the rasterization is deferred.
+	for (const int32_t &glyph : p_glyphs) {
+		if ((glyph & 0xffffff) == 0 || p_data->glyph_map.has(glyph) || batch->glyphs.has(glyph)) {
+			continue;
+		}
+
+		GlyphRenderJob job;
+		job.glyph = glyph;
+		Vector2 advance;
+		if (_load_glyph(p_font_data, p_data, glyph, job.aa_mode, job.bgra, advance) != 0) {
+			p_data->glyph_map[glyph] = FontGlyph();
+			continue;
+		}
+
+		if (!outline && p_font_data->msdf) {
+#ifdef MODULE_MSDFGEN_ENABLED
+			job.msdf = true;
+			job.advance = advance;
+			job.shape = memnew(msdfgen::Shape);
+			if (!_msdf_decompose_outline(&p_data->face->glyph->outline, *job.shape)) {
+				memdelete(job.shape);
+				p_data->glyph_map[glyph] = FontGlyph();
+				continue;
+			}
+#else
+			continue; // Reported by _ensure_glyph().
+#endif
+		} else {
+			if (FT_Get_Glyph(p_data->face->glyph, &job.ft_glyph) != 0) {
+				p_data->glyph_map[glyph] = FontGlyph();
+				continue;
+			}
+			if (outline) {
+				if (FT_Glyph_Stroke(&job.ft_glyph, stroker, 1) != 0) {
+					FT_Done_Glyph(job.ft_glyph);
+					p_data->glyph_map[glyph] = FontGlyph();
+					continue;
+				}
+			} else {
+				job.advance = advance;
+			}
+		}
+
+		batch->glyphs.insert(glyph);
+		batch->jobs.push_back(job);
+	}
+
+	if (stroker) {
+		FT_Stroker_Done(stroker);
+	}
+
+	if (batch->jobs.is_empty()) {
+		memdelete(batch);
+		return;
+	}
+	batch->group_id = WorkerThreadPool::get_singleton()->add_native_group_task(&TextServerAdvanced::_render_batch_process, batch, batch->jobs.size(), -1, false, String("FontServerRenderGlyphs"));
+	p_data->render_batch = batch;
+}
+
+bool TextServerAdvanced::_render_batch_should_commit(const GlyphRenderBatch *p_batch, int32_t p_glyph) {
+	return p_batch->glyphs.has(p_glyph) || WorkerThreadPool::get_singleton()->is_group_task_completed(p_batch->group_id);
+}
+
+void TextServerAdvanced::_render_batch_commit(FontForSizeAdvanced *p_data) const {
+	GlyphRenderBatch *batch = p_data->render_batch;
+	p_data->render_batch = nullptr;
+
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(batch->group_id);
+	batch->group_id = -1;
+
+	// Pack the tallest glyphs first, it leaves less unused space on the atlas shelves.
+	struct JobOrder {
+		int height = 0;
+		uint32_t index = 0;
+		bool operator<(const JobOrder &p_other) const { return height > p_other.height; }
+	};
+	LocalVector<JobOrder> order;
+	order.resize(batch->jobs.size());
+	for (uint32_t i = 0; i < order.size(); i++) {
+		order[i].height = batch->jobs[i].height;
+		order[i].index = i;
+	}
+	order.sort();
+
+	for (const JobOrder &E : order) {
+		const GlyphRenderJob &job = batch->jobs[E.index];
+		if (p_data->glyph_map.has(job.glyph)) {
+			continue; // Already rendered on demand.
+		}
+		FontGlyph gl;
+		if (job.rendered) {
+			if (job.msdf) {
+#ifdef MODULE_MSDFGEN_ENABLED
+				if (job.width > 0 && job.height > 0) {
+					gl = _store_msdf_glyph(p_data, rect_range, job.pixels.ptr(), job.width, job.height, job.origin, job.advance);
+				} else {
+					gl.found = true;
+					gl.advance = job.advance;
+				}
+#endif
+			} else {
+				FT_BitmapGlyph glyph_bitmap = (FT_BitmapGlyph)job.ft_glyph;
+				gl = rasterize_bitmap(p_data, rect_range, glyph_bitmap->bitmap, glyph_bitmap->top, glyph_bitmap->left, job.advance, job.bgra);
+			}
+		}
+		p_data->glyph_map[job.glyph] = gl;
+	}
+
+	_render_batch_free(batch);
+}
+#endif
+
 _FORCE_INLINE_ bool TextServerAdvanced::_ensure_glyph(FontAdvanced *p_font_data, const Vector2i &p_size, int32_t p_glyph) const {
 	ERR_FAIL_COND_V(!_ensure_cache_for_size(p_font_data, p_size), false);
 
 	int32_t glyph_index = p_glyph & 0xffffff; // Remove subpixel shifts.
 
 	FontForSizeAdvanced *fd = p_font_data->cache[p_size];
+#ifdef MODULE_FREETYPE_ENABLED
+	if (unlikely(fd->render_batch != nullptr) && _render_batch_should_commit(fd->render_batch, p_glyph)) {
+		_render_batch_commit(fd);
+	}
+#endif
 	if (fd->glyph_map.has(p_glyph)) {
 		return fd->glyph_map[p_glyph].found;
 	}
@@ -1181,94 +1573,17 @@ _FORCE_INLINE_ bool TextServerAdvanced::_ensure_glyph(FontAdvanced *p_font_data,
 #ifdef MODULE_FREETYPE_ENABLED
 	FontGlyph gl;
 	if (fd->face) {
-		FT_Int32 flags = FT_LOAD_DEFAULT;
-
 		bool outline = p_size.y > 0;
-		switch (p_font_data->hinting) {
-			case TextServer::HINTING_NONE:
-				flags |= FT_LOAD_NO_HINTING;
-				break;
-			case TextServer::HINTING_LIGHT:
-				flags |= FT_LOAD_TARGET_LIGHT;
-				break;
-			default:
-				flags |= FT_LOAD_TARGET_NORMAL;
-				break;
-		}
-		if (p_font_data->force_autohinter) {
-			flags |= FT_LOAD_FORCE_AUTOHINT;
-		}
-		if (outline) {
-			flags |= FT_LOAD_NO_BITMAP;
-		} else if (FT_HAS_COLOR(fd->face)) {
-			flags |= FT_LOAD_COLOR;
-		}
-
-		FT_Fixed v, h;
-		FT_Get_Advance(fd->face, glyph_index, flags, &h);
-		FT_Get_Advance(fd->face, glyph_index, flags | FT_LOAD_VERTICAL_LAYOUT, &v);
+		FT_Render_Mode aa_mode = FT_RENDER_MODE_NORMAL;
+		bool bgra = false;
+		Vector2 advance;
 
-		int error = FT_Load_Glyph(fd->face, glyph_index, flags);
+		int error = _load_glyph(p_font_data, fd, p_glyph, aa_mode, bgra, advance);
 		if (error) {
 			fd->glyph_map[p_glyph] = FontGlyph();
 			return false;
 		}
 
-		if (!p_font_data->msdf) {
-			if ((p_font_data->subpixel_positioning == SUBPIXEL_POSITIONING_ONE_QUARTER) || (p_font_data->subpixel_positioning == SUBPIXEL_POSITIONING_AUTO && p_size.x <= SUBPIXEL_POSITIONING_ONE_QUARTER_MAX_SIZE)) {
-				FT_Pos xshift = (int)((p_glyph >> 27) & 3) << 4;
-				FT_Outline_Translate(&fd->face->glyph->outline, xshift, 0);
-			} else if ((p_font_data->subpixel_positioning == SUBPIXEL_POSITIONING_ONE_HALF) || (p_font_data->subpixel_positioning == SUBPIXEL_POSITIONING_AUTO && p_size.x <= SUBPIXEL_POSITIONING_ONE_HALF_MAX_SIZE)) {
-				FT_Pos xshift = (int)((p_glyph >> 27) & 3) << 5;
-				FT_Outline_Translate(&fd->face->glyph->outline, xshift, 0);
-			}
-		}
-
-		if (p_font_data->embolden != 0.f) {
-			FT_Pos strength = p_font_data->embolden * p_size.x * 4; // 26.6 fractional units (1 / 64).
-			FT_Outline_Embolden(&fd->face->glyph->outline, strength);
-		}
-
-		if (p_font_data->transform != Transform2D()) {
-			FT_Matrix mat = { FT_Fixed(p_font_data->transform[0][0] * 65536), FT_Fixed(p_font_data->transform[0][1] * 65536), FT_Fixed(p_font_data->transform[1][0] * 65536), FT_Fixed(p_font_data->transform[1][1] * 65536) }; // 16.16 fractional units (1 / 65536).
-			FT_Outline_Transform(&fd->face->glyph->outline, &mat);
-		}
-
-		FT_Render_Mode aa_mode = FT_RENDER_MODE_NORMAL;
-		bool bgra = false;
-		switch (p_font_data->antialiasing) {
-			case FONT_ANTIALIASING_NONE: {
-				aa_mode = FT_RENDER_MODE_MONO;
-			} break;
-			case FONT_ANTIALIASING_GRAY: {
-				aa_mode = FT_RENDER_MODE_NORMAL;
-			} break;
-			case FONT_ANTIALIASING_LCD: {
-				int aa_layout = (int)((p_glyph >> 24) & 7);
-				switch (aa_layout) {
-					case FONT_LCD_SUBPIXEL_LAYOUT_HRGB: {
-						aa_mode = FT_RENDER_MODE_LCD;
-						bgra = false;
-					} break;
-					case FONT_LCD_SUBPIXEL_LAYOUT_HBGR: {
-						aa_mode = FT_RENDER_MODE_LCD;
-						bgra = true;
-					} break;
-					case FONT_LCD_SUBPIXEL_LAYOUT_VRGB: {
-						aa_mode = FT_RENDER_MODE_LCD_V;
-						bgra = false;
-					} break;
-					case FONT_LCD_SUBPIXEL_LAYOUT_VBGR: {
-						aa_mode = FT_RENDER_MODE_LCD_V;
-						bgra = true;
-					} break;
-					default: {
-						aa_mode = FT_RENDER_MODE_NORMAL;
-					} break;
-				}
-			} break;
-		}
-
 		if (!outline) {
 			if (!p_font_data->msdf) {
 				error = FT_Render_Glyph(fd->face->glyph, aa_mode);
@@ -1277,13 +1592,13 @@ _FORCE_INLINE_ bool TextServerAdvanced::_ensure_glyph(FontAdvanced *p_font_data,
 			if (!error) {
 				if (p_font_data->msdf) {
 #ifdef MODULE_MSDFGEN_ENABLED
-					gl = rasterize_msdf(p_font_data, fd, p_font_data->msdf_range, rect_range, &slot->outline, Vector2((h + (1 << 9)) >> 10, (v + (1 << 9)) >> 10) / 64.0);
+					gl = rasterize_msdf(p_font_data, fd, p_font_data->msdf_range, rect_range, &slot->outline, advance);
 #else
 					fd->glyph_map[p_glyph] = FontGlyph();
 					ERR_FAIL_V_MSG(false, "Compiled without MSDFGEN support!");
 #endif
 				} else {
-					gl = rasterize_bitmap(fd, rect_range, slot->bitmap, slot->bitmap_top, slot->bitmap_left, Vector2((h + (1 << 9)) >> 10, (v + (1 << 9)) >> 10) / 64.0, bgra);
+					gl = rasterize_bitmap(fd, rect_range, slot->bitmap, slot->bitmap_top, slot->bitmap_left, advance, bgra);
 				}
 			}
 		} else {
@@ -1857,6 +2172,7 @@ void TextServerAdvanced::_font_set_data(const RID &p_font_rid, const PackedByteA
 	ERR_FAIL_NULL(fd);
 
 	MutexLock lock(fd->mutex);
+	_shaping_cache_invalidate();
 	_font_clear_cache(fd);
 	fd->data = p_data;
 	fd->data_ptr = fd->data.ptr();
@@ -1868,6 +2184,7 @@ void TextServerAdvanced::_font_set_data_ptr(const RID &p_font_rid, const uint8_t
 	ERR_FAIL_NULL(fd);
 
 	MutexLock lock(fd->mutex);
+	_shaping_cache_invalidate();
 	_font_clear_cache(fd);
 	fd->data.resize(0);
 	fd->data_ptr = p_data_ptr;
@@ -1883,6 +2200,7 @@ void TextServerAdvanced::_font_set_face_index(const RID &p_font_rid, int64_t p_f
 
 	MutexLock lock(fd->mutex);
 	if (fd->face_index != p_face_index) {
+		_shaping_cache_invalidate();
 		fd->face_index = p_face_index;
 		_font_clear_cache(fd);
 	}
@@ -1949,7 +2267,10 @@ void TextServerAdvanced::_font_set_style(const RID &p_font_rid, BitField<FontSty
 	MutexLock lock(fd->mutex);
 	Vector2i size = _get_size(fd, 16);
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
-	fd->style_flags = p_style;
+	if ((int64_t)fd->style_flags != (int64_t)p_style) {
+		_shaping_cache_invalidate();
+		fd->style_flags = p_style;
+	}
 }
 
 BitField<TextServer::FontStyle> TextServerAdvanced::_font_get_style(const RID &p_font_rid) const {
@@ -1969,7 +2290,10 @@ void TextServerAdvanced::_font_set_style_name(const RID &p_font_rid, const Strin
 	MutexLock lock(fd->mutex);
 	Vector2i size = _get_size(fd, 16);
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
-	fd->style_name = p_name;
+	if (fd->style_name != p_name) {
+		_shaping_cache_invalidate();
+		fd->style_name = p_name;
+	}
 }
 
 String TextServerAdvanced::_font_get_style_name(const RID &p_font_rid) const {
@@ -1989,7 +2313,11 @@ void TextServerAdvanced::_font_set_weight(const RID &p_font_rid, int64_t p_weigh
 	MutexLock lock(fd->mutex);
 	Vector2i size = _get_size(fd, 16);
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
-	fd->weight = CLAMP(p_weight, 100, 999);
+	int weight = CLAMP(p_weight, 100, 999);
+	if (fd->weight != weight) {
+		_shaping_cache_invalidate();
+		fd->weight = weight;
+	}
 }
 
 int64_t TextServerAdvanced::_font_get_weight(const RID &p_font_rid) const {
@@ -2009,7 +2337,11 @@ void TextServerAdvanced::_font_set_stretch(const RID &p_font_rid, int64_t p_stre
 	MutexLock lock(fd->mutex);
 	Vector2i size = _get_size(fd, 16);
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
-	fd->stretch = CLAMP(p_stretch, 50, 200);
+	int stretch = CLAMP(p_stretch, 50, 200);
+	if (fd->stretch != stretch) {
+		_shaping_cache_invalidate();
+		fd->stretch = stretch;
+	}
 }
 
 int64_t TextServerAdvanced::_font_get_stretch(const RID &p_font_rid) const {
@@ -2029,7 +2361,10 @@ void TextServerAdvanced::_font_set_name(const RID &p_font_rid, const String &p_n
 	MutexLock lock(fd->mutex);
 	Vector2i size = _get_size(fd, 16);
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
-	fd->font_name = p_name;
+	if (fd->font_name != p_name) {
+		_shaping_cache_invalidate();
+		fd->font_name = p_name;
+	}
 }
 
 String TextServerAdvanced::_font_get_name(const RID &p_font_rid) const {
@@ -2161,6 +2496,7 @@ void TextServerAdvanced::_font_set_antialiasing(const RID &p_font_rid, TextServe
 
 	MutexLock lock(fd->mutex);
 	if (fd->antialiasing != p_antialiasing) {
+		_shaping_cache_invalidate();
 		_font_clear_cache(fd);
 		fd->antialiasing = p_antialiasing;
 	}
@@ -2204,6 +2540,7 @@ void TextServerAdvanced::_font_set_multichannel_signed_distance_field(const RID
 
 	MutexLock lock(fd->mutex);
 	if (fd->msdf != p_msdf) {
+		_shaping_cache_invalidate();
 		_font_clear_cache(fd);
 		fd->msdf = p_msdf;
 	}
@@ -2223,6 +2560,7 @@ void TextServerAdvanced::_font_set_msdf_pixel_range(const RID &p_font_rid, int64
 
 	MutexLock lock(fd->mutex);
 	if (fd->msdf_range != p_msdf_pixel_range) {
+		_shaping_cache_invalidate();
 		_font_clear_cache(fd);
 		fd->msdf_range = p_msdf_pixel_range;
 	}
@@ -2242,6 +2580,7 @@ void TextServerAdvanced::_font_set_msdf_size(const RID &p_font_rid, int64_t p_ms
 
 	MutexLock lock(fd->mutex);
 	if (fd->msdf_source_size != p_msdf_size) {
+		_shaping_cache_invalidate();
 		_font_clear_cache(fd);
 		fd->msdf_source_size = p_msdf_size;
 	}
@@ -2260,7 +2599,10 @@ void TextServerAdvanced::_font_set_fixed_size(const RID &p_font_rid, int64_t p_f
 	ERR_FAIL_NULL(fd);
 
 	MutexLock lock(fd->mutex);
-	fd->fixed_size = p_fixed_size;
+	if (fd->fixed_size != p_fixed_size) {
+		_shaping_cache_invalidate();
+		fd->fixed_size = p_fixed_size;
+	}
 }
 
 int64_t TextServerAdvanced::_font_get_fixed_size(const RID &p_font_rid) const {
@@ -2276,7 +2618,10 @@ void TextServerAdvanced::_font_set_fixed_size_scale_mode(const RID &p_font_rid,
 	ERR_FAIL_NULL(fd);
 
 	MutexLock lock(fd->mutex);
-	fd->fixed_size_scale_mode = p_fixed_size_scale_mode;
+	if (fd->fixed_size_scale_mode != p_fixed_size_scale_mode) {
+		_shaping_cache_invalidate();
+		fd->fixed_size_scale_mode = p_fixed_size_scale_mode;
+	}
 }
 
 TextServer::FixedSizeScaleMode TextServerAdvanced::_font_get_fixed_size_scale_mode(const RID &p_font_rid) const {
@@ -2292,7 +2637,10 @@ void TextServerAdvanced::_font_set_allow_system_fallback(const RID &p_font_rid,
 	ERR_FAIL_NULL(fd);
 
 	MutexLock lock(fd->mutex);
-	fd->allow_system_fallback = p_allow_system_fallback;
+	if (fd->allow_system_fallback != p_allow_system_fallback) {
+		_shaping_cache_invalidate();
+		fd->allow_system_fallback = p_allow_system_fallback;
+	}
 }
 
 bool TextServerAdvanced::_font_is_allow_system_fallback(const RID &p_font_rid) const {
@@ -2309,6 +2657,7 @@ void TextServerAdvanced::_font_set_force_autohinter(const RID &p_font_rid, bool
 
 	MutexLock lock(fd->mutex);
 	if (fd->force_autohinter != p_force_autohinter) {
+		_shaping_cache_invalidate();
 		_font_clear_cache(fd);
 		fd->force_autohinter = p_force_autohinter;
 	}
@@ -2328,6 +2677,7 @@ void TextServerAdvanced::_font_set_hinting(const RID &p_font_rid, TextServer::Hi
 
 	MutexLock lock(fd->mutex);
 	if (fd->hinting != p_hinting) {
+		_shaping_cache_invalidate();
 		_font_clear_cache(fd);
 		fd->hinting = p_hinting;
 	}
@@ -2346,7 +2696,10 @@ void TextServerAdvanced::_font_set_subpixel_positioning(const RID &p_font_rid, T
 	ERR_FAIL_NULL(fd);
 
 	MutexLock lock(fd->mutex);
-	fd->subpixel_positioning = p_subpixel;
+	if (fd->subpixel_positioning != p_subpixel) {
+		_shaping_cache_invalidate();
+		fd->subpixel_positioning = p_subpixel;
+	}
 }
 
 TextServer::SubpixelPositioning TextServerAdvanced::_font_get_subpixel_positioning(const RID &p_font_rid) const {
@@ -2363,6 +2716,7 @@ void TextServerAdvanced::_font_set_embolden(const RID &p_font_rid, double p_stre
 
 	MutexLock lock(fd->mutex);
 	if (fd->embolden != p_strength) {
+		_shaping_cache_invalidate();
 		_font_clear_cache(fd);
 		fd->embolden = p_strength;
 	}
@@ -2381,6 +2735,7 @@ void TextServerAdvanced::_font_set_spacing(const RID &p_font_rid, SpacingType p_
 	FontAdvancedLinkedVariation *fdv = font_var_owner.get_or_null(p_font_rid);
 	if (fdv) {
 		if (fdv->extra_spacing[p_spacing] != p_value) {
+			_shaping_cache_invalidate();
 			fdv->extra_spacing[p_spacing] = p_value;
 		}
 	} else {
@@ -2389,6 +2744,7 @@ void TextServerAdvanced::_font_set_spacing(const RID &p_font_rid, SpacingType p_
 
 		MutexLock lock(fd->mutex);
 		if (fd->extra_spacing[p_spacing] != p_value) {
+			_shaping_cache_invalidate();
 			fd->extra_spacing[p_spacing] = p_value;
 		}
 	}
@@ -2414,6 +2770,7 @@ void TextServerAdvanced::_font_set_transform(const RID &p_font_rid, const Transf
 
 	MutexLock lock(fd->mutex);
 	if (fd->transform != p_transform) {
+		_shaping_cache_invalidate();
 		_font_clear_cache(fd);
 		fd->transform = p_transform;
 	}
@@ -2433,6 +2790,7 @@ void TextServerAdvanced::_font_set_variation_coordinates(const RID &p_font_rid,
 
 	MutexLock lock(fd->mutex);
 	if (!fd->variation_coordinates.recursive_equal(p_variation_coordinates, 1)) {
+		_shaping_cache_invalidate();
 		_font_clear_cache(fd);
 		fd->variation_coordinates = p_variation_coordinates.duplicate();
 	}
@@ -2452,6 +2810,7 @@ void TextServerAdvanced::_font_set_oversampling(const RID &p_font_rid, double p_
 
 	MutexLock lock(fd->mutex);
 	if (fd->oversampling != p_oversampling) {
+		_shaping_cache_invalidate();
 		_font_clear_cache(fd);
 		fd->oversampling = p_oversampling;
 	}
@@ -2482,6 +2841,7 @@ void TextServerAdvanced::_font_clear_size_cache(const RID &p_font_rid) {
 	ERR_FAIL_NULL(fd);
 
 	MutexLock lock(fd->mutex);
+	_shaping_cache_invalidate();
 	MutexLock ftlock(ft_mutex);
 	for (const KeyValue<Vector2i, FontForSizeAdvanced *> &E : fd->cache) {
 		memdelete(E.value);
@@ -2494,6 +2854,7 @@ void TextServerAdvanced::_font_remove_size_cache(const RID &p_font_rid, const Ve
 	ERR_FAIL_NULL(fd);
 
 	MutexLock lock(fd->mutex);
+	_shaping_cache_invalidate();
 	MutexLock ftlock(ft_mutex);
 	if (fd->cache.has(p_size)) {
 		memdelete(fd->cache[p_size]);
@@ -2506,6 +2867,7 @@ void TextServerAdvanced::_font_set_ascent(const RID &p_font_rid, int64_t p_size,
 	ERR_FAIL_NULL(fd);
 
 	MutexLock lock(fd->mutex);
+	_shaping_cache_invalidate();
 	Vector2i size = _get_size(fd, p_size);
 
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
@@ -2537,6 +2899,7 @@ double TextServerAdvanced::_font_get_ascent(const RID &p_font_rid, int64_t p_siz
 void TextServerAdvanced::_font_set_descent(const RID &p_font_rid, int64_t p_size, double p_descent) {
 	FontAdvanced *fd = _get_font_data(p_font_rid);
 	ERR_FAIL_NULL(fd);
+	_shaping_cache_invalidate();
 
 	Vector2i size = _get_size(fd, p_size);
 
@@ -2571,6 +2934,7 @@ void TextServerAdvanced::_font_set_underline_position(const RID &p_font_rid, int
 	ERR_FAIL_NULL(fd);
 
 	MutexLock lock(fd->mutex);
+	_shaping_cache_invalidate();
 	Vector2i size = _get_size(fd, p_size);
 
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
@@ -2604,6 +2968,7 @@ void TextServerAdvanced::_font_set_underline_thickness(const RID &p_font_rid, in
 	ERR_FAIL_NULL(fd);
 
 	MutexLock lock(fd->mutex);
+	_shaping_cache_invalidate();
 	Vector2i size = _get_size(fd, p_size);
 
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
@@ -2637,6 +3002,7 @@ void TextServerAdvanced::_font_set_scale(const RID &p_font_rid, int64_t p_size,
 	ERR_FAIL_NULL(fd);
 
 	MutexLock lock(fd->mutex);
+	_shaping_cache_invalidate();
 	Vector2i size = _get_size(fd, p_size);
 
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
@@ -2678,6 +3044,7 @@ int64_t TextServerAdvanced::_font_get_texture_count(const RID &p_font_rid, const
 	Vector2i size = _get_size_outline(fd, p_size);
 
 	ERR_FAIL_COND_V(!_ensure_cache_for_size(fd, size), 0);
+	_render_batch_flush(fd->cache[size]);
 
 	return fd->cache[size]->textures.size();
 }
@@ -2689,6 +3056,7 @@ void TextServerAdvanced::_font_clear_textures(const RID &p_font_rid, const Vecto
 	Vector2i size = _get_size_outline(fd, p_size);
 
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
+	_render_batch_flush(fd->cache[size]);
 	fd->cache[size]->textures.clear();
 }
 
@@ -2699,6 +3067,7 @@ void TextServerAdvanced::_font_remove_texture(const RID &p_font_rid, const Vecto
 	MutexLock lock(fd->mutex);
 	Vector2i size = _get_size_outline(fd, p_size);
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
+	_render_batch_flush(fd->cache[size]);
 	ERR_FAIL_INDEX(p_texture_index, fd->cache[size]->textures.size());
 
 	fd->cache[size]->textures.remove_at(p_texture_index);
@@ -2712,6 +3081,7 @@ void TextServerAdvanced::_font_set_texture_image(const RID &p_font_rid, const Ve
 	MutexLock lock(fd->mutex);
 	Vector2i size = _get_size_outline(fd, p_size);
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
+	_render_batch_flush(fd->cache[size]);
 	ERR_FAIL_COND(p_texture_index < 0);
 	if (p_texture_index >= fd->cache[size]->textures.size()) {
 		fd->cache[size]->textures.resize(p_texture_index + 1);
@@ -2740,6 +3110,7 @@ Ref<Image> TextServerAdvanced::_font_get_texture_image(const RID &p_font_rid, co
 	MutexLock lock(fd->mutex);
 	Vector2i size = _get_size_outline(fd, p_size);
 	ERR_FAIL_COND_V(!_ensure_cache_for_size(fd, size), Ref<Image>());
+	_render_batch_flush(fd->cache[size]);
 	ERR_FAIL_INDEX_V(p_texture_index, fd->cache[size]->textures.size(), Ref<Image>());
 
 	const ShelfPackTexture &tex = fd->cache[size]->textures[p_texture_index];
@@ -2754,6 +3125,7 @@ void TextServerAdvanced::_font_set_texture_offsets(const RID &p_font_rid, const
 	MutexLock lock(fd->mutex);
 	Vector2i size = _get_size_outline(fd, p_size);
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
+	_render_batch_flush(fd->cache[size]);
 	ERR_FAIL_COND(p_texture_index < 0);
 	if (p_texture_index >= fd->cache[size]->textures.size()) {
 		fd->cache[size]->textures.resize(p_texture_index + 1);
@@ -2773,6 +3145,7 @@ PackedInt32Array TextServerAdvanced::_font_get_texture_offsets(const RID &p_font
 	MutexLock lock(fd->mutex);
 	Vector2i size = _get_size_outline(fd, p_size);
 	ERR_FAIL_COND_V(!_ensure_cache_for_size(fd, size), PackedInt32Array());
+	_render_batch_flush(fd->cache[size]);
 	ERR_FAIL_INDEX_V(p_texture_index, fd->cache[size]->textures.size(), PackedInt32Array());
 
 	const ShelfPackTexture &tex = fd->cache[size]->textures[p_texture_index];
@@ -2798,6 +3171,7 @@ PackedInt32Array TextServerAdvanced::_font_get_glyph_list(const RID &p_font_rid,
 	MutexLock lock(fd->mutex);
 	Vector2i size = _get_size_outline(fd, p_size);
 	ERR_FAIL_COND_V(!_ensure_cache_for_size(fd, size), PackedInt32Array());
+	_render_batch_flush(fd->cache[size]);
 
 	PackedInt32Array ret;
 	const HashMap<int32_t, FontGlyph> &gl = fd->cache[size]->glyph_map;
@@ -2812,8 +3186,10 @@ void TextServerAdvanced::_font_clear_glyphs(const RID &p_font_rid, const Vector2
 	ERR_FAIL_NULL(fd);
 
 	MutexLock lock(fd->mutex);
+	_shaping_cache_invalidate();
 	Vector2i size = _get_size_outline(fd, p_size);
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
+	_render_batch_flush(fd->cache[size]);
 
 	fd->cache[size]->glyph_map.clear();
 }
@@ -2823,8 +3199,10 @@ void TextServerAdvanced::_font_remove_glyph(const RID &p_font_rid, const Vector2
 	ERR_FAIL_NULL(fd);
 
 	MutexLock lock(fd->mutex);
+	_shaping_cache_invalidate();
 	Vector2i size = _get_size_outline(fd, p_size);
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
+	_render_batch_flush(fd->cache[size]);
 
 	fd->cache[size]->glyph_map.erase(p_glyph);
 }
@@ -2892,6 +3270,7 @@ void TextServerAdvanced::_font_set_glyph_advance(const RID &p_font_rid, int64_t
 	ERR_FAIL_NULL(fd);
 
 	MutexLock lock(fd->mutex);
+	_shaping_cache_invalidate();
 	Vector2i size = _get_size(fd, p_size);
 
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
@@ -2943,6 +3322,7 @@ void TextServerAdvanced::_font_set_glyph_offset(const RID &p_font_rid, const Vec
 	ERR_FAIL_NULL(fd);
 
 	MutexLock lock(fd->mutex);
+	_shaping_cache_invalidate();
 	Vector2i size = _get_size_outline(fd, p_size);
 
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
@@ -2994,6 +3374,7 @@ void TextServerAdvanced::_font_set_glyph_size(const RID &p_font_rid, const Vecto
 	ERR_FAIL_NULL(fd);
 
 	MutexLock lock(fd->mutex);
+	_shaping_cache_invalidate();
 	Vector2i size = _get_size_outline(fd, p_size);
 
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
@@ -3253,6 +3634,7 @@ void TextServerAdvanced::_font_clear_kerning_map(const RID &p_font_rid, int64_t
 	ERR_FAIL_NULL(fd);
 
 	MutexLock lock(fd->mutex);
+	_shaping_cache_invalidate();
 	Vector2i size = _get_size(fd, p_size);
 
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
@@ -3264,6 +3646,7 @@ void TextServerAdvanced::_font_remove_kerning(const RID &p_font_rid, int64_t p_s
 	ERR_FAIL_NULL(fd);
 
 	MutexLock lock(fd->mutex);
+	_shaping_cache_invalidate();
 	Vector2i size = _get_size(fd, p_size);
 
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
@@ -3275,6 +3658,7 @@ void TextServerAdvanced::_font_set_kerning(const RID &p_font_rid, int64_t p_size
 	ERR_FAIL_NULL(fd);
 
 	MutexLock lock(fd->mutex);
+	_shaping_cache_invalidate();
 	Vector2i size = _get_size(fd, p_size);
 
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
@@ -3471,6 +3855,45 @@ void TextServerAdvanced::_font_render_range(const RID &p_font_rid, const Vector2
 	}
 }
 
+void TextServerAdvanced::_font_render_range_async(const RID &p_font_rid, const Vector2i &p_size, int64_t p_start, int64_t p_end) {
+	FontAdvanced *fd = _get_font_data(p_font_rid);
+	ERR_FAIL_NULL(fd);
+	ERR_FAIL_COND_MSG((p_start >= 0xd800 && p_start <= 0xdfff) || (p_start > 0x10ffff), "Unicode parsing error: Invalid unicode codepoint " + String::num_int64(p_start, 16) + ".");
+	ERR_FAIL_COND_MSG((p_end >= 0xd800 && p_end <= 0xdfff) || (p_end > 0x10ffff), "Unicode parsing error: Invalid unicode codepoint " + String::num_int64(p_end, 16) + ".");
+
+	MutexLock lock(fd->mutex);
+	Vector2i size = _get_size_outline(fd, p_size);
+	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
+#ifdef MODULE_FREETYPE_ENABLED
+	FontForSizeAdvanced *ffsd = fd->cache[size];
+	if (!ffsd->face) {
+		return;
+	}
+	LocalVector<int32_t> glyphs;
+	for (int64_t i = p_start; i <= p_end; i++) {
+		int32_t idx = FT_Get_Char_Index(ffsd->face, i);
+		if (fd->msdf) {
+			glyphs.push_back(idx);
+		} else {
+			for (int aa = 0; aa < ((fd->antialiasing == FONT_ANTIALIASING_LCD) ? FONT_LCD_SUBPIXEL_LAYOUT_MAX : 1); aa++) {
+				if ((fd->subpixel_positioning == SUBPIXEL_POSITIONING_ONE_QUARTER) || (fd->subpixel_positioning == SUBPIXEL_POSITIONING_AUTO && size.x <= SUBPIXEL_POSITIONING_ONE_QUARTER_MAX_SIZE)) {
+					glyphs.push_back(idx | (0 << 27) | (aa << 24));
+					glyphs.push_back(idx | (1 << 27) | (aa << 24));
+					glyphs.push_back(idx | (2 << 27) | (aa << 24));
+					glyphs.push_back(idx | (3 << 27) | (aa << 24));
+				} else if ((fd->subpixel_positioning == SUBPIXEL_POSITIONING_ONE_HALF) || (fd->subpixel_positioning == SUBPIXEL_POSITIONING_AUTO && size.x <= SUBPIXEL_POSITIONING_ONE_HALF_MAX_SIZE)) {
+					glyphs.push_back(idx | (1 << 27) | (aa << 24));
+					glyphs.push_back(idx | (0 << 27) | (aa << 24));
+				} else {
+					glyphs.push_back(idx | (aa << 24));
+				}
+			}
+		}
+	}
+	_render_batch_start(fd, ffsd, glyphs);
+#endif
+}
+
 void TextServerAdvanced::_font_render_glyph(const RID &p_font_rid, const Vector2i &p_size, int64_t p_index) {
 	FontAdvanced *fd = _get_font_data(p_font_rid);
 	ERR_FAIL_NULL(fd);
@@ -3727,6 +4150,7 @@ void TextServerAdvanced::_font_set_language_support_override(const RID &p_font_r
 	ERR_FAIL_NULL(fd);
 
 	MutexLock lock(fd->mutex);
+	_shaping_cache_invalidate();
 	fd->language_support_overrides[p_language] = p_supported;
 }
 
@@ -3743,6 +4167,7 @@ void TextServerAdvanced::_font_remove_language_support_override(const RID &p_fon
 	ERR_FAIL_NULL(fd);
 
 	MutexLock lock(fd->mutex);
+	_shaping_cache_invalidate();
 	fd->language_support_overrides.erase(p_language);
 }
 
@@ -3777,6 +4202,7 @@ void TextServerAdvanced::_font_set_script_support_override(const RID &p_font_rid
 	ERR_FAIL_NULL(fd);
 
 	MutexLock lock(fd->mutex);
+	_shaping_cache_invalidate();
 	fd->script_support_overrides[p_script] = p_supported;
 }
 
@@ -3793,6 +4219,7 @@ void TextServerAdvanced::_font_remove_script_support_override(const RID &p_font_
 	ERR_FAIL_NULL(fd);
 
 	MutexLock lock(fd->mutex);
+	_shaping_cache_invalidate();
 	fd->script_support_overrides.erase(p_script);
 }
 
@@ -3813,6 +4240,7 @@ void TextServerAdvanced::_font_set_opentype_feature_overrides(const RID &p_font_
 	ERR_FAIL_NULL(fd);
 
 	MutexLock lock(fd->mutex);
+	_shaping_cache_invalidate();
 	Vector2i size = _get_size(fd, 16);
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
 	fd->feature_overrides = p_overrides;
@@ -5972,6 +6400,93 @@ void TextServerAdvanced::_shape_run(ShapedTextDataAdvanced *p_sd, int64_t p_star
 	}
 }
 
+#ifndef GDEXTENSION
+bool TextServerAdvanced::ShapingCacheKey::operator==(const ShapingCacheKey &p_key) const {
+	if (hash_value != p_key.hash_value || start != p_key.start || end != p_key.end || base_para_direction != p_key.base_para_direction || orientation != p_key.orientation || preserve_invalid != p_key.preserve_invalid || preserve_control != p_key.preserve_control) {
+		return false;
+	}
+	for (int i = 0; i < 4; i++) {
+		if (extra_spacing[i] != p_key.extra_spacing[i]) {
+			return false;
+		}
+	}
+	if (text != p_key.text || custom_punct != p_key.custom_punct || locale != p_key.locale || bidi_override != p_key.bidi_override || spans.size() != p_key.spans.size()) {
+		return false;
+	}
+	for (int i = 0; i < spans.size(); i++) {
+		const ShapingCacheSpan &a = spans[i];
+		const ShapingCacheSpan &b = p_key.spans[i];
+		if (a.start != b.start || a.end != b.end || a.font_size != b.font_size || a.language != b.language || a.fonts != b.fonts || a.features != b.features) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool TextServerAdvanced::_shaping_cache_make_key(const ShapedTextDataAdvanced *p_sd, ShapingCacheKey &r_key) const {
+	if (shaping_cache_capacity <= 0 || !p_sd->objects.is_empty()) {
+		return false; // Embedded object rects are set by the caller and aligned during shaping.
+	}
+
+	r_key.text = p_sd->text;
+	r_key.custom_punct = p_sd->custom_punct;
+	r_key.start = p_sd->start;
+	r_key.end = p_sd->end;
+	r_key.base_para_direction = p_sd->base_para_direction;
+	r_key.orientation = p_sd->orientation;
+	r_key.preserve_invalid = p_sd->preserve_invalid;
+	r_key.preserve_control = p_sd->preserve_control;
+	r_key.bidi_override = p_sd->bidi_override;
+
+	uint32_t hash = p_sd->text.hash();
+	hash = hash_murmur3_one_32(p_sd->custom_punct.hash(), hash);
+	hash = hash_murmur3_one_32(p_sd->start, hash);
+	hash = hash_murmur3_one_32(p_sd->end, hash);
+	hash = hash_murmur3_one_32(p_sd->base_para_direction, hash);
+	hash = hash_murmur3_one_32(((int)p_sd->orientation) | ((int)p_sd->preserve_invalid << 1) | ((int)p_sd->preserve_control << 2), hash);
+	for (int i = 0; i < 4; i++) {
+		r_key.extra_spacing[i] = p_sd->extra_spacing[i];
+		hash = hash_murmur3_one_32(p_sd->extra_spacing[i], hash);
+	}
+	for (const Vector3i &E : p_sd->bidi_override) {
+		hash = hash_murmur3_one_32(E.x, hash);
+		hash = hash_murmur3_one_32(E.y, hash);
+		hash = hash_murmur3_one_32(E.z, hash);
+	}
+
+	bool needs_locale = false;
+	r_key.spans.resize(p_sd->spans.size());
+	ShapingCacheSpan *spans_w = r_key.spans.ptrw();
+	for (int i = 0; i < p_sd->spans.size(); i++) {
+		const ShapedTextDataAdvanced::Span &span = p_sd->spans[i];
+		if (span.embedded_key != Variant()) {
+			return false;
+		}
+		spans_w[i].start = span.start;
+		spans_w[i].end = span.end;
+		spans_w[i].fonts = span.fonts;
+		spans_w[i].font_size = span.font_size;
+		spans_w[i].language = span.language;
+		spans_w[i].features = span.features;
+		needs_locale = needs_locale || span.language.is_empty();
+
+		hash = hash_murmur3_one_32(span.start, hash);
+		hash = hash_murmur3_one_32(span.end, hash);
+		hash = hash_murmur3_one_32(span.fonts.hash(), hash);
+		hash = hash_murmur3_one_32(span.font_size, hash);
+		hash = hash_murmur3_one_32(span.language.hash(), hash);
+		hash = hash_murmur3_one_32(span.features.hash(), hash);
+	}
+	if (needs_locale) {
+		r_key.locale = TranslationServer::get_singleton()->get_tool_locale();
+		hash = hash_murmur3_one_32(r_key.locale.hash(), hash);
+	}
+	r_key.hash_value = hash_fmix32(hash);
+
+	return true;
+}
+#endif
+
 bool TextServerAdvanced::_shaped_text_shape(const RID &p_shaped) {
 	_THREAD_SAFE_METHOD_
 	ShapedTextDataAdvanced *sd = shaped_owner.get_or_null(p_shaped);
@@ -6034,6 +6549,28 @@ bool TextServerAdvanced::_shaped_text_shape(const RID &p_shaped) {
 		sd->bidi_override.push_back(Vector3i(sd->start, sd->end, DIRECTION_INHERITED));
 	}
 
+	bool shaping_cached = false;
+#ifndef GDEXTENSION
+	ShapingCacheKey shaping_key;
+	bool shaping_cacheable = _shaping_cache_make_key(sd, shaping_key);
+	uint64_t font_generation = shaping_cache_font_generation.get();
+	if (shaping_cacheable) {
+		const ShapingCacheEntry *entry = shaping_cache.getptr(shaping_key);
+		if (entry && entry->font_generation == font_generation) {
+			sd->glyphs = entry->glyphs;
+			sd->ascent = entry->ascent;
+			sd->descent = entry->descent;
+			sd->width = entry->width;
+			sd->upos = entry->upos;
+			sd->uthk = entry->uthk;
+			shaping_cached = true;
+			shaping_cache_hits.increment();
+		} else {
+			shaping_cache_misses.increment();
+		}
+	}
+#endif
+
 	for (int ov = 0; ov < sd->bidi_override.size(); ov++) {
 		// Create BiDi iterator.
 		int start = _convert_pos_inv(sd, sd->bidi_override[ov].x - sd->start);
@@ -6075,6 +6612,9 @@ bool TextServerAdvanced::_shaped_text_shape(const RID &p_shaped) {
 			ERR_PRINT(vformat("BiDi iterator allocation for the paragraph failed: %s", u_errorName(err)));
 		}
 		sd->bidi_iter.push_back(bidi_iter);
+		if (shaping_cached) {
+			continue; // BiDi iterators are still used by the substrings.
+		}
 
 		err = U_ZERO_ERROR;
 		int bidi_run_count = 1;
@@ -6184,6 +6724,20 @@ bool TextServerAdvanced::_shaped_text_shape(const RID &p_shaped) {
 		}
 	}
 
+#ifndef GDEXTENSION
+	if (shaping_cacheable && !shaping_cached) {
+		ShapingCacheEntry entry;
+		entry.font_generation = font_generation;
+		entry.glyphs = sd->glyphs;
+		entry.ascent = sd->ascent;
+		entry.descent = sd->descent;
+		entry.width = sd->width;
+		entry.upos = sd->upos;
+		entry.uthk = sd->uthk;
+		shaping_cache.insert(shaping_key, entry);
+	}
+#endif
+
 	_realign(sd);
 	sd->valid = true;
 	return sd->valid;
@@ -7069,6 +7623,9 @@ TextServerAdvanced::TextServerAdvanced() {
 	_insert_num_systems_lang();
 	_insert_feature_sets();
 	_bmp_create_font_funcs();
+#ifndef GDEXTENSION
+	shaping_cache.set_capacity(shaping_cache_capacity);
+#endif
 }
 
 void TextServerAdvanced::_cleanup() {
@@ -7081,6 +7638,9 @@ void TextServerAdvanced::_cleanup() {
 	}
 	system_fonts.clear();
 	system_font_data.clear();
+#ifndef GDEXTENSION
+	shaping_cache.clear();
+#endif
 }
 
 TextServerAdvanced::~TextServerAdvanced() {
@@ -73,6 +73,7 @@
 
 #include <godot_cpp/templates/hash_map.hpp>
 #include <godot_cpp/templates/hash_set.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
 #include <godot_cpp/templates/rid_owner.hpp>
 #include <godot_cpp/templates/vector.hpp>
 
@@ -84,7 +85,10 @@ using namespace godot;
 #include "core/extension/ext_wrappers.gen.inc"
 #include "core/object/worker_thread_pool.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/lru.h"
 #include "core/templates/rid_owner.h"
+#include "core/templates/safe_refcount.h"
 #include "scene/resources/image_texture.h"
 #include "servers/text/text_server_extension.h"
 
@@ -260,6 +264,13 @@ class TextServerAdvanced : public TextServerExtension {
 		Vector2 advance;
 	};
 
+#ifdef MODULE_FREETYPE_ENABLED
+	// Glyphs rasterized on the WorkerThreadPool, see font_render_range_async().
+	struct GlyphRenderJob;
+	struct GlyphRenderBatch;
+	static void _render_batch_free(GlyphRenderBatch *p_batch);
+#endif
+
 	struct FontForSizeAdvanced {
 		double ascent = 0.0;
 		double descent = 0.0;
@@ -279,6 +290,7 @@ class TextServerAdvanced : public TextServerExtension {
 #ifdef MODULE_FREETYPE_ENABLED
 		FT_Face face = nullptr;
 		FT_StreamRec stream;
+		GlyphRenderBatch *render_batch = nullptr; // Committed to the atlas on the next access to one of its glyphs.
 #endif
 
 		~FontForSizeAdvanced() {
@@ -286,6 +298,9 @@ class TextServerAdvanced : public TextServerExtension {
 				hb_font_destroy(hb_handle);
 			}
 #ifdef MODULE_FREETYPE_ENABLED
+			if (render_batch != nullptr) {
+				_render_batch_free(render_batch);
+			}
 			if (face != nullptr) {
 				FT_Done_Face(face);
 			}
@@ -351,11 +366,24 @@ class TextServerAdvanced : public TextServerExtension {
 
 	_FORCE_INLINE_ FontTexturePosition find_texture_pos_for_glyph(FontForSizeAdvanced *p_data, int p_color_size, Image::Format p_image_format, int p_width, int p_height, bool p_msdf) const;
 #ifdef MODULE_MSDFGEN_ENABLED
+	_FORCE_INLINE_ FontGlyph _store_msdf_glyph(FontForSizeAdvanced *p_data, int p_rect_margin, const uint8_t *p_pixels, int p_width, int p_height, const Vector2 &p_origin, const Vector2 &p_advance) const;
 	_FORCE_INLINE_ FontGlyph rasterize_msdf(FontAdvanced *p_font_data, FontForSizeAdvanced *p_data, int p_pixel_range, int p_rect_margin, FT_Outline *outline, const Vector2 &advance) const;
 #endif
 #ifdef MODULE_FREETYPE_ENABLED
 	_FORCE_INLINE_ FontGlyph rasterize_bitmap(FontForSizeAdvanced *p_data, int p_rect_margin, FT_Bitmap bitmap, int yofs, int xofs, const Vector2 &advance, bool p_bgra) const;
+	_FORCE_INLINE_ int _load_glyph(FontAdvanced *p_font_data, FontForSizeAdvanced *p_data, int32_t p_glyph, FT_Render_Mode &r_aa_mode, bool &r_bgra, Vector2 &r_advance) const;
+	void _render_batch_start(FontAdvanced *p_font_data, FontForSizeAdvanced *p_data, const LocalVector<int32_t> &p_glyphs) const;
+	static void _render_batch_process(void *p_batch, uint32_t p_index);
+	static bool _render_batch_should_commit(const GlyphRenderBatch *p_batch, int32_t p_glyph);
+	void _render_batch_commit(FontForSizeAdvanced *p_data) const;
 #endif
+	_FORCE_INLINE_ void _render_batch_flush(FontForSizeAdvanced *p_data) const {
+#ifdef MODULE_FREETYPE_ENABLED
+		if (p_data->render_batch) {
+			_render_batch_commit(p_data);
+		}
+#endif
+	}
 	_FORCE_INLINE_ bool _ensure_glyph(FontAdvanced *p_font_data, const Vector2i &p_size, int32_t p_glyph) const;
 	_FORCE_INLINE_ bool _ensure_cache_for_size(FontAdvanced *p_font_data, const Vector2i &p_size) const;
 	_FORCE_INLINE_ void _font_clear_cache(FontAdvanced *p_font_data);
@@ -638,6 +666,63 @@ class TextServerAdvanced : public TextServerExtension {
 	mutable HashMap<SystemFontKey, SystemFontCache, SystemFontKeyHasher> system_fonts;
 	mutable HashMap<String, PackedByteArray> system_font_data;
 
+#ifndef GDEXTENSION
+	// Shaping results of the whole paragraphs, shared by all buffers with the same source data.
+	struct ShapingCacheSpan {
+		int start = -1;
+		int end = -1;
+		Array fonts;
+		int font_size = 0;
+		String language;
+		Dictionary features;
+	};
+
+	struct ShapingCacheKey {
+		String text;
+		String custom_punct;
+		String locale; // Used by the spans without language.
+		int start = 0;
+		int end = 0;
+		int base_para_direction = UBIDI_DEFAULT_LTR;
+		TextServer::Orientation orientation = ORIENTATION_HORIZONTAL;
+		bool preserve_invalid = true;
+		bool preserve_control = false;
+		int extra_spacing[4] = { 0, 0, 0, 0 };
+		Vector<Vector3i> bidi_override;
+		Vector<ShapingCacheSpan> spans;
+		uint32_t hash_value = 0;
+
+		_FORCE_INLINE_ uint32_t hash() const { return hash_value; }
+		bool operator==(const ShapingCacheKey &p_key) const;
+	};
+
+	struct ShapingCacheEntry {
+		uint64_t font_generation = 0; // Entries shaped before the last font change are stale.
+		Vector<Glyph> glyphs;
+		double ascent = 0.0;
+		double descent = 0.0;
+		double width = 0.0;
+		double upos = 0.0;
+		double uthk = 0.0;
+	};
+
+	static const int64_t SHAPING_CACHE_DEFAULT_CAPACITY = 4096;
+
+	LRUCache<ShapingCacheKey, ShapingCacheEntry, HashableHasher<ShapingCacheKey>> shaping_cache;
+	int64_t shaping_cache_capacity = SHAPING_CACHE_DEFAULT_CAPACITY;
+	SafeNumeric<uint64_t> shaping_cache_hits;
+	SafeNumeric<uint64_t> shaping_cache_misses;
+	SafeNumeric<uint64_t> shaping_cache_font_generation;
+
+	bool _shaping_cache_make_key(const ShapedTextDataAdvanced *p_sd, ShapingCacheKey &r_key) const;
+#endif
+
+	_FORCE_INLINE_ void _shaping_cache_invalidate() {
+#ifndef GDEXTENSION
+		shaping_cache_font_generation.increment();
+#endif
+	}
+
 	void _update_chars(ShapedTextDataAdvanced *p_sd) const;
 	void _realign(ShapedTextDataAdvanced *p_sd) const;
 	int64_t _convert_pos(const String &p_utf32, const Char16String &p_utf16, int64_t p_pos) const;
@@ -717,6 +802,11 @@ public:
 	MODBIND1RC(int64_t, name_to_tag, const String &);
 	MODBIND1RC(String, tag_to_name, int64_t);
 
+	MODBIND0RC(int64_t, shaping_cache_get_hit_count);
+	MODBIND0RC(int64_t, shaping_cache_get_miss_count);
+	MODBIND1(shaping_cache_set_capacity, int64_t);
+	MODBIND0RC(int64_t, shaping_cache_get_capacity);
+
 	/* Font interface */
 
 	MODBIND0R(RID, create_font);
@@ -861,6 +951,7 @@ public:
 	MODBIND1RC(String, font_get_supported_chars, const RID &);
 
 	MODBIND4(font_render_range, const RID &, const Vector2i &, int64_t, int64_t);
+	MODBIND4(font_render_range_async, const RID &, const Vector2i &, int64_t, int64_t);
 	MODBIND3(font_render_glyph, const RID &, const Vector2i &, int64_t);
 
 	MODBIND6C(font_draw_glyph, const RID &, const RID &, int64_t, const Vector2 &, int64_t, const Color &);
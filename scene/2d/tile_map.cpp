@@ -33,6 +33,10 @@
 
 #include "core/core_string_names.h"
 #include "core/io/marshalls.h"
+#include "core/object/worker_thread_pool.h"
+#include "scene/resources/compressed_texture.h"
+#include "scene/resources/image_texture.h"
+#include "scene/resources/portable_compressed_texture.h"
 #include "scene/resources/world_2d.h"
 #include "servers/navigation_server_2d.h"
 
@@ -265,6 +269,11 @@ void TileMapLayer::_rendering_update() {
 		}
 
 		// Update all dirty quadrants.
+		RenderingQuadrantsRebuild rebuild;
+		rebuild.tile_set = tile_set;
+		rebuild.y_sorted = tile_map_node->is_y_sort_enabled() && is_y_sort_enabled();
+		rebuild.self_modulate = tile_map_node->get_self_modulate();
+
 		for (SelfList<RenderingQuadrant> *quadrant_list_element = dirty_rendering_quadrant_list.first(); quadrant_list_element;) {
 			SelfList<RenderingQuadrant> *next_quadrant_list_element = quadrant_list_element->next(); // "Hack" to clear the list while iterating.
 
@@ -281,16 +290,52 @@ void TileMapLayer::_rendering_update() {
 			}
 
 			if (has_a_tile) {
-				// Process the quadrant.
-
-				// First, clear the quadrant's canvas items.
+				// Clear the quadrant's canvas items, then queue it to be redrawn.
 				for (RID &ci : rendering_quadrant->canvas_items) {
 					rs->free(ci);
 				}
 				rendering_quadrant->canvas_items.clear();
+				rebuild.quadrants.push_back(rendering_quadrant.ptr());
+			} else {
+				// Free the quadrant.
+				for (int i = 0; i < rendering_quadrant->canvas_items.size(); i++) {
+					const RID &ci = rendering_quadrant->canvas_items[i];
+					if (ci.is_valid()) {
+						rs->free(ci);
+					}
+				}
+				rendering_quadrant->cells.clear();
+				rendering_quadrant_map.erase(rendering_quadrant->quadrant_coords);
+			}
+
+			quadrant_list_element = next_quadrant_list_element;
+		}
 
+		if (_rendering_get_source_textures(tile_set, rebuild.source_textures)) {
+			// Draw the quadrants into command buffers on worker threads. Only the canvas items are created here.
+			if (rebuild.quadrants.size() >= PARALLEL_UPDATE_MIN_QUADRANTS) {
+				WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &TileMapLayer::_rendering_quadrant_build_commands, &rebuild, rebuild.quadrants.size(), -1, true);
+				WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+			} else {
+				for (uint32_t i = 0; i < rebuild.quadrants.size(); i++) {
+					_rendering_quadrant_build_commands(i, &rebuild);
+				}
+			}
+
+			for (RenderingQuadrant *rendering_quadrant : rebuild.quadrants) {
+				for (RenderingQuadrant::CanvasItemBatch &batch : rendering_quadrant->pending_batches) {
+					RID ci = _rendering_quadrant_create_canvas_item(rendering_quadrant, batch.material, batch.z_index);
+					if (!batch.commands.is_empty()) {
+						rs->canvas_item_add_command_buffer(ci, batch.commands.to_byte_array());
+					}
+				}
+				rendering_quadrant->pending_batches.clear();
+			}
+		} else {
+			// Some textures have their own drawing code, so draw through them on the main thread.
+			for (RenderingQuadrant *rendering_quadrant : rebuild.quadrants) {
 				// Sort the quadrant cells.
-				if (tile_map_node->is_y_sort_enabled() && is_y_sort_enabled()) {
+				if (rebuild.y_sorted) {
 					// For compatibility reasons, we use another comparator for Y-sorted layers.
 					rendering_quadrant->cells.sort_custom<CellDataYSortedComparator>();
 				} else {
@@ -318,32 +363,16 @@ void TileMapLayer::_rendering_update() {
 					Ref<Material> mat = tile_data->get_material();
 					int tile_z_index = tile_data->get_z_index();
 
-					// Quandrant pos.
-
 					// --- CanvasItems ---
 					RID ci;
 
 					// Check if the material or the z_index changed.
 					if (prev_ci == RID() || prev_material != mat || prev_z_index != tile_z_index) {
 						// If so, create a new CanvasItem.
-						ci = rs->canvas_item_create();
-						if (mat.is_valid()) {
-							rs->canvas_item_set_material(ci, mat->get_rid());
-						}
-						rs->canvas_item_set_parent(ci, canvas_item);
-						rs->canvas_item_set_use_parent_material(ci, tile_map_node->get_use_parent_material() || tile_map_node->get_material().is_valid());
-
-						Transform2D xform(0, rendering_quadrant->canvas_items_position);
-						rs->canvas_item_set_transform(ci, xform);
-
-						rs->canvas_item_set_light_mask(ci, tile_map_node->get_light_mask());
-						rs->canvas_item_set_z_as_relative_to_parent(ci, true);
-						rs->canvas_item_set_z_index(ci, tile_z_index);
+						ci = _rendering_quadrant_create_canvas_item(rendering_quadrant, mat, tile_z_index);
 
-						rs->canvas_item_set_default_texture_filter(ci, RS::CanvasItemTextureFilter(tile_map_node->get_texture_filter_in_tree()));
-						rs->canvas_item_set_default_texture_repeat(ci, RS::CanvasItemTextureRepeat(tile_map_node->get_texture_repeat_in_tree()));
-
-						rendering_quadrant->canvas_items.push_back(ci);
+						// Tiles are submitted to the server as a single command buffer per canvas item.
+						rs->canvas_item_begin_command_buffer(ci);
 
 						prev_ci = ci;
 						prev_material = mat;
@@ -366,21 +395,10 @@ void TileMapLayer::_rendering_update() {
 					}
 
 					// Drawing the tile in the canvas item.
-					tile_map_node->draw_tile(ci, local_tile_pos - rendering_quadrant->canvas_items_position, tile_set, cell_data.cell.source_id, cell_data.cell.get_atlas_coords(), cell_data.cell.alternative_tile, -1, tile_map_node->get_self_modulate(), tile_data, random_animation_offset);
+					tile_map_node->draw_tile(ci, local_tile_pos - rendering_quadrant->canvas_items_position, tile_set, cell_data.cell.source_id, cell_data.cell.get_atlas_coords(), cell_data.cell.alternative_tile, -1, rebuild.self_modulate, tile_data, random_animation_offset);
 				}
-			} else {
-				// Free the quadrant.
-				for (int i = 0; i < rendering_quadrant->canvas_items.size(); i++) {
-					const RID &ci = rendering_quadrant->canvas_items[i];
-					if (ci.is_valid()) {
-						rs->free(ci);
-					}
-				}
-				rendering_quadrant->cells.clear();
-				rendering_quadrant_map.erase(rendering_quadrant->quadrant_coords);
+				rs->canvas_item_end_command_buffer();
 			}
-
-			quadrant_list_element = next_quadrant_list_element;
 		}
 
 		dirty_rendering_quadrant_list.clear();
@@ -459,6 +477,108 @@ void TileMapLayer::_rendering_update() {
 	_rendering_was_cleaned_up = forced_cleanup;
 }
 
+bool TileMapLayer::_rendering_get_source_textures(const Ref<TileSet> &p_tile_set, HashMap<int, RID> &r_source_textures) const {
+	// Quadrants can only be drawn off the main thread if all textures are drawn as a plain texture rect region.
+	for (int i = 0; i < p_tile_set->get_source_count(); i++) {
+		int source_id = p_tile_set->get_source_id(i);
+		const TileSetAtlasSource *atlas_source = Object::cast_to<TileSetAtlasSource>(*p_tile_set->get_source(source_id));
+		if (!atlas_source) {
+			continue;
+		}
+
+		Ref<Texture2D> tex = atlas_source->get_runtime_texture();
+		if (tex.is_null()) {
+			r_source_textures[source_id] = RID();
+			continue;
+		}
+		if (!Object::cast_to<ImageTexture>(*tex) && !Object::cast_to<CompressedTexture2D>(*tex) && !Object::cast_to<PortableCompressedTexture2D>(*tex)) {
+			return false;
+		}
+		// Those textures draw nothing while empty.
+		r_source_textures[source_id] = (tex->get_width() > 0 && tex->get_height() > 0) ? tex->get_rid() : RID();
+	}
+	return true;
+}
+
+void TileMapLayer::_rendering_quadrant_build_commands(uint32_t p_index, RenderingQuadrantsRebuild *p_rebuild) {
+	RenderingQuadrant *rendering_quadrant = p_rebuild->quadrants[p_index];
+	const Ref<TileSet> &tile_set = p_rebuild->tile_set;
+
+	// Sort the quadrant cells.
+	if (p_rebuild->y_sorted) {
+		// For compatibility reasons, we use another comparator for Y-sorted layers.
+		rendering_quadrant->cells.sort_custom<CellDataYSortedComparator>();
+	} else {
+		rendering_quadrant->cells.sort();
+	}
+
+	// Group cells per material and z-index, one canvas item each.
+	LocalVector<RenderingQuadrant::CanvasItemBatch> &batches = rendering_quadrant->pending_batches;
+	batches.clear();
+
+	for (SelfList<CellData> *cell_data_quadrant_list_element = rendering_quadrant->cells.first(); cell_data_quadrant_list_element; cell_data_quadrant_list_element = cell_data_quadrant_list_element->next()) {
+		CellData &cell_data = *cell_data_quadrant_list_element->self();
+
+		TileSetAtlasSource *atlas_source = Object::cast_to<TileSetAtlasSource>(*tile_set->get_source(cell_data.cell.source_id));
+
+		// Get the tile data.
+		const TileData *tile_data;
+		if (cell_data.runtime_tile_data_cache) {
+			tile_data = cell_data.runtime_tile_data_cache;
+		} else {
+			tile_data = atlas_source->get_tile_data(cell_data.cell.get_atlas_coords(), cell_data.cell.alternative_tile);
+		}
+
+		Ref<Material> mat = tile_data->get_material();
+		int tile_z_index = tile_data->get_z_index();
+
+		// Check if the material or the z_index changed.
+		if (batches.is_empty() || batches[batches.size() - 1].material != mat || batches[batches.size() - 1].z_index != tile_z_index) {
+			batches.push_back(RenderingQuadrant::CanvasItemBatch());
+			batches[batches.size() - 1].material = mat;
+			batches[batches.size() - 1].z_index = tile_z_index;
+		}
+
+		const Vector2 local_tile_pos = tile_map_node->map_to_local(cell_data.coords);
+
+		// Random animation offset.
+		real_t random_animation_offset = 0.0;
+		if (atlas_source->get_tile_animation_mode(cell_data.cell.get_atlas_coords()) != TileSetAtlasSource::TILE_ANIMATION_MODE_DEFAULT) {
+			Array to_hash;
+			to_hash.push_back(local_tile_pos);
+			to_hash.push_back(get_instance_id()); // Use instance id as a random hash
+			random_animation_offset = RandomPCG(to_hash.hash()).randf();
+		}
+
+		const RID *texture = p_rebuild->source_textures.getptr(cell_data.cell.source_id);
+		TileMap::draw_tile_to_command_buffer(batches[batches.size() - 1].commands, texture ? *texture : RID(), local_tile_pos - rendering_quadrant->canvas_items_position, tile_set, cell_data.cell.source_id, cell_data.cell.get_atlas_coords(), cell_data.cell.alternative_tile, p_rebuild->self_modulate, tile_data, random_animation_offset);
+	}
+}
+
+RID TileMapLayer::_rendering_quadrant_create_canvas_item(RenderingQuadrant *p_rendering_quadrant, const Ref<Material> &p_material, int p_z_index) {
+	RenderingServer *rs = RenderingServer::get_singleton();
+
+	RID ci = rs->canvas_item_create();
+	if (p_material.is_valid()) {
+		rs->canvas_item_set_material(ci, p_material->get_rid());
+	}
+	rs->canvas_item_set_parent(ci, canvas_item);
+	rs->canvas_item_set_use_parent_material(ci, tile_map_node->get_use_parent_material() || tile_map_node->get_material().is_valid());
+
+	Transform2D xform(0, p_rendering_quadrant->canvas_items_position);
+	rs->canvas_item_set_transform(ci, xform);
+
+	rs->canvas_item_set_light_mask(ci, tile_map_node->get_light_mask());
+	rs->canvas_item_set_z_as_relative_to_parent(ci, true);
+	rs->canvas_item_set_z_index(ci, p_z_index);
+
+	rs->canvas_item_set_default_texture_filter(ci, RS::CanvasItemTextureFilter(tile_map_node->get_texture_filter_in_tree()));
+	rs->canvas_item_set_default_texture_repeat(ci, RS::CanvasItemTextureRepeat(tile_map_node->get_texture_repeat_in_tree()));
+
+	p_rendering_quadrant->canvas_items.push_back(ci);
+	return ci;
+}
+
 void TileMapLayer::_rendering_quadrants_update_cell(CellData &r_cell_data, SelfList<RenderingQuadrant>::List &r_dirty_rendering_quadrant_list) {
 	const Ref<TileSet> &tile_set = tile_map_node->get_tileset();
 
@@ -2815,6 +2935,8 @@ TerrainConstraint::TerrainConstraint(const TileMap *p_tile_map, const Vector2i &
 	ERR_FAIL_INDEX_V(layer, (int)layers.size(), err_value);       \
 	return layers[layer]->function(__VA_ARGS__);
 
+SafeNumeric<uint64_t> TileMap::quadrant_rebuild_time[2];
+
 Vector2i TileMap::transform_coords_layout(const Vector2i &p_coords, TileSet::TileOffsetAxis p_offset_axis, TileSet::TileLayout p_from_layout, TileSet::TileLayout p_to_layout) {
 	// Transform to stacked layout.
 	Vector2i output = p_coords;
@@ -3050,6 +3172,8 @@ void TileMap::_internal_update() {
 		return;
 	}
 
+	uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+
 	// Update dirty quadrants on layers.
 	polygon_cache.clear();
 	for (Ref<TileMapLayer> &layer : layers) {
@@ -3057,6 +3181,8 @@ void TileMap::_internal_update() {
 	}
 
 	pending_update = false;
+
+	add_quadrant_rebuild_time(OS::get_singleton()->get_ticks_usec() - begin_usec);
 }
 
 void TileMap::set_tileset(const Ref<TileSet> &p_tileset) {
@@ -3131,29 +3257,10 @@ void TileMap::draw_tile(RID p_canvas_item, const Vector2 &p_position, const Ref<
 		// Get the tile modulation.
 		Color modulate = tile_data->get_modulate() * p_modulation;
 
-		// Compute the offset.
-		Vector2 tile_offset = tile_data->get_texture_origin();
-
 		// Get destination rect.
 		Rect2 dest_rect;
-		dest_rect.size = atlas_source->get_runtime_tile_texture_region(p_atlas_coords).size;
-		dest_rect.size.x += FP_ADJUST;
-		dest_rect.size.y += FP_ADJUST;
-
-		bool transpose = tile_data->get_transpose() ^ bool(p_alternative_tile & TileSetAtlasSource::TRANSFORM_TRANSPOSE);
-		if (transpose) {
-			dest_rect.position = (p_position - Vector2(dest_rect.size.y, dest_rect.size.x) / 2 - tile_offset);
-		} else {
-			dest_rect.position = (p_position - dest_rect.size / 2 - tile_offset);
-		}
-
-		if (tile_data->get_flip_h() ^ bool(p_alternative_tile & TileSetAtlasSource::TRANSFORM_FLIP_H)) {
-			dest_rect.size.x = -dest_rect.size.x;
-		}
-
-		if (tile_data->get_flip_v() ^ bool(p_alternative_tile & TileSetAtlasSource::TRANSFORM_FLIP_V)) {
-			dest_rect.size.y = -dest_rect.size.y;
-		}
+		bool transpose;
+		_get_tile_dest_rect(atlas_source, tile_data, p_atlas_coords, p_alternative_tile, p_position, dest_rect, transpose);
 
 		// Draw the tile.
 		if (p_frame >= 0) {
@@ -3184,6 +3291,89 @@ void TileMap::draw_tile(RID p_canvas_item, const Vector2 &p_position, const Ref<
 	}
 }
 
+void TileMap::draw_tile_to_command_buffer(CanvasItemCommandBuffer &r_buffer, RID p_texture, const Vector2 &p_position, const Ref<TileSet> &p_tile_set, int p_atlas_source_id, const Vector2i &p_atlas_coords, int p_alternative_tile, Color p_modulation, const TileData *p_tile_data, real_t p_animation_offset) {
+	// Callers already validated the cell, and resolved the texture since getting it might need the RenderingServer.
+	const TileSetAtlasSource *atlas_source = Object::cast_to<TileSetAtlasSource>(*p_tile_set->get_source(p_atlas_source_id));
+	if (!atlas_source || !p_texture.is_valid()) {
+		return;
+	}
+
+	// Check if we are in the texture, return otherwise.
+	Vector2i grid_size = atlas_source->get_atlas_grid_size();
+	if (p_atlas_coords.x >= grid_size.x || p_atlas_coords.y >= grid_size.y) {
+		return;
+	}
+
+	Color modulate = p_tile_data->get_modulate() * p_modulation;
+
+	Rect2 dest_rect;
+	bool transpose;
+	_get_tile_dest_rect(atlas_source, p_tile_data, p_atlas_coords, p_alternative_tile, p_position, dest_rect, transpose);
+
+	bool clip_uv = p_tile_set->is_uv_clipping();
+	int frames_count = atlas_source->get_tile_animation_frames_count(p_atlas_coords);
+	if (frames_count == 1) {
+		r_buffer.add_texture_rect_region(dest_rect, p_texture, atlas_source->get_runtime_tile_texture_region(p_atlas_coords, 0), modulate, transpose, clip_uv);
+	} else {
+		// Same slicing as in draw_tile().
+		real_t speed = atlas_source->get_tile_animation_speed(p_atlas_coords);
+		real_t animation_duration = atlas_source->get_tile_animation_total_duration(p_atlas_coords) / speed;
+		real_t time_unscaled = 0.0;
+		for (int frame = 0; frame < frames_count; frame++) {
+			real_t frame_duration_unscaled = atlas_source->get_tile_animation_frame_duration(p_atlas_coords, frame);
+			real_t slice_start = time_unscaled / speed;
+			real_t slice_end = (time_unscaled + frame_duration_unscaled) / speed;
+			r_buffer.add_animation_slice(animation_duration, slice_start, slice_end, p_animation_offset);
+			r_buffer.add_texture_rect_region(dest_rect, p_texture, atlas_source->get_runtime_tile_texture_region(p_atlas_coords, frame), modulate, transpose, clip_uv);
+
+			time_unscaled += frame_duration_unscaled;
+		}
+		r_buffer.add_animation_slice(1.0, 0.0, 1.0, 0.0);
+	}
+}
+
+void TileMap::_get_tile_dest_rect(const TileSetAtlasSource *p_atlas_source, const TileData *p_tile_data, const Vector2i &p_atlas_coords, int p_alternative_tile, const Vector2 &p_position, Rect2 &r_dest_rect, bool &r_transpose) {
+	// Compute the offset.
+	Vector2 tile_offset = p_tile_data->get_texture_origin();
+
+	r_dest_rect.size = p_atlas_source->get_runtime_tile_texture_region(p_atlas_coords).size;
+	r_dest_rect.size.x += FP_ADJUST;
+	r_dest_rect.size.y += FP_ADJUST;
+
+	r_transpose = p_tile_data->get_transpose() ^ bool(p_alternative_tile & TileSetAtlasSource::TRANSFORM_TRANSPOSE);
+	if (r_transpose) {
+		r_dest_rect.position = (p_position - Vector2(r_dest_rect.size.y, r_dest_rect.size.x) / 2 - tile_offset);
+	} else {
+		r_dest_rect.position = (p_position - r_dest_rect.size / 2 - tile_offset);
+	}
+
+	if (p_tile_data->get_flip_h() ^ bool(p_alternative_tile & TileSetAtlasSource::TRANSFORM_FLIP_H)) {
+		r_dest_rect.size.x = -r_dest_rect.size.x;
+	}
+
+	if (p_tile_data->get_flip_v() ^ bool(p_alternative_tile & TileSetAtlasSource::TRANSFORM_FLIP_V)) {
+		r_dest_rect.size.y = -r_dest_rect.size.y;
+	}
+}
+
+void TileMap::add_quadrant_rebuild_time(uint64_t p_usec) {
+	uint64_t frame = Engine::get_singleton()->get_process_frames();
+	SafeNumeric<uint64_t> &slot = quadrant_rebuild_time[frame & 1];
+	// Frames only grow, so this resets the slot once when it still holds the time of two frames ago.
+	slot.exchange_if_greater((frame & UINT32_MAX) << 32);
+	slot.add(MIN(p_usec, (uint64_t)UINT32_MAX));
+}
+
+double TileMap::get_quadrant_rebuild_time() {
+	// Time of the last complete frame.
+	uint64_t last_frame = Engine::get_singleton()->get_process_frames() - 1;
+	uint64_t value = quadrant_rebuild_time[last_frame & 1].get();
+	if ((value >> 32) != (last_frame & UINT32_MAX)) {
+		return 0.0;
+	}
+	return (value & UINT32_MAX) / 1000000.0;
+}
+
 int TileMap::get_layers_count() const {
 	return layers.size();
 }
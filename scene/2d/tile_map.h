@@ -31,9 +31,11 @@
 #ifndef TILE_MAP_H
 #define TILE_MAP_H
 
+#include "core/templates/safe_refcount.h"
 #include "scene/2d/node_2d.h"
 #include "scene/gui/control.h"
 #include "scene/resources/tile_set.h"
+#include "servers/rendering/canvas_item_command_buffer.h"
 
 class TileSetAtlasSource;
 
@@ -207,11 +209,21 @@ public:
 		}
 	};
 
+	// Cells sharing a material and a z-index, drawn in a single canvas item.
+	struct CanvasItemBatch {
+		Ref<Material> material;
+		int z_index = 0;
+		CanvasItemCommandBuffer commands;
+	};
+
 	Vector2i quadrant_coords;
 	SelfList<CellData>::List cells;
 	List<RID> canvas_items;
 	Vector2 canvas_items_position;
 
+	// Filled by worker threads, then submitted to the RenderingServer on the main thread.
+	LocalVector<CanvasItemBatch> pending_batches;
+
 	SelfList<RenderingQuadrant> dirty_quadrant_list_element;
 
 	// For those, copy everything but SelfList elements.
@@ -296,6 +308,9 @@ private:
 	} dirty;
 	bool in_destructor = false;
 
+	// Below this many quadrants, rebuilds are not worth dispatching to the WorkerThreadPool.
+	static constexpr uint32_t PARALLEL_UPDATE_MIN_QUADRANTS = 2;
+
 	// Rect cache.
 	mutable Rect2 rect_cache;
 	mutable bool rect_cache_dirty = true;
@@ -317,9 +332,21 @@ private:
 	void _debug_quadrants_update_cell(CellData &r_cell_data, SelfList<DebugQuadrant>::List &r_dirty_debug_quadrant_list);
 #endif // DEBUG_ENABLED
 
+	// Shared by the worker threads rebuilding the rendering quadrants.
+	struct RenderingQuadrantsRebuild {
+		LocalVector<RenderingQuadrant *> quadrants;
+		HashMap<int, RID> source_textures; // Runtime texture of each atlas source.
+		Ref<TileSet> tile_set;
+		bool y_sorted = false;
+		Color self_modulate;
+	};
+
 	HashMap<Vector2i, Ref<RenderingQuadrant>> rendering_quadrant_map;
 	bool _rendering_was_cleaned_up = false;
 	void _rendering_update();
+	bool _rendering_get_source_textures(const Ref<TileSet> &p_tile_set, HashMap<int, RID> &r_source_textures) const;
+	void _rendering_quadrant_build_commands(uint32_t p_index, RenderingQuadrantsRebuild *p_rebuild);
+	RID _rendering_quadrant_create_canvas_item(RenderingQuadrant *p_rendering_quadrant, const Ref<Material> &p_material, int p_z_index);
 	void _rendering_quadrants_update_cell(CellData &r_cell_data, SelfList<RenderingQuadrant>::List &r_dirty_rendering_quadrant_list);
 	void _rendering_occluders_clear_cell(CellData &r_cell_data);
 	void _rendering_occluders_update_cell(CellData &r_cell_data);
@@ -452,6 +479,11 @@ private:
 
 	static constexpr float FP_ADJUST = 0.00001;
 
+	// Time spent updating the layers, summed over all TileMaps, for the Performance monitor.
+	// One slot per frame parity, packing the frame in the high 32 bits and the time in usec in the low 32 bits,
+	// so TileMaps updated from several threads can add to it without a lock.
+	static SafeNumeric<uint64_t> quadrant_rebuild_time[2];
+
 	// Properties.
 	Ref<TileSet> tile_set;
 	int rendering_quadrant_size = 16;
@@ -475,6 +507,8 @@ private:
 	HashMap<Pair<Ref<Resource>, int>, Ref<Resource>, PairHash<Ref<Resource>, int>> polygon_cache;
 	PackedVector2Array _get_transformed_vertices(const PackedVector2Array &p_vertices, int p_alternative_id);
 
+	static void _get_tile_dest_rect(const TileSetAtlasSource *p_atlas_source, const TileData *p_tile_data, const Vector2i &p_atlas_coords, int p_alternative_tile, const Vector2 &p_position, Rect2 &r_dest_rect, bool &r_transpose);
+
 protected:
 	bool _set(const StringName &p_name, const Variant &p_value);
 	bool _get(const StringName &p_name, Variant &r_ret) const;
@@ -513,6 +547,11 @@ public:
 	int get_rendering_quadrant_size() const;
 
 	static void draw_tile(RID p_canvas_item, const Vector2 &p_position, const Ref<TileSet> p_tile_set, int p_atlas_source_id, const Vector2i &p_atlas_coords, int p_alternative_tile, int p_frame = -1, Color p_modulation = Color(1.0, 1.0, 1.0, 1.0), const TileData *p_tile_data_override = nullptr, real_t p_animation_offset = 0.0);
+	// Same as draw_tile(), but records the commands into a buffer. Does not call any server, so it can be used from any thread.
+	static void draw_tile_to_command_buffer(CanvasItemCommandBuffer &r_buffer, RID p_texture, const Vector2 &p_position, const Ref<TileSet> &p_tile_set, int p_atlas_source_id, const Vector2i &p_atlas_coords, int p_alternative_tile, Color p_modulation, const TileData *p_tile_data, real_t p_animation_offset);
+
+	static void add_quadrant_rebuild_time(uint64_t p_usec);
+	static double get_quadrant_rebuild_time();
 
 	// Layers management.
 	int get_layers_count() const;
@@ -476,6 +476,9 @@ void Label::_notification(int p_what) {
 				}
 			}
 
+			// Glyphs are submitted to the server as a single command buffer.
+			RenderingServer::get_singleton()->canvas_item_begin_command_buffer(ci);
+
 			Vector2 ofs;
 			ofs.y = style->get_offset().y + vbegin;
 			for (int i = lines_skipped; i < last_line; i++) {
@@ -636,6 +639,8 @@ void Label::_notification(int p_what) {
 				}
 				ofs.y += TS->shaped_text_get_descent(lines_rid[i]) + vsep + line_spacing;
 			}
+
+			RenderingServer::get_singleton()->canvas_item_end_command_buffer();
 		} break;
 
 		case NOTIFICATION_THEME_CHANGED: {
@@ -251,7 +251,7 @@ void Node::_propagate_enter_tree() {
 	data.inside_tree = true;
 
 	for (KeyValue<StringName, GroupData> &E : data.grouped) {
-		E.value.group = data.tree->add_to_group(E.key, this);
+		E.value.group = data.tree->add_to_group(E.key, this, &E.value.slot);
 	}
 
 	notification(NOTIFICATION_ENTER_TREE);
@@ -350,7 +350,7 @@ void Node::_propagate_exit_tree() {
 
 	// exit groups
 	for (KeyValue<StringName, GroupData> &E : data.grouped) {
-		data.tree->remove_from_group(E.key, this);
+		data.tree->remove_from_group(E.key, this, E.value.slot);
 		E.value.group = nullptr;
 	}
 
@@ -2103,17 +2103,16 @@ void Node::add_to_group(const StringName &p_identifier, bool p_persistent) {
 		return;
 	}
 
-	GroupData gd;
+	GroupData &gd = data.grouped[p_identifier];
 
 	if (data.tree) {
-		gd.group = data.tree->add_to_group(p_identifier, this);
+		// The group keeps a pointer to the slot index, so it must be added once stored.
+		gd.group = data.tree->add_to_group(p_identifier, this, &gd.slot);
 	} else {
 		gd.group = nullptr;
 	}
 
 	gd.persistent = p_persistent;
-
-	data.grouped[p_identifier] = gd;
 }
 
 void Node::remove_from_group(const StringName &p_identifier) {
@@ -2125,7 +2124,7 @@ void Node::remove_from_group(const StringName &p_identifier) {
 	}
 
 	if (data.tree) {
-		data.tree->remove_from_group(E->key, this);
+		data.tree->remove_from_group(E->key, this, E->value.slot);
 	}
 
 	data.grouped.remove(E);
@@ -120,6 +120,7 @@ private:
 	struct GroupData {
 		bool persistent = false;
 		SceneTree::Group *group = nullptr;
+		uint32_t slot = 0; // Index in SceneTree::Group::nodes.
 	};
 
 	struct ComparatorByIndex {
@@ -141,7 +141,7 @@ void SceneTree::node_renamed(Node *p_node) {
 	emit_signal(node_renamed_name, p_node);
 }
 
-SceneTree::Group *SceneTree::add_to_group(const StringName &p_group, Node *p_node) {
+SceneTree::Group *SceneTree::add_to_group(const StringName &p_group, Node *p_node, uint32_t *r_slot) {
 	_THREAD_SAFE_METHOD_
 
 	HashMap<StringName, Group>::Iterator E = group_map.find(p_group);
@@ -149,23 +149,30 @@ SceneTree::Group *SceneTree::add_to_group(const StringName &p_group, Node *p_nod
 		E = group_map.insert(p_group, Group());
 	}
 
-	ERR_FAIL_COND_V_MSG(E->value.nodes.has(p_node), &E->value, "Already in group: " + p_group + ".");
-	E->value.nodes.push_back(p_node);
-	//E->value.last_tree_version=0;
-	E->value.changed = true;
-	return &E->value;
+	Group &g = E->value;
+	*r_slot = g.nodes.size();
+	g.nodes.push_back(p_node);
+	g.node_slots.push_back(r_slot);
+	return &g;
 }
 
-void SceneTree::remove_from_group(const StringName &p_group, Node *p_node) {
+void SceneTree::remove_from_group(const StringName &p_group, Node *p_node, uint32_t p_slot) {
 	_THREAD_SAFE_METHOD_
 
 	HashMap<StringName, Group>::Iterator E = group_map.find(p_group);
 	ERR_FAIL_COND(!E);
 
-	E->value.nodes.erase(p_node);
-	if (E->value.nodes.is_empty()) {
+	Group &g = E->value;
+	ERR_FAIL_COND((int)p_slot >= g.nodes.size() || g.nodes[p_slot] != p_node);
+
+	if (g.nodes.size() - g.removed_count == 1) {
 		group_map.remove(E);
+		return;
 	}
+
+	g.nodes.write[p_slot] = nullptr;
+	g.node_slots[p_slot] = nullptr;
+	g.removed_count++;
 }
 
 void SceneTree::make_group_changed(const StringName &p_group) {
@@ -209,20 +216,84 @@ void SceneTree::_flush_ugc() {
 	ugc_locked = false;
 }
 
+struct SceneTreeGroupSlot {
+	Node *node = nullptr;
+	uint32_t *slot = nullptr;
+};
+
+struct SceneTreeGroupSlotComparator {
+	_FORCE_INLINE_ bool operator()(const SceneTreeGroupSlot &p_a, const SceneTreeGroupSlot &p_b) const {
+		return Node::Comparator()(p_a.node, p_b.node);
+	}
+};
+
 void SceneTree::_update_group_order(Group &g) {
-	if (!g.changed) {
+	uint32_t count = g.nodes.size();
+	if (!g.changed && g.removed_count == 0 && g.sorted_count == count) {
 		return;
 	}
-	if (g.nodes.is_empty()) {
-		return;
+
+	// Compact empty slots, keeping the order.
+	Node **nodes = g.nodes.ptrw();
+	uint32_t live = 0;
+	uint32_t sorted_live = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		if (!nodes[i]) {
+			continue;
+		}
+		if (i < g.sorted_count) {
+			sorted_live++;
+		}
+		nodes[live] = nodes[i];
+		g.node_slots[live] = g.node_slots[i];
+		live++;
+	}
+	g.nodes.resize(live);
+	g.node_slots.resize(live);
+	g.removed_count = 0;
+	nodes = g.nodes.ptrw();
+
+	if (g.changed) {
+		sorted_live = 0; // Tree order changed, sort everything.
+	} else if (sorted_live > 1 && sorted_live < live) {
+		// Merging relies on the sorted part still being in tree order. Moving a node only flags the groups
+		// it can find, so check it rather than trust it, and sort everything if it is no longer the case.
+		Node::Comparator compare;
+		for (uint32_t i = 1; i < sorted_live; i++) {
+			if (compare(nodes[i], nodes[i - 1])) {
+				sorted_live = 0;
+				break;
+			}
+		}
 	}
 
-	Node **gr_nodes = g.nodes.ptrw();
-	int gr_node_count = g.nodes.size();
+	if (sorted_live < live) {
+		LocalVector<SceneTreeGroupSlot> slots;
+		slots.resize(live);
+		for (uint32_t i = 0; i < live; i++) {
+			slots[i].node = nodes[i];
+			slots[i].slot = g.node_slots[i];
+		}
+
+		// Only the nodes added since the last update need sorting, then they are merged with the rest.
+		SortArray<SceneTreeGroupSlot, SceneTreeGroupSlotComparator> sorter;
+		sorter.sort(slots.ptr() + sorted_live, live - sorted_live);
+
+		SceneTreeGroupSlotComparator compare;
+		uint32_t a = 0;
+		uint32_t b = sorted_live;
+		for (uint32_t i = 0; i < live; i++) {
+			const SceneTreeGroupSlot &next = (b >= live || (a < sorted_live && !compare(slots[b], slots[a]))) ? slots[a++] : slots[b++];
+			nodes[i] = next.node;
+			g.node_slots[i] = next.slot;
+		}
+	}
 
-	SortArray<Node *, Node::Comparator> node_sort;
-	node_sort.sort(gr_nodes, gr_node_count);
+	for (uint32_t i = 0; i < live; i++) {
+		*g.node_slots[i] = i;
+	}
 
+	g.sorted_count = live;
 	g.changed = false;
 }
 
@@ -899,10 +970,14 @@ void SceneTree::_process_group(ProcessGroup *p_group, bool p_physics) {
 	// When reading this function, keep in mind that this code must work in a way where
 	// if any node is removed, this needs to continue working.
 
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	uint64_t &process_usec = p_physics ? p_group->physics_process_usec : p_group->process_usec;
+
 	p_group->call_queue.flush(); // Flush messages before processing.
 
 	Vector<Node *> &nodes = p_physics ? p_group->physics_nodes : p_group->nodes;
 	if (nodes.is_empty()) {
+		process_usec = OS::get_singleton()->get_ticks_usec() - begin;
 		return;
 	}
 
@@ -954,6 +1029,8 @@ void SceneTree::_process_group(ProcessGroup *p_group, bool p_physics) {
 	}
 
 	p_group->call_queue.flush(); // Flush messages also after processing (for potential deferred calls).
+
+	process_usec = OS::get_singleton()->get_ticks_usec() - begin;
 }
 
 void SceneTree::_process_groups_thread(uint32_t p_index, bool p_physics) {
@@ -1031,6 +1108,13 @@ void SceneTree::_process(bool p_physics) {
 				}
 
 				if (using_threads) {
+					// Each group stays on a single thread, so its nodes are processed in order and can safely touch each other.
+					// Start with the groups that took longest last time, so a large group doesn't end up running alone at the end.
+					if (p_physics) {
+						local_process_group_cache.sort_custom<ProcessGroupPhysicsTimeSort>();
+					} else {
+						local_process_group_cache.sort_custom<ProcessGroupTimeSort>();
+					}
 					WorkerThreadPool::GroupID id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &SceneTree::_process_groups_thread, p_physics, local_process_group_cache.size(), -1, true);
 					WorkerThreadPool::get_singleton()->wait_for_group_task_completion(id);
 				}
@@ -1632,6 +1716,8 @@ void SceneTree::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_multiplayer_poll_enabled", "enabled"), &SceneTree::set_multiplayer_poll_enabled);
 	ClassDB::bind_method(D_METHOD("is_multiplayer_poll_enabled"), &SceneTree::is_multiplayer_poll_enabled);
 
+	ClassDB::bind_method(D_METHOD("get_process_group_timings"), &SceneTree::get_process_group_timings);
+
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "auto_accept_quit"), "set_auto_accept_quit", "is_auto_accept_quit");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "quit_on_go_back"), "set_quit_on_go_back", "is_quit_on_go_back");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "debug_collisions_hint"), "set_debug_collisions_hint", "is_debugging_collisions_hint");
@@ -1710,6 +1796,24 @@ void SceneTree::set_disable_node_threading(bool p_disable) {
 	node_threading_disabled = p_disable;
 }
 
+TypedArray<Dictionary> SceneTree::get_process_group_timings() const {
+	TypedArray<Dictionary> ret;
+	for (const ProcessGroup *pg : process_groups) {
+		if (pg->removed) {
+			continue;
+		}
+		Dictionary timing;
+		timing["owner"] = pg->owner;
+		timing["sub_thread"] = pg->owner != nullptr && pg->owner->data.process_thread_group == Node::PROCESS_THREAD_GROUP_SUB_THREAD;
+		timing["process_node_count"] = pg->nodes.size();
+		timing["physics_process_node_count"] = pg->physics_nodes.size();
+		timing["process_time"] = pg->process_usec / 1000000.0;
+		timing["physics_process_time"] = pg->physics_process_usec / 1000000.0;
+		ret.push_back(timing);
+	}
+	return ret;
+}
+
 SceneTree::SceneTree() {
 	if (singleton == nullptr) {
 		singleton = this;
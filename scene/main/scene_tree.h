@@ -98,6 +98,22 @@ private:
 		bool removed = false;
 		Node *owner = nullptr;
 		uint64_t last_pass = 0;
+
+		// Time spent in the last pass, for the timing breakdown.
+		uint64_t process_usec = 0;
+		uint64_t physics_process_usec = 0;
+	};
+
+	struct ProcessGroupTimeSort {
+		_FORCE_INLINE_ bool operator()(const ProcessGroup *p_left, const ProcessGroup *p_right) const {
+			return p_left->process_usec > p_right->process_usec;
+		}
+	};
+
+	struct ProcessGroupPhysicsTimeSort {
+		_FORCE_INLINE_ bool operator()(const ProcessGroup *p_left, const ProcessGroup *p_right) const {
+			return p_left->physics_process_usec > p_right->physics_process_usec;
+		}
 	};
 
 	struct ProcessGroupSort {
@@ -116,8 +132,15 @@ private:
 	bool node_threading_disabled = false;
 
 	struct Group {
+		// Nodes in tree order, followed by the nodes added since the last update.
+		// Removing a node only clears its slot, so every node can keep the index
+		// of its slot and be removed in constant time. Empty slots are compacted
+		// and new nodes merged in order lazily, by _update_group_order().
 		Vector<Node *> nodes;
-		bool changed = false;
+		LocalVector<uint32_t *> node_slots; // Where each node stores the index of its slot.
+		uint32_t sorted_count = 0;
+		uint32_t removed_count = 0;
+		bool changed = false; // Tree order changed, everything must be sorted again.
 	};
 
 	Window *root = nullptr;
@@ -211,8 +234,8 @@ private:
 	void process_timers(double p_delta, bool p_physics_frame);
 	void process_tweens(double p_delta, bool p_physics_frame);
 
-	Group *add_to_group(const StringName &p_group, Node *p_node);
-	void remove_from_group(const StringName &p_group, Node *p_node);
+	Group *add_to_group(const StringName &p_group, Node *p_node, uint32_t *r_slot);
+	void remove_from_group(const StringName &p_group, Node *p_node, uint32_t p_slot);
 	void make_group_changed(const StringName &p_group);
 
 	void _process_group(ProcessGroup *p_group, bool p_physics);
@@ -420,6 +443,9 @@ public:
 	static void add_idle_callback(IdleCallback p_callback);
 
 	void set_disable_node_threading(bool p_disable);
+
+	TypedArray<Dictionary> get_process_group_timings() const;
+
 	//default texture settings
 
 	SceneTree();
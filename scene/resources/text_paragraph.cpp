@@ -730,6 +730,7 @@ void TextParagraph::draw(RID p_canvas, const Vector2 &p_pos, const Color &p_colo
 	_THREAD_SAFE_METHOD_
 
 	const_cast<TextParagraph *>(this)->_shape_lines();
+	RenderingServer::get_singleton()->canvas_item_begin_command_buffer(p_canvas);
 	Vector2 ofs = p_pos;
 	float h_offset = 0.f;
 	if (TS->shaped_text_get_orientation(dropcap_rid) == TextServer::ORIENTATION_HORIZONTAL) {
@@ -827,12 +828,14 @@ void TextParagraph::draw(RID p_canvas, const Vector2 &p_pos, const Color &p_colo
 			ofs.x += TS->shaped_text_get_descent(lines_rid[i]);
 		}
 	}
+	RenderingServer::get_singleton()->canvas_item_end_command_buffer();
 }
 
 void TextParagraph::draw_outline(RID p_canvas, const Vector2 &p_pos, int p_outline_size, const Color &p_color, const Color &p_dc_color) const {
 	_THREAD_SAFE_METHOD_
 
 	const_cast<TextParagraph *>(this)->_shape_lines();
+	RenderingServer::get_singleton()->canvas_item_begin_command_buffer(p_canvas);
 	Vector2 ofs = p_pos;
 
 	float h_offset = 0.f;
@@ -929,6 +932,7 @@ void TextParagraph::draw_outline(RID p_canvas, const Vector2 &p_pos, int p_outli
 			ofs.x += TS->shaped_text_get_descent(lines_rid[i]);
 		}
 	}
+	RenderingServer::get_singleton()->canvas_item_end_command_buffer();
 }
 
 int TextParagraph::hit_test(const Point2 &p_coords) const {
@@ -65,6 +65,7 @@ void NavigationServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("map_force_update", "map"), &NavigationServer3D::map_force_update);
 
 	ClassDB::bind_method(D_METHOD("query_path", "parameters", "result"), &NavigationServer3D::query_path);
+	ClassDB::bind_method(D_METHOD("query_path_async", "parameters", "result", "callback"), &NavigationServer3D::query_path_async, DEFVAL(Callable()));
 
 	ClassDB::bind_method(D_METHOD("region_create"), &NavigationServer3D::region_create);
 	ClassDB::bind_method(D_METHOD("region_set_enabled", "region", "enabled"), &NavigationServer3D::region_set_enabled);
@@ -180,6 +181,9 @@ void NavigationServer3D::_bind_methods() {
 	BIND_ENUM_CONSTANT(INFO_EDGE_MERGE_COUNT);
 	BIND_ENUM_CONSTANT(INFO_EDGE_CONNECTION_COUNT);
 	BIND_ENUM_CONSTANT(INFO_EDGE_FREE_COUNT);
+	BIND_ENUM_CONSTANT(INFO_PATH_QUERY_QUEUE_DEPTH);
+	BIND_ENUM_CONSTANT(INFO_PATH_QUERY_COUNT);
+	BIND_ENUM_CONSTANT(INFO_CLUSTER_BUILD_TIME);
 }
 
 NavigationServer3D *NavigationServer3D::get_singleton() {
@@ -204,10 +208,16 @@ NavigationServer3D::NavigationServer3D() {
 
 	GLOBAL_DEF("navigation/avoidance/thread_model/avoidance_use_multiple_threads", true);
 	GLOBAL_DEF("navigation/avoidance/thread_model/avoidance_use_high_priority_threads", true);
+	GLOBAL_DEF("navigation/avoidance/thread_model/avoidance_use_deterministic_steps", false);
 
 	GLOBAL_DEF("navigation/baking/thread_model/baking_use_multiple_threads", true);
 	GLOBAL_DEF("navigation/baking/thread_model/baking_use_high_priority_threads", true);
 
+	GLOBAL_DEF("navigation/pathfinding/thread_model/path_queries_use_multiple_threads", true);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "navigation/pathfinding/max_async_path_queries_per_frame", PROPERTY_HINT_RANGE, "1,1024,1,or_greater"), 128);
+	GLOBAL_DEF("navigation/pathfinding/use_hierarchical_pathfinding", false);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "navigation/pathfinding/hierarchical_cluster_size", PROPERTY_HINT_RANGE, "1,1024,1,or_greater"), 64);
+
 #ifdef DEBUG_ENABLED
 	debug_navigation_edge_connection_color = GLOBAL_DEF("debug/shapes/navigation/edge_connection_color", Color(1.0, 0.0, 1.0, 1.0));
 	debug_navigation_geometry_edge_color = GLOBAL_DEF("debug/shapes/navigation/geometry_edge_color", Color(0.5, 1.0, 1.0, 1.0));
@@ -155,6 +155,7 @@ public:
 	void sync() override {}
 	void finish() override {}
 	NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const override { return NavigationUtilities::PathQueryResult(); }
+	void query_path_async(const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback = Callable()) override {}
 	int get_process_info(ProcessInfo p_info) const override { return 0; }
 	void set_debug_enabled(bool p_enabled) {}
 	bool get_debug_enabled() const { return false; }
@@ -33,7 +33,9 @@
 #include "godot_collision_solver_2d.h"
 #include "godot_physics_server_2d.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/pair.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
@@ -114,37 +116,32 @@ int GodotPhysicsDirectSpaceState2D::intersect_point(const PointParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V(space->locked, false);
-
+// Finds the closest hit among the broadphase results of a ray.
+static bool _intersect_ray_candidates(const PhysicsDirectSpaceState2D::RayParameters &p_parameters, const Vector2 &p_from, const Vector2 &p_to, GodotCollisionObject2D *const *p_objects, const int *p_shapes, int p_amount, PhysicsDirectSpaceState2D::RayResult &r_result) {
 	Vector2 begin, end;
 	Vector2 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
+	begin = p_from;
+	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
-
-	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
-
 	bool collided = false;
 	Vector2 res_point, res_normal;
 	int res_shape = -1;
 	const GodotCollisionObject2D *res_obj = nullptr;
 	real_t min_d = 1e10;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+	for (int i = 0; i < p_amount; i++) {
+		if (!_can_collide_with(p_objects[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_objects[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject2D *col_obj = p_objects[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = p_shapes[i];
 		Transform2D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector2 local_from = inv_xform.xform(begin);
@@ -204,6 +201,16 @@ bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
+bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V(space->locked, false);
+
+	int amount = space->broadphase->cull_segment(p_parameters.from, p_parameters.to, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
+
+	return _intersect_ray_candidates(p_parameters, p_parameters.from, p_parameters.to, space->intersection_query_results, space->intersection_query_subindex_results, amount, r_result);
+}
+
 int GodotPhysicsDirectSpaceState2D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	if (p_result_max <= 0) {
 		return 0;
@@ -253,43 +260,41 @@ int GodotPhysicsDirectSpaceState2D::intersect_shape(const ShapeParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe) {
-	GodotShape2D *shape = GodotPhysicsServer2D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
-	ERR_FAIL_NULL_V(shape, false);
-
-	Rect2 aabb = p_parameters.transform.xform(shape->get_aabb());
-	aabb = aabb.merge(Rect2(aabb.position + p_parameters.motion, aabb.size)); //motion
-	aabb = aabb.grow(p_parameters.margin);
-
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+_FORCE_INLINE_ static Rect2 _get_motion_aabb(const GodotShape2D *p_shape, const Transform2D &p_transform, const Vector2 &p_motion, real_t p_margin) {
+	Rect2 aabb = p_transform.xform(p_shape->get_aabb());
+	aabb = aabb.merge(Rect2(aabb.position + p_motion, aabb.size)); //motion
+	return aabb.grow(p_margin);
+}
 
+// Finds how far a p_shape can move among the broadphase results of its motion.
+static void _cast_motion_candidates(GodotShape2D *p_shape, const PhysicsDirectSpaceState2D::ShapeParameters &p_parameters, const Transform2D &p_transform, const Vector2 &p_motion, GodotCollisionObject2D *const *p_objects, const int *p_shapes, int p_amount, real_t &r_closest_safe, real_t &r_closest_unsafe) {
 	real_t best_safe = 1;
 	real_t best_unsafe = 1;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+	for (int i = 0; i < p_amount; i++) {
+		if (!_can_collide_with(p_objects[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_objects[i]->get_self())) {
 			continue; //ignore excluded
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject2D *col_obj = p_objects[i];
+		int shape_idx = p_shapes[i];
 
 		Transform2D col_obj_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 		//test initial overlap, does it collide if going all the way?
-		if (!GodotCollisionSolver2D::solve(shape, p_parameters.transform, p_parameters.motion, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
+		if (!GodotCollisionSolver2D::solve(p_shape, p_transform, p_motion, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
 			continue;
 		}
 
 		//test initial overlap, ignore objects it's inside of.
-		if (GodotCollisionSolver2D::solve(shape, p_parameters.transform, Vector2(), col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
+		if (GodotCollisionSolver2D::solve(p_shape, p_transform, Vector2(), col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
 			continue;
 		}
 
-		Vector2 mnormal = p_parameters.motion.normalized();
+		Vector2 mnormal = p_motion.normalized();
 
 		//just do kinematic solving
 		real_t low = 0.0;
@@ -299,7 +304,7 @@ bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parame
 			real_t fraction = low + (hi - low) * fraction_coeff;
 
 			Vector2 sep = mnormal; //important optimization for this to work fast enough
-			bool collided = GodotCollisionSolver2D::solve(shape, p_parameters.transform, p_parameters.motion * fraction, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, &sep, p_parameters.margin);
+			bool collided = GodotCollisionSolver2D::solve(p_shape, p_transform, p_motion * fraction, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, &sep, p_parameters.margin);
 
 			if (collided) {
 				hi = fraction;
@@ -330,8 +335,258 @@ bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parame
 		}
 	}
 
-	p_closest_safe = best_safe;
-	p_closest_unsafe = best_unsafe;
+	r_closest_safe = best_safe;
+	r_closest_unsafe = best_unsafe;
+}
+
+bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe) {
+	GodotShape2D *shape = GodotPhysicsServer2D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, false);
+
+	Rect2 aabb = _get_motion_aabb(shape, p_parameters.transform, p_parameters.motion, p_parameters.margin);
+
+	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	_cast_motion_candidates(shape, p_parameters, p_parameters.transform, p_parameters.motion, space->intersection_query_results, space->intersection_query_subindex_results, amount, p_closest_safe, p_closest_unsafe);
+
+	return true;
+}
+
+// Queries per packet, neighboring queries mostly find the same broadphase results.
+#define QUERY_BATCH_PACKET_SIZE 32
+// Smaller batches are processed on the calling thread.
+#define QUERY_BATCH_PARALLEL_MIN 64
+
+struct GodotPhysicsDirectSpaceState2D::RayBatch : public QueryBatch {
+	const RayParameters *parameters = nullptr;
+	const Vector2 *from = nullptr;
+	const Vector2 *to = nullptr;
+	RayResult *results = nullptr;
+	SafeNumeric<uint32_t> hit_count;
+};
+
+struct GodotPhysicsDirectSpaceState2D::MotionBatch : public QueryBatch {
+	GodotShape2D *shape = nullptr;
+	const ShapeParameters *parameters = nullptr;
+	const Transform2D *transforms = nullptr;
+	const Vector2 *motions = nullptr;
+	real_t *closest_safe = nullptr;
+	real_t *closest_unsafe = nullptr;
+};
+
+// Spreads the 16 lower bits of a value one bit apart, to interleave them into a Morton code.
+_FORCE_INLINE_ static uint32_t _morton_spread_bits(uint32_t p_value) {
+	uint32_t v = p_value & 0xffff;
+	v = (v | (v << 8)) & 0x00ff00ff;
+	v = (v | (v << 4)) & 0x0f0f0f0f;
+	v = (v | (v << 2)) & 0x33333333;
+	v = (v | (v << 1)) & 0x55555555;
+	return v;
+}
+
+void GodotPhysicsDirectSpaceState2D::_add_query_packet(QueryBatch &r_batch, uint32_t p_query_begin, uint32_t p_query_end) {
+	Rect2 packet_aabb = r_batch.query_aabbs[r_batch.order[p_query_begin]];
+	for (uint32_t i = p_query_begin + 1; i < p_query_end; i++) {
+		packet_aabb = packet_aabb.merge(r_batch.query_aabbs[r_batch.order[i]]);
+	}
+
+	int amount = 0;
+	if (p_query_end - p_query_begin == 1 && r_batch.segment_from) {
+		// A single ray, its segment is tighter than its bounds.
+		uint32_t query = r_batch.order[p_query_begin];
+		amount = space->broadphase->cull_segment(r_batch.segment_from[query], r_batch.segment_to[query], space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	} else {
+		amount = space->broadphase->cull_aabb(packet_aabb, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+		if (amount >= GodotSpace2D::INTERSECTION_QUERY_MAX && p_query_end - p_query_begin > 1) {
+			// Results were truncated, split the packet until they fit.
+			uint32_t middle = (p_query_begin + p_query_end) / 2;
+			_add_query_packet(r_batch, p_query_begin, middle);
+			_add_query_packet(r_batch, middle, p_query_end);
+			return;
+		}
+	}
+
+	QueryBatch::Packet packet;
+	packet.query_begin = p_query_begin;
+	packet.query_end = p_query_end;
+	packet.candidate_begin = r_batch.candidates.size();
+	for (int i = 0; i < amount; i++) {
+		r_batch.candidates.push_back(space->intersection_query_results[i]);
+		r_batch.candidate_shapes.push_back(space->intersection_query_subindex_results[i]);
+	}
+	packet.candidate_end = r_batch.candidates.size();
+	r_batch.packets.push_back(packet);
+}
+
+void GodotPhysicsDirectSpaceState2D::_build_query_batch(QueryBatch &r_batch, uint32_t p_query_count) {
+	// Sort the queries along a Morton curve of their centers, so packets are spatially coherent.
+	Rect2 bounds(r_batch.query_aabbs[0].get_center(), Vector2());
+	for (uint32_t i = 1; i < p_query_count; i++) {
+		bounds.expand_to(r_batch.query_aabbs[i].get_center());
+	}
+	Vector2 scale;
+	for (int axis = 0; axis < 2; axis++) {
+		scale[axis] = bounds.size[axis] > 0 ? 65535.0 / bounds.size[axis] : 0.0;
+	}
+
+	struct QueryKey {
+		uint32_t key = 0;
+		uint32_t query = 0;
+		bool operator<(const QueryKey &p_other) const { return key < p_other.key; }
+	};
+	LocalVector<QueryKey> keys;
+	keys.resize(p_query_count);
+	for (uint32_t i = 0; i < p_query_count; i++) {
+		Vector2 cell = (r_batch.query_aabbs[i].get_center() - bounds.position) * scale;
+		keys[i].key = _morton_spread_bits(uint32_t(cell.x)) | (_morton_spread_bits(uint32_t(cell.y)) << 1);
+		keys[i].query = i;
+	}
+	keys.sort();
+
+	r_batch.order.resize(p_query_count);
+	for (uint32_t i = 0; i < p_query_count; i++) {
+		r_batch.order[i] = keys[i].query;
+	}
+
+	for (uint32_t begin = 0; begin < p_query_count; begin += QUERY_BATCH_PACKET_SIZE) {
+		_add_query_packet(r_batch, begin, MIN(begin + QUERY_BATCH_PACKET_SIZE, p_query_count));
+	}
+}
+
+void GodotPhysicsDirectSpaceState2D::_intersect_ray_packet(uint32_t p_packet_index, RayBatch *p_batch) {
+	const QueryBatch::Packet &packet = p_batch->packets[p_packet_index];
+
+	LocalVector<GodotCollisionObject2D *> objects;
+	LocalVector<int> shapes;
+	objects.reserve(packet.candidate_end - packet.candidate_begin);
+	shapes.reserve(packet.candidate_end - packet.candidate_begin);
+
+	uint32_t hit_count = 0;
+	for (uint32_t i = packet.query_begin; i < packet.query_end; i++) {
+		uint32_t ray = p_batch->order[i];
+		const Vector2 &from = p_batch->from[ray];
+		const Vector2 &to = p_batch->to[ray];
+
+		// Keep the packet results this ray actually goes through.
+		objects.clear();
+		shapes.clear();
+		for (uint32_t j = packet.candidate_begin; j < packet.candidate_end; j++) {
+			GodotCollisionObject2D *col_obj = p_batch->candidates[j];
+			int shape_idx = p_batch->candidate_shapes[j];
+			if (col_obj->get_shape_aabb(shape_idx).intersects_segment(from, to)) {
+				objects.push_back(col_obj);
+				shapes.push_back(shape_idx);
+			}
+		}
+
+		RayResult &result = p_batch->results[ray];
+		result = RayResult();
+		if (_intersect_ray_candidates(*p_batch->parameters, from, to, objects.ptr(), shapes.ptr(), objects.size(), result)) {
+			hit_count++;
+		}
+	}
+	p_batch->hit_count.add(hit_count);
+}
+
+int GodotPhysicsDirectSpaceState2D::intersect_rays_batch(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_ray_count, RayResult *r_results, bool p_use_threads) {
+	ERR_FAIL_COND_V(space->locked, 0);
+	if (p_ray_count <= 0) {
+		return 0;
+	}
+
+	LocalVector<Rect2> ray_aabbs;
+	ray_aabbs.resize(p_ray_count);
+	for (int i = 0; i < p_ray_count; i++) {
+		Rect2 aabb(p_from[i], Vector2());
+		aabb.expand_to(p_to[i]);
+		ray_aabbs[i] = aabb;
+	}
+
+	RayBatch batch;
+	batch.query_aabbs = ray_aabbs.ptr();
+	batch.segment_from = p_from;
+	batch.segment_to = p_to;
+	batch.parameters = &p_parameters;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.results = r_results;
+
+	// The broadphase is only traversed from this thread, workers only do the narrowphase.
+	_build_query_batch(batch, p_ray_count);
+
+	if (p_use_threads && p_ray_count >= QUERY_BATCH_PARALLEL_MIN) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState2D::_intersect_ray_packet, &batch, batch.packets.size(), -1, true, SNAME("Physics2DIntersectRaysBatch"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < batch.packets.size(); i++) {
+			_intersect_ray_packet(i, &batch);
+		}
+	}
+
+	return batch.hit_count.get();
+}
+
+void GodotPhysicsDirectSpaceState2D::_cast_motion_packet(uint32_t p_packet_index, MotionBatch *p_batch) {
+	const QueryBatch::Packet &packet = p_batch->packets[p_packet_index];
+
+	LocalVector<GodotCollisionObject2D *> objects;
+	LocalVector<int> shapes;
+	objects.reserve(packet.candidate_end - packet.candidate_begin);
+	shapes.reserve(packet.candidate_end - packet.candidate_begin);
+
+	for (uint32_t i = packet.query_begin; i < packet.query_end; i++) {
+		uint32_t query = p_batch->order[i];
+		const Rect2 &aabb = p_batch->query_aabbs[query];
+
+		// Keep the packet results overlapped by this motion.
+		objects.clear();
+		shapes.clear();
+		for (uint32_t j = packet.candidate_begin; j < packet.candidate_end; j++) {
+			GodotCollisionObject2D *col_obj = p_batch->candidates[j];
+			int shape_idx = p_batch->candidate_shapes[j];
+			if (col_obj->get_shape_aabb(shape_idx).intersects(aabb, true)) {
+				objects.push_back(col_obj);
+				shapes.push_back(shape_idx);
+			}
+		}
+
+		_cast_motion_candidates(p_batch->shape, *p_batch->parameters, p_batch->transforms[query], p_batch->motions[query], objects.ptr(), shapes.ptr(), objects.size(), p_batch->closest_safe[query], p_batch->closest_unsafe[query]);
+	}
+}
+
+bool GodotPhysicsDirectSpaceState2D::cast_motions_batch(const ShapeParameters &p_parameters, const Transform2D *p_transforms, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe, bool p_use_threads) {
+	GodotShape2D *shape = GodotPhysicsServer2D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, false);
+	if (p_count <= 0) {
+		return true;
+	}
+
+	LocalVector<Rect2> motion_aabbs;
+	motion_aabbs.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		motion_aabbs[i] = _get_motion_aabb(shape, p_transforms[i], p_motions[i], p_parameters.margin);
+	}
+
+	MotionBatch batch;
+	batch.query_aabbs = motion_aabbs.ptr();
+	batch.shape = shape;
+	batch.parameters = &p_parameters;
+	batch.transforms = p_transforms;
+	batch.motions = p_motions;
+	batch.closest_safe = r_closest_safe;
+	batch.closest_unsafe = r_closest_unsafe;
+
+	// The broadphase is only traversed from this thread, workers only do the narrowphase.
+	_build_query_batch(batch, p_count);
+
+	if (p_use_threads && p_count >= QUERY_BATCH_PARALLEL_MIN) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState2D::_cast_motion_packet, &batch, batch.packets.size(), -1, true, SNAME("Physics2DCastMotionsBatch"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < batch.packets.size(); i++) {
+			_cast_motion_packet(i, &batch);
+		}
+	}
 
 	return true;
 }
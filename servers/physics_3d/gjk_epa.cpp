@@ -113,7 +113,10 @@ struct	MinkowskiDiff {
 	real_t margin_A = 0.0;
 	real_t margin_B = 0.0;
 
-	Vector3 (*get_support)(const GodotShape3D*, const Vector3&, real_t) = nullptr;
+	typedef Vector3 (*SupportFunc)(const GodotShape3D*, const Vector3&, real_t);
+
+	SupportFunc get_support_A = nullptr;
+	SupportFunc get_support_B = nullptr;
 
 	void Initialize(const GodotShape3D* shape0, const Transform3D& wtrs0, const real_t margin0,
 		const GodotShape3D* shape1, const Transform3D& wtrs1, const real_t margin1) {
@@ -125,12 +128,39 @@ struct	MinkowskiDiff {
 		margin_B		=	margin1;
 
 		if ((margin0 > 0.0) || (margin1 > 0.0)) {
-			get_support = get_support_with_margin;
+			get_support_A = get_support_with_margin;
+			get_support_B = get_support_with_margin;
 		} else {
-			get_support = get_support_without_margin;
+			get_support_A = get_support_func(shape0);
+			get_support_B = get_support_func(shape1);
+		}
+	}
+
+	// Box and convex polygon supports don't depend on the length of the direction,
+	// so they skip the normalization and the virtual dispatch.
+	static SupportFunc get_support_func(const GodotShape3D* p_shape) {
+		switch (p_shape->get_type()) {
+			case PhysicsServer3D::SHAPE_BOX:
+				return get_box_support;
+			case PhysicsServer3D::SHAPE_CONVEX_POLYGON:
+				return get_convex_polygon_support;
+			default:
+				return get_support_without_margin;
 		}
 	}
 
+	static Vector3 get_box_support(const GodotShape3D* p_shape, const Vector3& p_dir, real_t p_margin) {
+		const Vector3 half_extents = static_cast<const GodotBoxShape3D*>(p_shape)->get_half_extents();
+		return Vector3(
+				p_dir.x < 0 ? -half_extents.x : half_extents.x,
+				p_dir.y < 0 ? -half_extents.y : half_extents.y,
+				p_dir.z < 0 ? -half_extents.z : half_extents.z);
+	}
+
+	static Vector3 get_convex_polygon_support(const GodotShape3D* p_shape, const Vector3& p_dir, real_t p_margin) {
+		return static_cast<const GodotConvexPolygonShape3D*>(p_shape)->GodotConvexPolygonShape3D::get_support(p_dir);
+	}
+
 	static Vector3 get_support_without_margin(const GodotShape3D* p_shape, const Vector3& p_dir, real_t p_margin) {
 		return p_shape->get_support(p_dir.normalized());
 	}
@@ -147,11 +177,11 @@ struct	MinkowskiDiff {
 
 	// i wonder how this could be sped up... if it can
 	_FORCE_INLINE_ Vector3 Support0(const Vector3& d) const {
-		return transform_A.xform(get_support(m_shapes[0], transform_A.basis.xform_inv(d), margin_A));
+		return transform_A.xform(get_support_A(m_shapes[0], transform_A.basis.xform_inv(d), margin_A));
 	}
 
 	_FORCE_INLINE_ Vector3 Support1(const Vector3& d) const {
-		return transform_B.xform(get_support(m_shapes[1], transform_B.basis.xform_inv(d), margin_B));
+		return transform_B.xform(get_support_B(m_shapes[1], transform_B.basis.xform_inv(d), margin_B));
 	}
 
 	_FORCE_INLINE_ Vector3 Support (const Vector3& d) const {
@@ -993,22 +1023,37 @@ bool Penetration(	const GodotShape3D*	shape0,
 
 /* clang-format on */
 
-bool gjk_epa_calculate_distance(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, Vector3 &r_result_A, Vector3 &r_result_B) {
+bool gjk_epa_calculate_distance(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, Vector3 &r_result_A, Vector3 &r_result_B, Vector3 *r_sep_axis) {
 	GjkEpa2::sResults res;
 
-	if (GjkEpa2::Distance(p_shape_A, p_transform_A, 0.0, p_shape_B, p_transform_B, 0.0, p_transform_B.origin - p_transform_A.origin, res)) {
+	// The search starts from the closest point of the Minkowski difference, which lies
+	// opposite to the last separating axis when the shapes barely moved since it was found.
+	Vector3 guess = p_transform_B.origin - p_transform_A.origin;
+	if (r_sep_axis && *r_sep_axis != Vector3()) {
+		guess = -*r_sep_axis;
+	}
+
+	if (GjkEpa2::Distance(p_shape_A, p_transform_A, 0.0, p_shape_B, p_transform_B, 0.0, guess, res)) {
 		r_result_A = res.witnesses[0];
 		r_result_B = res.witnesses[1];
+		if (r_sep_axis && res.distance > 0) {
+			*r_sep_axis = -res.normal;
+		}
 		return true;
 	}
 
 	return false;
 }
 
-bool gjk_epa_calculate_penetration(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, GodotCollisionSolver3D::CallbackResult p_result_callback, void *p_userdata, bool p_swap, real_t p_margin_A, real_t p_margin_B) {
+bool gjk_epa_calculate_penetration(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, GodotCollisionSolver3D::CallbackResult p_result_callback, void *p_userdata, bool p_swap, real_t p_margin_A, real_t p_margin_B, const Vector3 *p_prev_axis) {
 	GjkEpa2::sResults res;
 
-	if (GjkEpa2::Penetration(p_shape_A, p_transform_A, p_margin_A, p_shape_B, p_transform_B, p_margin_B, p_transform_B.origin - p_transform_A.origin, res)) {
+	Vector3 guess = p_transform_B.origin - p_transform_A.origin;
+	if (p_prev_axis && *p_prev_axis != Vector3()) {
+		guess = -*p_prev_axis;
+	}
+
+	if (GjkEpa2::Penetration(p_shape_A, p_transform_A, p_margin_A, p_shape_B, p_transform_B, p_margin_B, guess, res)) {
 		if (p_result_callback) {
 			if (p_swap) {
 				Vector3 normal = (res.witnesses[1] - res.witnesses[0]).normalized();
@@ -467,6 +467,12 @@ void GodotBodyPair3D::solve(real_t p_step) {
 	real_t inv_mass_A = collide_A ? A->get_inv_mass() : 0.0;
 	real_t inv_mass_B = collide_B ? B->get_inv_mass() : 0.0;
 
+	// Invariant for all contacts of the pair, only velocities change while solving.
+	const real_t inv_mass_sum = inv_mass_A + inv_mass_B;
+	const real_t friction = combine_friction(A, B);
+	const Vector3 center_of_mass_A = A->get_center_of_mass();
+	const Vector3 center_of_mass_B = B->get_center_of_mass();
+
 	for (int i = 0; i < contact_count; i++) {
 		Contact &c = contacts[i];
 		if (!c.active) {
@@ -491,10 +497,10 @@ void GodotBodyPair3D::solve(real_t p_step) {
 			Vector3 jb = c.normal * (c.acc_bias_impulse - jbnOld);
 
 			if (collide_A) {
-				A->apply_bias_impulse(-jb, c.rA + A->get_center_of_mass(), max_bias_av);
+				A->apply_bias_impulse(-jb, c.rA + center_of_mass_A, max_bias_av);
 			}
 			if (collide_B) {
-				B->apply_bias_impulse(jb, c.rB + B->get_center_of_mass(), max_bias_av);
+				B->apply_bias_impulse(jb, c.rB + center_of_mass_B, max_bias_av);
 			}
 
 			crbA = A->get_biased_angular_velocity().cross(c.rA);
@@ -504,17 +510,17 @@ void GodotBodyPair3D::solve(real_t p_step) {
 			vbn = dbv.dot(c.normal);
 
 			if (Math::abs(-vbn + c.bias) > MIN_VELOCITY) {
-				real_t jbn_com = (-vbn + c.bias) / (inv_mass_A + inv_mass_B);
+				real_t jbn_com = (-vbn + c.bias) / inv_mass_sum;
 				real_t jbnOld_com = c.acc_bias_impulse_center_of_mass;
 				c.acc_bias_impulse_center_of_mass = MAX(jbnOld_com + jbn_com, 0.0f);
 
 				Vector3 jb_com = c.normal * (c.acc_bias_impulse_center_of_mass - jbnOld_com);
 
 				if (collide_A) {
-					A->apply_bias_impulse(-jb_com, A->get_center_of_mass(), 0.0f);
+					A->apply_bias_impulse(-jb_com, center_of_mass_A, 0.0f);
 				}
 				if (collide_B) {
-					B->apply_bias_impulse(jb_com, B->get_center_of_mass(), 0.0f);
+					B->apply_bias_impulse(jb_com, center_of_mass_B, 0.0f);
 				}
 			}
 
@@ -536,10 +542,10 @@ void GodotBodyPair3D::solve(real_t p_step) {
 			Vector3 j = c.normal * (c.acc_normal_impulse - jnOld);
 
 			if (collide_A) {
-				A->apply_impulse(-j, c.rA + A->get_center_of_mass());
+				A->apply_impulse(-j, c.rA + center_of_mass_A);
 			}
 			if (collide_B) {
-				B->apply_impulse(j, c.rB + B->get_center_of_mass());
+				B->apply_impulse(j, c.rB + center_of_mass_B);
 			}
 			c.acc_impulse -= j;
 
@@ -548,8 +554,6 @@ void GodotBodyPair3D::solve(real_t p_step) {
 
 		//friction impulse
 
-		real_t friction = combine_friction(A, B);
-
 		Vector3 lvA = A->get_linear_velocity() + A->get_angular_velocity().cross(c.rA);
 		Vector3 lvB = B->get_linear_velocity() + B->get_angular_velocity().cross(c.rB);
 
@@ -566,7 +570,7 @@ void GodotBodyPair3D::solve(real_t p_step) {
 			Vector3 temp1 = inv_inertia_tensor_A.xform(c.rA.cross(tv));
 			Vector3 temp2 = inv_inertia_tensor_B.xform(c.rB.cross(tv));
 
-			real_t t = -tvl / (inv_mass_A + inv_mass_B + tv.dot(temp1.cross(c.rA) + temp2.cross(c.rB)));
+			real_t t = -tvl / (inv_mass_sum + tv.dot(temp1.cross(c.rA) + temp2.cross(c.rB)));
 
 			Vector3 jt = t * tv;
 
@@ -583,10 +587,10 @@ void GodotBodyPair3D::solve(real_t p_step) {
 			jt = c.acc_tangent_impulse - jtOld;
 
 			if (collide_A) {
-				A->apply_impulse(-jt, c.rA + A->get_center_of_mass());
+				A->apply_impulse(-jt, c.rA + center_of_mass_A);
 			}
 			if (collide_B) {
-				B->apply_impulse(jt, c.rB + B->get_center_of_mass());
+				B->apply_impulse(jt, c.rB + center_of_mass_B);
 			}
 			c.acc_impulse -= jt;
 
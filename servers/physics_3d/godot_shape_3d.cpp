@@ -827,9 +827,7 @@ void GodotConvexPolygonShape3D::project_range(const Vector3 &p_normal, const Tra
 		return;
 	}
 
-	const Vector3 *vrts = &mesh.vertices[0];
-
-	if (vertex_count > 3 * extreme_vertices.size()) {
+	if (!_use_full_scan()) {
 		// For a large mesh, two calls to get_support() is faster than a full
 		// scan over all vertices.
 
@@ -837,17 +835,67 @@ void GodotConvexPolygonShape3D::project_range(const Vector3 &p_normal, const Tra
 		r_min = p_normal.dot(p_transform.xform(get_support(-n)));
 		r_max = p_normal.dot(p_transform.xform(get_support(n)));
 	} else {
-		for (uint32_t i = 0; i < vertex_count; i++) {
-			real_t d = p_normal.dot(p_transform.xform(vrts[i]));
+		// Project the vertices in local space, n.dot(B * v + o) == (B^T * n).dot(v) + n.dot(o).
+		real_t offset = p_normal.dot(p_transform.origin);
+		_project_range_soa(p_transform.basis.xform_inv(p_normal), r_min, r_max);
+		r_min += offset;
+		r_max += offset;
+	}
+}
+
+int GodotConvexPolygonShape3D::_get_support_index_soa(const Vector3 &p_normal) const {
+	const real_t *xs = vertices_soa.ptr();
+	const real_t *ys = xs + vertices_soa_stride;
+	const real_t *zs = ys + vertices_soa_stride;
+
+	// 4 independent lanes, the compiler can keep them in a single vector register.
+	real_t best[4];
+	uint32_t best_index[4];
+	for (uint32_t l = 0; l < 4; l++) {
+		best[l] = xs[l] * p_normal.x + ys[l] * p_normal.y + zs[l] * p_normal.z;
+		best_index[l] = l;
+	}
+	for (uint32_t i = 4; i < vertices_soa_stride; i += 4) {
+		for (uint32_t l = 0; l < 4; l++) {
+			real_t d = xs[i + l] * p_normal.x + ys[i + l] * p_normal.y + zs[i + l] * p_normal.z;
+			bool better = d > best[l];
+			best[l] = better ? d : best[l];
+			best_index[l] = better ? i + l : best_index[l];
+		}
+	}
 
-			if (i == 0 || d > r_max) {
-				r_max = d;
-			}
-			if (i == 0 || d < r_min) {
-				r_min = d;
-			}
+	uint32_t result = best_index[0];
+	real_t max_support = best[0];
+	for (uint32_t l = 1; l < 4; l++) {
+		if (best[l] > max_support || (best[l] == max_support && best_index[l] < result)) {
+			result = best_index[l];
+			max_support = best[l];
+		}
+	}
+	// Padding lanes hold the first vertex.
+	return result < mesh.vertices.size() ? result : 0;
+}
+
+void GodotConvexPolygonShape3D::_project_range_soa(const Vector3 &p_normal, real_t &r_min, real_t &r_max) const {
+	const real_t *xs = vertices_soa.ptr();
+	const real_t *ys = xs + vertices_soa_stride;
+	const real_t *zs = ys + vertices_soa_stride;
+
+	real_t lane_min[4];
+	real_t lane_max[4];
+	for (uint32_t l = 0; l < 4; l++) {
+		lane_min[l] = lane_max[l] = xs[l] * p_normal.x + ys[l] * p_normal.y + zs[l] * p_normal.z;
+	}
+	for (uint32_t i = 4; i < vertices_soa_stride; i += 4) {
+		for (uint32_t l = 0; l < 4; l++) {
+			real_t d = xs[i + l] * p_normal.x + ys[i + l] * p_normal.y + zs[i + l] * p_normal.z;
+			lane_min[l] = MIN(lane_min[l], d);
+			lane_max[l] = MAX(lane_max[l], d);
 		}
 	}
+
+	r_min = MIN(MIN(lane_min[0], lane_min[1]), MIN(lane_min[2], lane_min[3]));
+	r_max = MAX(MAX(lane_max[0], lane_max[1]), MAX(lane_max[2], lane_max[3]));
 }
 
 Vector3 GodotConvexPolygonShape3D::get_support(const Vector3 &p_normal) const {
@@ -859,6 +907,11 @@ Vector3 GodotConvexPolygonShape3D::get_support(const Vector3 &p_normal) const {
 	// Get the array of vertices
 	const Vector3 *const vertices_array = mesh.vertices.ptr();
 
+	// For a small mesh, a linear scan is faster than walking the surface.
+	if (_use_full_scan()) {
+		return vertices_array[_get_support_index_soa(p_normal)];
+	}
+
 	// Start with an initial assumption of the first extreme vertex.
 	int best_vertex = extreme_vertices[0];
 	real_t max_support = p_normal.dot(vertices_array[best_vertex]);
@@ -1140,6 +1193,15 @@ void GodotConvexPolygonShape3D::_setup(const Vector<Vector3> &p_vertices) {
 		}
 	}
 
+	vertices_soa_stride = (mesh.vertices.size() + 3) & ~3;
+	vertices_soa.resize(vertices_soa_stride * 3);
+	for (uint32_t i = 0; i < vertices_soa_stride; i++) {
+		const Vector3 &vertex = mesh.vertices[i < mesh.vertices.size() ? i : 0];
+		vertices_soa[i] = vertex.x;
+		vertices_soa[vertices_soa_stride + i] = vertex.y;
+		vertices_soa[vertices_soa_stride * 2 + i] = vertex.z;
+	}
+
 	// Record all the neighbors of each vertex.  This is used in get_support().
 
 	if (extreme_vertices.size() < mesh.vertices.size()) {
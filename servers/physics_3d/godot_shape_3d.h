@@ -280,6 +280,15 @@ struct GodotConvexPolygonShape3D : public GodotShape3D {
 	LocalVector<int> extreme_vertices;
 	LocalVector<LocalVector<int>> vertex_neighbors;
 
+	// Vertex coordinates as x, y and z blocks, each padded to a multiple of 4 with the first vertex,
+	// so that small hulls are scanned 4 vertices at a time without any indirection.
+	LocalVector<real_t> vertices_soa;
+	uint32_t vertices_soa_stride = 0;
+
+	_FORCE_INLINE_ bool _use_full_scan() const { return mesh.vertices.size() <= 3 * extreme_vertices.size(); }
+	int _get_support_index_soa(const Vector3 &p_normal) const;
+	void _project_range_soa(const Vector3 &p_normal, real_t &r_min, real_t &r_max) const;
+
 	void _setup(const Vector<Vector3> &p_vertices);
 
 public:
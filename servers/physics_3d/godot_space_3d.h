@@ -41,18 +41,49 @@
 
 #include "core/config/project_settings.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "core/typedefs.h"
 
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
+	// Queries of a batch are sorted spatially and grouped into packets,
+	// each packet traverses the broadphase once for all its queries.
+	struct QueryBatch {
+		struct Packet {
+			uint32_t query_begin = 0; // Range in the query order.
+			uint32_t query_end = 0;
+			uint32_t candidate_begin = 0; // Range in the candidates.
+			uint32_t candidate_end = 0;
+		};
+
+		const AABB *query_aabbs = nullptr;
+		// Segments of ray queries, culled more tightly than their bounds when alone in a packet.
+		const Vector3 *segment_from = nullptr;
+		const Vector3 *segment_to = nullptr;
+		LocalVector<uint32_t> order;
+		LocalVector<Packet> packets;
+		LocalVector<GodotCollisionObject3D *> candidates;
+		LocalVector<int> candidate_shapes;
+	};
+
+	struct RayBatch;
+	struct MotionBatch;
+
+	void _build_query_batch(QueryBatch &r_batch, uint32_t p_query_count);
+	void _add_query_packet(QueryBatch &r_batch, uint32_t p_query_begin, uint32_t p_query_end);
+	void _intersect_ray_packet(uint32_t p_packet_index, RayBatch *p_batch);
+	void _cast_motion_packet(uint32_t p_packet_index, MotionBatch *p_batch);
+
 public:
 	GodotSpace3D *space = nullptr;
 
 	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override;
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
+	virtual int intersect_rays_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results, bool p_use_threads = true) override;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info = nullptr) override;
+	virtual bool cast_motions_batch(const ShapeParameters &p_parameters, const Transform3D *p_transforms, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe, bool p_use_threads = true) override;
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) override;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) override;
 	virtual Vector3 get_closest_point_to_object_volume(RID p_object, const Vector3 p_point) const override;
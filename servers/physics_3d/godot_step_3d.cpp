@@ -41,6 +41,27 @@
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
 
+// Islands with at least this many constraints are colored and solved in parallel.
+#define LARGE_ISLAND_CONSTRAINT_COUNT 256
+// Constraints of a color solved by a thread at once, smaller chunks would cost more in synchronization than they save.
+#define CONSTRAINT_COLOR_CHUNK_SIZE 32
+// Limited by the size of the per-body color masks.
+#define CONSTRAINT_COLOR_COUNT_MAX 64
+
+// Keeps only the constraints of at least the given priority, returns how many are left.
+static uint32_t _filter_constraint_priority(LocalVector<GodotConstraint3D *> &p_constraints, int p_priority) {
+	uint32_t constraint_count = p_constraints.size();
+	uint32_t priority_constraint_count = 0;
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		GodotConstraint3D *constraint = p_constraints[constraint_index];
+		if (constraint->get_priority() >= p_priority) {
+			p_constraints[priority_constraint_count++] = constraint;
+		}
+	}
+	p_constraints.resize(priority_constraint_count);
+	return priority_constraint_count;
+}
+
 void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
 
@@ -145,16 +166,154 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 		}
 
 		// Check priority to keep only higher priority constraints.
-		uint32_t priority_constraint_count = 0;
 		++current_priority;
-		for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
-			GodotConstraint3D *constraint = constraint_island[constraint_index];
-			if (constraint->get_priority() >= current_priority) {
-				// Keep this constraint for the next iteration.
-				constraint_island[priority_constraint_count++] = constraint;
+		constraint_count = _filter_constraint_priority(constraint_island, current_priority);
+	}
+}
+
+void GodotStep3D::_solve_small_island(uint32_t p_index, void *p_userdata) {
+	_solve_island(small_islands[p_index]);
+}
+
+uint32_t GodotStep3D::_color_island(const LocalVector<GodotConstraint3D *> &p_constraint_island) {
+	// Greedy coloring: constraints of the same color don't share any rigid body, so they can be solved concurrently.
+	// Static and kinematic bodies are never written to by the solver, they don't restrict the coloring.
+	body_color_masks.clear();
+	uncolored_constraints.clear();
+
+	uint32_t color_count = 0;
+	for (GodotConstraint3D *constraint : p_constraint_island) {
+		if (constraint->get_soft_body_count() > 0) {
+			// Soft body constraints write to the soft body nodes, keep them serial.
+			uncolored_constraints.push_back(constraint);
+			continue;
+		}
+
+		GodotBody3D **bodies = constraint->get_body_ptr();
+		int body_count = constraint->get_body_count();
+
+		uint64_t used_colors = 0;
+		for (int i = 0; i < body_count; i++) {
+			if (bodies[i]->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
+				HashMap<GodotBody3D *, uint64_t>::Iterator E = body_color_masks.find(bodies[i]);
+				if (E) {
+					used_colors |= E->value;
+				}
+			}
+		}
+
+		uint32_t color = 0;
+		while (color < CONSTRAINT_COLOR_COUNT_MAX && (used_colors & (uint64_t(1) << color))) {
+			color++;
+		}
+		if (color == CONSTRAINT_COLOR_COUNT_MAX) {
+			uncolored_constraints.push_back(constraint);
+			continue;
+		}
+
+		for (int i = 0; i < body_count; i++) {
+			if (bodies[i]->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
+				body_color_masks[bodies[i]] |= uint64_t(1) << color;
 			}
 		}
-		constraint_count = priority_constraint_count;
+
+		// Colors are allocated in order, a new one is always the next one.
+		if (color == color_count) {
+			++color_count;
+			if (constraint_colors.size() < color_count) {
+				constraint_colors.resize(color_count);
+			}
+			constraint_colors[color].clear();
+		}
+		constraint_colors[color].push_back(constraint);
+	}
+
+	return color_count;
+}
+
+void GodotStep3D::_solve_large_island_chunks(uint32_t p_worker_index, void *p_userdata) {
+	// Chunks are claimed in order, so the thread waiting on the oldest unfinished stage always has its chunk's
+	// dependencies solved, and the solve completes no matter how many threads join it.
+	uint32_t stage_index = 0;
+	while (true) {
+		uint32_t chunk = large_island_next_chunk.postincrement();
+		if (chunk >= large_island_chunk_count) {
+			break;
+		}
+		while (stage_index + 1 < large_island_stages.size() && large_island_stages[stage_index + 1].chunk_begin <= chunk) {
+			++stage_index;
+		}
+		const LargeIslandStage &stage = large_island_stages[stage_index];
+
+		// Barrier between stages: a color reads the bodies written by the previous ones.
+		while (large_island_done_chunks.get() < stage.chunk_begin) {
+			OS::get_singleton()->yield();
+		}
+
+		const LocalVector<GodotConstraint3D *> &constraints = *stage.constraints;
+		uint32_t begin = (chunk - stage.chunk_begin) * stage.chunk_size;
+		uint32_t end = MIN(begin + stage.chunk_size, constraints.size());
+		for (uint32_t constraint_index = begin; constraint_index < end; ++constraint_index) {
+			constraints[constraint_index]->solve(delta);
+		}
+
+		large_island_done_chunks.increment();
+	}
+}
+
+void GodotStep3D::_solve_large_island(const LocalVector<GodotConstraint3D *> &p_constraint_island) {
+	uint32_t color_count = _color_island(p_constraint_island);
+
+	int current_priority = 1;
+
+	uint32_t constraint_count = p_constraint_island.size();
+	while (constraint_count > 0) {
+		// Colors are solved one after another, like constraints are in a small island, and the uncolored constraints
+		// last by a single thread. All iterations of a pass are solved by a single group task, with a barrier between stages.
+		large_island_stages.clear();
+		large_island_chunk_count = 0;
+		uint32_t max_stage_chunks = 0;
+		for (int i = 0; i < iterations; i++) {
+			for (uint32_t color_index = 0; color_index <= color_count; ++color_index) {
+				LargeIslandStage stage;
+				if (color_index < color_count) {
+					stage.constraints = &constraint_colors[color_index];
+					stage.chunk_size = CONSTRAINT_COLOR_CHUNK_SIZE;
+				} else {
+					stage.constraints = &uncolored_constraints;
+					stage.chunk_size = MAX(uncolored_constraints.size(), 1u);
+				}
+				if (stage.constraints->is_empty()) {
+					continue;
+				}
+				stage.chunk_begin = large_island_chunk_count;
+				uint32_t stage_chunks = (stage.constraints->size() + stage.chunk_size - 1) / stage.chunk_size;
+				large_island_chunk_count += stage_chunks;
+				max_stage_chunks = MAX(max_stage_chunks, stage_chunks);
+				large_island_stages.push_back(stage);
+			}
+		}
+
+		large_island_next_chunk.set(0);
+		large_island_done_chunks.set(0);
+
+		// This thread takes part in the solve, so helpers are only needed for stages with several chunks.
+		uint32_t helper_count = MIN((uint32_t)WorkerThreadPool::get_singleton()->get_thread_count(), max_stage_chunks - 1);
+		WorkerThreadPool::GroupID group_task = 0;
+		if (helper_count > 0) {
+			group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_large_island_chunks, nullptr, helper_count, helper_count, true, SNAME("Physics3DConstraintSolveLargeIsland"));
+		}
+		_solve_large_island_chunks();
+		if (helper_count > 0) {
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		}
+
+		// Check priority to keep only higher priority constraints.
+		++current_priority;
+		constraint_count = _filter_constraint_priority(uncolored_constraints, current_priority);
+		for (uint32_t color_index = 0; color_index < color_count; ++color_index) {
+			constraint_count += _filter_constraint_priority(constraint_colors[color_index], current_priority);
+		}
 	}
 }
 
@@ -362,9 +521,26 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
+	small_islands.clear();
+	large_islands.clear();
+	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+		if (constraint_islands[island_index].size() >= LARGE_ISLAND_CONSTRAINT_COUNT) {
+			large_islands.push_back(island_index);
+		} else {
+			small_islands.push_back(island_index);
+		}
+	}
+
 	// Warning: _solve_island modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_small_island, nullptr, small_islands.size(), -1, true, SNAME("Physics3DConstraintSolveIslands"));
+
+	// A single island would serialize the whole solve, large ones are split across threads instead.
+	// They are solved from here while small islands are processed, islands never share rigid bodies.
+	for (const uint32_t &island_index : large_islands) {
+		_solve_large_island(constraint_islands[island_index]);
+	}
+
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	{ //profile
@@ -412,6 +588,7 @@ GodotStep3D::GodotStep3D() {
 	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
 	all_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
+	small_islands.reserve(ISLAND_COUNT_RESERVE);
 }
 
 GodotStep3D::~GodotStep3D() {
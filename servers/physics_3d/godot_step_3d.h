@@ -33,7 +33,9 @@
 
 #include "godot_space_3d.h"
 
+#include "core/templates/hash_map.h"
 #include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 
 class GodotStep3D {
 	uint64_t _step = 1;
@@ -45,11 +47,34 @@ class GodotStep3D {
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
 
+	// Islands solved as a whole by a single thread, and islands too large for that,
+	// split into independent sets of constraints (colors) solved in parallel.
+	LocalVector<uint32_t> small_islands;
+	LocalVector<uint32_t> large_islands;
+	LocalVector<LocalVector<GodotConstraint3D *>> constraint_colors;
+	LocalVector<GodotConstraint3D *> uncolored_constraints;
+	HashMap<GodotBody3D *, uint64_t> body_color_masks;
+
+	// Constraints solved in order during a priority pass of a large island, split in chunks shared by the threads.
+	struct LargeIslandStage {
+		LocalVector<GodotConstraint3D *> *constraints = nullptr;
+		uint32_t chunk_begin = 0; // First chunk of this stage among the chunks of the pass.
+		uint32_t chunk_size = 0;
+	};
+	LocalVector<LargeIslandStage> large_island_stages;
+	uint32_t large_island_chunk_count = 0;
+	SafeNumeric<uint32_t> large_island_next_chunk;
+	SafeNumeric<uint32_t> large_island_done_chunks;
+
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
+	void _solve_small_island(uint32_t p_index, void *p_userdata = nullptr);
+	uint32_t _color_island(const LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _solve_large_island_chunks(uint32_t p_worker_index = 0, void *p_userdata = nullptr);
+	void _solve_large_island(const LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
 
 public:
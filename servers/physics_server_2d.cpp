@@ -449,14 +449,117 @@ Dictionary PhysicsDirectSpaceState2D::_get_rest_info(const Ref<PhysicsShapeQuery
 	return r;
 }
 
+Dictionary PhysicsDirectSpaceState2D::_intersect_rays_batch(const Ref<PhysicsRayQueryParameters2D> &p_ray_query, const Vector<Vector2> &p_from, const Vector<Vector2> &p_to, bool p_use_threads) {
+	ERR_FAIL_COND_V(!p_ray_query.is_valid(), Dictionary());
+	ERR_FAIL_COND_V_MSG(p_from.size() != p_to.size(), Dictionary(), "The arrays of ray starts and ends must have the same size.");
+
+	int ray_count = p_from.size();
+	Vector<RayResult> results;
+	results.resize(ray_count);
+	intersect_rays_batch(p_ray_query->get_parameters(), p_from.ptr(), p_to.ptr(), ray_count, results.ptrw(), p_use_threads);
+
+	Vector<Vector2> positions;
+	Vector<Vector2> normals;
+	Vector<int64_t> collider_ids;
+	Array colliders;
+	Vector<int32_t> shapes;
+	Array rids;
+	positions.resize(ray_count);
+	normals.resize(ray_count);
+	collider_ids.resize(ray_count);
+	colliders.resize(ray_count);
+	shapes.resize(ray_count);
+	rids.resize(ray_count);
+	for (int i = 0; i < ray_count; i++) {
+		const RayResult &result = results[i];
+		positions.write[i] = result.position;
+		normals.write[i] = result.normal;
+		collider_ids.write[i] = result.collider_id;
+		colliders[i] = result.collider;
+		shapes.write[i] = result.shape;
+		rids[i] = result.rid;
+	}
+
+	Dictionary d;
+	d["position"] = positions;
+	d["normal"] = normals;
+	d["collider_id"] = collider_ids;
+	d["collider"] = colliders;
+	d["shape"] = shapes;
+	d["rid"] = rids;
+
+	return d;
+}
+
+Vector<real_t> PhysicsDirectSpaceState2D::_cast_motions_batch(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query, const Vector<Vector2> &p_origins, const Vector<Vector2> &p_motions, bool p_use_threads) {
+	ERR_FAIL_COND_V(!p_shape_query.is_valid(), Vector<real_t>());
+	ERR_FAIL_COND_V_MSG(p_origins.size() != p_motions.size(), Vector<real_t>(), "The arrays of origins and motions must have the same size.");
+
+	int count = p_origins.size();
+	Vector<Transform2D> transforms;
+	transforms.resize(count);
+	Transform2D transform = p_shape_query->get_transform();
+	for (int i = 0; i < count; i++) {
+		transform.columns[2] = p_origins[i];
+		transforms.write[i] = transform;
+	}
+
+	Vector<real_t> closest_safe;
+	Vector<real_t> closest_unsafe;
+	closest_safe.resize(count);
+	closest_unsafe.resize(count);
+	bool res = cast_motions_batch(p_shape_query->get_parameters(), transforms.ptr(), p_motions.ptr(), count, closest_safe.ptrw(), closest_unsafe.ptrw(), p_use_threads);
+	if (!res) {
+		return Vector<real_t>();
+	}
+
+	Vector<real_t> ret;
+	ret.resize(count * 2);
+	for (int i = 0; i < count; i++) {
+		ret.write[i * 2 + 0] = closest_safe[i];
+		ret.write[i * 2 + 1] = closest_unsafe[i];
+	}
+	return ret;
+}
+
+int PhysicsDirectSpaceState2D::intersect_rays_batch(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_ray_count, RayResult *r_results, bool p_use_threads) {
+	RayParameters parameters = p_parameters;
+	int hit_count = 0;
+	for (int i = 0; i < p_ray_count; i++) {
+		parameters.from = p_from[i];
+		parameters.to = p_to[i];
+		r_results[i] = RayResult();
+		if (intersect_ray(parameters, r_results[i])) {
+			hit_count++;
+		}
+	}
+	return hit_count;
+}
+
+bool PhysicsDirectSpaceState2D::cast_motions_batch(const ShapeParameters &p_parameters, const Transform2D *p_transforms, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe, bool p_use_threads) {
+	ShapeParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.transform = p_transforms[i];
+		parameters.motion = p_motions[i];
+		r_closest_safe[i] = 1.0;
+		r_closest_unsafe[i] = 1.0;
+		if (!cast_motion(parameters, r_closest_safe[i], r_closest_unsafe[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
 PhysicsDirectSpaceState2D::PhysicsDirectSpaceState2D() {
 }
 
 void PhysicsDirectSpaceState2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("intersect_point", "parameters", "max_results"), &PhysicsDirectSpaceState2D::_intersect_point, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("intersect_ray", "parameters"), &PhysicsDirectSpaceState2D::_intersect_ray);
+	ClassDB::bind_method(D_METHOD("intersect_rays_batch", "parameters", "from", "to", "use_threads"), &PhysicsDirectSpaceState2D::_intersect_rays_batch, DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("intersect_shape", "parameters", "max_results"), &PhysicsDirectSpaceState2D::_intersect_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState2D::_cast_motion);
+	ClassDB::bind_method(D_METHOD("cast_motions_batch", "parameters", "origins", "motions", "use_threads"), &PhysicsDirectSpaceState2D::_cast_motions_batch, DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState2D::_collide_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("get_rest_info", "parameters"), &PhysicsDirectSpaceState2D::_get_rest_info);
 }
@@ -121,6 +121,8 @@ class PhysicsDirectSpaceState2D : public Object {
 	TypedArray<Dictionary> _intersect_point(const Ref<PhysicsPointQueryParameters2D> &p_point_query, int p_max_results = 32);
 	TypedArray<Dictionary> _intersect_shape(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query, int p_max_results = 32);
 	Vector<real_t> _cast_motion(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query);
+	Dictionary _intersect_rays_batch(const Ref<PhysicsRayQueryParameters2D> &p_ray_query, const Vector<Vector2> &p_from, const Vector<Vector2> &p_to, bool p_use_threads = true);
+	Vector<real_t> _cast_motions_batch(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query, const Vector<Vector2> &p_origins, const Vector<Vector2> &p_motions, bool p_use_threads = true);
 	TypedArray<Vector2> _collide_shape(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query, int p_max_results = 32);
 	Dictionary _get_rest_info(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query);
 
@@ -151,6 +153,10 @@ public:
 
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) = 0;
 
+	// Casts rays sharing the same parameters, except for their ends which are given per ray.
+	// Rays which don't hit anything get a default result, with an invalid RID. Returns how many rays hit.
+	virtual int intersect_rays_batch(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_ray_count, RayResult *r_results, bool p_use_threads = true);
+
 	struct ShapeResult {
 		RID rid;
 		ObjectID collider_id;
@@ -195,6 +201,8 @@ public:
 
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) = 0;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe) = 0;
+	// Casts the same shape from several transforms, with a motion per cast. The transform and motion of the parameters are ignored.
+	virtual bool cast_motions_batch(const ShapeParameters &p_parameters, const Transform2D *p_transforms, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe, bool p_use_threads = true);
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector2 *r_results, int p_result_max, int &r_result_count) = 0;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) = 0;
 
@@ -0,0 +1,210 @@
+/**************************************************************************/
+/*  canvas_item_command_buffer.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef CANVAS_ITEM_COMMAND_BUFFER_H
+#define CANVAS_ITEM_COMMAND_BUFFER_H
+
+#include "core/templates/local_vector.h"
+#include "servers/rendering_server.h"
+
+// Packed stream of canvas item commands, submitted in a single call with
+// RenderingServer::canvas_item_add_command_buffer().
+//
+// Every command is a 32-bit RS::CanvasItemBufferCommand followed by its
+// arguments: rect and transform components are real_t, so they keep their
+// precision in double precision builds, colors and other scalars are 32-bit
+// floats, booleans and integers are 32-bit, RIDs are their 64-bit id, and
+// animation slices use 64-bit floats. The layout is documented with the bound
+// method.
+class CanvasItemCommandBuffer {
+	LocalVector<uint8_t> data;
+	uint32_t command_count = 0;
+
+	template <class T>
+	_FORCE_INLINE_ void _push(const T &p_value) {
+		uint32_t ofs = data.size();
+		data.resize(ofs + sizeof(T));
+		memcpy(&data[ofs], &p_value, sizeof(T));
+	}
+
+	_FORCE_INLINE_ void _push_command(RS::CanvasItemBufferCommand p_command) {
+		_push<uint32_t>(p_command);
+		command_count++;
+	}
+	_FORCE_INLINE_ void _push_bool(bool p_value) { _push<uint32_t>(p_value ? 1 : 0); }
+	_FORCE_INLINE_ void _push_rid(const RID &p_rid) { _push<uint64_t>(p_rid.get_id()); }
+	_FORCE_INLINE_ void _push_rect(const Rect2 &p_rect) {
+		const real_t v[4] = { p_rect.position.x, p_rect.position.y, p_rect.size.x, p_rect.size.y };
+		_push(v);
+	}
+	_FORCE_INLINE_ void _push_color(const Color &p_color) {
+		const float v[4] = { p_color.r, p_color.g, p_color.b, p_color.a };
+		_push(v);
+	}
+
+public:
+	class Reader {
+		const uint8_t *ptr = nullptr;
+		const uint8_t *end = nullptr;
+		bool error = false;
+
+		template <class T>
+		_FORCE_INLINE_ T _read() {
+			T value = T();
+			if (unlikely(end - ptr < (int64_t)sizeof(T))) {
+				error = true;
+				ptr = end;
+				return value;
+			}
+			memcpy(&value, ptr, sizeof(T));
+			ptr += sizeof(T);
+			return value;
+		}
+
+	public:
+		_FORCE_INLINE_ bool has_next() const { return ptr < end; }
+		// Set when a command was truncated, everything read after it is zeroed.
+		_FORCE_INLINE_ bool has_error() const { return error; }
+
+		_FORCE_INLINE_ uint32_t read_command() { return _read<uint32_t>(); }
+		_FORCE_INLINE_ float read_float() { return _read<float>(); }
+		_FORCE_INLINE_ double read_double() { return _read<double>(); }
+		_FORCE_INLINE_ int32_t read_int() { return _read<int32_t>(); }
+		_FORCE_INLINE_ bool read_bool() { return _read<uint32_t>() != 0; }
+		_FORCE_INLINE_ RID read_rid() { return RID::from_uint64(_read<uint64_t>()); }
+		_FORCE_INLINE_ Rect2 read_rect() {
+			real_t v[4];
+			for (int i = 0; i < 4; i++) {
+				v[i] = _read<real_t>();
+			}
+			return Rect2(v[0], v[1], v[2], v[3]);
+		}
+		_FORCE_INLINE_ Color read_color() {
+			float v[4];
+			for (int i = 0; i < 4; i++) {
+				v[i] = _read<float>();
+			}
+			return Color(v[0], v[1], v[2], v[3]);
+		}
+		_FORCE_INLINE_ Transform2D read_transform() {
+			real_t v[6];
+			for (int i = 0; i < 6; i++) {
+				v[i] = _read<real_t>();
+			}
+			return Transform2D(v[0], v[1], v[2], v[3], v[4], v[5]);
+		}
+
+		Reader(const uint8_t *p_data, uint32_t p_size) :
+				ptr(p_data), end(p_data + p_size) {}
+	};
+
+	void add_rect(const Rect2 &p_rect, const Color &p_color) {
+		_push_command(RS::CANVAS_ITEM_BUFFER_COMMAND_RECT);
+		_push_rect(p_rect);
+		_push_color(p_color);
+	}
+
+	void add_texture_rect(const Rect2 &p_rect, RID p_texture, bool p_tile, const Color &p_modulate, bool p_transpose) {
+		_push_command(RS::CANVAS_ITEM_BUFFER_COMMAND_TEXTURE_RECT);
+		_push_rect(p_rect);
+		_push_rid(p_texture);
+		_push_color(p_modulate);
+		_push_bool(p_tile);
+		_push_bool(p_transpose);
+	}
+
+	void add_texture_rect_region(const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, bool p_transpose, bool p_clip_uv) {
+		_push_command(RS::CANVAS_ITEM_BUFFER_COMMAND_TEXTURE_RECT_REGION);
+		_push_rect(p_rect);
+		_push_rid(p_texture);
+		_push_rect(p_src_rect);
+		_push_color(p_modulate);
+		_push_bool(p_transpose);
+		_push_bool(p_clip_uv);
+	}
+
+	void add_msdf_texture_rect_region(const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, int p_outline_size, float p_px_range, float p_scale) {
+		_push_command(RS::CANVAS_ITEM_BUFFER_COMMAND_MSDF_TEXTURE_RECT_REGION);
+		_push_rect(p_rect);
+		_push_rid(p_texture);
+		_push_rect(p_src_rect);
+		_push_color(p_modulate);
+		_push<int32_t>(p_outline_size);
+		_push<float>(p_px_range);
+		_push<float>(p_scale);
+	}
+
+	void add_lcd_texture_rect_region(const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate) {
+		_push_command(RS::CANVAS_ITEM_BUFFER_COMMAND_LCD_TEXTURE_RECT_REGION);
+		_push_rect(p_rect);
+		_push_rid(p_texture);
+		_push_rect(p_src_rect);
+		_push_color(p_modulate);
+	}
+
+	void add_set_transform(const Transform2D &p_transform) {
+		_push_command(RS::CANVAS_ITEM_BUFFER_COMMAND_SET_TRANSFORM);
+		const real_t v[6] = { p_transform.columns[0].x, p_transform.columns[0].y, p_transform.columns[1].x, p_transform.columns[1].y, p_transform.columns[2].x, p_transform.columns[2].y };
+		_push(v);
+	}
+
+	void add_clip_ignore(bool p_ignore) {
+		_push_command(RS::CANVAS_ITEM_BUFFER_COMMAND_CLIP_IGNORE);
+		_push_bool(p_ignore);
+	}
+
+	void add_animation_slice(double p_animation_length, double p_slice_begin, double p_slice_end, double p_offset) {
+		_push_command(RS::CANVAS_ITEM_BUFFER_COMMAND_ANIMATION_SLICE);
+		const double v[4] = { p_animation_length, p_slice_begin, p_slice_end, p_offset };
+		_push(v);
+	}
+
+	_FORCE_INLINE_ bool is_empty() const { return command_count == 0; }
+	_FORCE_INLINE_ uint32_t get_command_count() const { return command_count; }
+	_FORCE_INLINE_ uint32_t size() const { return data.size(); }
+	_FORCE_INLINE_ const uint8_t *ptr() const { return data.ptr(); }
+
+	Vector<uint8_t> to_byte_array() const {
+		Vector<uint8_t> bytes;
+		bytes.resize(data.size());
+		if (data.size()) {
+			memcpy(bytes.ptrw(), data.ptr(), data.size());
+		}
+		return bytes;
+	}
+
+	// Keeps the allocation, so a recording buffer can be reused without reallocating.
+	void clear() {
+		data.clear();
+		command_count = 0;
+	}
+};
+
+#endif // CANVAS_ITEM_COMMAND_BUFFER_H
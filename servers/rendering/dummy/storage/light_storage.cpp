@@ -0,0 +1,178 @@
+/**************************************************************************/
+/*  light_storage.cpp                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "light_storage.h"
+
+using namespace RendererDummy;
+
+LightStorage *LightStorage::singleton = nullptr;
+
+LightStorage::LightStorage() {
+	singleton = this;
+}
+
+LightStorage::~LightStorage() {
+	singleton = nullptr;
+}
+
+/* Light API */
+
+void LightStorage::_light_initialize(RID p_rid, RS::LightType p_type) {
+	DummyLight light;
+	light.type = p_type;
+
+	// Same defaults as the RD light storage, culling depends on range and angle.
+	light.param[RS::LIGHT_PARAM_ENERGY] = 1.0;
+	light.param[RS::LIGHT_PARAM_INDIRECT_ENERGY] = 1.0;
+	light.param[RS::LIGHT_PARAM_VOLUMETRIC_FOG_ENERGY] = 1.0;
+	light.param[RS::LIGHT_PARAM_SPECULAR] = 0.5;
+	light.param[RS::LIGHT_PARAM_RANGE] = 1.0;
+	light.param[RS::LIGHT_PARAM_SIZE] = 0.0;
+	light.param[RS::LIGHT_PARAM_ATTENUATION] = 1.0;
+	light.param[RS::LIGHT_PARAM_SPOT_ANGLE] = 45;
+	light.param[RS::LIGHT_PARAM_SPOT_ATTENUATION] = 1.0;
+	light.param[RS::LIGHT_PARAM_SHADOW_MAX_DISTANCE] = 0;
+	light.param[RS::LIGHT_PARAM_SHADOW_SPLIT_1_OFFSET] = 0.1;
+	light.param[RS::LIGHT_PARAM_SHADOW_SPLIT_2_OFFSET] = 0.3;
+	light.param[RS::LIGHT_PARAM_SHADOW_SPLIT_3_OFFSET] = 0.6;
+	light.param[RS::LIGHT_PARAM_SHADOW_FADE_START] = 0.8;
+	light.param[RS::LIGHT_PARAM_SHADOW_NORMAL_BIAS] = 1.0;
+	light.param[RS::LIGHT_PARAM_SHADOW_BIAS] = 0.02;
+	light.param[RS::LIGHT_PARAM_SHADOW_BLUR] = 0;
+	light.param[RS::LIGHT_PARAM_SHADOW_PANCAKE_SIZE] = 20.0;
+	light.param[RS::LIGHT_PARAM_SHADOW_OPACITY] = 1.0;
+	light.param[RS::LIGHT_PARAM_TRANSMITTANCE_BIAS] = 0.05;
+
+	light_owner.initialize_rid(p_rid, light);
+}
+
+RID LightStorage::directional_light_allocate() {
+	return light_owner.allocate_rid();
+}
+
+void LightStorage::directional_light_initialize(RID p_rid) {
+	_light_initialize(p_rid, RS::LIGHT_DIRECTIONAL);
+}
+
+RID LightStorage::omni_light_allocate() {
+	return light_owner.allocate_rid();
+}
+
+void LightStorage::omni_light_initialize(RID p_rid) {
+	_light_initialize(p_rid, RS::LIGHT_OMNI);
+}
+
+RID LightStorage::spot_light_allocate() {
+	return light_owner.allocate_rid();
+}
+
+void LightStorage::spot_light_initialize(RID p_rid) {
+	_light_initialize(p_rid, RS::LIGHT_SPOT);
+}
+
+void LightStorage::light_free(RID p_rid) {
+	DummyLight *light = light_owner.get_or_null(p_rid);
+	ERR_FAIL_NULL(light);
+
+	light_owner.free(p_rid);
+}
+
+void LightStorage::light_set_param(RID p_light, RS::LightParam p_param, float p_value) {
+	ERR_FAIL_INDEX(p_param, RS::LIGHT_PARAM_MAX);
+	DummyLight *light = light_owner.get_or_null(p_light);
+	ERR_FAIL_NULL(light);
+
+	light->param[p_param] = p_value;
+}
+
+void LightStorage::light_set_cull_mask(RID p_light, uint32_t p_mask) {
+	DummyLight *light = light_owner.get_or_null(p_light);
+	ERR_FAIL_NULL(light);
+
+	light->cull_mask = p_mask;
+}
+
+void LightStorage::light_set_bake_mode(RID p_light, RS::LightBakeMode p_bake_mode) {
+	DummyLight *light = light_owner.get_or_null(p_light);
+	ERR_FAIL_NULL(light);
+
+	light->bake_mode = p_bake_mode;
+}
+
+RS::LightType LightStorage::light_get_type(RID p_light) const {
+	const DummyLight *light = light_owner.get_or_null(p_light);
+	ERR_FAIL_NULL_V(light, RS::LIGHT_OMNI);
+
+	return light->type;
+}
+
+AABB LightStorage::light_get_aabb(RID p_light) const {
+	const DummyLight *light = light_owner.get_or_null(p_light);
+	ERR_FAIL_NULL_V(light, AABB());
+
+	switch (light->type) {
+		case RS::LIGHT_SPOT: {
+			float len = light->param[RS::LIGHT_PARAM_RANGE];
+			float size = Math::tan(Math::deg_to_rad(light->param[RS::LIGHT_PARAM_SPOT_ANGLE])) * len;
+			return AABB(Vector3(-size, -size, -len), Vector3(size * 2, size * 2, len));
+		};
+		case RS::LIGHT_OMNI: {
+			float r = light->param[RS::LIGHT_PARAM_RANGE];
+			return AABB(-Vector3(r, r, r), Vector3(r, r, r) * 2);
+		};
+		case RS::LIGHT_DIRECTIONAL: {
+			return AABB();
+		};
+	}
+
+	ERR_FAIL_V(AABB());
+}
+
+float LightStorage::light_get_param(RID p_light, RS::LightParam p_param) {
+	ERR_FAIL_INDEX_V(p_param, RS::LIGHT_PARAM_MAX, 0);
+	const DummyLight *light = light_owner.get_or_null(p_light);
+	ERR_FAIL_NULL_V(light, 0);
+
+	return light->param[p_param];
+}
+
+RS::LightBakeMode LightStorage::light_get_bake_mode(RID p_light) {
+	const DummyLight *light = light_owner.get_or_null(p_light);
+	ERR_FAIL_NULL_V(light, RS::LIGHT_BAKE_DISABLED);
+
+	return light->bake_mode;
+}
+
+uint32_t LightStorage::light_get_cull_mask(RID p_light) const {
+	const DummyLight *light = light_owner.get_or_null(p_light);
+	ERR_FAIL_NULL_V(light, 0);
+
+	return light->cull_mask;
+}
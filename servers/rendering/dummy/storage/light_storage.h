@@ -31,32 +31,58 @@
 #ifndef LIGHT_STORAGE_DUMMY_H
 #define LIGHT_STORAGE_DUMMY_H
 
+#include "core/templates/rid_owner.h"
 #include "servers/rendering/storage/light_storage.h"
 
 namespace RendererDummy {
 
 class LightStorage : public RendererLightStorage {
+private:
+	static LightStorage *singleton;
+
+	// Lights keep the state the scene cull needs (type, range, angle, masks)
+	// so culling and light pairing behave like a real renderer.
+	struct DummyLight {
+		RS::LightType type = RS::LIGHT_OMNI;
+		float param[RS::LIGHT_PARAM_MAX] = {};
+		uint32_t cull_mask = 0xFFFFFFFF;
+		RS::LightBakeMode bake_mode = RS::LIGHT_BAKE_DYNAMIC;
+	};
+
+	mutable RID_Owner<DummyLight> light_owner;
+
+	void _light_initialize(RID p_rid, RS::LightType p_type);
+
 public:
+	static LightStorage *get_singleton() {
+		return singleton;
+	};
+
+	LightStorage();
+	~LightStorage();
+
 	/* Light API */
 
-	virtual RID directional_light_allocate() override { return RID(); }
-	virtual void directional_light_initialize(RID p_rid) override {}
-	virtual RID omni_light_allocate() override { return RID(); }
-	virtual void omni_light_initialize(RID p_rid) override {}
-	virtual RID spot_light_allocate() override { return RID(); }
-	virtual void spot_light_initialize(RID p_rid) override {}
+	bool owns_light(RID p_rid) { return light_owner.owns(p_rid); };
+
+	virtual RID directional_light_allocate() override;
+	virtual void directional_light_initialize(RID p_rid) override;
+	virtual RID omni_light_allocate() override;
+	virtual void omni_light_initialize(RID p_rid) override;
+	virtual RID spot_light_allocate() override;
+	virtual void spot_light_initialize(RID p_rid) override;
 
-	virtual void light_free(RID p_rid) override {}
+	virtual void light_free(RID p_rid) override;
 
 	virtual void light_set_color(RID p_light, const Color &p_color) override {}
-	virtual void light_set_param(RID p_light, RS::LightParam p_param, float p_value) override {}
+	virtual void light_set_param(RID p_light, RS::LightParam p_param, float p_value) override;
 	virtual void light_set_shadow(RID p_light, bool p_enabled) override {}
 	virtual void light_set_projector(RID p_light, RID p_texture) override {}
 	virtual void light_set_negative(RID p_light, bool p_enable) override {}
-	virtual void light_set_cull_mask(RID p_light, uint32_t p_mask) override {}
+	virtual void light_set_cull_mask(RID p_light, uint32_t p_mask) override;
 	virtual void light_set_distance_fade(RID p_light, bool p_enabled, float p_begin, float p_shadow, float p_length) override {}
 	virtual void light_set_reverse_cull_face_mode(RID p_light, bool p_enabled) override {}
-	virtual void light_set_bake_mode(RID p_light, RS::LightBakeMode p_bake_mode) override {}
+	virtual void light_set_bake_mode(RID p_light, RS::LightBakeMode p_bake_mode) override;
 	virtual void light_set_max_sdfgi_cascade(RID p_light, uint32_t p_cascade) override {}
 
 	virtual void light_omni_set_shadow_mode(RID p_light, RS::LightOmniShadowMode p_mode) override {}
@@ -73,15 +99,15 @@ public:
 	virtual bool light_has_shadow(RID p_light) const override { return false; }
 	virtual bool light_has_projector(RID p_light) const override { return false; }
 
-	virtual RS::LightType light_get_type(RID p_light) const override { return RS::LIGHT_OMNI; }
-	virtual AABB light_get_aabb(RID p_light) const override { return AABB(); }
-	virtual float light_get_param(RID p_light, RS::LightParam p_param) override { return 0.0; }
+	virtual RS::LightType light_get_type(RID p_light) const override;
+	virtual AABB light_get_aabb(RID p_light) const override;
+	virtual float light_get_param(RID p_light, RS::LightParam p_param) override;
 	virtual Color light_get_color(RID p_light) override { return Color(); }
 	virtual bool light_get_reverse_cull_face_mode(RID p_light) const override { return false; }
-	virtual RS::LightBakeMode light_get_bake_mode(RID p_light) override { return RS::LIGHT_BAKE_DISABLED; }
+	virtual RS::LightBakeMode light_get_bake_mode(RID p_light) override;
 	virtual uint32_t light_get_max_sdfgi_cascade(RID p_light) override { return 0; }
 	virtual uint64_t light_get_version(RID p_light) const override { return 0; }
-	virtual uint32_t light_get_cull_mask(RID p_light) const override { return 0; }
+	virtual uint32_t light_get_cull_mask(RID p_light) const override;
 
 	/* LIGHT INSTANCE API */
 
@@ -31,6 +31,7 @@
 #ifndef UTILITIES_DUMMY_H
 #define UTILITIES_DUMMY_H
 
+#include "light_storage.h"
 #include "mesh_storage.h"
 #include "servers/rendering/storage/utilities.h"
 #include "texture_storage.h"
@@ -52,6 +53,8 @@ public:
 	virtual RS::InstanceType get_base_type(RID p_rid) const override {
 		if (RendererDummy::MeshStorage::get_singleton()->owns_mesh(p_rid)) {
 			return RS::INSTANCE_MESH;
+		} else if (RendererDummy::LightStorage::get_singleton()->owns_light(p_rid)) {
+			return RS::INSTANCE_LIGHT;
 		}
 		return RS::INSTANCE_NONE;
 	}
@@ -63,6 +66,9 @@ public:
 		} else if (RendererDummy::MeshStorage::get_singleton()->owns_mesh(p_rid)) {
 			RendererDummy::MeshStorage::get_singleton()->mesh_free(p_rid);
 			return true;
+		} else if (RendererDummy::LightStorage::get_singleton()->owns_light(p_rid)) {
+			RendererDummy::LightStorage::get_singleton()->light_free(p_rid);
+			return true;
 		}
 		return false;
 	}
@@ -0,0 +1,566 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "raster_occlusion_cull.h"
+
+#include "core/object/worker_thread_pool.h"
+
+// Below this amount of triangle/tile row pairs, threading costs more than it saves.
+static const uint32_t RASTER_THREAD_THRESHOLD = 4096;
+
+void RasterOcclusionCull::RasterHZBuffer::clear() {
+	HZBuffer::clear();
+
+	tile_grid_size = Size2i();
+	tile_max_depth.clear();
+	triangles.clear();
+}
+
+void RasterOcclusionCull::RasterHZBuffer::resize(const Size2i &p_size) {
+	if (p_size == Size2i()) {
+		clear();
+		return;
+	}
+
+	if (!sizes.is_empty() && p_size == sizes[0]) {
+		return; // Size didn't change
+	}
+
+	HZBuffer::resize(p_size);
+
+	tile_grid_size = Size2i((p_size.x + TILE_WIDTH - 1) / TILE_WIDTH, (p_size.y + TILE_HEIGHT - 1) / TILE_HEIGHT);
+	tile_max_depth.resize(tile_grid_size.x * tile_grid_size.y);
+}
+
+void RasterOcclusionCull::RasterHZBuffer::begin(float p_z_far) {
+	ERR_FAIL_COND(is_empty());
+
+	const uint32_t pixel_count = sizes[0].x * sizes[0].y;
+	float *depth = mips[0];
+	for (uint32_t i = 0; i < pixel_count; i++) {
+		depth[i] = FLT_MAX;
+	}
+	for (uint32_t i = 0; i < tile_max_depth.size(); i++) {
+		tile_max_depth[i] = FLT_MAX;
+	}
+
+	triangles.clear();
+	debug_tex_range = p_z_far;
+}
+
+void RasterOcclusionCull::RasterHZBuffer::add_triangles(const Vector3 *p_vertices, const uint32_t *p_indices, uint32_t p_index_count, const Projection &p_view_projection, const Transform3D &p_cam_inv_transform) {
+	ERR_FAIL_COND(is_empty());
+
+	const Vector4 *m = p_view_projection.columns;
+	const Vector3 depth_row = -p_cam_inv_transform.basis.rows[2];
+	const real_t depth_offset = -p_cam_inv_transform.origin.z;
+
+	for (uint32_t i = 0; i + 2 < p_index_count; i += 3) {
+		ClipVertex vertices[3];
+		uint32_t outside_all = 0x3F;
+		uint32_t outside_any = 0;
+
+		for (int j = 0; j < 3; j++) {
+			const Vector3 &v = p_vertices[p_indices[i + j]];
+			ClipVertex &cv = vertices[j];
+			cv.x = m[0][0] * v.x + m[1][0] * v.y + m[2][0] * v.z + m[3][0];
+			cv.y = m[0][1] * v.x + m[1][1] * v.y + m[2][1] * v.z + m[3][1];
+			cv.z = m[0][2] * v.x + m[1][2] * v.y + m[2][2] * v.z + m[3][2];
+			cv.w = m[0][3] * v.x + m[1][3] * v.y + m[2][3] * v.z + m[3][3];
+			cv.depth = depth_row.dot(v) + depth_offset;
+
+			uint32_t outcode = 0;
+			outcode |= cv.x < -cv.w ? (1 << 0) : 0;
+			outcode |= cv.x > cv.w ? (1 << 1) : 0;
+			outcode |= cv.y < -cv.w ? (1 << 2) : 0;
+			outcode |= cv.y > cv.w ? (1 << 3) : 0;
+			outcode |= cv.z < -cv.w ? (1 << 4) : 0;
+			outcode |= cv.z > cv.w ? (1 << 5) : 0;
+			outside_all &= outcode;
+			outside_any |= outcode;
+		}
+
+		if (outside_all) {
+			continue; // Fully outside one of the frustum planes.
+		}
+
+		if (!(outside_any & (1 << 4))) {
+			_setup_triangle(vertices);
+			continue;
+		}
+
+		// Clip against the near plane (z >= -w), which yields up to 4 vertices.
+		ClipVertex clipped[4];
+		int clipped_count = 0;
+		for (int j = 0; j < 3; j++) {
+			const ClipVertex &a = vertices[j];
+			const ClipVertex &b = vertices[(j + 1) % 3];
+			float da = a.z + a.w;
+			float db = b.z + b.w;
+
+			if (da >= 0.0f) {
+				clipped[clipped_count++] = a;
+			}
+			if ((da >= 0.0f) != (db >= 0.0f)) {
+				float t = da / (da - db);
+				ClipVertex &c = clipped[clipped_count++];
+				c.x = a.x + (b.x - a.x) * t;
+				c.y = a.y + (b.y - a.y) * t;
+				c.z = a.z + (b.z - a.z) * t;
+				c.w = a.w + (b.w - a.w) * t;
+				c.depth = a.depth + (b.depth - a.depth) * t;
+			}
+		}
+
+		for (int j = 2; j < clipped_count; j++) {
+			ClipVertex fan[3] = { clipped[0], clipped[j - 1], clipped[j] };
+			_setup_triangle(fan);
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_setup_triangle(const ClipVertex *p_vertices) {
+	const Size2i &buffer_size = sizes[0];
+
+	float sx[3];
+	float sy[3];
+	float iw[3];
+	float dw[3];
+	float min_depth = FLT_MAX;
+
+	for (int i = 0; i < 3; i++) {
+		const ClipVertex &v = p_vertices[i];
+		if (v.w <= CMP_EPSILON) {
+			return; // Only reachable through numerical error after clipping.
+		}
+		iw[i] = 1.0f / v.w;
+		sx[i] = (v.x * iw[i] * 0.5f + 0.5f) * buffer_size.x;
+		sy[i] = (v.y * iw[i] * 0.5f + 0.5f) * buffer_size.y;
+		dw[i] = v.depth * iw[i];
+		min_depth = MIN(min_depth, v.depth);
+	}
+
+	float area = (sx[1] - sx[0]) * (sy[2] - sy[0]) - (sx[2] - sx[0]) * (sy[1] - sy[0]);
+	if (Math::abs(area) < CMP_EPSILON) {
+		return;
+	}
+
+	// Occluders are double sided, so wind every triangle counter-clockwise.
+	if (area < 0.0f) {
+		SWAP(sx[1], sx[2]);
+		SWAP(sy[1], sy[2]);
+		SWAP(iw[1], iw[2]);
+		SWAP(dw[1], dw[2]);
+		area = -area;
+	}
+
+	int min_x = MAX(0, (int)Math::ceil(MIN(sx[0], MIN(sx[1], sx[2])) - 0.5f));
+	int min_y = MAX(0, (int)Math::ceil(MIN(sy[0], MIN(sy[1], sy[2])) - 0.5f));
+	int max_x = MIN(buffer_size.x - 1, (int)Math::floor(MAX(sx[0], MAX(sx[1], sx[2])) - 0.5f));
+	int max_y = MIN(buffer_size.y - 1, (int)Math::floor(MAX(sy[0], MAX(sy[1], sy[2])) - 0.5f));
+
+	if (min_x > max_x || min_y > max_y) {
+		return; // Covers no pixel center.
+	}
+
+	RasterTriangle triangle;
+
+	// Edge i goes from vertex i to vertex i + 1 and is zero at the opposite vertex.
+	for (int i = 0; i < 3; i++) {
+		int j = (i + 1) % 3;
+		triangle.edge_a[i] = sy[i] - sy[j];
+		triangle.edge_b[i] = sx[j] - sx[i];
+		triangle.edge_c[i] = -(triangle.edge_a[i] * sx[i] + triangle.edge_b[i] * sy[i]);
+	}
+
+	// Barycentric weight of vertex i is the edge opposite to it, divided by the area.
+	const float inv_area = 1.0f / area;
+	const int opposite[3] = { 1, 2, 0 };
+	for (int i = 0; i < 3; i++) {
+		triangle.inv_w[i] = 0.0f;
+		triangle.depth_w[i] = 0.0f;
+	}
+	for (int v = 0; v < 3; v++) {
+		int e = opposite[v];
+		triangle.inv_w[0] += triangle.edge_a[e] * iw[v] * inv_area;
+		triangle.inv_w[1] += triangle.edge_b[e] * iw[v] * inv_area;
+		triangle.inv_w[2] += triangle.edge_c[e] * iw[v] * inv_area;
+		triangle.depth_w[0] += triangle.edge_a[e] * dw[v] * inv_area;
+		triangle.depth_w[1] += triangle.edge_b[e] * dw[v] * inv_area;
+		triangle.depth_w[2] += triangle.edge_c[e] * dw[v] * inv_area;
+	}
+
+	triangle.min_depth = min_depth;
+	triangle.min_x = min_x;
+	triangle.min_y = min_y;
+	triangle.max_x = max_x;
+	triangle.max_y = max_y;
+	triangles.push_back(triangle);
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_rasterize_triangle_in_tile(const RasterTriangle &p_triangle, int p_tile_x, int p_tile_y) {
+	const int tile_index = p_tile_y * tile_grid_size.x + p_tile_x;
+	if (p_triangle.min_depth >= tile_max_depth[tile_index]) {
+		return; // The whole tile is already covered by closer occluders.
+	}
+
+	const float x0 = p_tile_x * TILE_WIDTH + 0.5f;
+	const float y0 = p_tile_y * TILE_HEIGHT + 0.5f;
+
+	// Reject the tile if any edge excludes all of its pixel centers.
+	for (int i = 0; i < 3; i++) {
+		float x = p_triangle.edge_a[i] > 0.0f ? x0 + (TILE_WIDTH - 1) : x0;
+		float y = p_triangle.edge_b[i] > 0.0f ? y0 + (TILE_HEIGHT - 1) : y0;
+		if (p_triangle.edge_a[i] * x + p_triangle.edge_b[i] * y + p_triangle.edge_c[i] < 0.0f) {
+			return;
+		}
+	}
+
+	const int buffer_width = sizes[0].x;
+	const int width = MIN(TILE_WIDTH, buffer_width - p_tile_x * TILE_WIDTH);
+	const int height = MIN(TILE_HEIGHT, sizes[0].y - p_tile_y * TILE_HEIGHT);
+
+	float tile_max = 0.0f;
+
+	for (int row = 0; row < height; row++) {
+		const float y = y0 + row;
+		float lane_depth[TILE_WIDTH];
+
+		// All lanes are evaluated branch-free so the compiler can vectorize
+		// this loop (SSE2, NEON), coverage then selects which depths land.
+		for (int lane = 0; lane < TILE_WIDTH; lane++) {
+			const float x = x0 + lane;
+			const float e0 = p_triangle.edge_a[0] * x + p_triangle.edge_b[0] * y + p_triangle.edge_c[0];
+			const float e1 = p_triangle.edge_a[1] * x + p_triangle.edge_b[1] * y + p_triangle.edge_c[1];
+			const float e2 = p_triangle.edge_a[2] * x + p_triangle.edge_b[2] * y + p_triangle.edge_c[2];
+			const float inv_w = p_triangle.inv_w[0] * x + p_triangle.inv_w[1] * y + p_triangle.inv_w[2];
+			const float depth_w = p_triangle.depth_w[0] * x + p_triangle.depth_w[1] * y + p_triangle.depth_w[2];
+			const bool inside = (e0 >= 0.0f) & (e1 >= 0.0f) & (e2 >= 0.0f);
+			lane_depth[lane] = inside ? depth_w / inv_w : FLT_MAX;
+		}
+
+		float *depth = mips[0] + (p_tile_y * TILE_HEIGHT + row) * buffer_width + p_tile_x * TILE_WIDTH;
+		for (int lane = 0; lane < width; lane++) {
+			depth[lane] = MIN(depth[lane], lane_depth[lane]);
+			tile_max = MAX(tile_max, depth[lane]);
+		}
+	}
+
+	tile_max_depth[tile_index] = tile_max;
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_rasterize_tile_row(uint32_t p_tile_row, void *p_userdata) {
+	const int row_min_y = p_tile_row * TILE_HEIGHT;
+	const int row_max_y = row_min_y + TILE_HEIGHT - 1;
+
+	for (const RasterTriangle &triangle : triangles) {
+		if (triangle.max_y < row_min_y || triangle.min_y > row_max_y) {
+			continue;
+		}
+
+		const int tile_from = triangle.min_x / TILE_WIDTH;
+		const int tile_to = triangle.max_x / TILE_WIDTH;
+		for (int tile_x = tile_from; tile_x <= tile_to; tile_x++) {
+			_rasterize_triangle_in_tile(triangle, tile_x, p_tile_row);
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::rasterize() {
+	ERR_FAIL_COND(is_empty());
+
+	// Tile rows never share pixels, so they can be rasterized in parallel without synchronization.
+	const uint32_t tile_rows = tile_grid_size.y;
+	if (triangles.size() * tile_rows >= RASTER_THREAD_THRESHOLD) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_rasterize_tile_row, (void *)nullptr, tile_rows, -1, true, SNAME("RasterOcclusionCullRasterize"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < tile_rows; i++) {
+			_rasterize_tile_row(i, nullptr);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////
+
+bool RasterOcclusionCull::is_occluder(RID p_rid) {
+	return occluders.has(p_rid);
+}
+
+RID RasterOcclusionCull::occluder_allocate() {
+	return occluder_rid_owner.allocate_rid();
+}
+
+void RasterOcclusionCull::occluder_initialize(RID p_occluder) {
+	ERR_FAIL_COND(occluders.has(p_occluder));
+	if (occluder_rid_owner.owns(p_occluder)) {
+		occluder_rid_owner.initialize_rid(p_occluder, 0);
+	}
+	occluders[p_occluder] = Occluder();
+}
+
+void RasterOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluders.getptr(p_occluder);
+	ERR_FAIL_NULL(occluder);
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+
+	for (const InstanceID &E : occluder->users) {
+		Scenario *scenario = scenarios.getptr(E.scenario);
+		ERR_CONTINUE(!scenario);
+		_mark_instance_dirty(*scenario, E.instance);
+	}
+}
+
+void RasterOcclusionCull::free_occluder(RID p_occluder) {
+	ERR_FAIL_COND(!occluders.has(p_occluder));
+	occluders.erase(p_occluder);
+	if (occluder_rid_owner.owns(p_occluder)) {
+		occluder_rid_owner.free(p_occluder);
+	}
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::_mark_instance_dirty(Scenario &p_scenario, RID p_instance) {
+	OccluderInstance *instance = p_scenario.instances.getptr(p_instance);
+	ERR_FAIL_NULL(instance);
+
+	if (!instance->dirty) {
+		instance->dirty = true;
+		p_scenario.dirty_instances.push_back(p_instance);
+	}
+}
+
+void RasterOcclusionCull::_update_scenario(Scenario &p_scenario) {
+	for (const RID &rid : p_scenario.dirty_instances) {
+		OccluderInstance *instance = p_scenario.instances.getptr(rid);
+		if (!instance) {
+			continue; // Removed after being marked dirty.
+		}
+		instance->dirty = false;
+
+		const Occluder *occluder = occluders.getptr(instance->occluder);
+		if (!occluder) {
+			instance->xformed_vertices.clear();
+			instance->indices.clear();
+			continue;
+		}
+
+		const int vertex_count = occluder->vertices.size();
+		const Vector3 *read = occluder->vertices.ptr();
+		instance->xformed_vertices.resize(vertex_count);
+		for (int i = 0; i < vertex_count; i++) {
+			instance->xformed_vertices[i] = instance->xform.xform(read[i]);
+			if (i == 0) {
+				instance->aabb = AABB(instance->xformed_vertices[i], Vector3());
+			} else {
+				instance->aabb.expand_to(instance->xformed_vertices[i]);
+			}
+		}
+
+		const int index_count = occluder->indices.size() - occluder->indices.size() % 3;
+		const int32_t *indices = occluder->indices.ptr();
+		instance->indices.clear();
+		instance->indices.reserve(index_count);
+		for (int i = 0; i < index_count; i += 3) {
+			if (indices[i] < 0 || indices[i] >= vertex_count || indices[i + 1] < 0 || indices[i + 1] >= vertex_count || indices[i + 2] < 0 || indices[i + 2] >= vertex_count) {
+				continue; // Invalid triangle, skip it instead of reading out of bounds.
+			}
+			instance->indices.push_back(indices[i]);
+			instance->indices.push_back(indices[i + 1]);
+			instance->indices.push_back(indices[i + 2]);
+		}
+	}
+
+	p_scenario.dirty_instances.clear();
+}
+
+void RasterOcclusionCull::add_scenario(RID p_scenario) {
+	ERR_FAIL_COND(scenarios.has(p_scenario));
+	scenarios[p_scenario] = Scenario();
+}
+
+void RasterOcclusionCull::remove_scenario(RID p_scenario) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_NULL(scenario);
+
+	for (const KeyValue<RID, OccluderInstance> &E : scenario->instances) {
+		Occluder *occluder = occluders.getptr(E.value.occluder);
+		if (occluder) {
+			occluder->users.erase(InstanceID(p_scenario, E.key));
+		}
+	}
+	scenarios.erase(p_scenario);
+}
+
+void RasterOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_NULL(scenario);
+
+	OccluderInstance *instance = scenario->instances.getptr(p_instance);
+	if (!instance) {
+		scenario->instances[p_instance] = OccluderInstance();
+		instance = scenario->instances.getptr(p_instance);
+		scenario->dirty_instances.push_back(p_instance);
+	}
+
+	bool changed = false;
+
+	if (instance->occluder != p_occluder) {
+		Occluder *old_occluder = occluders.getptr(instance->occluder);
+		if (old_occluder) {
+			old_occluder->users.erase(InstanceID(p_scenario, p_instance));
+		}
+
+		instance->occluder = p_occluder;
+
+		if (p_occluder.is_valid()) {
+			Occluder *occluder = occluders.getptr(p_occluder);
+			ERR_FAIL_NULL(occluder);
+			occluder->users.insert(InstanceID(p_scenario, p_instance));
+		}
+		changed = true;
+	}
+
+	if (instance->xform != p_xform) {
+		instance->xform = p_xform;
+		changed = true;
+	}
+
+	instance->enabled = p_enabled;
+
+	if (changed) {
+		_mark_instance_dirty(*scenario, p_instance);
+	}
+}
+
+void RasterOcclusionCull::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_NULL(scenario);
+
+	OccluderInstance *instance = scenario->instances.getptr(p_instance);
+	if (!instance) {
+		return;
+	}
+
+	Occluder *occluder = occluders.getptr(instance->occluder);
+	if (occluder) {
+		occluder->users.erase(InstanceID(p_scenario, p_instance));
+	}
+	scenario->instances.erase(p_instance);
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = RasterHZBuffer();
+}
+
+void RasterOcclusionCull::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+RasterOcclusionCull::HZBuffer *RasterOcclusionCull::buffer_get_ptr(RID p_buffer) {
+	return buffers.getptr(p_buffer);
+}
+
+void RasterOcclusionCull::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+}
+
+void RasterOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+void RasterOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	RasterHZBuffer *buffer = buffers.getptr(p_buffer);
+	if (!buffer || buffer->is_empty()) {
+		return;
+	}
+
+	Scenario *scenario = scenarios.getptr(buffer->scenario_rid);
+	if (!scenario) {
+		return;
+	}
+
+	_update_scenario(*scenario);
+
+	const Transform3D cam_inv_transform = p_cam_transform.affine_inverse();
+	const Projection view_projection = p_cam_projection * Projection(cam_inv_transform);
+	const Vector<Plane> planes = p_cam_projection.get_projection_planes(p_cam_transform);
+
+	buffer->begin(p_cam_projection.get_z_far());
+
+	for (const KeyValue<RID, OccluderInstance> &E : scenario->instances) {
+		const OccluderInstance &instance = E.value;
+		if (!instance.enabled || instance.indices.is_empty()) {
+			continue;
+		}
+
+		bool outside = false;
+		for (const Plane &plane : planes) {
+			if (plane.is_point_over(instance.aabb.get_support(-plane.normal))) {
+				outside = true;
+				break;
+			}
+		}
+		if (outside) {
+			continue;
+		}
+
+		buffer->add_triangles(instance.xformed_vertices.ptr(), instance.indices.ptr(), instance.indices.size(), view_projection, cam_inv_transform);
+	}
+
+	buffer->rasterize();
+	buffer->update_mips();
+}
+
+RID RasterOcclusionCull::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
+
+RasterOcclusionCull::RasterOcclusionCull() {
+	software_singleton = this;
+}
+
+RasterOcclusionCull::~RasterOcclusionCull() {
+	if (software_singleton == this) {
+		software_singleton = nullptr;
+		software_mirror_enabled = false;
+	}
+}
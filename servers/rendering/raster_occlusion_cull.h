@@ -0,0 +1,167 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef RASTER_OCCLUSION_CULL_H
+#define RASTER_OCCLUSION_CULL_H
+
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/rid_owner.h"
+#include "servers/rendering/renderer_scene_occlusion_cull.h"
+
+// Software occlusion culler that rasterizes occluder triangles on the CPU into
+// a tiled depth buffer, in the spirit of Masked Occlusion Culling. It needs no
+// ray tracing library, so it is used when none is available, and it can also
+// be selected per viewport next to another culler.
+class RasterOcclusionCull : public RendererSceneOcclusionCull {
+public:
+	// Pixels are processed in tiles of 8x4 (32 pixels), one row of 8 lanes at a time.
+	static const int TILE_WIDTH = 8;
+	static const int TILE_HEIGHT = 4;
+
+	struct RasterTriangle {
+		// Edge functions, E(x, y) = a * x + b * y + c, positive inside.
+		float edge_a[3];
+		float edge_b[3];
+		float edge_c[3];
+		// Screen-space planes for 1/w and depth/w, view depth is their ratio.
+		float inv_w[3];
+		float depth_w[3];
+		float min_depth = 0.0f;
+		int min_x = 0;
+		int min_y = 0;
+		int max_x = 0;
+		int max_y = 0;
+	};
+
+	class RasterHZBuffer : public HZBuffer {
+		Size2i tile_grid_size;
+		LocalVector<float> tile_max_depth;
+		LocalVector<RasterTriangle> triangles;
+
+		struct ClipVertex {
+			float x, y, z, w;
+			float depth;
+		};
+
+		void _setup_triangle(const ClipVertex *p_vertices);
+		void _rasterize_triangle_in_tile(const RasterTriangle &p_triangle, int p_tile_x, int p_tile_y);
+		void _rasterize_tile_row(uint32_t p_tile_row, void *p_userdata);
+
+	public:
+		RID scenario_rid;
+
+		virtual void clear() override;
+		virtual void resize(const Size2i &p_size) override;
+
+		void begin(float p_z_far);
+		void add_triangles(const Vector3 *p_vertices, const uint32_t *p_indices, uint32_t p_index_count, const Projection &p_view_projection, const Transform3D &p_cam_inv_transform);
+		void rasterize();
+		uint32_t get_triangle_count() const { return triangles.size(); }
+	};
+
+private:
+	struct InstanceID {
+		RID scenario;
+		RID instance;
+
+		static uint32_t hash(const InstanceID &p_ins) {
+			uint32_t h = hash_murmur3_one_64(p_ins.scenario.get_id());
+			return hash_fmix32(hash_murmur3_one_64(p_ins.instance.get_id(), h));
+		}
+		bool operator==(const InstanceID &rhs) const {
+			return instance == rhs.instance && rhs.scenario == scenario;
+		}
+
+		InstanceID() {}
+		InstanceID(RID s, RID i) :
+				scenario(s), instance(i) {}
+	};
+
+	struct Occluder {
+		PackedVector3Array vertices;
+		PackedInt32Array indices;
+		HashSet<InstanceID, InstanceID> users;
+	};
+
+	struct OccluderInstance {
+		RID occluder;
+		LocalVector<Vector3> xformed_vertices;
+		LocalVector<uint32_t> indices;
+		AABB aabb;
+		Transform3D xform;
+		bool enabled = true;
+		bool dirty = true;
+	};
+
+	struct Scenario {
+		HashMap<RID, OccluderInstance> instances;
+		LocalVector<RID> dirty_instances;
+	};
+
+	// Occluders are keyed by RID rather than owned, as the RIDs come from the
+	// main culler when this one only mirrors its data.
+	HashMap<RID, Occluder> occluders;
+	RID_Owner<uint8_t> occluder_rid_owner;
+	HashMap<RID, Scenario> scenarios;
+	HashMap<RID, RasterHZBuffer> buffers;
+
+	void _mark_instance_dirty(Scenario &p_scenario, RID p_instance);
+	void _update_scenario(Scenario &p_scenario);
+
+public:
+	virtual bool is_occluder(RID p_rid) override;
+	virtual RID occluder_allocate() override;
+	virtual void occluder_initialize(RID p_occluder) override;
+	virtual void occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) override;
+	virtual void free_occluder(RID p_occluder) override;
+
+	virtual void add_scenario(RID p_scenario) override;
+	virtual void remove_scenario(RID p_scenario) override;
+	virtual void scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) override;
+	virtual void scenario_remove_instance(RID p_scenario, RID p_instance) override;
+
+	virtual void add_buffer(RID p_buffer) override;
+	virtual void remove_buffer(RID p_buffer) override;
+	virtual HZBuffer *buffer_get_ptr(RID p_buffer) override;
+	virtual void buffer_set_scenario(RID p_buffer, RID p_scenario) override;
+	virtual void buffer_set_size(RID p_buffer, const Vector2i &p_size) override;
+	virtual void buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) override;
+
+	virtual RID buffer_get_debug_texture(RID p_buffer) override;
+
+	virtual void set_build_quality(RS::ViewportOcclusionCullingBuildQuality p_quality) override {}
+
+	RasterOcclusionCull();
+	~RasterOcclusionCull();
+};
+
+#endif // RASTER_OCCLUSION_CULL_H
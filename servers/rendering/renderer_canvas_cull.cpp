@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/math/geometry_2d.h"
+#include "canvas_item_command_buffer.h"
 #include "renderer_viewport.h"
 #include "rendering_server_default.h"
 #include "rendering_server_globals.h"
@@ -1127,14 +1128,18 @@ void RendererCanvasCull::canvas_item_add_multiline(RID p_item, const Vector<Poin
 	}
 }
 
+void RendererCanvasCull::_canvas_item_add_rect(Item *p_canvas_item, const Rect2 &p_rect, const Color &p_color) {
+	Item::CommandRect *rect = p_canvas_item->alloc_command<Item::CommandRect>();
+	ERR_FAIL_NULL(rect);
+	rect->modulate = p_color;
+	rect->rect = p_rect;
+}
+
 void RendererCanvasCull::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, const Color &p_color) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
-	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
-	ERR_FAIL_NULL(rect);
-	rect->modulate = p_color;
-	rect->rect = p_rect;
+	_canvas_item_add_rect(canvas_item, p_rect, p_color);
 }
 
 void RendererCanvasCull::canvas_item_add_circle(RID p_item, const Point2 &p_pos, float p_radius, const Color &p_color) {
@@ -1176,11 +1181,8 @@ void RendererCanvasCull::canvas_item_add_circle(RID p_item, const Point2 &p_pos,
 	circle->polygon.create(indices, points, color);
 }
 
-void RendererCanvasCull::canvas_item_add_texture_rect(RID p_item, const Rect2 &p_rect, RID p_texture, bool p_tile, const Color &p_modulate, bool p_transpose) {
-	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
-	ERR_FAIL_NULL(canvas_item);
-
-	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
+void RendererCanvasCull::_canvas_item_add_texture_rect(Item *p_canvas_item, const Rect2 &p_rect, RID p_texture, bool p_tile, const Color &p_modulate, bool p_transpose) {
+	Item::CommandRect *rect = p_canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
 	rect->modulate = p_modulate;
 	rect->rect = p_rect;
@@ -1207,11 +1209,15 @@ void RendererCanvasCull::canvas_item_add_texture_rect(RID p_item, const Rect2 &p
 	rect->texture = p_texture;
 }
 
-void RendererCanvasCull::canvas_item_add_msdf_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, int p_outline_size, float p_px_range, float p_scale) {
+void RendererCanvasCull::canvas_item_add_texture_rect(RID p_item, const Rect2 &p_rect, RID p_texture, bool p_tile, const Color &p_modulate, bool p_transpose) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
-	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
+	_canvas_item_add_texture_rect(canvas_item, p_rect, p_texture, p_tile, p_modulate, p_transpose);
+}
+
+void RendererCanvasCull::_canvas_item_add_msdf_texture_rect_region(Item *p_canvas_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, int p_outline_size, float p_px_range, float p_scale) {
+	Item::CommandRect *rect = p_canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
 	rect->modulate = p_modulate;
 	rect->rect = p_rect;
@@ -1241,11 +1247,15 @@ void RendererCanvasCull::canvas_item_add_msdf_texture_rect_region(RID p_item, co
 	rect->px_range = p_px_range;
 }
 
-void RendererCanvasCull::canvas_item_add_lcd_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate) {
+void RendererCanvasCull::canvas_item_add_msdf_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, int p_outline_size, float p_px_range, float p_scale) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
-	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
+	_canvas_item_add_msdf_texture_rect_region(canvas_item, p_rect, p_texture, p_src_rect, p_modulate, p_outline_size, p_px_range, p_scale);
+}
+
+void RendererCanvasCull::_canvas_item_add_lcd_texture_rect_region(Item *p_canvas_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate) {
+	Item::CommandRect *rect = p_canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
 	rect->modulate = p_modulate;
 	rect->rect = p_rect;
@@ -1273,11 +1283,15 @@ void RendererCanvasCull::canvas_item_add_lcd_texture_rect_region(RID p_item, con
 	}
 }
 
-void RendererCanvasCull::canvas_item_add_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, bool p_transpose, bool p_clip_uv) {
+void RendererCanvasCull::canvas_item_add_lcd_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
-	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
+	_canvas_item_add_lcd_texture_rect_region(canvas_item, p_rect, p_texture, p_src_rect, p_modulate);
+}
+
+void RendererCanvasCull::_canvas_item_add_texture_rect_region(Item *p_canvas_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, bool p_transpose, bool p_clip_uv) {
+	Item::CommandRect *rect = p_canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
 	rect->modulate = p_modulate;
 	rect->rect = p_rect;
@@ -1314,6 +1328,13 @@ void RendererCanvasCull::canvas_item_add_texture_rect_region(RID p_item, const R
 	}
 }
 
+void RendererCanvasCull::canvas_item_add_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, bool p_transpose, bool p_clip_uv) {
+	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
+	ERR_FAIL_NULL(canvas_item);
+
+	_canvas_item_add_texture_rect_region(canvas_item, p_rect, p_texture, p_src_rect, p_modulate, p_transpose, p_clip_uv);
+}
+
 void RendererCanvasCull::canvas_item_add_nine_patch(RID p_item, const Rect2 &p_rect, const Rect2 &p_source, RID p_texture, const Vector2 &p_topleft, const Vector2 &p_bottomright, RS::NinePatchAxisMode p_x_axis_mode, RS::NinePatchAxisMode p_y_axis_mode, bool p_draw_center, const Color &p_modulate) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
@@ -1408,13 +1429,17 @@ void RendererCanvasCull::canvas_item_add_triangle_array(RID p_item, const Vector
 	polygon->primitive = RS::PRIMITIVE_TRIANGLES;
 }
 
+void RendererCanvasCull::_canvas_item_add_set_transform(Item *p_canvas_item, const Transform2D &p_transform) {
+	Item::CommandTransform *tr = p_canvas_item->alloc_command<Item::CommandTransform>();
+	ERR_FAIL_NULL(tr);
+	tr->xform = p_transform;
+}
+
 void RendererCanvasCull::canvas_item_add_set_transform(RID p_item, const Transform2D &p_transform) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
-	Item::CommandTransform *tr = canvas_item->alloc_command<Item::CommandTransform>();
-	ERR_FAIL_NULL(tr);
-	tr->xform = p_transform;
+	_canvas_item_add_set_transform(canvas_item, p_transform);
 }
 
 void RendererCanvasCull::canvas_item_add_mesh(RID p_item, const RID &p_mesh, const Transform2D &p_transform, const Color &p_modulate, RID p_texture) {
@@ -1461,20 +1486,21 @@ void RendererCanvasCull::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p
 	mm->texture = p_texture;
 }
 
-void RendererCanvasCull::canvas_item_add_clip_ignore(RID p_item, bool p_ignore) {
-	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
-	ERR_FAIL_NULL(canvas_item);
-
-	Item::CommandClipIgnore *ci = canvas_item->alloc_command<Item::CommandClipIgnore>();
+void RendererCanvasCull::_canvas_item_add_clip_ignore(Item *p_canvas_item, bool p_ignore) {
+	Item::CommandClipIgnore *ci = p_canvas_item->alloc_command<Item::CommandClipIgnore>();
 	ERR_FAIL_NULL(ci);
 	ci->ignore = p_ignore;
 }
 
-void RendererCanvasCull::canvas_item_add_animation_slice(RID p_item, double p_animation_length, double p_slice_begin, double p_slice_end, double p_offset) {
+void RendererCanvasCull::canvas_item_add_clip_ignore(RID p_item, bool p_ignore) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
-	Item::CommandAnimationSlice *as = canvas_item->alloc_command<Item::CommandAnimationSlice>();
+	_canvas_item_add_clip_ignore(canvas_item, p_ignore);
+}
+
+void RendererCanvasCull::_canvas_item_add_animation_slice(Item *p_canvas_item, double p_animation_length, double p_slice_begin, double p_slice_end, double p_offset) {
+	Item::CommandAnimationSlice *as = p_canvas_item->alloc_command<Item::CommandAnimationSlice>();
 	ERR_FAIL_NULL(as);
 	as->animation_length = p_animation_length;
 	as->slice_begin = p_slice_begin;
@@ -1482,6 +1508,95 @@ void RendererCanvasCull::canvas_item_add_animation_slice(RID p_item, double p_an
 	as->offset = p_offset;
 }
 
+void RendererCanvasCull::canvas_item_add_animation_slice(RID p_item, double p_animation_length, double p_slice_begin, double p_slice_end, double p_offset) {
+	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
+	ERR_FAIL_NULL(canvas_item);
+
+	_canvas_item_add_animation_slice(canvas_item, p_animation_length, p_slice_begin, p_slice_end, p_offset);
+}
+
+void RendererCanvasCull::canvas_item_add_command_buffer(RID p_item, const Vector<uint8_t> &p_buffer) {
+	canvas_item_add_commands(p_item, p_buffer.ptr(), p_buffer.size());
+}
+
+void RendererCanvasCull::canvas_item_add_commands(RID p_item, const uint8_t *p_data, uint32_t p_size) {
+	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
+	ERR_FAIL_NULL(canvas_item);
+
+	// Arguments are read into locals first, the evaluation order of call arguments is unspecified.
+	CanvasItemCommandBuffer::Reader reader(p_data, p_size);
+	while (reader.has_next()) {
+		const uint32_t command = reader.read_command();
+		switch (command) {
+			case RS::CANVAS_ITEM_BUFFER_COMMAND_RECT: {
+				const Rect2 rect = reader.read_rect();
+				const Color color = reader.read_color();
+				ERR_FAIL_COND_MSG(reader.has_error(), "Truncated canvas item command buffer.");
+				_canvas_item_add_rect(canvas_item, rect, color);
+			} break;
+			case RS::CANVAS_ITEM_BUFFER_COMMAND_TEXTURE_RECT: {
+				const Rect2 rect = reader.read_rect();
+				const RID texture = reader.read_rid();
+				const Color modulate = reader.read_color();
+				const bool tile = reader.read_bool();
+				const bool transpose = reader.read_bool();
+				ERR_FAIL_COND_MSG(reader.has_error(), "Truncated canvas item command buffer.");
+				_canvas_item_add_texture_rect(canvas_item, rect, texture, tile, modulate, transpose);
+			} break;
+			case RS::CANVAS_ITEM_BUFFER_COMMAND_TEXTURE_RECT_REGION: {
+				const Rect2 rect = reader.read_rect();
+				const RID texture = reader.read_rid();
+				const Rect2 src_rect = reader.read_rect();
+				const Color modulate = reader.read_color();
+				const bool transpose = reader.read_bool();
+				const bool clip_uv = reader.read_bool();
+				ERR_FAIL_COND_MSG(reader.has_error(), "Truncated canvas item command buffer.");
+				_canvas_item_add_texture_rect_region(canvas_item, rect, texture, src_rect, modulate, transpose, clip_uv);
+			} break;
+			case RS::CANVAS_ITEM_BUFFER_COMMAND_MSDF_TEXTURE_RECT_REGION: {
+				const Rect2 rect = reader.read_rect();
+				const RID texture = reader.read_rid();
+				const Rect2 src_rect = reader.read_rect();
+				const Color modulate = reader.read_color();
+				const int outline_size = reader.read_int();
+				const float px_range = reader.read_float();
+				const float scale = reader.read_float();
+				ERR_FAIL_COND_MSG(reader.has_error(), "Truncated canvas item command buffer.");
+				_canvas_item_add_msdf_texture_rect_region(canvas_item, rect, texture, src_rect, modulate, outline_size, px_range, scale);
+			} break;
+			case RS::CANVAS_ITEM_BUFFER_COMMAND_LCD_TEXTURE_RECT_REGION: {
+				const Rect2 rect = reader.read_rect();
+				const RID texture = reader.read_rid();
+				const Rect2 src_rect = reader.read_rect();
+				const Color modulate = reader.read_color();
+				ERR_FAIL_COND_MSG(reader.has_error(), "Truncated canvas item command buffer.");
+				_canvas_item_add_lcd_texture_rect_region(canvas_item, rect, texture, src_rect, modulate);
+			} break;
+			case RS::CANVAS_ITEM_BUFFER_COMMAND_SET_TRANSFORM: {
+				const Transform2D transform = reader.read_transform();
+				ERR_FAIL_COND_MSG(reader.has_error(), "Truncated canvas item command buffer.");
+				_canvas_item_add_set_transform(canvas_item, transform);
+			} break;
+			case RS::CANVAS_ITEM_BUFFER_COMMAND_CLIP_IGNORE: {
+				const bool ignore = reader.read_bool();
+				ERR_FAIL_COND_MSG(reader.has_error(), "Truncated canvas item command buffer.");
+				_canvas_item_add_clip_ignore(canvas_item, ignore);
+			} break;
+			case RS::CANVAS_ITEM_BUFFER_COMMAND_ANIMATION_SLICE: {
+				const double animation_length = reader.read_double();
+				const double slice_begin = reader.read_double();
+				const double slice_end = reader.read_double();
+				const double offset = reader.read_double();
+				ERR_FAIL_COND_MSG(reader.has_error(), "Truncated canvas item command buffer.");
+				_canvas_item_add_animation_slice(canvas_item, animation_length, slice_begin, slice_end, offset);
+			} break;
+			default: {
+				ERR_FAIL_MSG(vformat("Invalid canvas item buffer command: %d.", command));
+			}
+		}
+	}
+}
+
 void RendererCanvasCull::canvas_item_set_sort_children_by_y(RID p_item, bool p_enable) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
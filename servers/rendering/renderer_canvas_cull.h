@@ -192,6 +192,16 @@ private:
 	RendererCanvasRender::Item **z_list;
 	RendererCanvasRender::Item **z_last_list;
 
+	// Shared by the canvas_item_add_*() functions and command buffers.
+	void _canvas_item_add_rect(Item *p_canvas_item, const Rect2 &p_rect, const Color &p_color);
+	void _canvas_item_add_texture_rect(Item *p_canvas_item, const Rect2 &p_rect, RID p_texture, bool p_tile, const Color &p_modulate, bool p_transpose);
+	void _canvas_item_add_texture_rect_region(Item *p_canvas_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, bool p_transpose, bool p_clip_uv);
+	void _canvas_item_add_msdf_texture_rect_region(Item *p_canvas_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, int p_outline_size, float p_px_range, float p_scale);
+	void _canvas_item_add_lcd_texture_rect_region(Item *p_canvas_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate);
+	void _canvas_item_add_set_transform(Item *p_canvas_item, const Transform2D &p_transform);
+	void _canvas_item_add_clip_ignore(Item *p_canvas_item, bool p_ignore);
+	void _canvas_item_add_animation_slice(Item *p_canvas_item, double p_animation_length, double p_slice_begin, double p_slice_end, double p_offset);
+
 public:
 	void render_canvas(RID p_render_target, Canvas *p_canvas, const Transform2D &p_transform, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, const Rect2 &p_clip_rect, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_transforms_to_pixel, bool p_snap_2d_vertices_to_pixel, uint32_t canvas_cull_mask);
 
@@ -246,6 +256,9 @@ public:
 	void canvas_item_add_set_transform(RID p_item, const Transform2D &p_transform);
 	void canvas_item_add_clip_ignore(RID p_item, bool p_ignore);
 	void canvas_item_add_animation_slice(RID p_item, double p_animation_length, double p_slice_begin, double p_slice_end, double p_offset);
+	void canvas_item_add_command_buffer(RID p_item, const Vector<uint8_t> &p_buffer);
+	// Same as above, for callers on the server thread that don't need a copy of their buffer.
+	void canvas_item_add_commands(RID p_item, const uint8_t *p_data, uint32_t p_size);
 
 	void canvas_item_set_sort_children_by_y(RID p_item, bool p_enable);
 	void canvas_item_set_z_index(RID p_item, int p_z);
@@ -31,8 +31,10 @@
 #include "renderer_scene_cull.h"
 
 #include "core/config/project_settings.h"
+#include "core/math/simd_batch.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "raster_occlusion_cull.h"
 #include "rendering_server_default.h"
 
 #include <new>
@@ -132,10 +134,16 @@ RID RendererSceneCull::occluder_allocate() {
 
 void RendererSceneCull::occluder_initialize(RID p_rid) {
 	RendererSceneOcclusionCull::get_singleton()->occluder_initialize(p_rid);
+	if (RendererSceneOcclusionCull::get_mirror_singleton()) {
+		RendererSceneOcclusionCull::get_mirror_singleton()->occluder_initialize(p_rid);
+	}
 }
 
 void RendererSceneCull::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
 	RendererSceneOcclusionCull::get_singleton()->occluder_set_mesh(p_occluder, p_vertices, p_indices);
+	if (RendererSceneOcclusionCull::get_mirror_singleton()) {
+		RendererSceneOcclusionCull::get_mirror_singleton()->occluder_set_mesh(p_occluder, p_vertices, p_indices);
+	}
 }
 
 /* SCENARIO API */
@@ -382,10 +390,14 @@ void RendererSceneCull::scenario_initialize(RID p_rid) {
 	scenario->reflection_atlas = RSG::light_storage->reflection_atlas_create();
 
 	scenario->instance_aabbs.set_page_pool(&instance_aabb_page_pool);
+	scenario->instance_cull_data.set_page_pool(&instance_cull_block_page_pool);
 	scenario->instance_data.set_page_pool(&instance_data_page_pool);
 	scenario->instance_visibility.set_page_pool(&instance_visibility_data_page_pool);
 
 	RendererSceneOcclusionCull::get_singleton()->add_scenario(p_rid);
+	if (RendererSceneOcclusionCull::get_mirror_singleton()) {
+		RendererSceneOcclusionCull::get_mirror_singleton()->add_scenario(p_rid);
+	}
 }
 
 void RendererSceneCull::scenario_set_environment(RID p_scenario, RID p_environment) {
@@ -605,6 +617,9 @@ void RendererSceneCull::instance_set_base(RID p_instance, RID p_base) {
 			case RS::INSTANCE_OCCLUDER: {
 				if (scenario && instance->visible) {
 					RendererSceneOcclusionCull::get_singleton()->scenario_remove_instance(instance->scenario->self, p_instance);
+					if (RendererSceneOcclusionCull::get_mirror_singleton()) {
+						RendererSceneOcclusionCull::get_mirror_singleton()->scenario_remove_instance(instance->scenario->self, p_instance);
+					}
 				}
 			} break;
 			default: {
@@ -732,6 +747,9 @@ void RendererSceneCull::instance_set_base(RID p_instance, RID p_base) {
 			case RS::INSTANCE_OCCLUDER: {
 				if (scenario) {
 					RendererSceneOcclusionCull::get_singleton()->scenario_set_instance(scenario->self, p_instance, p_base, instance->transform, instance->visible);
+					if (RendererSceneOcclusionCull::get_mirror_singleton()) {
+						RendererSceneOcclusionCull::get_mirror_singleton()->scenario_set_instance(scenario->self, p_instance, p_base, instance->transform, instance->visible);
+					}
 				}
 			} break;
 			default: {
@@ -808,6 +826,9 @@ void RendererSceneCull::instance_set_scenario(RID p_instance, RID p_scenario) {
 			case RS::INSTANCE_OCCLUDER: {
 				if (instance->visible) {
 					RendererSceneOcclusionCull::get_singleton()->scenario_remove_instance(instance->scenario->self, p_instance);
+					if (RendererSceneOcclusionCull::get_mirror_singleton()) {
+						RendererSceneOcclusionCull::get_mirror_singleton()->scenario_remove_instance(instance->scenario->self, p_instance);
+					}
 				}
 			} break;
 			default: {
@@ -841,6 +862,9 @@ void RendererSceneCull::instance_set_scenario(RID p_instance, RID p_scenario) {
 			} break;
 			case RS::INSTANCE_OCCLUDER: {
 				RendererSceneOcclusionCull::get_singleton()->scenario_set_instance(scenario->self, p_instance, instance->base, instance->transform, instance->visible);
+				if (RendererSceneOcclusionCull::get_mirror_singleton()) {
+					RendererSceneOcclusionCull::get_mirror_singleton()->scenario_set_instance(scenario->self, p_instance, instance->base, instance->transform, instance->visible);
+				}
 			} break;
 			default: {
 			}
@@ -861,6 +885,7 @@ void RendererSceneCull::instance_set_layer_mask(RID p_instance, uint32_t p_mask)
 	instance->layer_mask = p_mask;
 	if (instance->scenario && instance->array_index >= 0) {
 		instance->scenario->instance_data[instance->array_index].layer_mask = p_mask;
+		instance->scenario->instance_cull_data.set_layer_mask(instance->array_index, p_mask);
 	}
 
 	if ((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK && instance->base_data) {
@@ -1005,6 +1030,9 @@ void RendererSceneCull::instance_set_visible(RID p_instance, bool p_visible) {
 	if (instance->base_type == RS::INSTANCE_OCCLUDER) {
 		if (instance->scenario) {
 			RendererSceneOcclusionCull::get_singleton()->scenario_set_instance(instance->scenario->self, p_instance, instance->base, instance->transform, p_visible);
+			if (RendererSceneOcclusionCull::get_mirror_singleton()) {
+				RendererSceneOcclusionCull::get_mirror_singleton()->scenario_set_instance(instance->scenario->self, p_instance, instance->base, instance->transform, p_visible);
+			}
 		}
 	}
 }
@@ -1084,6 +1112,7 @@ void RendererSceneCull::instance_set_ignore_culling(RID p_instance, bool p_enabl
 		} else {
 			idata.flags &= ~uint32_t(InstanceData::FLAG_IGNORE_ALL_CULLING);
 		}
+		instance->scenario->instance_cull_data.set_flags(instance->array_index, idata.flags & InstanceData::FLAG_IGNORE_ALL_CULLING);
 	}
 }
 
@@ -1621,6 +1650,9 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 	} else if (p_instance->base_type == RS::INSTANCE_OCCLUDER) {
 		if (p_instance->scenario) {
 			RendererSceneOcclusionCull::get_singleton()->scenario_set_instance(p_instance->scenario->self, p_instance->self, p_instance->base, p_instance->transform, p_instance->visible);
+			if (RendererSceneOcclusionCull::get_mirror_singleton()) {
+				RendererSceneOcclusionCull::get_mirror_singleton()->scenario_set_instance(p_instance->scenario->self, p_instance->self, p_instance->base, p_instance->transform, p_instance->visible);
+			}
 		}
 	}
 
@@ -1780,14 +1812,17 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 
 		p_instance->scenario->instance_data.push_back(idata);
 		p_instance->scenario->instance_aabbs.push_back(InstanceBounds(p_instance->transformed_aabb));
+		p_instance->scenario->instance_cull_data.push_back(p_instance->transformed_aabb, idata.layer_mask, idata.flags & InstanceData::FLAG_IGNORE_ALL_CULLING);
 		_update_instance_visibility_dependencies(p_instance);
 	} else {
+		// Small motions only refit the BVH, the refits are batched and applied at the end of the instance update.
 		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
-			p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].update(p_instance->indexer_id, bvh_aabb);
+			p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].refit(p_instance->indexer_id, bvh_aabb);
 		} else {
-			p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].update(p_instance->indexer_id, bvh_aabb);
+			p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].refit(p_instance->indexer_id, bvh_aabb);
 		}
 		p_instance->scenario->instance_aabbs[p_instance->array_index] = InstanceBounds(p_instance->transformed_aabb);
+		p_instance->scenario->instance_cull_data.set_bounds(p_instance->array_index, p_instance->transformed_aabb);
 	}
 
 	if (p_instance->visibility_index != -1) {
@@ -1875,6 +1910,7 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 		swapped_instance->array_index = p_instance->array_index; //swap
 		p_instance->scenario->instance_data[p_instance->array_index] = p_instance->scenario->instance_data[swap_with_index];
 		p_instance->scenario->instance_aabbs[p_instance->array_index] = p_instance->scenario->instance_aabbs[swap_with_index];
+		p_instance->scenario->instance_cull_data.move(p_instance->array_index, swap_with_index);
 
 		if (swapped_instance->visibility_index != -1) {
 			swapped_instance->scenario->instance_visibility[swapped_instance->visibility_index].array_index = swapped_instance->array_index;
@@ -1891,6 +1927,7 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 	// pop last
 	p_instance->scenario->instance_data.pop_back();
 	p_instance->scenario->instance_aabbs.pop_back();
+	p_instance->scenario->instance_cull_data.pop_back();
 
 	//uninitialize
 	p_instance->array_index = -1;
@@ -2610,7 +2647,7 @@ void RendererSceneCull::render_camera(const Ref<RenderSceneBuffers> &p_render_bu
 
 	RENDER_TIMESTAMP("Update Occlusion Buffer")
 	// For now just cull on the first camera
-	RendererSceneOcclusionCull::get_singleton()->buffer_update(p_viewport, camera_data.main_transform, camera_data.main_projection, camera_data.is_orthogonal);
+	RendererSceneOcclusionCull::get_buffer_singleton(p_viewport)->buffer_update(p_viewport, camera_data.main_transform, camera_data.main_projection, camera_data.is_orthogonal);
 
 	_render_scene(&camera_data, p_render_buffers, environment, camera->attributes, camera->visible_layers, p_scenario, p_viewport, p_shadow_atlas, RID(), -1, p_screen_mesh_lod_threshold, true, r_render_info);
 #endif
@@ -2721,6 +2758,26 @@ void RendererSceneCull::_scene_cull_threaded(uint32_t p_thread, CullData *cull_d
 	_scene_cull(*cull_data, scene_cull_result_threads[p_thread], cull_from, cull_to);
 }
 
+uint32_t RendererSceneCull::InstanceCullBlock::cull(const Plane *p_planes, uint32_t p_plane_count, uint32_t p_visible_layers) const {
+	SIMDBatch::AABBSoA aabbs;
+	for (int i = 0; i < 3; i++) {
+		// Only read by the kernel.
+		aabbs.position[i] = const_cast<real_t *>(position[i]);
+		aabbs.size[i] = const_cast<real_t *>(size[i]);
+	}
+
+	uint8_t inside[SIZE];
+	SIMDBatch::cull_aabbs(p_planes, p_plane_count, aabbs, inside, SIZE);
+
+	uint32_t mask = 0;
+	for (uint32_t i = 0; i < SIZE; i++) {
+		if (inside[i] && (layer_mask[i] & p_visible_layers)) {
+			mask |= 1u << i;
+		}
+	}
+	return mask;
+}
+
 void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cull_result, uint64_t p_from, uint64_t p_to) {
 	uint64_t frame_number = RSG::rasterizer->get_frame_number();
 	float lightmap_probe_update_speed = RSG::light_storage->lightmap_get_probe_capture_update_speed() * RSG::rasterizer->get_frame_delta_time();
@@ -2733,7 +2790,33 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 	Transform3D inv_cam_transform = cull_data.cam_transform.inverse();
 	float z_near = cull_data.camera_matrix->get_z_near();
 
+	// Layer and camera frustum tests are done for a whole cull block at once. Without shadows
+	// or SDFGI regions to test, instances failing them (and not ignoring culling) are skipped
+	// without touching the rest of their data.
+	const Frustum &camera_frustum = cull_data.cull->frustum;
+	const bool camera_frustum_only = cull_data.cull->shadow_count == 0 && cull_data.cull->sdfgi.region_count == 0;
+	uint32_t camera_cull_mask = 0;
+	uint32_t process_mask = 0xFFFFFFFF;
+
 	for (uint64_t i = p_from; i < p_to; i++) {
+		const uint32_t cull_lane = i % InstanceCullBlock::SIZE;
+		if (cull_lane == 0 || i == p_from) {
+			const InstanceCullBlock &cull_block = cull_data.scenario->instance_cull_data.get_block(i);
+			camera_cull_mask = cull_block.cull(camera_frustum.planes_ptr, camera_frustum.plane_count, cull_data.visible_layers);
+			if (camera_frustum_only) {
+				process_mask = camera_cull_mask;
+				for (uint32_t j = 0; j < InstanceCullBlock::SIZE; j++) {
+					if (cull_block.flags[j] & InstanceData::FLAG_IGNORE_ALL_CULLING) {
+						process_mask |= 1u << j;
+					}
+				}
+			}
+		}
+
+		if (!(process_mask & (1u << cull_lane))) {
+			continue;
+		}
+
 		bool mesh_visible = false;
 
 		InstanceData &idata = cull_data.scenario->instance_data[i];
@@ -2743,13 +2826,14 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 #define HIDDEN_BY_VISIBILITY_CHECKS (visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE || visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN)
 #define LAYER_CHECK (cull_data.visible_layers & idata.layer_mask)
 #define IN_FRUSTUM(f) (cull_data.scenario->instance_aabbs[i].in_frustum(f))
+#define IN_CAMERA_FRUSTUM (camera_cull_mask & (1u << cull_lane)) // Includes the layer check.
 #define VIS_RANGE_CHECK ((idata.visibility_index == -1) || _visibility_range_check<false>(cull_data.scenario->instance_visibility[idata.visibility_index], cull_data.cam_transform.origin, cull_data.visibility_viewport_mask) == 0)
 #define VIS_PARENT_CHECK (_visibility_parent_check(cull_data, idata))
 #define VIS_CHECK (visibility_check < 0 ? (visibility_check = (visibility_flags != InstanceData::FLAG_VISIBILITY_DEPENDENCY_NEEDS_CHECK || (VIS_RANGE_CHECK && VIS_PARENT_CHECK))) : visibility_check)
 #define OCCLUSION_CULLED (cull_data.occlusion_buffer != nullptr && (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_OCCLUSION_CULLING) == 0 && cull_data.occlusion_buffer->is_occluded(cull_data.scenario->instance_aabbs[i].bounds, cull_data.cam_transform.origin, inv_cam_transform, *cull_data.camera_matrix, z_near))
 
 		if (!HIDDEN_BY_VISIBILITY_CHECKS) {
-			if ((LAYER_CHECK && IN_FRUSTUM(cull_data.cull->frustum) && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
+			if ((IN_CAMERA_FRUSTUM && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
 				uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 				if (base_type == RS::INSTANCE_LIGHT) {
 					cull_result.lights.push_back(idata.instance);
@@ -2956,6 +3040,7 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 #undef HIDDEN_BY_VISIBILITY_CHECKS
 #undef LAYER_CHECK
 #undef IN_FRUSTUM
+#undef IN_CAMERA_FRUSTUM
 #undef VIS_RANGE_CHECK
 #undef VIS_PARENT_CHECK
 #undef VIS_CHECK
@@ -3119,7 +3204,7 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		cull_data.cam_transform = p_camera_data->main_transform;
 		cull_data.visible_layers = p_visible_layers;
 		cull_data.render_reflection_probe = render_reflection_probe;
-		cull_data.occlusion_buffer = RendererSceneOcclusionCull::get_singleton()->buffer_get_ptr(p_viewport);
+		cull_data.occlusion_buffer = RendererSceneOcclusionCull::get_buffer_singleton(p_viewport)->buffer_get_ptr(p_viewport);
 		cull_data.camera_matrix = &p_camera_data->main_projection;
 		cull_data.visibility_viewport_mask = scenario->viewport_visibility_masks.has(p_viewport) ? scenario->viewport_visibility_masks[p_viewport] : 0;
 //#define DEBUG_CULL_TIME
@@ -4041,6 +4126,12 @@ void RendererSceneCull::update() {
 	}
 	scene_render->update();
 	update_dirty_instances();
+
+	for (uint32_t i = 0; i < rid_count; i++) {
+		Scenario *s = scenario_owner.get_or_null(rids[i]);
+		s->indexers[Scenario::INDEXER_GEOMETRY].flush_refits();
+		s->indexers[Scenario::INDEXER_VOLUMES].flush_refits();
+	}
 	render_particle_colliders();
 }
 
@@ -4063,6 +4154,7 @@ bool RendererSceneCull::free(RID p_rid) {
 			instance_set_scenario(scenario->instances.first()->self()->self, RID());
 		}
 		scenario->instance_aabbs.reset();
+		scenario->instance_cull_data.reset();
 		scenario->instance_data.reset();
 		scenario->instance_visibility.reset();
 
@@ -4070,9 +4162,15 @@ bool RendererSceneCull::free(RID p_rid) {
 		RSG::light_storage->reflection_atlas_free(scenario->reflection_atlas);
 		scenario_owner.free(p_rid);
 		RendererSceneOcclusionCull::get_singleton()->remove_scenario(p_rid);
+		if (RendererSceneOcclusionCull::get_mirror_singleton()) {
+			RendererSceneOcclusionCull::get_mirror_singleton()->remove_scenario(p_rid);
+		}
 
 	} else if (RendererSceneOcclusionCull::get_singleton()->is_occluder(p_rid)) {
 		RendererSceneOcclusionCull::get_singleton()->free_occluder(p_rid);
+		if (RendererSceneOcclusionCull::get_mirror_singleton()) {
+			RendererSceneOcclusionCull::get_mirror_singleton()->free_occluder(p_rid);
+		}
 	} else if (instance_owner.owns(p_rid)) {
 		// delete the instance
 
@@ -4144,6 +4242,9 @@ RendererSceneCull::RendererSceneCull() {
 	render_pass = 1;
 	singleton = this;
 
+	// Cull blocks are large, avoid allocating megabytes for small scenarios.
+	instance_cull_block_page_pool.configure(256);
+
 	instance_cull_result.set_page_pool(&instance_cull_page_pool);
 	instance_shadow_cull_result.set_page_pool(&instance_cull_page_pool);
 
@@ -4164,7 +4265,8 @@ RendererSceneCull::RendererSceneCull() {
 	thread_cull_threshold = GLOBAL_GET("rendering/limits/spatial_indexer/threaded_cull_minimum_instances");
 	thread_cull_threshold = MAX(thread_cull_threshold, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count()); //make sure there is at least one thread per CPU
 
-	dummy_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	// Becomes the main occlusion culler unless a module provides one, see get_mirror_singleton().
+	software_occlusion_culling = memnew(RasterOcclusionCull);
 }
 
 RendererSceneCull::~RendererSceneCull() {
@@ -4184,7 +4286,7 @@ RendererSceneCull::~RendererSceneCull() {
 	}
 	scene_cull_result_threads.clear();
 
-	if (dummy_occlusion_culling) {
-		memdelete(dummy_occlusion_culling);
+	if (software_occlusion_culling) {
+		memdelete(software_occlusion_culling);
 	}
 }
@@ -116,7 +116,7 @@ public:
 
 	/* VISIBILITY NOTIFIER API */
 
-	RendererSceneOcclusionCull *dummy_occlusion_culling = nullptr;
+	RendererSceneOcclusionCull *software_occlusion_culling = nullptr;
 
 	/* SCENARIO API */
 
@@ -241,6 +241,99 @@ public:
 		}
 	};
 
+	struct InstanceCullBlock {
+		// Culling data of consecutive instances, stored as structure of arrays so
+		// the first culling pass only loads what it tests and can check several
+		// instances per instruction. With single precision, every component
+		// fills exactly one 64-byte cache line.
+		enum {
+			SIZE = 16,
+		};
+
+		real_t position[3][SIZE];
+		real_t size[3][SIZE];
+		uint32_t layer_mask[SIZE];
+		uint32_t flags[SIZE]; // Only InstanceData::FLAG_IGNORE_ALL_CULLING is mirrored here.
+
+		_ALWAYS_INLINE_ void set_bounds(uint32_t p_lane, const AABB &p_aabb) {
+			for (int i = 0; i < 3; i++) {
+				position[i][p_lane] = p_aabb.position[i];
+				size[i][p_lane] = p_aabb.size[i];
+			}
+		}
+
+		_ALWAYS_INLINE_ void copy_lane(uint32_t p_lane, const InstanceCullBlock &p_from, uint32_t p_from_lane) {
+			for (int i = 0; i < 3; i++) {
+				position[i][p_lane] = p_from.position[i][p_from_lane];
+				size[i][p_lane] = p_from.size[i][p_from_lane];
+			}
+			layer_mask[p_lane] = p_from.layer_mask[p_from_lane];
+			flags[p_lane] = p_from.flags[p_from_lane];
+		}
+
+		// Returns a bit per lane that passes the layer mask and is not fully outside the frustum.
+		uint32_t cull(const Plane *p_planes, uint32_t p_plane_count, uint32_t p_visible_layers) const;
+	};
+
+	// Keeps an InstanceCullBlock lane per entry in Scenario::instance_data, with the same indices.
+	class InstanceCullArray {
+		PagedArray<InstanceCullBlock> blocks;
+		uint64_t count = 0;
+
+	public:
+		_FORCE_INLINE_ void set_page_pool(PagedArrayPool<InstanceCullBlock> *p_page_pool) {
+			blocks.set_page_pool(p_page_pool);
+		}
+
+		_FORCE_INLINE_ uint64_t size() const {
+			return count;
+		}
+
+		_FORCE_INLINE_ const InstanceCullBlock &get_block(uint64_t p_index) const {
+			return blocks[p_index / InstanceCullBlock::SIZE];
+		}
+
+		_FORCE_INLINE_ void push_back(const AABB &p_aabb, uint32_t p_layer_mask, uint32_t p_flags) {
+			if (count % InstanceCullBlock::SIZE == 0) {
+				blocks.push_back(InstanceCullBlock());
+			}
+			InstanceCullBlock &block = blocks[count / InstanceCullBlock::SIZE];
+			uint32_t lane = count % InstanceCullBlock::SIZE;
+			block.set_bounds(lane, p_aabb);
+			block.layer_mask[lane] = p_layer_mask;
+			block.flags[lane] = p_flags;
+			count++;
+		}
+
+		_FORCE_INLINE_ void pop_back() {
+			count--;
+			if (count % InstanceCullBlock::SIZE == 0) {
+				blocks.pop_back();
+			}
+		}
+
+		_FORCE_INLINE_ void set_bounds(uint64_t p_index, const AABB &p_aabb) {
+			blocks[p_index / InstanceCullBlock::SIZE].set_bounds(p_index % InstanceCullBlock::SIZE, p_aabb);
+		}
+
+		_FORCE_INLINE_ void set_layer_mask(uint64_t p_index, uint32_t p_layer_mask) {
+			blocks[p_index / InstanceCullBlock::SIZE].layer_mask[p_index % InstanceCullBlock::SIZE] = p_layer_mask;
+		}
+
+		_FORCE_INLINE_ void set_flags(uint64_t p_index, uint32_t p_flags) {
+			blocks[p_index / InstanceCullBlock::SIZE].flags[p_index % InstanceCullBlock::SIZE] = p_flags;
+		}
+
+		_FORCE_INLINE_ void move(uint64_t p_to, uint64_t p_from) {
+			blocks[p_to / InstanceCullBlock::SIZE].copy_lane(p_to % InstanceCullBlock::SIZE, blocks[p_from / InstanceCullBlock::SIZE], p_from % InstanceCullBlock::SIZE);
+		}
+
+		_FORCE_INLINE_ void reset() {
+			blocks.reset();
+			count = 0;
+		}
+	};
+
 	struct InstanceVisibilityNotifierData;
 
 	struct InstanceData {
@@ -304,6 +397,7 @@ public:
 	};
 
 	PagedArrayPool<InstanceBounds> instance_aabb_page_pool;
+	PagedArrayPool<InstanceCullBlock> instance_cull_block_page_pool;
 	PagedArrayPool<InstanceData> instance_data_page_pool;
 	PagedArrayPool<InstanceVisibilityData> instance_visibility_data_page_pool;
 
@@ -332,6 +426,7 @@ public:
 		LocalVector<RID> dynamic_lights;
 
 		PagedArray<InstanceBounds> instance_aabbs;
+		InstanceCullArray instance_cull_data;
 		PagedArray<InstanceData> instance_data;
 		VisibilityArray instance_visibility;
 
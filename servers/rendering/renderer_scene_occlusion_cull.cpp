@@ -31,6 +31,19 @@
 #include "renderer_scene_occlusion_cull.h"
 
 RendererSceneOcclusionCull *RendererSceneOcclusionCull::singleton = nullptr;
+RendererSceneOcclusionCull *RendererSceneOcclusionCull::software_singleton = nullptr;
+bool RendererSceneOcclusionCull::software_mirror_enabled = false;
+
+void RendererSceneOcclusionCull::enable_software_mirror() {
+	if (software_mirror_enabled || !software_singleton || software_singleton == singleton) {
+		return;
+	}
+	// Catch up with everything created so far, later changes are mirrored as they happen.
+	if (singleton) {
+		singleton->mirror_to(software_singleton);
+	}
+	software_mirror_enabled = true;
+}
 
 const Vector3 RendererSceneOcclusionCull::HZBuffer::corners[8] = {
 	Vector3(0, 0, 0),
@@ -36,8 +36,12 @@
 #include "servers/rendering_server.h"
 
 class RendererSceneOcclusionCull {
+	friend class TestOcclusionCullSingletonScope;
+
 protected:
 	static RendererSceneOcclusionCull *singleton;
+	static RendererSceneOcclusionCull *software_singleton;
+	static bool software_mirror_enabled;
 
 public:
 	class HZBuffer {
@@ -160,6 +164,20 @@ public:
 	};
 
 	static RendererSceneOcclusionCull *get_singleton() { return singleton; }
+	static RendererSceneOcclusionCull *get_software_singleton() { return software_singleton; }
+
+	// When the software rasterizer runs next to another culler, it receives a copy of all occluder and scenario data,
+	// but only once a viewport opted into it (see enable_software_mirror()).
+	static RendererSceneOcclusionCull *get_mirror_singleton() { return software_mirror_enabled && software_singleton != singleton ? software_singleton : nullptr; }
+	static void enable_software_mirror();
+
+	// Viewports may opt into the software rasterizer, so buffers can live in either culler.
+	static RendererSceneOcclusionCull *get_buffer_singleton(RID p_buffer) {
+		if (software_singleton && software_singleton != singleton && software_singleton->buffer_get_ptr(p_buffer)) {
+			return software_singleton;
+		}
+		return singleton;
+	}
 
 	void _print_warning() {
 		WARN_PRINT_ONCE("Occlusion culling is disabled at build-time.");
@@ -192,6 +210,9 @@ public:
 
 	virtual void set_build_quality(RS::ViewportOcclusionCullingBuildQuality p_quality) {}
 
+	// Sends all occluder and scenario data to another culler.
+	virtual void mirror_to(RendererSceneOcclusionCull *p_target) {}
+
 	RendererSceneOcclusionCull() {
 		singleton = this;
 	};
@@ -216,6 +216,13 @@ void RendererViewport::_configure_3d_render_buffers(Viewport *p_viewport) {
 	}
 }
 
+RendererSceneOcclusionCull *RendererViewport::_get_occlusion_cull(const Viewport *p_viewport) const {
+	if (p_viewport->use_software_occlusion_culling && RendererSceneOcclusionCull::get_software_singleton()) {
+		return RendererSceneOcclusionCull::get_software_singleton();
+	}
+	return RendererSceneOcclusionCull::get_singleton();
+}
+
 void RendererViewport::_draw_3d(Viewport *p_viewport) {
 	RENDER_TIMESTAMP("> Render 3D Scene");
 
@@ -234,7 +241,7 @@ void RendererViewport::_draw_3d(Viewport *p_viewport) {
 
 			float height = Math::sqrt(max_size / aspect);
 			Size2i new_size = Size2i(height * aspect, height);
-			RendererSceneOcclusionCull::get_singleton()->buffer_set_size(p_viewport->self, new_size);
+			_get_occlusion_cull(p_viewport)->buffer_set_size(p_viewport->self, new_size);
 			p_viewport->occlusion_buffer_dirty = false;
 		}
 	}
@@ -1028,7 +1035,7 @@ RID RendererViewport::viewport_get_occluder_debug_texture(RID p_viewport) const
 	ERR_FAIL_NULL_V(viewport, RID());
 
 	if (viewport->use_occlusion_culling && viewport->debug_draw == RenderingServer::VIEWPORT_DEBUG_DRAW_OCCLUDERS) {
-		return RendererSceneOcclusionCull::get_singleton()->buffer_get_debug_texture(p_viewport);
+		return _get_occlusion_cull(viewport)->buffer_get_debug_texture(p_viewport);
 	}
 	return RID();
 }
@@ -1097,7 +1104,7 @@ void RendererViewport::viewport_set_scenario(RID p_viewport, RID p_scenario) {
 
 	viewport->scenario = p_scenario;
 	if (viewport->use_occlusion_culling) {
-		RendererSceneOcclusionCull::get_singleton()->buffer_set_scenario(p_viewport, p_scenario);
+		_get_occlusion_cull(viewport)->buffer_set_scenario(p_viewport, p_scenario);
 	}
 }
 
@@ -1263,15 +1270,42 @@ void RendererViewport::viewport_set_use_occlusion_culling(RID p_viewport, bool p
 	viewport->use_occlusion_culling = p_use_occlusion_culling;
 
 	if (viewport->use_occlusion_culling) {
-		RendererSceneOcclusionCull::get_singleton()->add_buffer(p_viewport);
-		RendererSceneOcclusionCull::get_singleton()->buffer_set_scenario(p_viewport, viewport->scenario);
+		_get_occlusion_cull(viewport)->add_buffer(p_viewport);
+		_get_occlusion_cull(viewport)->buffer_set_scenario(p_viewport, viewport->scenario);
 	} else {
-		RendererSceneOcclusionCull::get_singleton()->remove_buffer(p_viewport);
+		_get_occlusion_cull(viewport)->remove_buffer(p_viewport);
 	}
 
 	viewport->occlusion_buffer_dirty = true;
 }
 
+void RendererViewport::viewport_set_use_software_occlusion_culling(RID p_viewport, bool p_enable) {
+	Viewport *viewport = viewport_owner.get_or_null(p_viewport);
+	ERR_FAIL_NULL(viewport);
+
+	if (viewport->use_software_occlusion_culling == p_enable) {
+		return;
+	}
+
+	// The buffer moves over to the newly selected culler.
+	if (viewport->use_occlusion_culling) {
+		_get_occlusion_cull(viewport)->remove_buffer(p_viewport);
+	}
+
+	viewport->use_software_occlusion_culling = p_enable;
+
+	if (p_enable) {
+		// The software culler only receives the scene's occluders from now on.
+		RendererSceneOcclusionCull::enable_software_mirror();
+	}
+
+	if (viewport->use_occlusion_culling) {
+		_get_occlusion_cull(viewport)->add_buffer(p_viewport);
+		_get_occlusion_cull(viewport)->buffer_set_scenario(p_viewport, viewport->scenario);
+		viewport->occlusion_buffer_dirty = true;
+	}
+}
+
 void RendererViewport::viewport_set_occlusion_rays_per_thread(int p_rays_per_thread) {
 	if (occlusion_rays_per_thread == p_rays_per_thread) {
 		return;
@@ -1418,7 +1452,7 @@ bool RendererViewport::free(RID p_rid) {
 		sorted_active_viewports_dirty = true;
 
 		if (viewport->use_occlusion_culling) {
-			RendererSceneOcclusionCull::get_singleton()->remove_buffer(p_rid);
+			_get_occlusion_cull(viewport)->remove_buffer(p_rid);
 		}
 
 		if (_viewport_requires_motion_vectors(viewport)) {
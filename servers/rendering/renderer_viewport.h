@@ -34,6 +34,7 @@
 #include "core/templates/local_vector.h"
 #include "core/templates/rid_owner.h"
 #include "core/templates/self_list.h"
+#include "servers/rendering/renderer_scene_occlusion_cull.h"
 #include "servers/rendering/renderer_scene_render.h"
 #include "servers/rendering/rendering_method.h"
 #include "servers/rendering_server.h"
@@ -79,6 +80,7 @@ public:
 		uint64_t prev_camera_data_frame = 0;
 
 		bool use_occlusion_culling = false;
+		bool use_software_occlusion_culling = false;
 		bool occlusion_buffer_dirty = false;
 
 		DisplayServer::WindowID viewport_to_screen;
@@ -169,6 +171,7 @@ public:
 			screen_space_aa = RS::VIEWPORT_SCREEN_SPACE_AA_DISABLED;
 			use_debanding = false;
 			use_occlusion_culling = false;
+			use_software_occlusion_culling = false;
 			occlusion_buffer_dirty = true;
 
 			snap_2d_transforms_to_pixel = false;
@@ -212,6 +215,7 @@ private:
 	int occlusion_rays_per_thread = 512;
 
 	void _resize_occlusion_culling_buffer(const Size2i &p_size);
+	RendererSceneOcclusionCull *_get_occlusion_cull(const Viewport *p_viewport) const;
 
 public:
 	RID viewport_allocate();
@@ -272,6 +276,7 @@ public:
 	void viewport_set_use_taa(RID p_viewport, bool p_use_taa);
 	void viewport_set_use_debanding(RID p_viewport, bool p_use_debanding);
 	void viewport_set_use_occlusion_culling(RID p_viewport, bool p_use_occlusion_culling);
+	void viewport_set_use_software_occlusion_culling(RID p_viewport, bool p_enable);
 	void viewport_set_occlusion_rays_per_thread(int p_rays_per_thread);
 	void viewport_set_occlusion_culling_build_quality(RS::ViewportOcclusionCullingBuildQuality p_quality);
 	void viewport_set_mesh_lod_threshold(RID p_viewport, float p_pixels);
@@ -41,6 +41,37 @@
 // careful, these may run in different threads than the rendering server
 
 int RenderingServerDefault::changes = 0;
+thread_local RenderingServerDefault::CanvasItemRecording RenderingServerDefault::canvas_item_recording;
+
+/* CANVAS ITEM COMMAND BUFFER */
+
+void RenderingServerDefault::_canvas_item_submit_recording() {
+	CanvasItemRecording &recording = canvas_item_recording;
+	if (Thread::get_caller_id() == server_thread) {
+		// The recording stays owned by this thread, so no copy is needed.
+		command_queue.flush_if_pending();
+		RSG::canvas->canvas_item_add_commands(recording.item, recording.buffer.ptr(), recording.buffer.size());
+	} else {
+		command_queue.push(RSG::canvas, &RendererCanvasCull::canvas_item_add_command_buffer, recording.item, recording.buffer.to_byte_array());
+	}
+	recording.buffer.clear();
+}
+
+void RenderingServerDefault::canvas_item_begin_command_buffer(RID p_item) {
+	if (canvas_item_recording.item.is_valid()) {
+		// Not nestable, keep what was recorded so far in order.
+		canvas_item_end_command_buffer();
+	}
+	canvas_item_recording.item = p_item;
+}
+
+void RenderingServerDefault::canvas_item_end_command_buffer() {
+	if (!canvas_item_recording.buffer.is_empty()) {
+		redraw_request();
+		_canvas_item_submit_recording();
+	}
+	canvas_item_recording.item = RID();
+}
 
 /* FREE */
 
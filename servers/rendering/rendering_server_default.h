@@ -34,6 +34,7 @@
 #include "core/os/thread.h"
 #include "core/templates/command_queue_mt.h"
 #include "core/templates/hash_map.h"
+#include "canvas_item_command_buffer.h"
 #include "renderer_canvas_cull.h"
 #include "renderer_scene_cull.h"
 #include "renderer_viewport.h"
@@ -99,6 +100,24 @@ class RenderingServerDefault : public RenderingServer {
 
 	void _call_on_render_thread(const Callable &p_callable);
 
+	struct CanvasItemRecording {
+		RID item;
+		CanvasItemCommandBuffer buffer;
+	};
+
+	// Per thread, so only calls from the thread that began the recording are packed.
+	static thread_local CanvasItemRecording canvas_item_recording;
+
+	_FORCE_INLINE_ static bool _canvas_item_is_recording(RID p_item) {
+		return unlikely(canvas_item_recording.item == p_item) && p_item.is_valid();
+	}
+	_FORCE_INLINE_ void _canvas_item_flush_recording(RID p_item) {
+		if (unlikely(canvas_item_recording.item == p_item) && !canvas_item_recording.buffer.is_empty()) {
+			_canvas_item_submit_recording();
+		}
+	}
+	void _canvas_item_submit_recording();
+
 public:
 	//if editor is redrawing when it shouldn't, enable this and put a breakpoint in _changes_changed()
 	//#define DEBUG_CHANGES
@@ -650,6 +669,7 @@ public:
 	FUNC2(viewport_set_use_taa, RID, bool)
 	FUNC2(viewport_set_use_debanding, RID, bool)
 	FUNC2(viewport_set_use_occlusion_culling, RID, bool)
+	FUNC2(viewport_set_use_software_occlusion_culling, RID, bool)
 	FUNC1(viewport_set_occlusion_rays_per_thread, int)
 	FUNC1(viewport_set_occlusion_culling_build_quality, ViewportOcclusionCullingBuildQuality)
 	FUNC2(viewport_set_mesh_lod_threshold, RID, float)
@@ -857,15 +877,44 @@ public:
 
 	FUNC2(canvas_item_set_draw_behind_parent, RID, bool)
 
+	// Calls that can't be recorded into a command buffer first submit what
+	// the calling thread recorded for the item, so commands keep their order.
+#undef WRITE_ACTION
+#define WRITE_ACTION  \
+	redraw_request(); \
+	_canvas_item_flush_recording(p1);
+
+// Packs the command into the recording of the calling thread, or sends it like FUNC*() does.
+#define CANVAS_ITEM_RECORD_OR_CALL(m_type, m_record, ...)                          \
+	redraw_request();                                                              \
+	if (_canvas_item_is_recording(p_item)) {                                       \
+		canvas_item_recording.buffer.m_record;                                     \
+	} else if (Thread::get_caller_id() != server_thread) {                         \
+		command_queue.push(server_name, &ServerName::m_type, p_item, __VA_ARGS__); \
+	} else {                                                                       \
+		command_queue.flush_if_pending();                                          \
+		server_name->m_type(p_item, __VA_ARGS__);                                  \
+	}
+
 	FUNC6(canvas_item_add_line, RID, const Point2 &, const Point2 &, const Color &, float, bool)
 	FUNC5(canvas_item_add_polyline, RID, const Vector<Point2> &, const Vector<Color> &, float, bool)
 	FUNC4(canvas_item_add_multiline, RID, const Vector<Point2> &, const Vector<Color> &, float)
-	FUNC3(canvas_item_add_rect, RID, const Rect2 &, const Color &)
+	virtual void canvas_item_add_rect(RID p_item, const Rect2 &p_rect, const Color &p_color) override {
+		CANVAS_ITEM_RECORD_OR_CALL(canvas_item_add_rect, add_rect(p_rect, p_color), p_rect, p_color)
+	}
 	FUNC4(canvas_item_add_circle, RID, const Point2 &, float, const Color &)
-	FUNC6(canvas_item_add_texture_rect, RID, const Rect2 &, RID, bool, const Color &, bool)
-	FUNC7(canvas_item_add_texture_rect_region, RID, const Rect2 &, RID, const Rect2 &, const Color &, bool, bool)
-	FUNC8(canvas_item_add_msdf_texture_rect_region, RID, const Rect2 &, RID, const Rect2 &, const Color &, int, float, float)
-	FUNC5(canvas_item_add_lcd_texture_rect_region, RID, const Rect2 &, RID, const Rect2 &, const Color &)
+	virtual void canvas_item_add_texture_rect(RID p_item, const Rect2 &p_rect, RID p_texture, bool p_tile, const Color &p_modulate, bool p_transpose) override {
+		CANVAS_ITEM_RECORD_OR_CALL(canvas_item_add_texture_rect, add_texture_rect(p_rect, p_texture, p_tile, p_modulate, p_transpose), p_rect, p_texture, p_tile, p_modulate, p_transpose)
+	}
+	virtual void canvas_item_add_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, bool p_transpose, bool p_clip_uv) override {
+		CANVAS_ITEM_RECORD_OR_CALL(canvas_item_add_texture_rect_region, add_texture_rect_region(p_rect, p_texture, p_src_rect, p_modulate, p_transpose, p_clip_uv), p_rect, p_texture, p_src_rect, p_modulate, p_transpose, p_clip_uv)
+	}
+	virtual void canvas_item_add_msdf_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, int p_outline_size, float p_px_range, float p_scale) override {
+		CANVAS_ITEM_RECORD_OR_CALL(canvas_item_add_msdf_texture_rect_region, add_msdf_texture_rect_region(p_rect, p_texture, p_src_rect, p_modulate, p_outline_size, p_px_range, p_scale), p_rect, p_texture, p_src_rect, p_modulate, p_outline_size, p_px_range, p_scale)
+	}
+	virtual void canvas_item_add_lcd_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate) override {
+		CANVAS_ITEM_RECORD_OR_CALL(canvas_item_add_lcd_texture_rect_region, add_lcd_texture_rect_region(p_rect, p_texture, p_src_rect, p_modulate), p_rect, p_texture, p_src_rect, p_modulate)
+	}
 	FUNC10(canvas_item_add_nine_patch, RID, const Rect2 &, const Rect2 &, RID, const Vector2 &, const Vector2 &, NinePatchAxisMode, NinePatchAxisMode, bool, const Color &)
 	FUNC5(canvas_item_add_primitive, RID, const Vector<Point2> &, const Vector<Color> &, const Vector<Point2> &, RID)
 	FUNC5(canvas_item_add_polygon, RID, const Vector<Point2> &, const Vector<Color> &, const Vector<Point2> &, RID)
@@ -873,9 +922,15 @@ public:
 	FUNC5(canvas_item_add_mesh, RID, const RID &, const Transform2D &, const Color &, RID)
 	FUNC3(canvas_item_add_multimesh, RID, RID, RID)
 	FUNC3(canvas_item_add_particles, RID, RID, RID)
-	FUNC2(canvas_item_add_set_transform, RID, const Transform2D &)
-	FUNC2(canvas_item_add_clip_ignore, RID, bool)
-	FUNC5(canvas_item_add_animation_slice, RID, double, double, double, double)
+	virtual void canvas_item_add_set_transform(RID p_item, const Transform2D &p_transform) override {
+		CANVAS_ITEM_RECORD_OR_CALL(canvas_item_add_set_transform, add_set_transform(p_transform), p_transform)
+	}
+	virtual void canvas_item_add_clip_ignore(RID p_item, bool p_ignore) override {
+		CANVAS_ITEM_RECORD_OR_CALL(canvas_item_add_clip_ignore, add_clip_ignore(p_ignore), p_ignore)
+	}
+	virtual void canvas_item_add_animation_slice(RID p_item, double p_animation_length, double p_slice_begin, double p_slice_end, double p_offset) override {
+		CANVAS_ITEM_RECORD_OR_CALL(canvas_item_add_animation_slice, add_animation_slice(p_animation_length, p_slice_begin, p_slice_end, p_offset), p_animation_length, p_slice_begin, p_slice_end, p_offset)
+	}
 
 	FUNC2(canvas_item_set_sort_children_by_y, RID, bool)
 	FUNC2(canvas_item_set_z_index, RID, int)
@@ -884,6 +939,15 @@ public:
 	FUNC2(canvas_item_attach_skeleton, RID, RID)
 
 	FUNC1(canvas_item_clear, RID)
+
+#undef CANVAS_ITEM_RECORD_OR_CALL
+#undef WRITE_ACTION
+#define WRITE_ACTION redraw_request();
+
+	FUNC2(canvas_item_add_command_buffer, RID, const Vector<uint8_t> &)
+
+	virtual void canvas_item_begin_command_buffer(RID p_item) override;
+	virtual void canvas_item_end_command_buffer() override;
 	FUNC2(canvas_item_set_draw_index, RID, int)
 
 	FUNC2(canvas_item_set_material, RID, RID)
@@ -982,6 +1046,11 @@ public:
 	/* FREE */
 
 	virtual void free(RID p_rid) override {
+		if (unlikely(canvas_item_recording.item == p_rid)) {
+			// Nothing left to submit the recording to.
+			canvas_item_recording.item = RID();
+			canvas_item_recording.buffer.clear();
+		}
 		if (Thread::get_caller_id() == server_thread) {
 			command_queue.flush_if_pending();
 			_free(p_rid);
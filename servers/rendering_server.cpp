@@ -2678,6 +2678,7 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("viewport_set_use_taa", "viewport", "enable"), &RenderingServer::viewport_set_use_taa);
 	ClassDB::bind_method(D_METHOD("viewport_set_use_debanding", "viewport", "enable"), &RenderingServer::viewport_set_use_debanding);
 	ClassDB::bind_method(D_METHOD("viewport_set_use_occlusion_culling", "viewport", "enable"), &RenderingServer::viewport_set_use_occlusion_culling);
+	ClassDB::bind_method(D_METHOD("viewport_set_use_software_occlusion_culling", "viewport", "enable"), &RenderingServer::viewport_set_use_software_occlusion_culling);
 	ClassDB::bind_method(D_METHOD("viewport_set_occlusion_rays_per_thread", "rays_per_thread"), &RenderingServer::viewport_set_occlusion_rays_per_thread);
 	ClassDB::bind_method(D_METHOD("viewport_set_occlusion_culling_build_quality", "quality"), &RenderingServer::viewport_set_occlusion_culling_build_quality);
 
@@ -3071,6 +3072,7 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("canvas_item_add_set_transform", "item", "transform"), &RenderingServer::canvas_item_add_set_transform);
 	ClassDB::bind_method(D_METHOD("canvas_item_add_clip_ignore", "item", "ignore"), &RenderingServer::canvas_item_add_clip_ignore);
 	ClassDB::bind_method(D_METHOD("canvas_item_add_animation_slice", "item", "animation_length", "slice_begin", "slice_end", "offset"), &RenderingServer::canvas_item_add_animation_slice, DEFVAL(0.0));
+	ClassDB::bind_method(D_METHOD("canvas_item_add_command_buffer", "item", "buffer"), &RenderingServer::canvas_item_add_command_buffer);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_sort_children_by_y", "item", "enabled"), &RenderingServer::canvas_item_set_sort_children_by_y);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_z_index", "item", "z_index"), &RenderingServer::canvas_item_set_z_index);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_z_as_relative_to_parent", "item", "enabled"), &RenderingServer::canvas_item_set_z_as_relative_to_parent);
@@ -3088,6 +3090,16 @@ void RenderingServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(NINE_PATCH_TILE);
 	BIND_ENUM_CONSTANT(NINE_PATCH_TILE_FIT);
 
+	BIND_ENUM_CONSTANT(CANVAS_ITEM_BUFFER_COMMAND_RECT);
+	BIND_ENUM_CONSTANT(CANVAS_ITEM_BUFFER_COMMAND_TEXTURE_RECT);
+	BIND_ENUM_CONSTANT(CANVAS_ITEM_BUFFER_COMMAND_TEXTURE_RECT_REGION);
+	BIND_ENUM_CONSTANT(CANVAS_ITEM_BUFFER_COMMAND_MSDF_TEXTURE_RECT_REGION);
+	BIND_ENUM_CONSTANT(CANVAS_ITEM_BUFFER_COMMAND_LCD_TEXTURE_RECT_REGION);
+	BIND_ENUM_CONSTANT(CANVAS_ITEM_BUFFER_COMMAND_SET_TRANSFORM);
+	BIND_ENUM_CONSTANT(CANVAS_ITEM_BUFFER_COMMAND_CLIP_IGNORE);
+	BIND_ENUM_CONSTANT(CANVAS_ITEM_BUFFER_COMMAND_ANIMATION_SLICE);
+	BIND_ENUM_CONSTANT(CANVAS_ITEM_BUFFER_COMMAND_MAX);
+
 	BIND_ENUM_CONSTANT(CANVAS_ITEM_TEXTURE_FILTER_DEFAULT);
 	BIND_ENUM_CONSTANT(CANVAS_ITEM_TEXTURE_FILTER_NEAREST);
 	BIND_ENUM_CONSTANT(CANVAS_ITEM_TEXTURE_FILTER_LINEAR);
@@ -937,6 +937,7 @@ public:
 	virtual void viewport_set_mesh_lod_threshold(RID p_viewport, float p_pixels) = 0;
 
 	virtual void viewport_set_use_occlusion_culling(RID p_viewport, bool p_use_occlusion_culling) = 0;
+	virtual void viewport_set_use_software_occlusion_culling(RID p_viewport, bool p_enable) = 0;
 	virtual void viewport_set_occlusion_rays_per_thread(int p_rays_per_thread) = 0;
 
 	enum ViewportOcclusionCullingBuildQuality {
@@ -1387,6 +1388,26 @@ public:
 	virtual void canvas_item_add_clip_ignore(RID p_item, bool p_ignore) = 0;
 	virtual void canvas_item_add_animation_slice(RID p_item, double p_animation_length, double p_slice_begin, double p_slice_end, double p_offset) = 0;
 
+	enum CanvasItemBufferCommand {
+		CANVAS_ITEM_BUFFER_COMMAND_RECT,
+		CANVAS_ITEM_BUFFER_COMMAND_TEXTURE_RECT,
+		CANVAS_ITEM_BUFFER_COMMAND_TEXTURE_RECT_REGION,
+		CANVAS_ITEM_BUFFER_COMMAND_MSDF_TEXTURE_RECT_REGION,
+		CANVAS_ITEM_BUFFER_COMMAND_LCD_TEXTURE_RECT_REGION,
+		CANVAS_ITEM_BUFFER_COMMAND_SET_TRANSFORM,
+		CANVAS_ITEM_BUFFER_COMMAND_CLIP_IGNORE,
+		CANVAS_ITEM_BUFFER_COMMAND_ANIMATION_SLICE,
+		CANVAS_ITEM_BUFFER_COMMAND_MAX,
+	};
+
+	// See CanvasItemCommandBuffer for the layout.
+	virtual void canvas_item_add_command_buffer(RID p_item, const Vector<uint8_t> &p_buffer) = 0;
+
+	// Until the matching end, canvas_item_add_*() calls made by the calling thread on p_item
+	// are packed into a single canvas_item_add_command_buffer() submission, when supported.
+	virtual void canvas_item_begin_command_buffer(RID p_item) = 0;
+	virtual void canvas_item_end_command_buffer() = 0;
+
 	virtual void canvas_item_set_sort_children_by_y(RID p_item, bool p_enable) = 0;
 	virtual void canvas_item_set_z_index(RID p_item, int p_z) = 0;
 	virtual void canvas_item_set_z_as_relative_to_parent(RID p_item, bool p_enable) = 0;
@@ -1713,6 +1734,7 @@ VARIANT_ENUM_CAST(RenderingServer::InstanceFlags);
 VARIANT_ENUM_CAST(RenderingServer::ShadowCastingSetting);
 VARIANT_ENUM_CAST(RenderingServer::VisibilityRangeFadeMode);
 VARIANT_ENUM_CAST(RenderingServer::NinePatchAxisMode);
+VARIANT_ENUM_CAST(RenderingServer::CanvasItemBufferCommand);
 VARIANT_ENUM_CAST(RenderingServer::CanvasItemTextureFilter);
 VARIANT_ENUM_CAST(RenderingServer::CanvasItemTextureRepeat);
 VARIANT_ENUM_CAST(RenderingServer::CanvasGroupMode);
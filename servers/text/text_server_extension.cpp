@@ -48,6 +48,11 @@ void TextServerExtension::_bind_methods() {
 	GDVIRTUAL_BIND(_name_to_tag, "name");
 	GDVIRTUAL_BIND(_tag_to_name, "tag");
 
+	GDVIRTUAL_BIND(_shaping_cache_get_hit_count);
+	GDVIRTUAL_BIND(_shaping_cache_get_miss_count);
+	GDVIRTUAL_BIND(_shaping_cache_set_capacity, "capacity");
+	GDVIRTUAL_BIND(_shaping_cache_get_capacity);
+
 	/* Font interface */
 
 	GDVIRTUAL_BIND(_create_font);
@@ -192,6 +197,7 @@ void TextServerExtension::_bind_methods() {
 	GDVIRTUAL_BIND(_font_get_supported_chars, "font_rid");
 
 	GDVIRTUAL_BIND(_font_render_range, "font_rid", "size", "start", "end");
+	GDVIRTUAL_BIND(_font_render_range_async, "font_rid", "size", "start", "end");
 	GDVIRTUAL_BIND(_font_render_glyph, "font_rid", "size", "index");
 
 	GDVIRTUAL_BIND(_font_draw_glyph, "font_rid", "canvas", "size", "pos", "index", "color");
@@ -406,6 +412,28 @@ String TextServerExtension::tag_to_name(int64_t p_tag) const {
 	return ret;
 }
 
+int64_t TextServerExtension::shaping_cache_get_hit_count() const {
+	int64_t ret = 0;
+	GDVIRTUAL_CALL(_shaping_cache_get_hit_count, ret);
+	return ret;
+}
+
+int64_t TextServerExtension::shaping_cache_get_miss_count() const {
+	int64_t ret = 0;
+	GDVIRTUAL_CALL(_shaping_cache_get_miss_count, ret);
+	return ret;
+}
+
+void TextServerExtension::shaping_cache_set_capacity(int64_t p_capacity) {
+	GDVIRTUAL_CALL(_shaping_cache_set_capacity, p_capacity);
+}
+
+int64_t TextServerExtension::shaping_cache_get_capacity() const {
+	int64_t ret = 0;
+	GDVIRTUAL_CALL(_shaping_cache_get_capacity, ret);
+	return ret;
+}
+
 /*************************************************************************/
 /* Font                                                                  */
 /*************************************************************************/
@@ -894,6 +922,12 @@ void TextServerExtension::font_render_range(const RID &p_font_rid, const Vector2
 	GDVIRTUAL_CALL(_font_render_range, p_font_rid, p_size, p_start, p_end);
 }
 
+void TextServerExtension::font_render_range_async(const RID &p_font_rid, const Vector2i &p_size, int64_t p_start, int64_t p_end) {
+	if (!GDVIRTUAL_CALL(_font_render_range_async, p_font_rid, p_size, p_start, p_end)) {
+		TextServer::font_render_range_async(p_font_rid, p_size, p_start, p_end);
+	}
+}
+
 void TextServerExtension::font_render_glyph(const RID &p_font_rid, const Vector2i &p_size, int64_t p_index) {
 	GDVIRTUAL_CALL(_font_render_glyph, p_font_rid, p_size, p_index);
 }
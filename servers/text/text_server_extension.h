@@ -75,6 +75,15 @@ public:
 	GDVIRTUAL1RC(int64_t, _name_to_tag, const String &);
 	GDVIRTUAL1RC(String, _tag_to_name, int64_t);
 
+	virtual int64_t shaping_cache_get_hit_count() const override;
+	virtual int64_t shaping_cache_get_miss_count() const override;
+	virtual void shaping_cache_set_capacity(int64_t p_capacity) override;
+	virtual int64_t shaping_cache_get_capacity() const override;
+	GDVIRTUAL0RC(int64_t, _shaping_cache_get_hit_count);
+	GDVIRTUAL0RC(int64_t, _shaping_cache_get_miss_count);
+	GDVIRTUAL1(_shaping_cache_set_capacity, int64_t);
+	GDVIRTUAL0RC(int64_t, _shaping_cache_get_capacity);
+
 	/* Font interface */
 
 	virtual RID create_font() override;
@@ -317,8 +326,10 @@ public:
 	GDVIRTUAL1RC(String, _font_get_supported_chars, RID);
 
 	virtual void font_render_range(const RID &p_font, const Vector2i &p_size, int64_t p_start, int64_t p_end) override;
+	virtual void font_render_range_async(const RID &p_font, const Vector2i &p_size, int64_t p_start, int64_t p_end) override;
 	virtual void font_render_glyph(const RID &p_font_rid, const Vector2i &p_size, int64_t p_index) override;
 	GDVIRTUAL4(_font_render_range, RID, const Vector2i &, int64_t, int64_t);
+	GDVIRTUAL4(_font_render_range_async, RID, const Vector2i &, int64_t, int64_t);
 	GDVIRTUAL3(_font_render_glyph, RID, const Vector2i &, int64_t);
 
 	virtual void font_draw_glyph(const RID &p_font, const RID &p_canvas, int64_t p_size, const Vector2 &p_pos, int64_t p_index, const Color &p_color = Color(1, 1, 1)) const override;
@@ -200,6 +200,11 @@ void TextServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("name_to_tag", "name"), &TextServer::name_to_tag);
 	ClassDB::bind_method(D_METHOD("tag_to_name", "tag"), &TextServer::tag_to_name);
 
+	ClassDB::bind_method(D_METHOD("shaping_cache_get_hit_count"), &TextServer::shaping_cache_get_hit_count);
+	ClassDB::bind_method(D_METHOD("shaping_cache_get_miss_count"), &TextServer::shaping_cache_get_miss_count);
+	ClassDB::bind_method(D_METHOD("shaping_cache_set_capacity", "capacity"), &TextServer::shaping_cache_set_capacity);
+	ClassDB::bind_method(D_METHOD("shaping_cache_get_capacity"), &TextServer::shaping_cache_get_capacity);
+
 	ClassDB::bind_method(D_METHOD("has", "rid"), &TextServer::has);
 	ClassDB::bind_method(D_METHOD("free_rid", "rid"), &TextServer::free_rid);
 
@@ -346,6 +351,7 @@ void TextServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("font_get_supported_chars", "font_rid"), &TextServer::font_get_supported_chars);
 
 	ClassDB::bind_method(D_METHOD("font_render_range", "font_rid", "size", "start", "end"), &TextServer::font_render_range);
+	ClassDB::bind_method(D_METHOD("font_render_range_async", "font_rid", "size", "start", "end"), &TextServer::font_render_range_async);
 	ClassDB::bind_method(D_METHOD("font_render_glyph", "font_rid", "size", "index"), &TextServer::font_render_glyph);
 
 	ClassDB::bind_method(D_METHOD("font_draw_glyph", "font_rid", "canvas", "size", "pos", "index", "color"), &TextServer::font_draw_glyph, DEFVAL(Color(1, 1, 1)));
@@ -629,6 +635,10 @@ void TextServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(FIXED_SIZE_SCALE_ENABLED);
 }
 
+void TextServer::font_render_range_async(const RID &p_font_rid, const Vector2i &p_size, int64_t p_start, int64_t p_end) {
+	font_render_range(p_font_rid, p_size, p_start, p_end);
+}
+
 Vector2 TextServer::get_hex_code_box_size(int64_t p_size, int64_t p_index) const {
 	int w = ((p_index <= 0xFF) ? 1 : ((p_index <= 0xFFFF) ? 2 : 3));
 	int sp = MAX(0, w - 1);
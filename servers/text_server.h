@@ -240,6 +240,11 @@ public:
 	virtual int64_t name_to_tag(const String &p_name) const { return 0; };
 	virtual String tag_to_name(int64_t p_tag) const { return ""; };
 
+	virtual int64_t shaping_cache_get_hit_count() const { return 0; };
+	virtual int64_t shaping_cache_get_miss_count() const { return 0; };
+	virtual void shaping_cache_set_capacity(int64_t p_capacity) {}
+	virtual int64_t shaping_cache_get_capacity() const { return 0; };
+
 	/* Font interface */
 
 	virtual RID create_font() = 0;
@@ -383,6 +388,7 @@ public:
 	virtual String font_get_supported_chars(const RID &p_font_rid) const = 0;
 
 	virtual void font_render_range(const RID &p_font, const Vector2i &p_size, int64_t p_start, int64_t p_end) = 0;
+	virtual void font_render_range_async(const RID &p_font, const Vector2i &p_size, int64_t p_start, int64_t p_end);
 	virtual void font_render_glyph(const RID &p_font_rid, const Vector2i &p_size, int64_t p_index) = 0;
 
 	virtual void font_draw_glyph(const RID &p_font, const RID &p_canvas, int64_t p_size, const Vector2 &p_pos, int64_t p_index, const Color &p_color = Color(1, 1, 1)) const = 0;
@@ -0,0 +1,118 @@
+/**************************************************************************/
+/*  test_dynamic_bvh.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_DYNAMIC_BVH_H
+#define TEST_DYNAMIC_BVH_H
+
+#include "core/math/dynamic_bvh.h"
+#include "core/math/random_number_generator.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestDynamicBVH {
+
+struct CollectQuery {
+	LocalVector<intptr_t> hits;
+
+	bool operator()(void *p_data) {
+		hits.push_back(intptr_t(p_data));
+		return false; // Keep going.
+	}
+};
+
+static void check_query(DynamicBVH &p_bvh, const LocalVector<AABB> &p_boxes, const AABB &p_query) {
+	CollectQuery query;
+	p_bvh.aabb_query(p_query, query);
+
+	uint32_t expected = 0;
+	for (uint32_t i = 0; i < p_boxes.size(); i++) {
+		if (p_boxes[i].intersects_inclusive(p_query)) {
+			expected++;
+			CHECK_MESSAGE(query.hits.find(intptr_t(i)) != -1, "Every intersecting box should be found.");
+		}
+	}
+	CHECK(query.hits.size() == expected);
+}
+
+TEST_CASE("[DynamicBVH] Refit moved leaves") {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(42);
+
+	DynamicBVH bvh;
+	LocalVector<AABB> boxes;
+	LocalVector<DynamicBVH::ID> ids;
+	for (int i = 0; i < 200; i++) {
+		AABB box(Vector3(rng->randf_range(-100, 100), rng->randf_range(-100, 100), rng->randf_range(-100, 100)), Vector3(2, 2, 2));
+		boxes.push_back(box);
+		ids.push_back(bvh.insert(box, (void *)intptr_t(i)));
+	}
+
+	const AABB query(Vector3(-30, -30, -30), Vector3(60, 60, 60));
+
+	SUBCASE("Small motions are found before and after flushing") {
+		for (uint32_t i = 0; i < boxes.size(); i++) {
+			boxes[i].position += Vector3(rng->randf_range(-0.5, 0.5), rng->randf_range(-0.5, 0.5), rng->randf_range(-0.5, 0.5));
+			bvh.refit(ids[i], boxes[i]);
+		}
+		check_query(bvh, boxes, query);
+		bvh.flush_refits();
+		check_query(bvh, boxes, query);
+	}
+
+	SUBCASE("Large motions re-insert the leaf") {
+		for (uint32_t i = 0; i < boxes.size(); i += 3) {
+			boxes[i].position = -boxes[i].position;
+			bvh.refit(ids[i], boxes[i]);
+		}
+		check_query(bvh, boxes, query);
+		CHECK(bvh.get_leaf_count() == int(boxes.size()));
+	}
+
+	SUBCASE("Structural changes with pending refits") {
+		for (uint32_t i = 0; i < boxes.size(); i++) {
+			boxes[i].position += Vector3(0.25, 0, 0);
+			bvh.refit(ids[i], boxes[i]);
+		}
+		// Removing leaves deletes internal nodes, pending refits must not reference them anymore.
+		for (uint32_t i = 0; i < 50; i++) {
+			bvh.remove(ids[i]);
+			boxes[i] = AABB(Vector3(1000, 1000, 1000), Vector3(1, 1, 1));
+		}
+		bvh.optimize_incremental(10);
+		check_query(bvh, boxes, query);
+		CHECK(bvh.get_leaf_count() == 150);
+	}
+}
+
+} // namespace TestDynamicBVH
+
+#endif // TEST_DYNAMIC_BVH_H
@@ -0,0 +1,299 @@
+/**************************************************************************/
+/*  test_simd_batch.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SIMD_BATCH_H
+#define TEST_SIMD_BATCH_H
+
+#include "core/math/random_number_generator.h"
+#include "core/math/simd_batch.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSIMDBatch {
+
+// Not a multiple of any backend width, so the scalar tail is exercised too.
+static const uint32_t ELEMENT_COUNT = 37;
+
+struct TransformArrays {
+	LocalVector<real_t> values[12];
+	SIMDBatch::TransformSoA soa;
+
+	TransformArrays() {
+		for (int i = 0; i < 12; i++) {
+			values[i].resize(ELEMENT_COUNT);
+		}
+		for (int r = 0; r < 3; r++) {
+			for (int c = 0; c < 3; c++) {
+				soa.basis[r][c] = values[r * 3 + c].ptr();
+			}
+			soa.origin[r] = values[9 + r].ptr();
+		}
+	}
+
+	void set(uint32_t p_index, const Transform3D &p_transform) {
+		for (int r = 0; r < 3; r++) {
+			for (int c = 0; c < 3; c++) {
+				soa.basis[r][c][p_index] = p_transform.basis.rows[r][c];
+			}
+			soa.origin[r][p_index] = p_transform.origin[r];
+		}
+	}
+
+	Transform3D get(uint32_t p_index) const {
+		Transform3D t;
+		for (int r = 0; r < 3; r++) {
+			for (int c = 0; c < 3; c++) {
+				t.basis.rows[r][c] = soa.basis[r][c][p_index];
+			}
+			t.origin[r] = soa.origin[r][p_index];
+		}
+		return t;
+	}
+};
+
+struct Vector3Arrays {
+	LocalVector<real_t> values[3];
+	SIMDBatch::Vector3SoA soa;
+
+	Vector3Arrays() {
+		for (int i = 0; i < 3; i++) {
+			values[i].resize(ELEMENT_COUNT);
+		}
+		soa.x = values[0].ptr();
+		soa.y = values[1].ptr();
+		soa.z = values[2].ptr();
+	}
+
+	void set(uint32_t p_index, const Vector3 &p_vector) {
+		soa.x[p_index] = p_vector.x;
+		soa.y[p_index] = p_vector.y;
+		soa.z[p_index] = p_vector.z;
+	}
+
+	Vector3 get(uint32_t p_index) const {
+		return Vector3(soa.x[p_index], soa.y[p_index], soa.z[p_index]);
+	}
+};
+
+struct AABBArrays {
+	LocalVector<real_t> values[6];
+	SIMDBatch::AABBSoA soa;
+
+	AABBArrays() {
+		for (int i = 0; i < 6; i++) {
+			values[i].resize(ELEMENT_COUNT);
+		}
+		for (int i = 0; i < 3; i++) {
+			soa.position[i] = values[i].ptr();
+			soa.size[i] = values[3 + i].ptr();
+		}
+	}
+
+	void set(uint32_t p_index, const AABB &p_aabb) {
+		for (int i = 0; i < 3; i++) {
+			soa.position[i][p_index] = p_aabb.position[i];
+			soa.size[i][p_index] = p_aabb.size[i];
+		}
+	}
+
+	AABB get(uint32_t p_index) const {
+		AABB aabb;
+		for (int i = 0; i < 3; i++) {
+			aabb.position[i] = soa.position[i][p_index];
+			aabb.size[i] = soa.size[i][p_index];
+		}
+		return aabb;
+	}
+};
+
+static Vector3 random_vector(RandomNumberGenerator &p_rng, real_t p_range) {
+	return Vector3(p_rng.randf_range(-p_range, p_range), p_rng.randf_range(-p_range, p_range), p_rng.randf_range(-p_range, p_range));
+}
+
+static Transform3D random_transform(RandomNumberGenerator &p_rng) {
+	Basis basis = Basis(random_vector(p_rng, 1).normalized(), p_rng.randf_range(-Math_PI, Math_PI));
+	basis.scale(Vector3(p_rng.randf_range(0.5, 2), p_rng.randf_range(0.5, 2), p_rng.randf_range(0.5, 2)));
+	return Transform3D(basis, random_vector(p_rng, 100));
+}
+
+static AABB random_aabb(RandomNumberGenerator &p_rng) {
+	return AABB(random_vector(p_rng, 50), Vector3(p_rng.randf_range(0, 10), p_rng.randf_range(0, 10), p_rng.randf_range(0, 10)));
+}
+
+static bool aabb_over_any_plane(const AABB &p_aabb, const Plane *p_planes, int p_plane_count) {
+	Vector3 half_extents = p_aabb.size * 0.5f;
+	Vector3 center = p_aabb.position + half_extents;
+	for (int i = 0; i < p_plane_count; i++) {
+		const Plane &p = p_planes[i];
+		Vector3 point(
+				(p.normal.x > 0) ? -half_extents.x : half_extents.x,
+				(p.normal.y > 0) ? -half_extents.y : half_extents.y,
+				(p.normal.z > 0) ? -half_extents.z : half_extents.z);
+		if (p.is_point_over(center + point)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+TEST_CASE("[SIMDBatch] Backend selection") {
+	SIMDBatch::Backend default_backend = SIMDBatch::get_backend();
+	CHECK(SIMDBatch::is_backend_supported(SIMDBatch::BACKEND_SCALAR));
+	CHECK(SIMDBatch::is_backend_supported(default_backend));
+
+	CHECK(SIMDBatch::set_backend(SIMDBatch::BACKEND_SCALAR));
+	CHECK(SIMDBatch::get_backend() == SIMDBatch::BACKEND_SCALAR);
+	CHECK(SIMDBatch::set_backend(default_backend));
+	CHECK(SIMDBatch::get_backend() == default_backend);
+}
+
+TEST_CASE("[SIMDBatch] All backends match the scalar math") {
+	RandomNumberGenerator rng;
+	rng.set_seed(8427);
+
+	TransformArrays a;
+	TransformArrays b;
+	Vector3Arrays points;
+	AABBArrays aabbs;
+	for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+		a.set(i, random_transform(rng));
+		b.set(i, random_transform(rng));
+		points.set(i, random_vector(rng, 100));
+		aabbs.set(i, random_aabb(rng));
+	}
+	const Transform3D uniform = random_transform(rng);
+
+	// Camera-like frustum around the origin.
+	const Plane planes[6] = {
+		Plane(Vector3(1, 0, 0), 30),
+		Plane(Vector3(-1, 0, 0), 30),
+		Plane(Vector3(0, 1, 0), 30),
+		Plane(Vector3(0, -1, 0), 30),
+		Plane(Vector3(0, 0.6, 0.8), 20),
+		Plane(Vector3(0, 0, -1), 40),
+	};
+
+	SIMDBatch::Backend default_backend = SIMDBatch::get_backend();
+
+	for (int backend = 0; backend < SIMDBatch::BACKEND_MAX; backend++) {
+		if (!SIMDBatch::set_backend(SIMDBatch::Backend(backend))) {
+			continue;
+		}
+		INFO("Backend: ", SIMDBatch::get_backend_name(SIMDBatch::Backend(backend)));
+
+		TransformArrays composed;
+		SIMDBatch::transform_compose(a.soa, b.soa, composed.soa, ELEMENT_COUNT);
+		for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+			CHECK(composed.get(i).is_equal_approx(a.get(i) * b.get(i)));
+		}
+
+		Vector3Arrays transformed;
+		SIMDBatch::transform_points(a.soa, points.soa, transformed.soa, ELEMENT_COUNT);
+		for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+			CHECK(transformed.get(i).is_equal_approx(a.get(i).xform(points.get(i))));
+		}
+
+		SIMDBatch::transform_points(uniform, points.soa, transformed.soa, ELEMENT_COUNT);
+		for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+			CHECK(transformed.get(i).is_equal_approx(uniform.xform(points.get(i))));
+		}
+
+		AABBArrays transformed_aabbs;
+		SIMDBatch::transform_aabbs(a.soa, aabbs.soa, transformed_aabbs.soa, ELEMENT_COUNT);
+		for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+			CHECK(transformed_aabbs.get(i).is_equal_approx(a.get(i).xform(aabbs.get(i))));
+		}
+
+		uint8_t inside[ELEMENT_COUNT];
+		uint32_t inside_count = SIMDBatch::cull_aabbs(planes, 6, aabbs.soa, inside, ELEMENT_COUNT);
+		uint32_t expected_count = 0;
+		for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+			bool expected = !aabb_over_any_plane(aabbs.get(i), planes, 6);
+			CHECK(bool(inside[i]) == expected);
+			expected_count += expected ? 1 : 0;
+		}
+		CHECK(inside_count == expected_count);
+	}
+
+	SIMDBatch::set_backend(default_backend);
+}
+
+TEST_CASE("[SIMDBatch] In-place update") {
+	RandomNumberGenerator rng;
+	rng.set_seed(1234);
+
+	TransformArrays parents;
+	TransformArrays locals;
+	LocalVector<Transform3D> expected;
+	for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+		Transform3D parent = random_transform(rng);
+		Transform3D local = random_transform(rng);
+		parents.set(i, parent);
+		locals.set(i, local);
+		expected.push_back(parent * local);
+	}
+
+	// Result written over the second operand, as when propagating poses.
+	SIMDBatch::transform_compose(parents.soa, locals.soa, locals.soa, ELEMENT_COUNT);
+	for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+		CHECK(locals.get(i).is_equal_approx(expected[i]));
+	}
+}
+
+TEST_CASE("[SIMDBatch] Frustum culling edge cases") {
+	const Plane planes[2] = {
+		Plane(Vector3(1, 0, 0), 10),
+		Plane(Vector3(-1, 0, 0), 10),
+	};
+
+	AABBArrays aabbs;
+	for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+		aabbs.set(i, AABB(Vector3(-1, -1, -1), Vector3(2, 2, 2)));
+	}
+	aabbs.set(0, AABB(Vector3(20, 0, 0), Vector3(1, 1, 1))); // Fully outside.
+	aabbs.set(1, AABB(Vector3(9, 0, 0), Vector3(2, 1, 1))); // Straddling a plane.
+	aabbs.set(ELEMENT_COUNT - 1, AABB(Vector3(-30, 0, 0), Vector3(1, 1, 1))); // Outside, in the scalar tail.
+
+	uint8_t inside[ELEMENT_COUNT];
+	uint32_t inside_count = SIMDBatch::cull_aabbs(planes, 2, aabbs.soa, inside, ELEMENT_COUNT);
+	CHECK(inside[0] == 0);
+	CHECK(inside[1] == 1);
+	CHECK(inside[2] == 1);
+	CHECK(inside[ELEMENT_COUNT - 1] == 0);
+	CHECK(inside_count == ELEMENT_COUNT - 2);
+
+	// No planes means nothing can be culled.
+	CHECK(SIMDBatch::cull_aabbs(planes, 0, aabbs.soa, inside, ELEMENT_COUNT) == ELEMENT_COUNT);
+}
+
+} // namespace TestSIMDBatch
+
+#endif // TEST_SIMD_BATCH_H
@@ -0,0 +1,102 @@
+/**************************************************************************/
+/*  test_frame_arena.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_FRAME_ARENA_H
+#define TEST_FRAME_ARENA_H
+
+#include "core/os/frame_arena.h"
+#include "core/templates/hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFrameArena {
+
+TEST_CASE("[FrameArena] Allocations are aligned and don't overlap") {
+	FrameArena::begin_frame();
+
+	uint8_t *a = (uint8_t *)FrameArena::alloc(3);
+	uint8_t *b = (uint8_t *)FrameArena::alloc(100);
+	uint8_t *big = (uint8_t *)FrameArena::alloc(1024 * 1024); // Larger than a block.
+	uint8_t *c = (uint8_t *)FrameArena::alloc(16);
+
+	CHECK(((uintptr_t)a % 16) == 0);
+	CHECK(((uintptr_t)b % 16) == 0);
+	CHECK(((uintptr_t)big % 16) == 0);
+	CHECK(((uintptr_t)c % 16) == 0);
+	CHECK(b >= a + 16);
+	CHECK((c >= big + 1024 * 1024 || c + 16 <= big));
+
+	memset(big, 0xFF, 1024 * 1024);
+	memset(c, 0, 16);
+	CHECK(big[1024 * 1024 - 1] == 0xFF);
+}
+
+TEST_CASE("[FrameArena] Containers and usage statistics") {
+	FrameArena::begin_frame();
+	{
+		FrameLocalVector<int> vector;
+		for (int i = 0; i < 1000; i++) {
+			vector.push_back(i);
+		}
+		CHECK(vector.size() == 1000);
+		CHECK(vector[999] == 999);
+
+		HashMap<int, int, HashMapHasherDefault, HashMapComparatorDefault<int>, FrameArenaTypedAllocator<HashMapElement<int, int>>> map;
+		for (int i = 0; i < 100; i++) {
+			map.insert(i, i * 2);
+		}
+		CHECK(map.size() == 100);
+		CHECK(map[50] == 100);
+	}
+	FrameArena::begin_frame();
+
+	CHECK(FrameArena::get_last_frame_usage() >= 1000 * sizeof(int) + 100 * sizeof(HashMapElement<int, int>));
+	CHECK(FrameArena::get_max_frame_usage() >= FrameArena::get_last_frame_usage());
+}
+
+TEST_CASE("[FrameArena] Memory is reused after a new frame") {
+	FrameArena::begin_frame();
+	void *first = FrameArena::alloc(64);
+	FrameArena::begin_frame();
+	void *second = FrameArena::alloc(64);
+	CHECK(first == second);
+
+	{
+		// A scope keeps the arena from being rewound.
+		FrameArena::Scope scope;
+		FrameArena::begin_frame();
+		void *third = FrameArena::alloc(64);
+		CHECK(third != second);
+	}
+}
+
+} // namespace TestFrameArena
+
+#endif // TEST_FRAME_ARENA_H
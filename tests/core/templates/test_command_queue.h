@@ -422,6 +422,109 @@ TEST_CASE("[Stress][CommandQueue] Stress test command queue") {
 	ProjectSettings::get_singleton()->set_setting(COMMAND_QUEUE_SETTING,
 			ProjectSettings::get_singleton()->property_get_revert(COMMAND_QUEUE_SETTING));
 }
+
+class MultiProducerState {
+public:
+	CommandQueueMT command_queue = CommandQueueMT(true);
+	Thread consumer_thread;
+	bool exit_consumer = false;
+
+	static const int MAX_PRODUCERS = 16;
+	uint64_t received[MAX_PRODUCERS] = {};
+	int order_errors = 0;
+	uint64_t total = 0;
+
+	int producer_count = 0;
+	int commands_per_producer = 0;
+
+	void receive(int p_producer, uint64_t p_index, Transform3D p_payload) {
+		if (received[p_producer] != p_index) {
+			order_errors++;
+		}
+		received[p_producer] = p_index + 1;
+		total++;
+	}
+	uint64_t receive_sync(int p_producer, uint64_t p_index) {
+		receive(p_producer, p_index, Transform3D());
+		return p_index;
+	}
+	void exit() {
+		exit_consumer = true;
+	}
+
+	static void consumer_loop(void *p_state) {
+		MultiProducerState *state = static_cast<MultiProducerState *>(p_state);
+		while (!state->exit_consumer) {
+			state->command_queue.wait_and_flush();
+		}
+	}
+
+	struct ProducerData {
+		MultiProducerState *state = nullptr;
+		int index = 0;
+		Thread thread;
+	};
+
+	static void producer_loop(void *p_data) {
+		ProducerData *data = static_cast<ProducerData *>(p_data);
+		MultiProducerState *state = data->state;
+		Transform3D payload;
+		for (int i = 0; i < state->commands_per_producer; i++) {
+			if (i % 1024 == 1023) {
+				uint64_t ret = 0;
+				state->command_queue.push_and_ret(state, &MultiProducerState::receive_sync, data->index, (uint64_t)i, &ret);
+			} else {
+				state->command_queue.push(state, &MultiProducerState::receive, data->index, (uint64_t)i, payload);
+			}
+		}
+	}
+
+	// Returns the elapsed time in microseconds.
+	uint64_t run(int p_producers, int p_commands_per_producer) {
+		producer_count = p_producers;
+		commands_per_producer = p_commands_per_producer;
+		consumer_thread.start(&MultiProducerState::consumer_loop, this);
+
+		ProducerData producers[MAX_PRODUCERS];
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < p_producers; i++) {
+			producers[i].state = this;
+			producers[i].index = i;
+			producers[i].thread.start(&MultiProducerState::producer_loop, &producers[i]);
+		}
+		for (int i = 0; i < p_producers; i++) {
+			producers[i].thread.wait_to_finish();
+		}
+		command_queue.push(this, &MultiProducerState::exit);
+		consumer_thread.wait_to_finish();
+		return MAX(OS::get_singleton()->get_ticks_usec() - begin, 1u);
+	}
+};
+
+TEST_CASE("[CommandQueue] Multiple producers keep per-producer order across blocks") {
+	MultiProducerState state;
+	// Enough commands to chain and recycle many blocks.
+	state.run(4, 20000);
+
+	CHECK_MESSAGE(state.order_errors == 0, "Commands from the same producer must be executed in push order.");
+	CHECK(state.total == 4 * 20000);
+	for (int i = 0; i < 4; i++) {
+		CHECK(state.received[i] == 20000);
+	}
+}
+
+TEST_CASE("[CommandQueue][Benchmark] Push throughput with 1, 4 and 16 producers" * doctest::skip()) {
+	const int total_commands = 1600000;
+	const int producer_counts[] = { 1, 4, 16 };
+
+	for (int producers : producer_counts) {
+		MultiProducerState state;
+		uint64_t usec = state.run(producers, total_commands / producers);
+		CHECK(state.order_errors == 0);
+		CHECK(state.total == (uint64_t)total_commands);
+		MESSAGE("Producers: ", producers, ", commands/sec: ", uint64_t(total_commands * 1000000.0 / usec));
+	}
+}
 } // namespace TestCommandQueue
 
 #endif // TEST_COMMAND_QUEUE_H
@@ -0,0 +1,144 @@
+/**************************************************************************/
+/*  test_task_graph.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_TASK_GRAPH_H
+#define TEST_TASK_GRAPH_H
+
+#include "core/object/task_graph.h"
+
+#include "tests/test_macros.h"
+
+namespace TestTaskGraph {
+
+static const int ELEMENTS = 256;
+
+struct ChainData {
+	SafeNumeric<uint32_t> stage;
+	SafeNumeric<uint32_t> elements_done;
+	SafeFlag order_broken;
+	SafeFlag continued;
+};
+
+static void first_stage(void *p_arg) {
+	ChainData *data = (ChainData *)p_arg;
+	data->stage.set(1);
+}
+
+static void group_stage(void *p_arg, uint32_t p_index) {
+	ChainData *data = (ChainData *)p_arg;
+	if (data->stage.get() != 1) {
+		data->order_broken.set();
+	}
+	data->elements_done.increment();
+}
+
+static void last_stage(void *p_arg) {
+	ChainData *data = (ChainData *)p_arg;
+	if (data->elements_done.get() != ELEMENTS) {
+		data->order_broken.set();
+	}
+	data->stage.set(2);
+}
+
+static void continuation(void *p_arg) {
+	ChainData *data = (ChainData *)p_arg;
+	if (data->stage.get() != 2) {
+		data->order_broken.set();
+	}
+	data->continued.set();
+}
+
+TEST_CASE("[TaskGraph] Nodes run after their dependencies") {
+	Ref<TaskGraph> graph;
+	graph.instantiate();
+
+	ChainData data;
+	TaskGraph::NodeID last = graph->add_native_task(last_stage, &data);
+	TaskGraph::NodeID group = graph->add_native_group_task(group_stage, &data, ELEMENTS);
+	TaskGraph::NodeID first = graph->add_native_task(first_stage, &data);
+	CHECK(graph->add_dependency(group, first) == OK);
+	CHECK(graph->add_dependency(last, group) == OK);
+	graph->set_native_continuation(continuation, &data);
+
+	for (int iterations = 0; iterations < 100; iterations++) {
+		data.stage.set(0);
+		data.elements_done.set(0);
+		data.continued.clear();
+
+		CHECK(graph->submit() == OK);
+		graph->wait();
+
+		CHECK(graph->is_completed());
+		CHECK_FALSE(graph->is_running());
+		CHECK(data.continued.is_set());
+		CHECK(data.stage.get() == 2);
+	}
+	CHECK_FALSE(data.order_broken.is_set());
+}
+
+TEST_CASE("[TaskGraph] Empty graphs and empty group tasks complete") {
+	Ref<TaskGraph> graph;
+	graph.instantiate();
+
+	CHECK(graph->submit() == OK);
+	graph->wait();
+	CHECK(graph->is_completed());
+
+	ChainData data;
+	TaskGraph::NodeID group = graph->add_native_group_task(group_stage, &data, 0);
+	TaskGraph::NodeID last = graph->add_native_task(first_stage, &data);
+	graph->add_dependency(last, group);
+	CHECK(graph->submit() == OK);
+	graph->wait();
+	CHECK(data.stage.get() == 1);
+	CHECK(data.elements_done.get() == 0);
+}
+
+TEST_CASE("[TaskGraph] Cyclic dependencies are rejected") {
+	Ref<TaskGraph> graph;
+	graph.instantiate();
+
+	TaskGraph::NodeID a = graph->add_native_task(first_stage, nullptr);
+	TaskGraph::NodeID b = graph->add_native_task(first_stage, nullptr);
+	TaskGraph::NodeID c = graph->add_native_task(first_stage, nullptr);
+	graph->add_dependency(b, a);
+	graph->add_dependency(c, b);
+	graph->add_dependency(a, c);
+
+	ERR_PRINT_OFF;
+	CHECK(graph->add_dependency(a, a) == ERR_CYCLIC_LINK);
+	CHECK(graph->submit() == ERR_CYCLIC_LINK);
+	ERR_PRINT_ON;
+	CHECK_FALSE(graph->is_running());
+}
+
+} // namespace TestTaskGraph
+
+#endif // TEST_TASK_GRAPH_H
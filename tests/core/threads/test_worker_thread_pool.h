@@ -106,6 +106,108 @@ TEST_CASE("[WorkerThreadPool] Process elements using group tasks") {
 	}
 }
 
+static void static_nested_group_test(void *p_arg, uint32_t p_index) {
+	counter[p_index].increment();
+}
+static WorkerThreadPool::GroupID nested_group = WorkerThreadPool::INVALID_TASK_ID;
+static void static_nesting_task_test(void *p_arg) {
+	// Group posted from a pool thread, so it goes through the thread's own queue and is stolen by the rest.
+	nested_group = WorkerThreadPool::get_singleton()->add_native_group_task(static_nested_group_test, nullptr, (uintptr_t)p_arg, -1, true);
+}
+TEST_CASE("[WorkerThreadPool] Process group tasks posted from pool threads") {
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const int count = Math::pow(2.0f, Math::random(0.0f, 12.0f));
+
+		counter.clear();
+		counter.resize(count);
+		WorkerThreadPool::TaskID task = WorkerThreadPool::get_singleton()->add_native_task(static_nesting_task_test, (void *)(uintptr_t)count, true);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(nested_group);
+
+		bool all_run_once = true;
+		for (int i = 0; i < count; i++) {
+			//Reduce number of check messages
+			all_run_once &= counter[i].get() == 1;
+		}
+		CHECK(all_run_once);
+	}
+}
+
+// Benchmarks, skipped by default. Run with `--test --no-skip --test-case="*Benchmark*"`.
+
+static SafeNumeric<uint64_t> bench_sink;
+
+static void static_bench_task(void *p_arg) {
+	bench_sink.increment();
+}
+static void static_bench_group(void *p_arg, uint32_t p_index) {
+	bench_sink.add(p_index);
+}
+static void static_bench_spawn_tasks(void *p_arg) {
+	const int count = (uintptr_t)p_arg;
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	tasks.resize(count);
+	for (int i = 0; i < count; i++) {
+		tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_bench_task, nullptr, true);
+	}
+	for (int i = 0; i < count; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(tasks[i]);
+	}
+}
+
+struct BenchResult {
+	uint64_t shared_usec = 0;
+	uint64_t local_usec = 0;
+	uint64_t group_usec = 0;
+};
+
+static BenchResult run_worker_thread_pool_bench(int p_task_count, int p_group_iterations, int p_group_elements) {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	BenchResult result;
+
+	// Tasks posted from outside the pool go through the shared (locked) queue.
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	static_bench_spawn_tasks((void *)(uintptr_t)p_task_count);
+	result.shared_usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, 1u);
+
+	// Tasks posted from a pool thread go through its own work-stealing queue (when enabled).
+	begin = OS::get_singleton()->get_ticks_usec();
+	WorkerThreadPool::TaskID spawner = pool->add_native_task(static_bench_spawn_tasks, (void *)(uintptr_t)p_task_count, true);
+	pool->wait_for_task_completion(spawner);
+	result.local_usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, 1u);
+
+	// Short group tasks, the typical culling/physics fan-out pattern.
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_group_iterations; i++) {
+		WorkerThreadPool::GroupID group = pool->add_native_group_task(static_bench_group, nullptr, p_group_elements, -1, true);
+		pool->wait_for_group_task_completion(group);
+	}
+	result.group_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	return result;
+}
+
+TEST_CASE("[WorkerThreadPool][Benchmark] Task throughput and group task latency" * doctest::skip()) {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	const int task_count = 100000;
+	const int group_iterations = 10000;
+	const int group_elements = 64;
+
+	// Baseline: the previous pool, where every task goes through the shared queue one lock and one post at a time.
+	const bool work_stealing_was_enabled = pool->is_work_stealing_enabled();
+	pool->set_work_stealing_enabled(false);
+	BenchResult baseline = run_worker_thread_pool_bench(task_count, group_iterations, group_elements);
+	pool->set_work_stealing_enabled(true);
+	BenchResult stealing = run_worker_thread_pool_bench(task_count, group_iterations, group_elements);
+	pool->set_work_stealing_enabled(work_stealing_was_enabled);
+
+	MESSAGE("Threads: ", pool->get_thread_count());
+	MESSAGE("Tasks/sec (posted from main thread): ", uint64_t(task_count * 1000000.0 / baseline.shared_usec), " baseline, ", uint64_t(task_count * 1000000.0 / stealing.shared_usec), " work-stealing");
+	MESSAGE("Tasks/sec (posted from pool thread): ", uint64_t(task_count * 1000000.0 / baseline.local_usec), " baseline, ", uint64_t(task_count * 1000000.0 / stealing.local_usec), " work-stealing");
+	MESSAGE("Group task latency (", group_elements, " elements): ", double(baseline.group_usec) / group_iterations, " usec baseline, ", double(stealing.group_usec) / group_iterations, " usec work-stealing");
+	CHECK(bench_sink.get() > 0);
+}
+
 } // namespace TestWorkerThreadPool
 
 #endif // TEST_WORKER_THREAD_POOL_H
@@ -31,6 +31,7 @@
 #ifndef TEST_NODE_H
 #define TEST_NODE_H
 
+#include "core/os/os.h"
 #include "scene/main/node.h"
 
 #include "tests/test_macros.h"
@@ -762,6 +763,211 @@ TEST_CASE("[SceneTree][Node] Test the process priority") {
 	memdelete(node4);
 }
 
+TEST_CASE("[SceneTree][Node] Sub-thread process groups and timings") {
+	SceneTree *tree = SceneTree::get_singleton();
+
+	const int group_count = 4;
+	const int node_count = 250;
+	LocalVector<Node *> group_owners;
+	LocalVector<TestNode *> nodes;
+	for (int i = 0; i < group_count; i++) {
+		Node *group_owner = memnew(Node);
+		group_owner->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+		tree->get_root()->add_child(group_owner);
+		group_owners.push_back(group_owner);
+
+		// Uneven sizes, so groups are dispatched by their cost.
+		for (int j = 0; j < node_count * (i + 1); j++) {
+			TestNode *node = memnew(TestNode);
+			group_owner->add_child(node);
+			node->set_process(true);
+			node->set_physics_process(true);
+			nodes.push_back(node);
+		}
+	}
+
+	tree->process(0);
+	tree->physics_process(0);
+	tree->process(0);
+
+	bool all_processed = true;
+	for (TestNode *node : nodes) {
+		all_processed = all_processed && node->process_counter == 2 && node->physics_process_counter == 1;
+	}
+	CHECK_MESSAGE(all_processed, "Every node of a sub-thread group should be processed exactly once per frame.");
+
+	TypedArray<Dictionary> timings = tree->get_process_group_timings();
+	int found_groups = 0;
+	for (int i = 0; i < timings.size(); i++) {
+		Dictionary timing = timings[i];
+		int64_t index = group_owners.find(Object::cast_to<Node>(timing["owner"]));
+		if (index >= 0) {
+			found_groups++;
+			CHECK(bool(timing["sub_thread"]));
+			CHECK(int(timing["process_node_count"]) == node_count * (index + 1));
+			CHECK(int(timing["physics_process_node_count"]) == node_count * (index + 1));
+			CHECK(double(timing["process_time"]) >= 0.0);
+		}
+	}
+	CHECK(found_groups == group_count);
+
+	for (Node *group_owner : group_owners) {
+		memdelete(group_owner);
+	}
+}
+
+TEST_CASE("[SceneTree][Node] Group membership churn keeps tree order") {
+	Node *parent = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(parent);
+
+	const int node_count = 64;
+	LocalVector<Node *> nodes;
+	for (int i = 0; i < node_count; i++) {
+		Node *node = memnew(Node);
+		parent->add_child(node);
+		nodes.push_back(node);
+	}
+
+	// Add in reverse order, so the group has to be sorted.
+	for (int i = node_count - 1; i >= 0; i--) {
+		nodes[i]->add_to_group("churn");
+	}
+
+	// Remove every third node, then add some of them back.
+	for (int i = 0; i < node_count; i += 3) {
+		nodes[i]->remove_from_group("churn");
+	}
+	for (int i = 0; i < node_count; i += 6) {
+		nodes[i]->add_to_group("churn");
+	}
+
+	List<Node *> in_group;
+	SceneTree::get_singleton()->get_nodes_in_group("churn", &in_group);
+	LocalVector<Node *> expected;
+	for (int i = 0; i < node_count; i++) {
+		if (i % 3 != 0 || i % 6 == 0) {
+			expected.push_back(nodes[i]);
+		}
+	}
+	CHECK(in_group.size() == (int)expected.size());
+	bool in_order = true;
+	int index = 0;
+	for (Node *node : in_group) {
+		in_order = in_order && index < (int)expected.size() && node == expected[index];
+		index++;
+	}
+	CHECK_MESSAGE(in_order, "Nodes in a group should be returned in tree order.");
+
+	// Removing nodes after the group was sorted, and adding more, must keep it consistent.
+	nodes[1]->remove_from_group("churn");
+	nodes[3]->add_to_group("churn");
+	CHECK(SceneTree::get_singleton()->get_first_node_in_group("churn") == nodes[0]);
+	nodes[0]->remove_from_group("churn");
+	CHECK(SceneTree::get_singleton()->get_first_node_in_group("churn") == nodes[2]);
+
+	// Moving a node changes the tree order.
+	parent->move_child(nodes[node_count - 2], 0);
+	CHECK(SceneTree::get_singleton()->get_first_node_in_group("churn") == nodes[node_count - 2]);
+
+	for (int i = 0; i < node_count; i++) {
+		nodes[i]->remove_from_group("churn");
+	}
+	CHECK_FALSE(SceneTree::get_singleton()->has_group("churn"));
+
+	memdelete(parent);
+}
+
+TEST_CASE("[SceneTree][Node] Group order after moving a subtree") {
+	Node *parent = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(parent);
+
+	// Two subtrees whose descendants share a group, sorted once.
+	Node *subtree_a = memnew(Node);
+	Node *subtree_b = memnew(Node);
+	parent->add_child(subtree_a);
+	parent->add_child(subtree_b);
+	LocalVector<Node *> children_a;
+	LocalVector<Node *> children_b;
+	for (int i = 0; i < 4; i++) {
+		children_a.push_back(memnew(Node));
+		subtree_a->add_child(children_a[i]);
+		children_a[i]->add_to_group("moved");
+		children_b.push_back(memnew(Node));
+		subtree_b->add_child(children_b[i]);
+		children_b[i]->add_to_group("moved");
+	}
+	CHECK(SceneTree::get_singleton()->get_first_node_in_group("moved") == children_a[0]);
+
+	// Move the second subtree first, then add a node so the group is merged rather than fully sorted.
+	parent->move_child(subtree_b, 0);
+	Node *added = memnew(Node);
+	subtree_a->add_child(added);
+	added->add_to_group("moved");
+
+	List<Node *> in_group;
+	SceneTree::get_singleton()->get_nodes_in_group("moved", &in_group);
+	LocalVector<Node *> expected;
+	for (Node *node : children_b) {
+		expected.push_back(node);
+	}
+	for (Node *node : children_a) {
+		expected.push_back(node);
+	}
+	expected.push_back(added);
+
+	CHECK(in_group.size() == (int)expected.size());
+	bool in_order = true;
+	int index = 0;
+	for (Node *node : in_group) {
+		in_order = in_order && index < (int)expected.size() && node == expected[index];
+		index++;
+	}
+	CHECK_MESSAGE(in_order, "Descendants of a moved subtree should stay in tree order in their groups.");
+
+	memdelete(parent);
+}
+
+TEST_CASE("[SceneTree][Node][Benchmark] Group add/remove churn" * doctest::skip()) {
+	Node *parent = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(parent);
+
+	const int node_count = 20000;
+	const int frames = 100;
+	const int churn_per_frame = 500;
+
+	LocalVector<Node *> nodes;
+	for (int i = 0; i < node_count; i++) {
+		Node *node = memnew(Node);
+		parent->add_child(node);
+		node->add_to_group("enemies");
+		nodes.push_back(node);
+	}
+	SceneTree::get_singleton()->get_first_node_in_group("enemies");
+
+	// Every frame, some "enemies" leave the group, some come back, and the group is iterated once.
+	const int unused_notification = 0x7FFF;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	uint32_t seed = 12345;
+	for (int f = 0; f < frames; f++) {
+		for (int i = 0; i < churn_per_frame; i++) {
+			seed = seed * 1664525u + 1013904223u;
+			Node *node = nodes[seed % node_count];
+			if (node->is_in_group("enemies")) {
+				node->remove_from_group("enemies");
+			} else {
+				node->add_to_group("enemies");
+			}
+		}
+		SceneTree::get_singleton()->notify_group("enemies", unused_notification);
+	}
+	uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	MESSAGE("Group of ", node_count, " nodes, ", churn_per_frame, " adds/removes per frame: ", double(usec) / frames, " usec/frame");
+	CHECK(SceneTree::get_singleton()->has_group("enemies"));
+
+	memdelete(parent);
+}
+
 } // namespace TestNode
 
 #endif // TEST_NODE_H
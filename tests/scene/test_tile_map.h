@@ -0,0 +1,192 @@
+/**************************************************************************/
+/*  test_tile_map.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_TILE_MAP_H
+#define TEST_TILE_MAP_H
+
+#include "scene/2d/tile_map.h"
+#include "scene/main/window.h"
+#include "scene/resources/canvas_item_material.h"
+#include "scene/resources/image_texture.h"
+#include "servers/rendering/renderer_canvas_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+
+namespace TestTileMap {
+
+typedef RendererCanvasRender::Item::Command Command;
+
+static LocalVector<const Command *> get_commands(RID p_item) {
+	LocalVector<const Command *> commands;
+	const RendererCanvasCull::Item *item = RSG::canvas->canvas_item_owner.get_or_null(p_item);
+	if (item) {
+		for (const Command *c = item->commands; c; c = c->next) {
+			commands.push_back(c);
+		}
+	}
+	return commands;
+}
+
+struct TestTileSet {
+	Ref<ImageTexture> texture;
+	Ref<TileSet> tile_set;
+	Ref<TileSetAtlasSource> atlas_source;
+	int source_id = TileSet::INVALID_SOURCE;
+
+	// A static tile at (0, 0) and a 2 frames animated tile at (0, 1).
+	TestTileSet() {
+		texture = ImageTexture::create_from_image(Image::create_empty(64, 64, false, Image::FORMAT_RGBA8));
+
+		tile_set.instantiate();
+		tile_set->set_tile_size(Size2i(16, 16));
+
+		atlas_source.instantiate();
+		atlas_source->set_use_texture_padding(false);
+		atlas_source->set_texture(texture);
+		atlas_source->set_texture_region_size(Vector2i(16, 16));
+		atlas_source->create_tile(Vector2i(0, 0));
+		atlas_source->create_tile(Vector2i(0, 1));
+		atlas_source->set_tile_animation_frames_count(Vector2i(0, 1), 2);
+		atlas_source->create_alternative_tile(Vector2i(0, 0), 1);
+		atlas_source->get_tile_data(Vector2i(0, 0), 1)->set_material(memnew(CanvasItemMaterial));
+		source_id = tile_set->add_source(atlas_source);
+	}
+};
+
+static void check_draw_tile_equivalence(const TestTileSet &p_test, const Vector2i &p_atlas_coords, int p_alternative_tile) {
+	RenderingServer *rs = RS::get_singleton();
+	RID direct = rs->canvas_item_create();
+	RID buffered = rs->canvas_item_create();
+
+	const TileData *tile_data = p_test.atlas_source->get_tile_data(p_atlas_coords, p_alternative_tile);
+	TileMap::draw_tile(direct, Vector2(8, 24), p_test.tile_set, p_test.source_id, p_atlas_coords, p_alternative_tile, -1, Color(1, 0.5, 1), tile_data, 0.25);
+
+	CanvasItemCommandBuffer buffer;
+	TileMap::draw_tile_to_command_buffer(buffer, p_test.texture->get_rid(), Vector2(8, 24), p_test.tile_set, p_test.source_id, p_atlas_coords, p_alternative_tile, Color(1, 0.5, 1), tile_data, 0.25);
+	rs->canvas_item_add_command_buffer(buffered, buffer.to_byte_array());
+
+	LocalVector<const Command *> a = get_commands(direct);
+	LocalVector<const Command *> b = get_commands(buffered);
+	REQUIRE(a.size() > 0);
+	REQUIRE(a.size() == b.size());
+	for (uint32_t i = 0; i < a.size(); i++) {
+		REQUIRE(a[i]->type == b[i]->type);
+		if (a[i]->type == Command::TYPE_RECT) {
+			const RendererCanvasRender::Item::CommandRect *ra = static_cast<const RendererCanvasRender::Item::CommandRect *>(a[i]);
+			const RendererCanvasRender::Item::CommandRect *rb = static_cast<const RendererCanvasRender::Item::CommandRect *>(b[i]);
+			CHECK(ra->rect.is_equal_approx(rb->rect));
+			CHECK(ra->source.is_equal_approx(rb->source));
+			CHECK(ra->modulate.is_equal_approx(rb->modulate));
+			CHECK(ra->texture == rb->texture);
+			CHECK(ra->flags == rb->flags);
+		} else if (a[i]->type == Command::TYPE_ANIMATION_SLICE) {
+			const RendererCanvasRender::Item::CommandAnimationSlice *sa = static_cast<const RendererCanvasRender::Item::CommandAnimationSlice *>(a[i]);
+			const RendererCanvasRender::Item::CommandAnimationSlice *sb = static_cast<const RendererCanvasRender::Item::CommandAnimationSlice *>(b[i]);
+			CHECK(sa->animation_length == doctest::Approx(sb->animation_length));
+			CHECK(sa->slice_begin == doctest::Approx(sb->slice_begin));
+			CHECK(sa->slice_end == doctest::Approx(sb->slice_end));
+			CHECK(sa->offset == doctest::Approx(sb->offset));
+		}
+	}
+
+	rs->free(direct);
+	rs->free(buffered);
+}
+
+TEST_CASE("[SceneTree][TileMap] Tiles recorded into command buffers match draw_tile()") {
+	TestTileSet test;
+
+	SUBCASE("Static tile") {
+		check_draw_tile_equivalence(test, Vector2i(0, 0), 0);
+	}
+	SUBCASE("Flipped and transposed tile") {
+		check_draw_tile_equivalence(test, Vector2i(0, 0), TileSetAtlasSource::TRANSFORM_FLIP_H | TileSetAtlasSource::TRANSFORM_TRANSPOSE);
+	}
+	SUBCASE("Animated tile") {
+		check_draw_tile_equivalence(test, Vector2i(0, 1), 0);
+	}
+}
+
+TEST_CASE("[SceneTree][TileMap] Quadrants are rebuilt into canvas items") {
+	TestTileSet test;
+
+	TileMap *tile_map = memnew(TileMap);
+	tile_map->set_tileset(test.tile_set);
+	tile_map->set_rendering_quadrant_size(16);
+	SceneTree::get_singleton()->get_root()->add_child(tile_map);
+
+	// 4 quadrants, each with a column of tiles using another material.
+	const int size = 32;
+	for (int y = 0; y < size; y++) {
+		for (int x = 0; x < size; x++) {
+			tile_map->set_cell(0, Vector2i(x, y), test.source_id, Vector2i(0, 0), x % 16 == 3 ? 1 : 0);
+		}
+	}
+	tile_map->_internal_update();
+
+	// The TileMap canvas item holds one per layer, which hold the quadrants' ones.
+	int quadrant_canvas_items = 0;
+	int rects = 0;
+	const RendererCanvasCull::Item *tile_map_item = RSG::canvas->canvas_item_owner.get_or_null(tile_map->get_canvas_item());
+	REQUIRE(tile_map_item);
+	for (const RendererCanvasCull::Item *layer_item : tile_map_item->child_items) {
+		for (const RendererCanvasCull::Item *quadrant_item : layer_item->child_items) {
+			quadrant_canvas_items++;
+			for (const Command *c = quadrant_item->commands; c; c = c->next) {
+				rects += c->type == Command::TYPE_RECT;
+			}
+		}
+	}
+	// Cells are drawn column by column, so columns 0-2, 3 and 4-15 of each quadrant use distinct canvas items.
+	CHECK(quadrant_canvas_items == 4 * 3);
+	CHECK(rects == size * size);
+
+	SUBCASE("Erasing cells frees the empty quadrants") {
+		for (int y = 0; y < size; y++) {
+			for (int x = 0; x < 16; x++) {
+				tile_map->erase_cell(0, Vector2i(x, y));
+			}
+		}
+		tile_map->_internal_update();
+
+		quadrant_canvas_items = 0;
+		for (const RendererCanvasCull::Item *layer_item : tile_map_item->child_items) {
+			quadrant_canvas_items += layer_item->child_items.size();
+		}
+		CHECK(quadrant_canvas_items == 2 * 3);
+	}
+
+	memdelete(tile_map);
+}
+
+} // namespace TestTileMap
+
+#endif // TEST_TILE_MAP_H
@@ -0,0 +1,223 @@
+/**************************************************************************/
+/*  test_canvas_item_command_buffer.h                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_CANVAS_ITEM_COMMAND_BUFFER_H
+#define TEST_CANVAS_ITEM_COMMAND_BUFFER_H
+
+#include "servers/rendering/canvas_item_command_buffer.h"
+#include "servers/rendering/renderer_canvas_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+
+namespace TestCanvasItemCommandBuffer {
+
+typedef RendererCanvasRender::Item::Command Command;
+
+static LocalVector<const Command *> get_commands(RID p_item) {
+	LocalVector<const Command *> commands;
+	const RendererCanvasCull::Item *item = RSG::canvas->canvas_item_owner.get_or_null(p_item);
+	if (item) {
+		for (const Command *c = item->commands; c; c = c->next) {
+			commands.push_back(c);
+		}
+	}
+	return commands;
+}
+
+static void check_same_commands(RID p_a, RID p_b) {
+	LocalVector<const Command *> a = get_commands(p_a);
+	LocalVector<const Command *> b = get_commands(p_b);
+	REQUIRE(a.size() == b.size());
+
+	for (uint32_t i = 0; i < a.size(); i++) {
+		REQUIRE(a[i]->type == b[i]->type);
+		switch (a[i]->type) {
+			case Command::TYPE_RECT: {
+				const RendererCanvasRender::Item::CommandRect *ra = static_cast<const RendererCanvasRender::Item::CommandRect *>(a[i]);
+				const RendererCanvasRender::Item::CommandRect *rb = static_cast<const RendererCanvasRender::Item::CommandRect *>(b[i]);
+				CHECK(ra->rect.is_equal_approx(rb->rect));
+				CHECK(ra->source.is_equal_approx(rb->source));
+				CHECK(ra->modulate.is_equal_approx(rb->modulate));
+				CHECK(ra->texture == rb->texture);
+				CHECK(ra->flags == rb->flags);
+				CHECK(ra->outline == doctest::Approx(rb->outline));
+				CHECK(ra->px_range == doctest::Approx(rb->px_range));
+			} break;
+			case Command::TYPE_TRANSFORM: {
+				const RendererCanvasRender::Item::CommandTransform *ta = static_cast<const RendererCanvasRender::Item::CommandTransform *>(a[i]);
+				const RendererCanvasRender::Item::CommandTransform *tb = static_cast<const RendererCanvasRender::Item::CommandTransform *>(b[i]);
+				CHECK(ta->xform.is_equal_approx(tb->xform));
+			} break;
+			case Command::TYPE_CLIP_IGNORE: {
+				CHECK(static_cast<const RendererCanvasRender::Item::CommandClipIgnore *>(a[i])->ignore == static_cast<const RendererCanvasRender::Item::CommandClipIgnore *>(b[i])->ignore);
+			} break;
+			case Command::TYPE_ANIMATION_SLICE: {
+				const RendererCanvasRender::Item::CommandAnimationSlice *sa = static_cast<const RendererCanvasRender::Item::CommandAnimationSlice *>(a[i]);
+				const RendererCanvasRender::Item::CommandAnimationSlice *sb = static_cast<const RendererCanvasRender::Item::CommandAnimationSlice *>(b[i]);
+				CHECK(sa->animation_length == sb->animation_length);
+				CHECK(sa->slice_begin == sb->slice_begin);
+				CHECK(sa->slice_end == sb->slice_end);
+				CHECK(sa->offset == sb->offset);
+			} break;
+			default: {
+			} break;
+		}
+	}
+}
+
+TEST_CASE("[SceneTree][CanvasItemCommandBuffer] Buffer produces the same commands as individual calls") {
+	RenderingServer *rs = RS::get_singleton();
+	RID canvas = rs->canvas_create();
+	RID direct = rs->canvas_item_create();
+	RID buffered = rs->canvas_item_create();
+	rs->canvas_item_set_parent(direct, canvas);
+	rs->canvas_item_set_parent(buffered, canvas);
+
+	// Never dereferenced by the cull, only stored.
+	const RID texture = RID::from_uint64(0x1234);
+
+	rs->canvas_item_add_rect(direct, Rect2(1, 2, 3, 4), Color(0.1, 0.2, 0.3, 0.4));
+	rs->canvas_item_add_texture_rect(direct, Rect2(0, 0, -16, 16), texture, true, Color(1, 0, 0), true);
+	rs->canvas_item_add_texture_rect_region(direct, Rect2(5, 6, 7, -8), texture, Rect2(0, 0, -2, 2), Color(0, 1, 0), true, true);
+	rs->canvas_item_add_msdf_texture_rect_region(direct, Rect2(10, 10, 20, 20), texture, Rect2(1, 1, 8, 8), Color(0, 0, 1), 3, 4.0, 2.0);
+	rs->canvas_item_add_lcd_texture_rect_region(direct, Rect2(-5, -5, 10, 10), texture, Rect2(2, 2, 4, 4), Color(1, 1, 0));
+	rs->canvas_item_add_set_transform(direct, Transform2D(0.5, Vector2(10, 20)));
+	rs->canvas_item_add_clip_ignore(direct, true);
+	rs->canvas_item_add_animation_slice(direct, 2.0, 0.5, 1.5, 0.25);
+
+	CanvasItemCommandBuffer buffer;
+	buffer.add_rect(Rect2(1, 2, 3, 4), Color(0.1, 0.2, 0.3, 0.4));
+	buffer.add_texture_rect(Rect2(0, 0, -16, 16), texture, true, Color(1, 0, 0), true);
+	buffer.add_texture_rect_region(Rect2(5, 6, 7, -8), texture, Rect2(0, 0, -2, 2), Color(0, 1, 0), true, true);
+	buffer.add_msdf_texture_rect_region(Rect2(10, 10, 20, 20), texture, Rect2(1, 1, 8, 8), Color(0, 0, 1), 3, 4.0, 2.0);
+	buffer.add_lcd_texture_rect_region(Rect2(-5, -5, 10, 10), texture, Rect2(2, 2, 4, 4), Color(1, 1, 0));
+	buffer.add_set_transform(Transform2D(0.5, Vector2(10, 20)));
+	buffer.add_clip_ignore(true);
+	buffer.add_animation_slice(2.0, 0.5, 1.5, 0.25);
+	CHECK(buffer.get_command_count() == 8);
+	rs->canvas_item_add_command_buffer(buffered, buffer.to_byte_array());
+
+	CHECK(get_commands(buffered).size() == 8);
+	check_same_commands(direct, buffered);
+
+	SUBCASE("Truncated buffers keep the complete commands") {
+		RID truncated = rs->canvas_item_create();
+		Vector<uint8_t> bytes = buffer.to_byte_array();
+		bytes.resize(bytes.size() - 4);
+
+		ERR_PRINT_OFF;
+		rs->canvas_item_add_command_buffer(truncated, bytes);
+		ERR_PRINT_ON;
+		CHECK(get_commands(truncated).size() == 7);
+		rs->free(truncated);
+	}
+
+	rs->free(buffered);
+	rs->free(direct);
+	rs->free(canvas);
+}
+
+TEST_CASE("[SceneTree][CanvasItemCommandBuffer] Rects and transforms keep real_t precision") {
+	RenderingServer *rs = RS::get_singleton();
+	RID canvas = rs->canvas_create();
+	RID direct = rs->canvas_item_create();
+	RID buffered = rs->canvas_item_create();
+	rs->canvas_item_set_parent(direct, canvas);
+	rs->canvas_item_set_parent(buffered, canvas);
+
+	// Not representable as a 32-bit float, so only exact with real_t storage in double builds.
+	const real_t far = 16777216.0 + 0.125;
+
+	rs->canvas_item_add_rect(direct, Rect2(far, -far, 3, 4), Color(1, 1, 1));
+	rs->canvas_item_add_set_transform(direct, Transform2D(0.5, Vector2(far, far)));
+
+	CanvasItemCommandBuffer buffer;
+	buffer.add_rect(Rect2(far, -far, 3, 4), Color(1, 1, 1));
+	buffer.add_set_transform(Transform2D(0.5, Vector2(far, far)));
+	rs->canvas_item_add_command_buffer(buffered, buffer.to_byte_array());
+
+	LocalVector<const Command *> a = get_commands(direct);
+	LocalVector<const Command *> b = get_commands(buffered);
+	REQUIRE(a.size() == 2);
+	REQUIRE(b.size() == 2);
+	CHECK(static_cast<const RendererCanvasRender::Item::CommandRect *>(a[0])->rect == static_cast<const RendererCanvasRender::Item::CommandRect *>(b[0])->rect);
+	CHECK(static_cast<const RendererCanvasRender::Item::CommandTransform *>(a[1])->xform == static_cast<const RendererCanvasRender::Item::CommandTransform *>(b[1])->xform);
+
+	rs->free(buffered);
+	rs->free(direct);
+	rs->free(canvas);
+}
+
+TEST_CASE("[SceneTree][CanvasItemCommandBuffer] Recording keeps the command order") {
+	RenderingServer *rs = RS::get_singleton();
+	RID canvas = rs->canvas_create();
+	RID item = rs->canvas_item_create();
+	RID other = rs->canvas_item_create();
+	rs->canvas_item_set_parent(item, canvas);
+	rs->canvas_item_set_parent(other, canvas);
+
+	rs->canvas_item_begin_command_buffer(item);
+	rs->canvas_item_add_rect(item, Rect2(0, 0, 1, 1), Color(1, 1, 1));
+	// Not recorded, only the recorded item is batched.
+	rs->canvas_item_add_rect(other, Rect2(0, 0, 1, 1), Color(1, 1, 1));
+	CHECK(get_commands(item).size() == 0);
+	CHECK(get_commands(other).size() == 1);
+
+	// Can't be recorded, so what was recorded before is submitted first.
+	rs->canvas_item_add_circle(item, Vector2(), 4.0, Color(1, 1, 1));
+	rs->canvas_item_add_set_transform(item, Transform2D());
+	rs->canvas_item_end_command_buffer();
+
+	LocalVector<const Command *> commands = get_commands(item);
+	REQUIRE(commands.size() == 3);
+	CHECK(commands[0]->type == Command::TYPE_RECT);
+	CHECK(commands[1]->type == Command::TYPE_POLYGON);
+	CHECK(commands[2]->type == Command::TYPE_TRANSFORM);
+
+	// Clearing drops what was recorded before.
+	rs->canvas_item_begin_command_buffer(item);
+	rs->canvas_item_add_rect(item, Rect2(0, 0, 1, 1), Color(1, 1, 1));
+	rs->canvas_item_clear(item);
+	rs->canvas_item_add_clip_ignore(item, true);
+	rs->canvas_item_end_command_buffer();
+
+	commands = get_commands(item);
+	REQUIRE(commands.size() == 1);
+	CHECK(commands[0]->type == Command::TYPE_CLIP_IGNORE);
+
+	rs->free(other);
+	rs->free(item);
+	rs->free(canvas);
+}
+
+} // namespace TestCanvasItemCommandBuffer
+
+#endif // TEST_CANVAS_ITEM_COMMAND_BUFFER_H
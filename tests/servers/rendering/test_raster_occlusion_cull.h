@@ -0,0 +1,199 @@
+/**************************************************************************/
+/*  test_raster_occlusion_cull.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RASTER_OCCLUSION_CULL_H
+#define TEST_RASTER_OCCLUSION_CULL_H
+
+#include "servers/rendering/raster_occlusion_cull.h"
+
+#include "tests/test_macros.h"
+
+// Creating a culler makes it the global one, this restores the engine's cullers when going out of scope.
+class TestOcclusionCullSingletonScope {
+	RendererSceneOcclusionCull *prev_singleton = nullptr;
+	RendererSceneOcclusionCull *prev_software_singleton = nullptr;
+	bool prev_software_mirror_enabled = false;
+
+public:
+	TestOcclusionCullSingletonScope() {
+		prev_singleton = RendererSceneOcclusionCull::singleton;
+		prev_software_singleton = RendererSceneOcclusionCull::software_singleton;
+		prev_software_mirror_enabled = RendererSceneOcclusionCull::software_mirror_enabled;
+	}
+	~TestOcclusionCullSingletonScope() {
+		RendererSceneOcclusionCull::singleton = prev_singleton;
+		RendererSceneOcclusionCull::software_singleton = prev_software_singleton;
+		RendererSceneOcclusionCull::software_mirror_enabled = prev_software_mirror_enabled;
+	}
+};
+
+namespace TestRasterOcclusionCull {
+
+static const Size2i BUFFER_SIZE = Size2i(256, 144);
+
+static void add_quad(PackedVector3Array &r_vertices, PackedInt32Array &r_indices, const Vector3 &p_origin, const Vector3 &p_u, const Vector3 &p_v, int p_subdivisions) {
+	const int base = r_vertices.size();
+	for (int y = 0; y <= p_subdivisions; y++) {
+		for (int x = 0; x <= p_subdivisions; x++) {
+			r_vertices.push_back(p_origin + p_u * (float(x) / p_subdivisions) + p_v * (float(y) / p_subdivisions));
+		}
+	}
+	for (int y = 0; y < p_subdivisions; y++) {
+		for (int x = 0; x < p_subdivisions; x++) {
+			int i = base + y * (p_subdivisions + 1) + x;
+			r_indices.push_back(i);
+			r_indices.push_back(i + 1);
+			r_indices.push_back(i + p_subdivisions + 2);
+			r_indices.push_back(i);
+			r_indices.push_back(i + p_subdivisions + 2);
+			r_indices.push_back(i + p_subdivisions + 1);
+		}
+	}
+}
+
+static RID add_occluder(RendererSceneOcclusionCull *p_cull, RID p_scenario, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices, const Transform3D &p_xform, LocalVector<RID> &r_rids) {
+	RID occluder = p_cull->occluder_allocate();
+	p_cull->occluder_initialize(occluder);
+	p_cull->occluder_set_mesh(occluder, p_vertices, p_indices);
+
+	RID instance = RID::from_uint64(0x10000 + r_rids.size());
+	p_cull->scenario_set_instance(p_scenario, instance, occluder, p_xform, true);
+	r_rids.push_back(occluder);
+	return instance;
+}
+
+// Reference scene shared with the ray traced implementation's tests: a finely
+// subdivided wall, a ground plane, a rotated box and a ceiling strip that
+// crosses the camera near plane.
+static void build_reference_scene(RendererSceneOcclusionCull *p_cull, RID p_scenario, LocalVector<RID> &r_occluders) {
+	{
+		PackedVector3Array vertices;
+		PackedInt32Array indices;
+		add_quad(vertices, indices, Vector3(-3, -2, -10), Vector3(6, 0, 0), Vector3(0, 4, 0), 16);
+		add_occluder(p_cull, p_scenario, vertices, indices, Transform3D(), r_occluders);
+	}
+	{
+		PackedVector3Array vertices;
+		PackedInt32Array indices;
+		add_quad(vertices, indices, Vector3(-30, -1, -1), Vector3(0, 0, -59), Vector3(60, 0, 0), 1);
+		add_occluder(p_cull, p_scenario, vertices, indices, Transform3D(), r_occluders);
+	}
+	{
+		PackedVector3Array vertices;
+		PackedInt32Array indices;
+		for (int axis = 0; axis < 3; axis++) {
+			Vector3 u;
+			Vector3 v;
+			Vector3 n;
+			u[(axis + 1) % 3] = 2;
+			v[(axis + 2) % 3] = 2;
+			n[axis] = 1;
+			add_quad(vertices, indices, -n - u * 0.5 - v * 0.5, u, v, 1);
+			add_quad(vertices, indices, n - u * 0.5 - v * 0.5, u, v, 1);
+		}
+		Transform3D xform(Basis(Vector3(0, 1, 0), Math::deg_to_rad(30.0)), Vector3(5, 0, -15));
+		add_occluder(p_cull, p_scenario, vertices, indices, xform, r_occluders);
+	}
+	{
+		PackedVector3Array vertices;
+		vertices.push_back(Vector3(-1, 1, 2));
+		vertices.push_back(Vector3(1, 1, 2));
+		vertices.push_back(Vector3(0, 1, -5));
+		PackedInt32Array indices;
+		indices.push_back(0);
+		indices.push_back(1);
+		indices.push_back(2);
+		add_occluder(p_cull, p_scenario, vertices, indices, Transform3D(), r_occluders);
+	}
+}
+
+static Projection get_reference_projection() {
+	Projection projection;
+	projection.set_perspective(70.0, float(BUFFER_SIZE.x) / BUFFER_SIZE.y, 0.05, 100.0);
+	return projection;
+}
+
+static bool is_box_occluded(RendererSceneOcclusionCull *p_cull, RID p_buffer, const Vector3 &p_center, real_t p_half_size, const Transform3D &p_cam_transform) {
+	const RendererSceneOcclusionCull::HZBuffer *buffer = p_cull->buffer_get_ptr(p_buffer);
+	const real_t bounds[6] = {
+		p_center.x - p_half_size, p_center.y - p_half_size, p_center.z - p_half_size,
+		p_center.x + p_half_size, p_center.y + p_half_size, p_center.z + p_half_size
+	};
+	const Projection projection = get_reference_projection();
+	return buffer->is_occluded(bounds, p_cam_transform.origin, p_cam_transform.affine_inverse(), projection, projection.get_z_near());
+}
+
+TEST_CASE("[RasterOcclusionCull] Reference scene visibility") {
+	TestOcclusionCullSingletonScope singleton_scope; // Keep the engine's cullers registered.
+	RasterOcclusionCull *cull = memnew(RasterOcclusionCull);
+
+	RID scenario = RID::from_uint64(1);
+	RID buffer = RID::from_uint64(2);
+	LocalVector<RID> occluders;
+
+	cull->add_scenario(scenario);
+	build_reference_scene(cull, scenario, occluders);
+
+	cull->add_buffer(buffer);
+	cull->buffer_set_scenario(buffer, scenario);
+	cull->buffer_set_size(buffer, BUFFER_SIZE);
+
+	const Transform3D cam_transform;
+	cull->buffer_update(buffer, cam_transform, get_reference_projection(), false);
+
+	CHECK_MESSAGE(is_box_occluded(cull, buffer, Vector3(0, 0, -20), 0.5, cam_transform), "A box right behind the wall should be occluded.");
+	CHECK_MESSAGE(!is_box_occluded(cull, buffer, Vector3(0, 0, -5), 0.5, cam_transform), "A box in front of the wall should be visible.");
+	CHECK_MESSAGE(!is_box_occluded(cull, buffer, Vector3(-12, 2, -15), 0.5, cam_transform), "A box beside the wall should be visible.");
+	CHECK_MESSAGE(is_box_occluded(cull, buffer, Vector3(-6, -4, -20), 0.5, cam_transform), "A box below the ground should be occluded.");
+	CHECK_MESSAGE(is_box_occluded(cull, buffer, Vector3(6.5, 0, -20), 0.5, cam_transform), "A box behind the rotated box should be occluded.");
+	CHECK_MESSAGE(is_box_occluded(cull, buffer, Vector3(0, 2, -2.5), 0.125, cam_transform), "A box above the near-clipped ceiling should be occluded.");
+
+	// Turning the camera around leaves every occluder behind it.
+	const Transform3D turned_transform(Basis(Vector3(0, 1, 0), Math_PI), Vector3());
+	cull->buffer_update(buffer, turned_transform, get_reference_projection(), false);
+	CHECK_MESSAGE(!is_box_occluded(cull, buffer, Vector3(0, 0, 20), 0.5, turned_transform), "Occluders behind the camera should not occlude anything.");
+
+	// Disabling the wall reveals what was behind it.
+	cull->scenario_set_instance(scenario, RID::from_uint64(0x10000), occluders[0], Transform3D(), false);
+	cull->buffer_update(buffer, cam_transform, get_reference_projection(), false);
+	CHECK_MESSAGE(!is_box_occluded(cull, buffer, Vector3(0, 0, -20), 0.5, cam_transform), "Disabled occluders should not occlude.");
+
+	cull->remove_buffer(buffer);
+	for (uint32_t i = 0; i < occluders.size(); i++) {
+		cull->scenario_remove_instance(scenario, RID::from_uint64(0x10000 + i));
+		cull->free_occluder(occluders[i]);
+	}
+	cull->remove_scenario(scenario);
+	memdelete(cull);
+}
+
+} // namespace TestRasterOcclusionCull
+
+#endif // TEST_RASTER_OCCLUSION_CULL_H
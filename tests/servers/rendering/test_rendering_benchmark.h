@@ -0,0 +1,433 @@
+/**************************************************************************/
+/*  test_rendering_benchmark.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERING_BENCHMARK_H
+#define TEST_RENDERING_BENCHMARK_H
+
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/math/random_pcg.h"
+#include "core/object/message_queue.h"
+#include "servers/display_server.h"
+#include "servers/rendering/renderer_canvas_cull.h"
+#include "servers/rendering/rendering_server_default.h"
+#include "servers/rendering/rendering_server_globals.h"
+#include "servers/rendering/storage/render_scene_buffers.h"
+
+#include "tests/test_macros.h"
+
+// Render-thread CPU benchmark running on the dummy renderer.
+//
+// The dummy rasterizer has no render targets, so viewports never reach the
+// culling code through `draw_viewports()`. The harness drives the same stages
+// directly on a generated scene instead, and reports how long each of them
+// takes and how many allocations it performs:
+//
+//   godot --test rendering-benchmark [--meshes N] [--lights N] [--canvas-items N]
+//         [--frames N] [--benchmark-file <path>]
+//
+// The report is printed as JSON, or written to the given file.
+
+namespace TestRenderingBenchmark {
+
+// Placeholder scene buffers, culling refuses to run without render buffers.
+class BenchmarkRenderSceneBuffers : public RenderSceneBuffers {
+	GDCLASS(BenchmarkRenderSceneBuffers, RenderSceneBuffers);
+
+public:
+	virtual void configure(const RenderSceneBuffersConfiguration *p_config) override {}
+	virtual void set_fsr_sharpness(float p_fsr_sharpness) override {}
+	virtual void set_texture_mipmap_bias(float p_texture_mipmap_bias) override {}
+	virtual void set_use_debanding(bool p_use_debanding) override {}
+};
+
+struct Config {
+	int meshes = 10000;
+	int lights = 64;
+	int canvas_items = 10000;
+	int frames = 120;
+	// Fraction of instances and canvas items moved every frame.
+	float moving_ratio = 0.1;
+	Size2i viewport_size = Size2i(1920, 1080);
+	uint64_t seed = 1234;
+};
+
+enum Stage {
+	STAGE_SUBMIT,
+	STAGE_SCENE_UPDATE,
+	STAGE_SCENE_CULL,
+	STAGE_CANVAS_CULL,
+	STAGE_VIEWPORT_DRAW,
+	STAGE_MAX,
+};
+
+static const char *stage_names[STAGE_MAX] = {
+	"submit",
+	"scene_update",
+	"scene_cull",
+	"canvas_cull",
+	"viewport_draw",
+};
+
+struct StageStats {
+	uint64_t total_usec = 0;
+	uint64_t min_usec = UINT64_MAX;
+	uint64_t max_usec = 0;
+	uint64_t allocations = 0;
+	int64_t memory_delta = 0;
+};
+
+class Benchmark {
+	Config config;
+	RandomPCG rng;
+
+	RID scenario;
+	RID mesh;
+	RID camera;
+	RID canvas;
+	RID viewport;
+	LocalVector<RID> mesh_instances;
+	LocalVector<RID> lights;
+	LocalVector<RID> light_instances;
+	LocalVector<RID> canvas_items;
+
+	Ref<RenderSceneBuffers> render_buffers;
+	StageStats stats[STAGE_MAX];
+
+	uint64_t stage_usec = 0;
+	uint64_t stage_allocations = 0;
+	uint64_t stage_memory = 0;
+
+	real_t _randf(real_t p_from, real_t p_to) {
+		return rng.random(float(p_from), float(p_to));
+	}
+
+	Transform3D _random_transform(real_t p_extent) {
+		Basis basis = Basis::from_euler(Vector3(_randf(-Math_PI, Math_PI), _randf(-Math_PI, Math_PI), 0));
+		return Transform3D(basis, Vector3(_randf(-p_extent, p_extent), _randf(-p_extent, p_extent), _randf(-p_extent, p_extent)));
+	}
+
+	Transform2D _random_transform_2d() {
+		// Twice the viewport size, so roughly three quarters of the items are culled.
+		const Size2 size = config.viewport_size;
+		return Transform2D(_randf(-Math_PI, Math_PI), Vector2(_randf(-size.x * 0.5, size.x * 1.5), _randf(-size.y * 0.5, size.y * 1.5)));
+	}
+
+	static uint64_t _get_allocation_count() {
+#ifdef ALLOCATION_TRACKING_ENABLED
+		return AllocationTracker::get_total_allocations();
+#else
+		return 0;
+#endif
+	}
+
+	void _stage_begin() {
+		stage_allocations = _get_allocation_count();
+		stage_memory = Memory::get_mem_usage();
+		stage_usec = OS::get_singleton()->get_ticks_usec();
+	}
+
+	void _stage_end(Stage p_stage) {
+		const uint64_t usec = OS::get_singleton()->get_ticks_usec() - stage_usec;
+		StageStats &s = stats[p_stage];
+		s.total_usec += usec;
+		s.min_usec = MIN(s.min_usec, usec);
+		s.max_usec = MAX(s.max_usec, usec);
+		s.allocations += _get_allocation_count() - stage_allocations;
+		s.memory_delta += int64_t(Memory::get_mem_usage()) - int64_t(stage_memory);
+	}
+
+public:
+	void setup() {
+		RenderingServer *rs = RS::get_singleton();
+		rng.seed(config.seed);
+
+		// Cube of instances sized so the camera frustum covers about half of it.
+		const real_t extent = Math::pow(real_t(MAX(config.meshes, 1)), real_t(1.0 / 3.0)) * 2.0;
+
+		scenario = rs->scenario_create();
+		mesh = rs->mesh_create();
+		mesh_instances.resize(config.meshes);
+		for (int i = 0; i < config.meshes; i++) {
+			RID instance = rs->instance_create2(mesh, scenario);
+			// Dummy meshes have no surfaces, give the instances a size to cull.
+			rs->instance_set_custom_aabb(instance, AABB(Vector3(-0.5, -0.5, -0.5), Vector3(1, 1, 1)));
+			rs->instance_set_transform(instance, _random_transform(extent));
+			mesh_instances[i] = instance;
+		}
+
+		lights.resize(config.lights);
+		light_instances.resize(config.lights);
+		for (int i = 0; i < config.lights; i++) {
+			RID light = (i % 4 == 3) ? rs->spot_light_create() : rs->omni_light_create();
+			rs->light_set_param(light, RS::LIGHT_PARAM_RANGE, extent * 0.25);
+			RID instance = rs->instance_create2(light, scenario);
+			rs->instance_set_transform(instance, _random_transform(extent));
+			lights[i] = light;
+			light_instances[i] = instance;
+		}
+
+		camera = rs->camera_create();
+		rs->camera_set_perspective(camera, 70.0, 0.05, extent * 4.0);
+		rs->camera_set_transform(camera, Transform3D(Basis(), Vector3(0, 0, extent)));
+
+		canvas = rs->canvas_create();
+		canvas_items.resize(config.canvas_items);
+		for (int i = 0; i < config.canvas_items; i++) {
+			RID item = rs->canvas_item_create();
+			rs->canvas_item_set_parent(item, canvas);
+			rs->canvas_item_add_rect(item, Rect2(0, 0, 32, 32), Color(1, 1, 1));
+			rs->canvas_item_set_transform(item, _random_transform_2d());
+			canvas_items[i] = item;
+		}
+
+		// Not drawn by the dummy renderer, but keeps the viewport bookkeeping
+		// of `draw_viewports()` representative.
+		viewport = rs->viewport_create();
+		rs->viewport_set_size(viewport, config.viewport_size.x, config.viewport_size.y);
+		rs->viewport_set_scenario(viewport, scenario);
+		rs->viewport_attach_camera(viewport, camera);
+		rs->viewport_attach_canvas(viewport, canvas);
+		rs->viewport_set_active(viewport, true);
+
+		render_buffers = Ref<RenderSceneBuffers>(memnew(BenchmarkRenderSceneBuffers));
+
+		// Settle the initial scene, so the first frame doesn't pay for insertion.
+		RSG::scene->update();
+	}
+
+	void run_frame(int p_frame) {
+		RenderingServer *rs = RS::get_singleton();
+		const real_t extent = Math::pow(real_t(MAX(config.meshes, 1)), real_t(1.0 / 3.0)) * 2.0;
+
+		_stage_begin();
+		const int moving_meshes = mesh_instances.size() * config.moving_ratio;
+		for (int i = 0; i < moving_meshes; i++) {
+			rs->instance_set_transform(mesh_instances[(p_frame * moving_meshes + i) % mesh_instances.size()], _random_transform(extent));
+		}
+		const int moving_items = canvas_items.size() * config.moving_ratio;
+		for (int i = 0; i < moving_items; i++) {
+			rs->canvas_item_set_transform(canvas_items[(p_frame * moving_items + i) % canvas_items.size()], _random_transform_2d());
+		}
+		_stage_end(STAGE_SUBMIT);
+
+		_stage_begin();
+		RSG::scene->update();
+		_stage_end(STAGE_SCENE_UPDATE);
+
+		_stage_begin();
+		Ref<XRInterface> xr_interface;
+		RSG::scene->render_camera(render_buffers, camera, scenario, viewport, config.viewport_size, 0, 1.0, RID(), xr_interface);
+		_stage_end(STAGE_SCENE_CULL);
+
+		_stage_begin();
+		RendererCanvasCull::Canvas *canvas_ptr = RSG::canvas->canvas_owner.get_or_null(canvas);
+		RSG::canvas->render_canvas(RID(), canvas_ptr, Transform2D(), nullptr, nullptr, Rect2(Vector2(), config.viewport_size), RS::CANVAS_ITEM_TEXTURE_FILTER_LINEAR, RS::CANVAS_ITEM_TEXTURE_REPEAT_DISABLED, false, false, 0xFFFFFFFF);
+		_stage_end(STAGE_CANVAS_CULL);
+
+		_stage_begin();
+		RSG::viewport->draw_viewports(false);
+		_stage_end(STAGE_VIEWPORT_DRAW);
+	}
+
+	void run() {
+		setup();
+		for (int i = 0; i < config.frames; i++) {
+			run_frame(i);
+		}
+		cleanup();
+	}
+
+	void cleanup() {
+		RenderingServer *rs = RS::get_singleton();
+		rs->free(viewport);
+		for (const RID &item : canvas_items) {
+			rs->free(item);
+		}
+		rs->free(canvas);
+		rs->free(camera);
+		for (const RID &instance : light_instances) {
+			rs->free(instance);
+		}
+		for (const RID &light : lights) {
+			rs->free(light);
+		}
+		for (const RID &instance : mesh_instances) {
+			rs->free(instance);
+		}
+		rs->free(mesh);
+		rs->free(scenario);
+		canvas_items.clear();
+		light_instances.clear();
+		lights.clear();
+		mesh_instances.clear();
+		render_buffers.unref();
+	}
+
+	Dictionary get_report() const {
+		Dictionary scene;
+		scene["meshes"] = config.meshes;
+		scene["lights"] = config.lights;
+		scene["canvas_items"] = config.canvas_items;
+		scene["moving_ratio"] = config.moving_ratio;
+
+		Dictionary stages;
+		uint64_t frame_usec = 0;
+		const int frames = MAX(config.frames, 1);
+		for (int i = 0; i < STAGE_MAX; i++) {
+			const StageStats &s = stats[i];
+			Dictionary stage;
+			stage["total_usec"] = s.total_usec;
+			stage["avg_usec"] = double(s.total_usec) / frames;
+			stage["min_usec"] = config.frames > 0 ? s.min_usec : 0;
+			stage["max_usec"] = s.max_usec;
+			stage["allocations_per_frame"] = double(s.allocations) / frames;
+			stage["memory_delta_bytes"] = s.memory_delta;
+			stages[stage_names[i]] = stage;
+			frame_usec += s.total_usec;
+		}
+
+		Dictionary report;
+		report["scene"] = scene;
+		report["frames"] = config.frames;
+		report["avg_frame_usec"] = double(frame_usec) / frames;
+		report["stages"] = stages;
+#ifdef ALLOCATION_TRACKING_ENABLED
+		report["allocations_tracked"] = true;
+#else
+		report["allocations_tracked"] = false;
+#endif
+		return report;
+	}
+
+	Benchmark(const Config &p_config) :
+			config(p_config) {}
+};
+
+static Config parse_config(const List<String> &p_args) {
+	Config config;
+	for (const List<String>::Element *E = p_args.front(); E && E->next(); E = E->next()) {
+		const String &arg = E->get();
+		const String &value = E->next()->get();
+		if (arg == "--meshes") {
+			config.meshes = MAX(value.to_int(), 0);
+		} else if (arg == "--lights") {
+			config.lights = MAX(value.to_int(), 0);
+		} else if (arg == "--canvas-items") {
+			config.canvas_items = MAX(value.to_int(), 0);
+		} else if (arg == "--frames") {
+			config.frames = MAX(value.to_int(), 1);
+		}
+	}
+	return config;
+}
+
+static void run_command() {
+	List<String> args = OS::get_singleton()->get_cmdline_args();
+	String output_path;
+	for (const List<String>::Element *E = args.front(); E && E->next(); E = E->next()) {
+		if (E->get() == "--benchmark-file") {
+			output_path = E->next()->get();
+		}
+	}
+
+	// Same headless setup as the scene tree tests.
+	MessageQueue *message_queue = MessageQueue::get_singleton() ? nullptr : memnew(MessageQueue);
+	Error err = OK;
+	for (int i = 0; i < DisplayServer::get_create_function_count(); i++) {
+		if (String("mock") == DisplayServer::get_create_function_name(i)) {
+			DisplayServer::create(i, "", DisplayServer::WindowMode::WINDOW_MODE_MINIMIZED, DisplayServer::VSyncMode::VSYNC_ENABLED, 0, nullptr, Vector2i(0, 0), DisplayServer::SCREEN_PRIMARY, err);
+			break;
+		}
+	}
+	ERR_FAIL_NULL_MSG(DisplayServer::get_singleton(), "The rendering benchmark requires the mock display server.");
+	memnew(RenderingServerDefault());
+	RenderingServerDefault::get_singleton()->init();
+	RenderingServerDefault::get_singleton()->set_render_loop_enabled(false);
+
+	Benchmark benchmark(parse_config(args));
+	benchmark.run();
+	const String json = JSON::stringify(benchmark.get_report(), "\t");
+
+	RenderingServer::get_singleton()->sync();
+	RenderingServer::get_singleton()->finish();
+	memdelete(RenderingServer::get_singleton());
+	memdelete(DisplayServer::get_singleton());
+	if (message_queue) {
+		memdelete(message_queue);
+	}
+
+	if (output_path.is_empty()) {
+		print_line(json);
+		return;
+	}
+	Ref<FileAccess> f = FileAccess::open(output_path, FileAccess::WRITE);
+	ERR_FAIL_COND_MSG(f.is_null(), "Could not open benchmark file: " + output_path);
+	f->store_string(json);
+	print_line("Rendering benchmark results written to: " + output_path);
+}
+
+REGISTER_TEST_COMMAND("rendering-benchmark", &run_command);
+
+TEST_CASE("[SceneTree][RenderingBenchmark] Small scene report") {
+	Config config;
+	config.meshes = 200;
+	config.lights = 8;
+	config.canvas_items = 200;
+	config.frames = 3;
+
+	Benchmark benchmark(config);
+	benchmark.run();
+	Dictionary report = benchmark.get_report();
+
+	CHECK(int(report["frames"]) == 3);
+	Dictionary stages = report["stages"];
+	for (int i = 0; i < STAGE_MAX; i++) {
+		CHECK_MESSAGE(stages.has(stage_names[i]), vformat("Stage \"%s\" should be reported.", stage_names[i]));
+	}
+	Dictionary scene_cull = stages["scene_cull"];
+	CHECK(uint64_t(scene_cull["max_usec"]) >= uint64_t(scene_cull["min_usec"]));
+
+	// The report must survive a JSON round trip, that's what CI consumes.
+	Variant parsed = JSON::parse_string(JSON::stringify(report));
+	REQUIRE(parsed.get_type() == Variant::DICTIONARY);
+	Dictionary parsed_report = parsed;
+	CHECK(parsed_report.has("avg_frame_usec"));
+}
+
+TEST_CASE("[SceneTree][RenderingBenchmark][Benchmark] Default scene" * doctest::skip()) {
+	Benchmark benchmark((Config()));
+	benchmark.run();
+	MESSAGE(JSON::stringify(benchmark.get_report(), "\t"));
+}
+
+} // namespace TestRenderingBenchmark
+
+#endif // TEST_RENDERING_BENCHMARK_H
@@ -31,6 +31,9 @@
 #ifndef TEST_NAVIGATION_SERVER_3D_H
 #define TEST_NAVIGATION_SERVER_3D_H
 
+#include "core/config/project_settings.h"
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/resources/primitive_meshes.h"
 #include "servers/navigation_server_3d.h"
@@ -63,6 +66,51 @@ static inline Array build_array(Variant item, Targs... Fargs) {
 	return a;
 }
 
+// A flat grid of unit quads. The wall removes the middle row of cells, except for a gap at its end.
+static Ref<NavigationMesh> build_grid_navigation_mesh(int p_size, bool p_wall) {
+	Ref<NavigationMesh> navigation_mesh;
+	navigation_mesh.instantiate();
+
+	Vector<Vector3> vertices;
+	for (int z = 0; z <= p_size; z++) {
+		for (int x = 0; x <= p_size; x++) {
+			vertices.push_back(Vector3(x, 0, z));
+		}
+	}
+	navigation_mesh->set_vertices(vertices);
+
+	for (int z = 0; z < p_size; z++) {
+		for (int x = 0; x < p_size; x++) {
+			if (p_wall && z == p_size / 2 && x < p_size - 1) {
+				continue;
+			}
+			int i = z * (p_size + 1) + x;
+			Vector<int> polygon;
+			polygon.push_back(i);
+			polygon.push_back(i + 1);
+			polygon.push_back(i + p_size + 2);
+			polygon.push_back(i + p_size + 1);
+			navigation_mesh->add_polygon(polygon);
+		}
+	}
+	return navigation_mesh;
+}
+
+// A square floor centered on the origin, with a crate standing on it.
+static void build_floor_source_geometry(const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry, real_t p_size, const Vector3 &p_crate_position) {
+	p_source_geometry->clear();
+
+	Array floor;
+	floor.resize(RS::ARRAY_MAX);
+	BoxMesh::create_mesh_array(floor, Vector3(p_size, 0.001, p_size));
+	p_source_geometry->add_mesh_array(floor, Transform3D());
+
+	Array crate;
+	crate.resize(RS::ARRAY_MAX);
+	BoxMesh::create_mesh_array(crate, Vector3(2.0, 2.0, 2.0));
+	p_source_geometry->add_mesh_array(crate, Transform3D(Basis(), p_crate_position));
+}
+
 TEST_SUITE("[Navigation]") {
 	TEST_CASE("[NavigationServer3D] Server should be empty when initialized") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
@@ -78,6 +126,8 @@ TEST_SUITE("[Navigation]") {
 			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 0);
 			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT), 0);
 			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT), 0);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_PATH_QUERY_QUEUE_DEPTH), 0);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_PATH_QUERY_COUNT), 0);
 		}
 	}
 
@@ -429,6 +479,104 @@ TEST_SUITE("[Navigation]") {
 		navigation_server->free(map);
 	}
 
+	TEST_CASE("[NavigationServer3D] Server should make agents in neighboring cells avoid each other") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		RID map = navigation_server->map_create();
+		RID agent_1 = navigation_server->agent_create();
+		RID agent_2 = navigation_server->agent_create();
+
+		navigation_server->map_set_active(map, true);
+
+		// Cells are as large as the neighbor distance, the agents are on both sides of a cell border.
+		navigation_server->agent_set_map(agent_1, map);
+		navigation_server->agent_set_avoidance_enabled(agent_1, true);
+		navigation_server->agent_set_neighbor_distance(agent_1, 5.0);
+		navigation_server->agent_set_position(agent_1, Vector3(4.0, 0, 0));
+		navigation_server->agent_set_radius(agent_1, 1);
+		navigation_server->agent_set_velocity(agent_1, Vector3(1, 0, 0));
+		CallableMock agent_1_avoidance_callback_mock;
+		navigation_server->agent_set_avoidance_callback(agent_1, callable_mp(&agent_1_avoidance_callback_mock, &CallableMock::function1));
+
+		navigation_server->agent_set_map(agent_2, map);
+		navigation_server->agent_set_avoidance_enabled(agent_2, true);
+		navigation_server->agent_set_neighbor_distance(agent_2, 5.0);
+		navigation_server->agent_set_position(agent_2, Vector3(6.5, 0, 0.5));
+		navigation_server->agent_set_radius(agent_2, 1);
+		navigation_server->agent_set_velocity(agent_2, Vector3(-1, 0, 0));
+		CallableMock agent_2_avoidance_callback_mock;
+		navigation_server->agent_set_avoidance_callback(agent_2, callable_mp(&agent_2_avoidance_callback_mock, &CallableMock::function1));
+
+		navigation_server->process(0.0); // Give server some cycles to commit.
+		CHECK_EQ(agent_1_avoidance_callback_mock.function1_calls, 1);
+		CHECK_EQ(agent_2_avoidance_callback_mock.function1_calls, 1);
+		Vector3 agent_1_safe_velocity = agent_1_avoidance_callback_mock.function1_latest_arg0;
+		Vector3 agent_2_safe_velocity = agent_2_avoidance_callback_mock.function1_latest_arg0;
+		CHECK_MESSAGE(agent_1_safe_velocity.z < 0, "agent 1 should move a bit to the side so that it avoids agent 2");
+		CHECK_MESSAGE(agent_2_safe_velocity.z > 0, "agent 2 should move a bit to the side so that it avoids agent 1");
+
+		navigation_server->free(agent_2);
+		navigation_server->free(agent_1);
+		navigation_server->free(map);
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should step crowds deterministically when enabled") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// The maps read the thread model when they are created. The first one steps its chunks on the WorkerThreadPool,
+		// the second one on the calling thread, both must give the same velocities.
+		ProjectSettings *project_settings = ProjectSettings::get_singleton();
+		const Variant use_multiple_threads = project_settings->get_setting("navigation/avoidance/thread_model/avoidance_use_multiple_threads");
+		const Variant use_deterministic_steps = project_settings->get_setting("navigation/avoidance/thread_model/avoidance_use_deterministic_steps");
+		project_settings->set_setting("navigation/avoidance/thread_model/avoidance_use_deterministic_steps", true);
+		project_settings->set_setting("navigation/avoidance/thread_model/avoidance_use_multiple_threads", true);
+		RID multithreaded_map = navigation_server->map_create();
+		project_settings->set_setting("navigation/avoidance/thread_model/avoidance_use_multiple_threads", false);
+		RID single_threaded_map = navigation_server->map_create();
+		project_settings->set_setting("navigation/avoidance/thread_model/avoidance_use_multiple_threads", use_multiple_threads);
+		project_settings->set_setting("navigation/avoidance/thread_model/avoidance_use_deterministic_steps", use_deterministic_steps);
+		RID maps[2] = { multithreaded_map, single_threaded_map };
+
+		// The same crowd converging to the origin on both maps, large enough to be split in several chunks.
+		const int crowd_size = 200;
+		LocalVector<RID> agents[2];
+		LocalVector<CallableMock *> callback_mocks[2];
+		for (int i = 0; i < 2; i++) {
+			navigation_server->map_set_active(maps[i], true);
+			for (int j = 0; j < crowd_size; j++) {
+				Vector3 position = Vector3(j % 20, 0.0, j / 20) * 1.5 - Vector3(15.0, 0.0, 7.5);
+				RID agent = navigation_server->agent_create();
+				navigation_server->agent_set_map(agent, maps[i]);
+				navigation_server->agent_set_avoidance_enabled(agent, true);
+				navigation_server->agent_set_position(agent, position);
+				navigation_server->agent_set_radius(agent, 0.5);
+				navigation_server->agent_set_velocity(agent, -position.normalized());
+				CallableMock *callback_mock = memnew(CallableMock);
+				navigation_server->agent_set_avoidance_callback(agent, callable_mp(callback_mock, &CallableMock::function1));
+				agents[i].push_back(agent);
+				callback_mocks[i].push_back(callback_mock);
+			}
+		}
+
+		for (int step = 0; step < 5; step++) {
+			navigation_server->process(0.1);
+		}
+
+		for (int j = 0; j < crowd_size; j++) {
+			CHECK_EQ(callback_mocks[0][j]->function1_calls, 5);
+			CHECK(Vector3(callback_mocks[0][j]->function1_latest_arg0) == Vector3(callback_mocks[1][j]->function1_latest_arg0));
+		}
+
+		for (int i = 0; i < 2; i++) {
+			for (int j = 0; j < crowd_size; j++) {
+				navigation_server->free(agents[i][j]);
+				memdelete(callback_mocks[i][j]);
+			}
+			navigation_server->free(maps[i]);
+		}
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
 #ifndef DISABLE_DEPRECATED
 	// This test case uses only public APIs on purpose - other test cases use simplified baking.
 	// FIXME: Remove once deprecated `region_bake_navigation_mesh()` is removed.
@@ -621,6 +769,448 @@ TEST_SUITE("[Navigation]") {
 		navigation_server->free(map);
 		navigation_server->process(0.0); // Give server some cycles to commit.
 	}
+
+	TEST_CASE("[NavigationServer3D] Server should find paths and closest points on large maps") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		const int size = 40;
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, build_grid_navigation_mesh(size, true));
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		SUBCASE("Closest points should be projected on the grid") {
+			RandomPCG rng(7);
+			for (int i = 0; i < 200; i++) {
+				Vector3 point(rng.random(-5.0f, 45.0f), rng.random(-2.0f, 2.0f), rng.random(-5.0f, 45.0f));
+				if (point.z > size / 2 - 1 && point.z < size / 2 + 2) {
+					continue; // Around the wall, the closest point is on its border instead.
+				}
+				Vector3 expected(CLAMP(point.x, 0.0f, real_t(size)), 0.0, CLAMP(point.z, 0.0f, real_t(size)));
+				CHECK(navigation_server->map_get_closest_point(map, point).is_equal_approx(expected));
+				CHECK(navigation_server->map_get_closest_point_owner(map, point) == region);
+			}
+		}
+
+		SUBCASE("Paths should go around the wall") {
+			Vector3 begin(0.5, 0.0, 10.5);
+			Vector3 end(0.5, 0.0, 30.5);
+			Vector<Vector3> path = navigation_server->map_get_path(map, begin, end, true);
+			REQUIRE(path.size() > 2);
+			CHECK(path[0].is_equal_approx(begin));
+			CHECK(path[path.size() - 1].is_equal_approx(end));
+
+			// The only way through is the gap at the end of the wall.
+			bool through_gap = false;
+			for (const Vector3 &point : path) {
+				through_gap = through_gap || point.x >= size - 1;
+			}
+			CHECK(through_gap);
+
+			Vector<Vector3> unoptimized_path = navigation_server->map_get_path(map, begin, end, false);
+			REQUIRE(unoptimized_path.size() > 2);
+			CHECK(unoptimized_path[unoptimized_path.size() - 1].is_equal_approx(end));
+		}
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should find paths over polygon clusters") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		const int size = 40;
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, build_grid_navigation_mesh(size, true));
+
+		// Clusters of 8 units with the default cell size.
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/use_hierarchical_pathfinding", true);
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/hierarchical_cluster_size", 32);
+		RID clustered_map = navigation_server->map_create();
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/use_hierarchical_pathfinding", false);
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/hierarchical_cluster_size", 64);
+		RID clustered_region = navigation_server->region_create();
+		navigation_server->map_set_active(clustered_map, true);
+		navigation_server->region_set_map(clustered_region, clustered_map);
+		navigation_server->region_set_navigation_mesh(clustered_region, build_grid_navigation_mesh(size, true));
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		SUBCASE("Paths should be close to the shortest ones") {
+			RandomPCG rng(11);
+			for (int i = 0; i < 50; i++) {
+				Vector3 from(rng.random(0.0f, real_t(size)), 0.0, rng.random(0.0f, size * 0.5f - 1.0f));
+				Vector3 to(rng.random(0.0f, real_t(size)), 0.0, rng.random(size * 0.5f + 1.0f, real_t(size)));
+				Vector<Vector3> path = navigation_server->map_get_path(map, from, to, true);
+				Vector<Vector3> clustered_path = navigation_server->map_get_path(clustered_map, from, to, true);
+				REQUIRE(path.size() >= 2);
+				REQUIRE(clustered_path.size() >= 2);
+				CHECK(clustered_path[0].is_equal_approx(path[0]));
+				CHECK(clustered_path[clustered_path.size() - 1].is_equal_approx(path[path.size() - 1]));
+
+				real_t length = 0.0;
+				for (int j = 1; j < path.size(); j++) {
+					length += path[j - 1].distance_to(path[j]);
+				}
+				real_t clustered_length = 0.0;
+				for (int j = 1; j < clustered_path.size(); j++) {
+					clustered_length += clustered_path[j - 1].distance_to(clustered_path[j]);
+				}
+				// The detours are bounded by the size of the clusters.
+				CHECK(clustered_length <= length + 16.0);
+			}
+		}
+
+		SUBCASE("Clusters should be updated when the region changes") {
+			Vector3 begin(0.5, 0.0, 10.5);
+			Vector3 end(0.5, 0.0, 30.5);
+			CHECK(navigation_server->map_get_path(clustered_map, begin, end, true).size() > 2);
+
+			// Without the wall, the path goes straight.
+			navigation_server->region_set_navigation_mesh(clustered_region, build_grid_navigation_mesh(size, false));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			Vector<Vector3> path = navigation_server->map_get_path(clustered_map, begin, end, true);
+			REQUIRE(path.size() == 2);
+			CHECK(path[1].is_equal_approx(end));
+		}
+
+		navigation_server->free(clustered_region);
+		navigation_server->free(clustered_map);
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should bake tiled navigation meshes incrementally") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+		build_floor_source_geometry(source_geometry, 20.0, Vector3(-5.0, 1.0, -5.0));
+
+		// Tiles of 8 units with the default cell size.
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		navigation_mesh->set_tile_size(32);
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		REQUIRE(navigation_mesh->get_polygon_count() > 0);
+
+		SUBCASE("Paths should cross the tile borders") {
+			RID map = navigation_server->map_create();
+			RID region = navigation_server->region_create();
+			navigation_server->map_set_active(map, true);
+			navigation_server->region_set_map(region, map);
+			navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(-8.0, 0.0, 8.0), Vector3(8.0, 0.0, -8.0), true);
+			REQUIRE(path.size() >= 2);
+			const Vector3 &path_end = path[path.size() - 1];
+			CHECK(Vector2(path_end.x, path_end.z).distance_to(Vector2(8.0, -8.0)) < 0.5);
+
+			navigation_server->free(region);
+			navigation_server->free(map);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+		}
+
+		SUBCASE("Rebaking should match a full bake of the same geometry") {
+			Vector<Vector3> vertices = navigation_mesh->get_vertices();
+			int polygon_count = navigation_mesh->get_polygon_count();
+			navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+			CHECK(navigation_mesh->get_vertices() == vertices);
+			CHECK(navigation_mesh->get_polygon_count() == polygon_count);
+
+			// Only the tiles around the crate are rebaked.
+			build_floor_source_geometry(source_geometry, 20.0, Vector3(5.0, 1.0, 5.0));
+			navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+
+			Ref<NavigationMesh> full_navigation_mesh = memnew(NavigationMesh);
+			full_navigation_mesh->set_tile_size(32);
+			navigation_server->bake_from_source_geometry_data(full_navigation_mesh, source_geometry, Callable());
+			CHECK(navigation_mesh->get_vertices() == full_navigation_mesh->get_vertices());
+			REQUIRE(navigation_mesh->get_polygon_count() == full_navigation_mesh->get_polygon_count());
+			for (int i = 0; i < navigation_mesh->get_polygon_count(); i++) {
+				CHECK(navigation_mesh->get_polygon(i) == full_navigation_mesh->get_polygon(i));
+			}
+		}
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should stitch tiles only within the same layer") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+		build_floor_source_geometry(source_geometry, 20.0, Vector3(-5.0, 1.0, -5.0));
+
+		// A platform above the floor, across the tile border at x = 8.
+		Array platform;
+		platform.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(platform, Vector3(6.0, 0.2, 6.0));
+		source_geometry->add_mesh_array(platform, Transform3D(Basis(), Vector3(8.0, 3.0, 0.0)));
+
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		navigation_mesh->set_tile_size(32);
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		REQUIRE(navigation_mesh->get_polygon_count() > 0);
+
+		// Border edges of the floor must not be split on the platform vertices, and the other way around.
+		const Vector<Vector3> vertices = navigation_mesh->get_vertices();
+		const real_t max_height_difference = navigation_mesh->get_agent_max_climb() + navigation_mesh->get_cell_height();
+		bool layers_mixed = false;
+		for (int i = 0; i < navigation_mesh->get_polygon_count(); i++) {
+			const Vector<int> polygon = navigation_mesh->get_polygon(i);
+			real_t min_height = vertices[polygon[0]].y;
+			real_t max_height = min_height;
+			for (int index : polygon) {
+				min_height = MIN(min_height, vertices[index].y);
+				max_height = MAX(max_height, vertices[index].y);
+			}
+			layers_mixed |= max_height - min_height > max_height_difference;
+		}
+		CHECK_FALSE(layers_mixed);
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should process asynchronous path queries") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		const int size = 10;
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, build_grid_navigation_mesh(size, true));
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		// Two queries more than the budget, they take two more steps to be delivered.
+		const int budget = GLOBAL_GET("navigation/pathfinding/max_async_path_queries_per_frame");
+		const int query_count = budget + 2;
+		CallableMock callback_mock;
+		RandomPCG rng(3);
+		Vector<Ref<NavigationPathQueryParameters3D>> query_parameters;
+		Vector<Ref<NavigationPathQueryResult3D>> query_results;
+		for (int i = 0; i < query_count; i++) {
+			Ref<NavigationPathQueryParameters3D> parameters;
+			parameters.instantiate();
+			parameters->set_map(map);
+			parameters->set_start_position(Vector3(rng.random(0.0f, 10.0f), 0.0, rng.random(0.0f, 4.5f)));
+			parameters->set_target_position(Vector3(rng.random(0.0f, 10.0f), 0.0, rng.random(6.0f, 10.0f)));
+			Ref<NavigationPathQueryResult3D> result;
+			result.instantiate();
+			navigation_server->query_path_async(parameters, result, callable_mp(&callback_mock, &CallableMock::function1).bind(i));
+			query_parameters.push_back(parameters);
+			query_results.push_back(result);
+		}
+		CHECK_EQ(callback_mock.function1_calls, 0);
+
+		navigation_server->process(0.0); // Starts the queries within the budget.
+		CHECK_EQ(callback_mock.function1_calls, 0);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_PATH_QUERY_QUEUE_DEPTH), 2);
+
+		navigation_server->process(0.0); // Delivers them and starts the remaining ones.
+		CHECK_EQ(callback_mock.function1_calls, budget);
+		CHECK_EQ(callback_mock.function1_latest_arg0, Variant(budget - 1));
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_PATH_QUERY_COUNT), budget);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_PATH_QUERY_QUEUE_DEPTH), 0);
+
+		navigation_server->process(0.0);
+		CHECK_EQ(callback_mock.function1_calls, query_count);
+		CHECK_EQ(callback_mock.function1_latest_arg0, Variant(query_count - 1));
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_PATH_QUERY_COUNT), 2);
+
+		// The results should match the synchronous queries.
+		Ref<NavigationPathQueryResult3D> expected_result;
+		expected_result.instantiate();
+		for (int i = 0; i < query_count; i++) {
+			navigation_server->query_path(query_parameters[i], expected_result);
+			REQUIRE(query_results[i]->get_path().size() > 0);
+			CHECK(query_results[i]->get_path() == expected_result->get_path());
+		}
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_PATH_QUERY_COUNT), 0);
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should deliver started path queries while inactive") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, build_grid_navigation_mesh(10, true));
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		CallableMock callback_mock;
+		Ref<NavigationPathQueryParameters3D> parameters;
+		parameters.instantiate();
+		parameters->set_map(map);
+		parameters->set_start_position(Vector3(1.0, 0.0, 1.0));
+		parameters->set_target_position(Vector3(9.0, 0.0, 9.0));
+		Ref<NavigationPathQueryResult3D> started_result;
+		started_result.instantiate();
+		navigation_server->query_path_async(parameters, started_result, callable_mp(&callback_mock, &CallableMock::function1).bind(0));
+		navigation_server->process(0.0); // Starts the query.
+		CHECK_EQ(callback_mock.function1_calls, 0);
+
+		navigation_server->set_active(false);
+		Ref<NavigationPathQueryResult3D> queued_result;
+		queued_result.instantiate();
+		navigation_server->query_path_async(parameters, queued_result, callable_mp(&callback_mock, &CallableMock::function1).bind(1));
+		navigation_server->process(0.0); // Delivers the started query, the new one stays queued.
+		CHECK_EQ(callback_mock.function1_calls, 1);
+		CHECK_EQ(callback_mock.function1_latest_arg0, Variant(0));
+		CHECK(started_result->get_path().size() > 0);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_PATH_QUERY_QUEUE_DEPTH), 1);
+
+		navigation_server->process(0.0);
+		CHECK_EQ(callback_mock.function1_calls, 1);
+
+		navigation_server->set_active(true);
+		navigation_server->process(0.0); // Starts the queued query.
+		navigation_server->process(0.0); // Delivers it.
+		CHECK_EQ(callback_mock.function1_calls, 2);
+		CHECK_EQ(callback_mock.function1_latest_arg0, Variant(1));
+		CHECK(queued_result->get_path() == started_result->get_path());
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D][Benchmark] Path queries on a large map" * doctest::skip()) {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		const int size = 300;
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, build_grid_navigation_mesh(size, true));
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		// Queries across the wall have to explore a large part of the map.
+		RandomPCG rng(42);
+		const int path_count = 100;
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < path_count; i++) {
+			Vector3 from(rng.random(0.0f, real_t(size)), 0.0, rng.random(0.0f, size * 0.5f));
+			Vector3 to(rng.random(0.0f, real_t(size)), 0.0, rng.random(size * 0.5f, real_t(size)));
+			navigation_server->map_get_path(map, from, to, true);
+		}
+		uint64_t path_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		const int closest_point_count = 10000;
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < closest_point_count; i++) {
+			navigation_server->map_get_closest_point(map, Vector3(rng.random(0.0f, real_t(size)), 1.0, rng.random(0.0f, real_t(size))));
+		}
+		uint64_t closest_point_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		MESSAGE(vformat("%d polygons: %d usec per path query, %d usec per closest point query.", size * size - (size - 1), path_usec / path_count, closest_point_usec / closest_point_count));
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D][Benchmark] Incremental tiled navigation mesh baking" * doctest::skip()) {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		const real_t size = 200.0;
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+		build_floor_source_geometry(source_geometry, size, Vector3(0.0, 1.0, 0.0));
+
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		uint64_t full_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		Ref<NavigationMesh> tiled_navigation_mesh = memnew(NavigationMesh);
+		tiled_navigation_mesh->set_tile_size(64);
+		begin = OS::get_singleton()->get_ticks_usec();
+		navigation_server->bake_from_source_geometry_data(tiled_navigation_mesh, source_geometry, Callable());
+		uint64_t tiled_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		// Moving the crate only rebakes the tiles around its old and new positions.
+		build_floor_source_geometry(source_geometry, size, Vector3(20.0, 1.0, 20.0));
+		begin = OS::get_singleton()->get_ticks_usec();
+		navigation_server->bake_from_source_geometry_data(tiled_navigation_mesh, source_geometry, Callable());
+		uint64_t incremental_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		MESSAGE(vformat("Full bake: %d usec, tiled bake: %d usec, incremental tiled bake: %d usec.", full_usec, tiled_usec, incremental_usec));
+	}
+
+	TEST_CASE("[NavigationServer3D][Benchmark] Crowd avoidance" * doctest::skip()) {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		const int crowd_sizes[3] = { 1000, 5000, 20000 };
+
+		for (const int crowd_size : crowd_sizes) {
+			RID map = navigation_server->map_create();
+			navigation_server->map_set_active(map, true);
+
+			// The same density of agents for all crowd sizes, walking in random directions.
+			RandomPCG rng(42);
+			const real_t area_size = Math::sqrt(real_t(crowd_size)) * 2.0;
+			LocalVector<RID> agents;
+			for (int i = 0; i < crowd_size; i++) {
+				RID agent = navigation_server->agent_create();
+				navigation_server->agent_set_map(agent, map);
+				navigation_server->agent_set_avoidance_enabled(agent, true);
+				navigation_server->agent_set_position(agent, Vector3(rng.random(0.0f, area_size), 0.0, rng.random(0.0f, area_size)));
+				navigation_server->agent_set_radius(agent, 0.5);
+				navigation_server->agent_set_velocity(agent, Vector3(rng.random(-1.0f, 1.0f), 0.0, rng.random(-1.0f, 1.0f)));
+				agents.push_back(agent);
+			}
+			navigation_server->process(1.0 / 60.0); // Give server some cycles to commit.
+
+			const int step_count = 20;
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < step_count; i++) {
+				navigation_server->process(1.0 / 60.0);
+			}
+			uint64_t step_usec = (OS::get_singleton()->get_ticks_usec() - begin) / step_count;
+
+			MESSAGE(vformat("%d agents: %d usec per step, %d agent steps per second.", crowd_size, step_usec, uint64_t(crowd_size) * 1000000 / MAX(step_usec, uint64_t(1))));
+
+			for (const RID &agent : agents) {
+				navigation_server->free(agent);
+			}
+			navigation_server->free(map);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+		}
+	}
+
+	TEST_CASE("[NavigationServer3D][Benchmark] Hierarchical path queries on a large map" * doctest::skip()) {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		const int size = 300;
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/use_hierarchical_pathfinding", true);
+		RID map = navigation_server->map_create();
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/use_hierarchical_pathfinding", false);
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, build_grid_navigation_mesh(size, true));
+		navigation_server->process(0.0); // Give server some cycles to commit.
+		const int build_usec = navigation_server->get_process_info(NavigationServer3D::INFO_CLUSTER_BUILD_TIME);
+
+		// Same queries as the non hierarchical benchmark.
+		RandomPCG rng(42);
+		const int path_count = 100;
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < path_count; i++) {
+			Vector3 from(rng.random(0.0f, real_t(size)), 0.0, rng.random(0.0f, size * 0.5f));
+			Vector3 to(rng.random(0.0f, real_t(size)), 0.0, rng.random(size * 0.5f, real_t(size)));
+			navigation_server->map_get_path(map, from, to, true);
+		}
+		uint64_t path_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		// Moving the region rebuilds its clusters.
+		navigation_server->region_set_transform(region, Transform3D(Basis(), Vector3(1.0, 0.0, 0.0)));
+		navigation_server->process(0.0); // Give server some cycles to commit.
+		const int rebuild_usec = navigation_server->get_process_info(NavigationServer3D::INFO_CLUSTER_BUILD_TIME);
+
+		MESSAGE(vformat("%d polygons: %d usec per path query, %d usec to build the clusters, %d usec to rebuild them.", size * size - (size - 1), path_usec / path_count, build_usec, rebuild_usec));
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
 }
 } //namespace TestNavigationServer3D
 
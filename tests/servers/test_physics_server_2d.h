@@ -0,0 +1,142 @@
+/**************************************************************************/
+/*  test_physics_server_2d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_2D_H
+#define TEST_PHYSICS_SERVER_2D_H
+
+#include "core/math/random_pcg.h"
+#include "servers/physics_server_2d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer2D {
+
+TEST_CASE("[SceneTree][PhysicsServer2D] Batched queries match single queries") {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+
+	// A grid of static boxes.
+	RID box = ps->rectangle_shape_create();
+	ps->shape_set_data(box, Vector2(8, 8));
+	LocalVector<RID> bodies;
+	for (int y = 0; y < 10; y++) {
+		for (int x = 0; x < 10; x++) {
+			RID body = ps->body_create();
+			ps->body_set_mode(body, PhysicsServer2D::BODY_MODE_STATIC);
+			ps->body_add_shape(body, box);
+			ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0.1 * x, Vector2(x * 40, y * 40)));
+			ps->body_set_space(body, space);
+			bodies.push_back(body);
+		}
+	}
+	ps->step(1.0 / 60.0);
+
+	PhysicsDirectSpaceState2D *state = ps->space_get_direct_state(space);
+	REQUIRE(state);
+
+	RandomPCG rng(42);
+	const int query_count = 200;
+	LocalVector<Vector2> from;
+	LocalVector<Vector2> to;
+	for (int i = 0; i < query_count; i++) {
+		from.push_back(Vector2(rng.random(-20.0f, 380.0f), rng.random(-20.0f, 380.0f)));
+		to.push_back(from[i] + Vector2(rng.random(-80.0f, 80.0f), rng.random(-80.0f, 80.0f)));
+	}
+
+	SUBCASE("Rays") {
+		PhysicsDirectSpaceState2D::RayParameters parameters;
+		for (bool use_threads : { false, true }) {
+			LocalVector<PhysicsDirectSpaceState2D::RayResult> results;
+			results.resize(query_count);
+			int hit_count = state->intersect_rays_batch(parameters, from.ptr(), to.ptr(), query_count, results.ptr(), use_threads);
+
+			int expected_hit_count = 0;
+			for (int i = 0; i < query_count; i++) {
+				parameters.from = from[i];
+				parameters.to = to[i];
+				PhysicsDirectSpaceState2D::RayResult expected;
+				bool hit = state->intersect_ray(parameters, expected);
+				expected_hit_count += hit;
+				CHECK(results[i].rid.is_valid() == hit);
+				if (hit) {
+					CHECK(results[i].rid == expected.rid);
+					CHECK(results[i].position.is_equal_approx(expected.position));
+				}
+			}
+			CHECK(expected_hit_count > 0);
+			CHECK(hit_count == expected_hit_count);
+		}
+	}
+
+	SUBCASE("Motions") {
+		RID circle = ps->circle_shape_create();
+		ps->shape_set_data(circle, 4.0);
+
+		PhysicsDirectSpaceState2D::ShapeParameters parameters;
+		parameters.shape_rid = circle;
+		LocalVector<Transform2D> transforms;
+		LocalVector<Vector2> motions;
+		for (int i = 0; i < query_count; i++) {
+			transforms.push_back(Transform2D(0.0, from[i]));
+			motions.push_back(to[i] - from[i]);
+		}
+
+		for (bool use_threads : { false, true }) {
+			LocalVector<real_t> safe;
+			LocalVector<real_t> unsafe;
+			safe.resize(query_count);
+			unsafe.resize(query_count);
+			REQUIRE(state->cast_motions_batch(parameters, transforms.ptr(), motions.ptr(), query_count, safe.ptr(), unsafe.ptr(), use_threads));
+
+			for (int i = 0; i < query_count; i++) {
+				parameters.transform = transforms[i];
+				parameters.motion = motions[i];
+				real_t expected_safe = 1.0;
+				real_t expected_unsafe = 1.0;
+				REQUIRE(state->cast_motion(parameters, expected_safe, expected_unsafe));
+				CHECK(safe[i] == doctest::Approx(expected_safe));
+				CHECK(unsafe[i] == doctest::Approx(expected_unsafe));
+			}
+		}
+
+		ps->free(circle);
+	}
+
+	for (const RID &body : bodies) {
+		ps->free(body);
+	}
+	ps->free(box);
+	ps->free(space);
+}
+
+} // namespace TestPhysicsServer2D
+
+#endif // TEST_PHYSICS_SERVER_2D_H
@@ -0,0 +1,572 @@
+/**************************************************************************/
+/*  test_physics_server_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_3D_H
+#define TEST_PHYSICS_SERVER_3D_H
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "servers/physics_3d/gjk_epa.h"
+#include "servers/physics_3d/godot_collision_solver_3d.h"
+#include "servers/physics_3d/godot_shape_3d.h"
+#include "servers/physics_3d/godot_space_3d.h"
+#include "servers/physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer3D {
+
+static const char *elapsed_time_names[GodotSpace3D::ELAPSED_TIME_MAX] = {
+	"integrate_forces",
+	"generate_islands",
+	"setup_constraints",
+	"solve_constraints",
+	"integrate_velocities",
+};
+
+// A space with a ground plane, filled through the scene builders below.
+class TestScene {
+	PhysicsServer3D *ps = nullptr;
+	RID space;
+	GodotSpace3D *godot_space = nullptr;
+
+	LocalVector<RID> shapes;
+	LocalVector<RID> bodies;
+	LocalVector<RID> joints;
+
+	bool can_sleep = true;
+	uint64_t elapsed_time[GodotSpace3D::ELAPSED_TIME_MAX] = {};
+	int steps = 0;
+
+	void _add_joint(RID p_joint, RID p_body_A, RID p_body_B, const Vector3 &p_position, bool p_hinge) {
+		Transform3D frame(Basis(), p_position);
+		Transform3D frame_A = Transform3D(ps->body_get_state(p_body_A, PhysicsServer3D::BODY_STATE_TRANSFORM)).affine_inverse() * frame;
+		Transform3D frame_B = Transform3D(ps->body_get_state(p_body_B, PhysicsServer3D::BODY_STATE_TRANSFORM)).affine_inverse() * frame;
+		if (p_hinge) {
+			ps->joint_make_hinge(p_joint, p_body_A, frame_A, p_body_B, frame_B);
+		} else {
+			ps->joint_make_cone_twist(p_joint, p_body_A, frame_A, p_body_B, frame_B);
+		}
+		joints.push_back(p_joint);
+	}
+
+	RID _add_capsule(real_t p_radius, real_t p_height, const Vector3 &p_position) {
+		RID shape = ps->capsule_shape_create();
+		Dictionary data;
+		data["radius"] = p_radius;
+		data["height"] = p_height;
+		ps->shape_set_data(shape, data);
+		shapes.push_back(shape);
+		return add_body(shape, Transform3D(Basis(), p_position));
+	}
+
+public:
+	GodotSpace3D *get_godot_space() const { return godot_space; }
+	PhysicsDirectSpaceState3D *get_direct_state() const { return ps->space_get_direct_state(space); }
+	RID get_body(uint32_t p_index) const { return bodies[p_index]; }
+	uint32_t get_body_count() const { return bodies.size(); }
+
+	Vector3 get_body_position(uint32_t p_index) const {
+		return Transform3D(ps->body_get_state(bodies[p_index], PhysicsServer3D::BODY_STATE_TRANSFORM)).origin;
+	}
+
+	RID add_body(RID p_shape, const Transform3D &p_transform) {
+		RID body = ps->body_create();
+		ps->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+		ps->body_add_shape(body, p_shape);
+		ps->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, p_transform);
+		ps->body_set_state(body, PhysicsServer3D::BODY_STATE_CAN_SLEEP, can_sleep);
+		ps->body_set_space(body, space);
+		bodies.push_back(body);
+		return body;
+	}
+
+	// Towers of unit boxes, each of them is an island of its own.
+	void add_stacks(int p_count, int p_height) {
+		RID box = ps->box_shape_create();
+		ps->shape_set_data(box, Vector3(0.5, 0.5, 0.5));
+		shapes.push_back(box);
+
+		int side = Math::ceil(Math::sqrt(real_t(p_count)));
+		for (int i = 0; i < p_count; i++) {
+			Vector3 base = Vector3((i % side) * 3.0, 0.5, (i / side) * 3.0);
+			for (int j = 0; j < p_height; j++) {
+				add_body(box, Transform3D(Basis(), base + Vector3(0, j, 0)));
+			}
+		}
+	}
+
+	// A block of slightly overlapping boxes, which collapses into a single large island.
+	void add_pile(int p_width, int p_height, uint64_t p_seed = 1234) {
+		RID box = ps->box_shape_create();
+		ps->shape_set_data(box, Vector3(0.5, 0.5, 0.5));
+		shapes.push_back(box);
+
+		RandomPCG rng(p_seed);
+		const real_t spacing = 0.98;
+		for (int y = 0; y < p_height; y++) {
+			for (int z = 0; z < p_width; z++) {
+				for (int x = 0; x < p_width; x++) {
+					Basis basis(Vector3(0, 1, 0), rng.random(-0.2f, 0.2f));
+					add_body(box, Transform3D(basis, Vector3(x * spacing, 0.5 + y * spacing, z * spacing)));
+				}
+			}
+		}
+	}
+
+	// Simplified humanoids, cone twist joints for the spine, shoulders and hips, hinges for elbows and knees.
+	void add_ragdolls(int p_count) {
+		int side = Math::ceil(Math::sqrt(real_t(p_count)));
+		for (int i = 0; i < p_count; i++) {
+			Vector3 o = Vector3((i % side) * 1.5, 1.0 + (i / side) * 0.5, (i / side) * 1.5);
+
+			RID pelvis = _add_capsule(0.15, 0.3, o + Vector3(0, 1.0, 0));
+			RID chest = _add_capsule(0.15, 0.4, o + Vector3(0, 1.38, 0));
+			RID head = _add_capsule(0.1, 0.25, o + Vector3(0, 1.75, 0));
+			_add_joint(ps->joint_create(), pelvis, chest, o + Vector3(0, 1.17, 0), false);
+			_add_joint(ps->joint_create(), chest, head, o + Vector3(0, 1.6, 0), false);
+
+			for (int side_sign = -1; side_sign <= 1; side_sign += 2) {
+				RID upper_arm = _add_capsule(0.06, 0.3, o + Vector3(side_sign * 0.3, 1.3, 0));
+				RID lower_arm = _add_capsule(0.05, 0.3, o + Vector3(side_sign * 0.3, 0.95, 0));
+				_add_joint(ps->joint_create(), chest, upper_arm, o + Vector3(side_sign * 0.25, 1.5, 0), false);
+				_add_joint(ps->joint_create(), upper_arm, lower_arm, o + Vector3(side_sign * 0.3, 1.12, 0), true);
+
+				RID upper_leg = _add_capsule(0.07, 0.4, o + Vector3(side_sign * 0.1, 0.65, 0));
+				RID lower_leg = _add_capsule(0.06, 0.4, o + Vector3(side_sign * 0.1, 0.22, 0));
+				_add_joint(ps->joint_create(), pelvis, upper_leg, o + Vector3(side_sign * 0.1, 0.87, 0), false);
+				_add_joint(ps->joint_create(), upper_leg, lower_leg, o + Vector3(side_sign * 0.1, 0.43, 0), true);
+			}
+		}
+	}
+
+	void step(int p_steps, real_t p_delta = 1.0 / 60.0) {
+		for (int i = 0; i < p_steps; i++) {
+			ps->step(p_delta);
+			ps->flush_queries();
+			for (int j = 0; j < GodotSpace3D::ELAPSED_TIME_MAX; j++) {
+				elapsed_time[j] += godot_space->get_elapsed_time(GodotSpace3D::ElapsedTime(j));
+			}
+			steps++;
+		}
+	}
+
+	String get_report() const {
+		String report;
+		uint64_t total = 0;
+		for (int i = 0; i < GodotSpace3D::ELAPSED_TIME_MAX; i++) {
+			report += vformat("  %s: %d usec/step\n", elapsed_time_names[i], elapsed_time[i] / MAX(steps, 1));
+			total += elapsed_time[i];
+		}
+		report += vformat("  total: %d usec/step (%d bodies, %d joints)", total / MAX(steps, 1), bodies.size(), joints.size());
+		return report;
+	}
+
+	TestScene(bool p_can_sleep = true) {
+		ps = PhysicsServer3D::get_singleton();
+		can_sleep = p_can_sleep;
+
+		space = ps->space_create();
+		ps->space_set_active(space, true);
+		GodotPhysicsDirectSpaceState3D *state = Object::cast_to<GodotPhysicsDirectSpaceState3D>(ps->space_get_direct_state(space));
+		if (state) {
+			godot_space = state->space;
+		}
+
+		RID plane = ps->world_boundary_shape_create();
+		ps->shape_set_data(plane, Plane(Vector3(0, 1, 0), 0));
+		shapes.push_back(plane);
+
+		RID ground = ps->body_create();
+		ps->body_set_mode(ground, PhysicsServer3D::BODY_MODE_STATIC);
+		ps->body_add_shape(ground, plane);
+		ps->body_set_space(ground, space);
+		bodies.push_back(ground);
+	}
+
+	~TestScene() {
+		for (const RID &joint : joints) {
+			ps->free(joint);
+		}
+		for (const RID &body : bodies) {
+			ps->free(body);
+		}
+		for (const RID &shape : shapes) {
+			ps->free(shape);
+		}
+		ps->free(space);
+	}
+};
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Box stack comes to rest") {
+	TestScene scene;
+	REQUIRE_MESSAGE(scene.get_godot_space(), "Requires the Godot physics server.");
+	scene.add_stacks(1, 5);
+	scene.step(180);
+
+	// Body 0 is the ground.
+	for (uint32_t i = 1; i < scene.get_body_count(); i++) {
+		Vector3 position = scene.get_body_position(i);
+		Vector3 expected = Vector3(0, 0.5 + (i - 1), 0);
+		CHECK_MESSAGE(position.distance_to(expected) < 0.1, vformat("Box %d should stay in place, it is at %s.", i, position));
+	}
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Box pile stays in place") {
+	// A single island with enough contacts to be colored and solved in parallel.
+	TestScene scene;
+	REQUIRE_MESSAGE(scene.get_godot_space(), "Requires the Godot physics server.");
+	scene.add_pile(8, 5);
+	scene.step(60);
+
+	for (uint32_t i = 1; i < scene.get_body_count(); i++) {
+		Vector3 position = scene.get_body_position(i);
+		REQUIRE_MESSAGE(position.is_finite(), vformat("Box %d has an invalid position.", i));
+		CHECK_MESSAGE(position.y > 0.25, vformat("Box %d fell through the ground, it is at %s.", i, position));
+		CHECK_MESSAGE(position.y < 6.0, vformat("Box %d was thrown out of the pile, it is at %s.", i, position));
+	}
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Batched queries match single queries") {
+	TestScene scene;
+	REQUIRE_MESSAGE(scene.get_godot_space(), "Requires the Godot physics server.");
+	scene.add_pile(6, 3);
+	scene.step(1);
+
+	PhysicsDirectSpaceState3D *state = scene.get_direct_state();
+	REQUIRE(state);
+
+	RandomPCG rng(42);
+	const int query_count = 200;
+	LocalVector<Vector3> from;
+	LocalVector<Vector3> to;
+	for (int i = 0; i < query_count; i++) {
+		from.push_back(Vector3(rng.random(-2.0f, 8.0f), rng.random(0.5f, 6.0f), rng.random(-2.0f, 8.0f)));
+		to.push_back(from[i] + Vector3(rng.random(-4.0f, 4.0f), rng.random(-6.0f, 1.0f), rng.random(-4.0f, 4.0f)));
+	}
+
+	SUBCASE("Rays") {
+		PhysicsDirectSpaceState3D::RayParameters parameters;
+		for (bool use_threads : { false, true }) {
+			LocalVector<PhysicsDirectSpaceState3D::RayResult> results;
+			results.resize(query_count);
+			int hit_count = state->intersect_rays_batch(parameters, from.ptr(), to.ptr(), query_count, results.ptr(), use_threads);
+
+			int expected_hit_count = 0;
+			for (int i = 0; i < query_count; i++) {
+				parameters.from = from[i];
+				parameters.to = to[i];
+				PhysicsDirectSpaceState3D::RayResult expected;
+				bool hit = state->intersect_ray(parameters, expected);
+				expected_hit_count += hit;
+				CHECK(results[i].rid.is_valid() == hit);
+				if (hit) {
+					CHECK(results[i].rid == expected.rid);
+					CHECK(results[i].position.is_equal_approx(expected.position));
+					CHECK(results[i].normal.is_equal_approx(expected.normal));
+				}
+			}
+			CHECK(expected_hit_count > 0);
+			CHECK(hit_count == expected_hit_count);
+		}
+	}
+
+	SUBCASE("Motions") {
+		RID sphere = PhysicsServer3D::get_singleton()->sphere_shape_create();
+		PhysicsServer3D::get_singleton()->shape_set_data(sphere, 0.25);
+
+		PhysicsDirectSpaceState3D::ShapeParameters parameters;
+		parameters.shape_rid = sphere;
+		LocalVector<Transform3D> transforms;
+		LocalVector<Vector3> motions;
+		for (int i = 0; i < query_count; i++) {
+			transforms.push_back(Transform3D(Basis(), from[i]));
+			motions.push_back(to[i] - from[i]);
+		}
+
+		for (bool use_threads : { false, true }) {
+			LocalVector<real_t> safe;
+			LocalVector<real_t> unsafe;
+			safe.resize(query_count);
+			unsafe.resize(query_count);
+			REQUIRE(state->cast_motions_batch(parameters, transforms.ptr(), motions.ptr(), query_count, safe.ptr(), unsafe.ptr(), use_threads));
+
+			for (int i = 0; i < query_count; i++) {
+				parameters.transform = transforms[i];
+				parameters.motion = motions[i];
+				real_t expected_safe = 1.0;
+				real_t expected_unsafe = 1.0;
+				REQUIRE(state->cast_motion(parameters, expected_safe, expected_unsafe));
+				CHECK(safe[i] == doctest::Approx(expected_safe));
+				CHECK(unsafe[i] == doctest::Approx(expected_unsafe));
+			}
+		}
+
+		PhysicsServer3D::get_singleton()->free(sphere);
+	}
+}
+
+static Vector<Vector3> make_sphere_points(int p_count, real_t p_radius, uint64_t p_seed) {
+	RandomPCG rng(p_seed);
+	Vector<Vector3> points;
+	for (int i = 0; i < p_count; i++) {
+		points.push_back(Vector3(rng.random(-1.0f, 1.0f), rng.random(-1.0f, 1.0f), rng.random(-1.0f, 1.0f)).normalized() * p_radius);
+	}
+	return points;
+}
+
+static void count_contact(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &p_normal, void *p_userdata) {
+	(*static_cast<int *>(p_userdata))++;
+}
+
+TEST_CASE("[PhysicsServer3D] Convex polygon supports match a full scan") {
+	// A small hull is scanned linearly, a large one is walked from its extreme vertices.
+	int point_count = 0;
+	SUBCASE("Small hull") {
+		point_count = 12;
+	}
+	SUBCASE("Large hull") {
+		point_count = 300;
+	}
+
+	GodotConvexPolygonShape3D convex;
+	convex.set_data(make_sphere_points(point_count, 0.5, 7));
+	const LocalVector<Vector3> &vertices = convex.get_mesh().vertices;
+	REQUIRE(vertices.size() > 4);
+
+	RandomPCG rng(13);
+	Transform3D transform(Basis(Vector3(1, 2, 3).normalized(), 0.7).scaled(Vector3(1, 2, 0.5)), Vector3(3, -1, 2));
+	for (int i = 0; i < 100; i++) {
+		Vector3 dir = Vector3(rng.random(-1.0f, 1.0f), rng.random(-1.0f, 1.0f), rng.random(-1.0f, 1.0f)).normalized();
+
+		real_t expected_max = -1e20;
+		real_t expected_min = 1e20;
+		real_t expected_support = -1e20;
+		for (const Vector3 &vertex : vertices) {
+			real_t d = dir.dot(transform.xform(vertex));
+			expected_min = MIN(expected_min, d);
+			expected_max = MAX(expected_max, d);
+			expected_support = MAX(expected_support, dir.dot(vertex));
+		}
+
+		CHECK(dir.dot(convex.get_support(dir)) == doctest::Approx(expected_support));
+
+		real_t min = 0.0, max = 0.0;
+		convex.project_range(dir, transform, min, max);
+		CHECK(min == doctest::Approx(expected_min));
+		CHECK(max == doctest::Approx(expected_max));
+	}
+}
+
+TEST_CASE("[PhysicsServer3D] Warm-started GJK matches a cold start") {
+	GodotBoxShape3D box;
+	box.set_data(Vector3(0.5, 0.5, 0.5));
+	GodotConvexPolygonShape3D convex;
+	convex.set_data(make_sphere_points(24, 0.5, 3));
+	GodotCylinderShape3D cylinder;
+	Dictionary cylinder_data;
+	cylinder_data["radius"] = 0.5;
+	cylinder_data["height"] = 1.0;
+	cylinder.set_data(cylinder_data);
+
+	const GodotShape3D *shapes[3] = { &box, &convex, &cylinder };
+	Transform3D transform_A(Basis(Vector3(0, 1, 0), 0.3), Vector3());
+
+	for (const GodotShape3D *shape_A : shapes) {
+		for (const GodotShape3D *shape_B : shapes) {
+			// The axis is carried along a motion, as body pairs and motion casts do.
+			Vector3 sep_axis;
+			for (int i = 0; i < 10; i++) {
+				Transform3D transform_B(Basis(Vector3(1, 0, 1).normalized(), i * 0.1), Vector3(0.2, 1.6 + i * 0.05, 0.1));
+
+				Vector3 cold_A, cold_B;
+				REQUIRE(gjk_epa_calculate_distance(shape_A, transform_A, shape_B, transform_B, cold_A, cold_B));
+				Vector3 warm_A, warm_B;
+				REQUIRE(gjk_epa_calculate_distance(shape_A, transform_A, shape_B, transform_B, warm_A, warm_B, &sep_axis));
+
+				CHECK(warm_A.distance_to(warm_B) == doctest::Approx(cold_A.distance_to(cold_B)).epsilon(0.001));
+				CHECK(sep_axis.dot((cold_B - cold_A).normalized()) == doctest::Approx(1.0).epsilon(0.001));
+			}
+		}
+	}
+
+	SUBCASE("Penetration") {
+		Transform3D transform_B(Basis(Vector3(1, 0, 1).normalized(), 0.4), Vector3(0.2, 0.8, 0.1));
+		Vector3 prev_axis;
+		int cold_contacts = 0;
+		REQUIRE(GodotCollisionSolver3D::solve_static(&cylinder, transform_A, &convex, transform_B, count_contact, &cold_contacts, &prev_axis));
+		REQUIRE(prev_axis != Vector3());
+		const Vector3 cold_axis = prev_axis;
+		int warm_contacts = 0;
+		CHECK(GodotCollisionSolver3D::solve_static(&cylinder, transform_A, &convex, transform_B, count_contact, &warm_contacts, &prev_axis));
+		CHECK(warm_contacts > 0);
+		CHECK(prev_axis.dot(cold_axis) == doctest::Approx(1.0).epsilon(0.001));
+	}
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D][Benchmark] Step time per phase" * doctest::skip()) {
+	// Bodies are kept awake, so that every step is measured under the same load.
+	const int steps = 300;
+
+	SUBCASE("Stacks") {
+		TestScene scene(false);
+		REQUIRE(scene.get_godot_space());
+		scene.add_stacks(100, 10);
+		scene.step(steps);
+		MESSAGE(vformat("Stacks:\n%s", scene.get_report()));
+	}
+	SUBCASE("Pile") {
+		TestScene scene(false);
+		REQUIRE(scene.get_godot_space());
+		scene.add_pile(16, 8);
+		scene.step(steps);
+		MESSAGE(vformat("Pile:\n%s", scene.get_report()));
+	}
+	SUBCASE("Ragdolls") {
+		TestScene scene(false);
+		REQUIRE(scene.get_godot_space());
+		scene.add_ragdolls(100);
+		scene.step(steps);
+		MESSAGE(vformat("Ragdolls:\n%s", scene.get_report()));
+	}
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D][Benchmark] Batched rays" * doctest::skip()) {
+	TestScene scene;
+	REQUIRE(scene.get_godot_space());
+	scene.add_stacks(400, 4);
+	scene.step(1);
+	PhysicsDirectSpaceState3D *state = scene.get_direct_state();
+
+	// Line of sight checks between random points over the stacks.
+	RandomPCG rng(42);
+	const int ray_count = 10000;
+	LocalVector<Vector3> from;
+	LocalVector<Vector3> to;
+	for (int i = 0; i < ray_count; i++) {
+		from.push_back(Vector3(rng.random(0.0f, 60.0f), 1.5, rng.random(0.0f, 60.0f)));
+		to.push_back(from[i] + Vector3(rng.random(-10.0f, 10.0f), 0.0, rng.random(-10.0f, 10.0f)));
+	}
+	PhysicsDirectSpaceState3D::RayParameters parameters;
+	LocalVector<PhysicsDirectSpaceState3D::RayResult> results;
+	results.resize(ray_count);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < ray_count; i++) {
+		parameters.from = from[i];
+		parameters.to = to[i];
+		state->intersect_ray(parameters, results[i]);
+	}
+	uint64_t single_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	state->intersect_rays_batch(parameters, from.ptr(), to.ptr(), ray_count, results.ptr(), false);
+	uint64_t batch_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	state->intersect_rays_batch(parameters, from.ptr(), to.ptr(), ray_count, results.ptr(), true);
+	uint64_t threaded_batch_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	MESSAGE(vformat("%d rays: %d usec one by one, %d usec batched, %d usec batched on threads.", ray_count, single_usec, batch_usec, threaded_batch_usec));
+}
+
+TEST_CASE("[PhysicsServer3D][Benchmark] Narrowphase per shape pair" * doctest::skip()) {
+	GodotSphereShape3D sphere;
+	sphere.set_data(0.5);
+	GodotBoxShape3D box;
+	box.set_data(Vector3(0.5, 0.5, 0.5));
+	GodotCapsuleShape3D capsule;
+	Dictionary capsule_data;
+	capsule_data["radius"] = 0.25;
+	capsule_data["height"] = 1.0;
+	capsule.set_data(capsule_data);
+	GodotCylinderShape3D cylinder;
+	Dictionary cylinder_data;
+	cylinder_data["radius"] = 0.5;
+	cylinder_data["height"] = 1.0;
+	cylinder.set_data(cylinder_data);
+	GodotConvexPolygonShape3D small_convex;
+	small_convex.set_data(make_sphere_points(16, 0.5, 1));
+	GodotConvexPolygonShape3D large_convex;
+	large_convex.set_data(make_sphere_points(256, 0.5, 2));
+
+	struct ShapePair {
+		const char *name = nullptr;
+		const GodotShape3D *shape_A = nullptr;
+		const GodotShape3D *shape_B = nullptr;
+	};
+	const ShapePair pairs[] = {
+		{ "sphere-convex", &sphere, &small_convex },
+		{ "box-box", &box, &box },
+		{ "box-capsule", &box, &capsule },
+		{ "box-convex", &box, &small_convex },
+		{ "capsule-convex", &capsule, &small_convex },
+		{ "cylinder-cylinder", &cylinder, &cylinder },
+		{ "cylinder-convex", &cylinder, &small_convex },
+		{ "convex-convex", &small_convex, &small_convex },
+		{ "large convex-large convex", &large_convex, &large_convex },
+	};
+
+	// Slowly moving shapes in contact, as in a resting pile.
+	const int iterations = 20000;
+	String report;
+	for (const ShapePair &pair : pairs) {
+		uint64_t usec[2] = {};
+		int contacts[2] = {};
+		for (int warm = 0; warm < 2; warm++) {
+			Vector3 sep_axis;
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < iterations; i++) {
+				Transform3D transform_B(Basis(Vector3(1, 0, 1).normalized(), i * 0.0001), Vector3(0.1, 0.9, 0.05));
+				GodotCollisionSolver3D::solve_static(pair.shape_A, Transform3D(), pair.shape_B, transform_B, count_contact, &contacts[warm], warm ? &sep_axis : nullptr);
+			}
+			usec[warm] = OS::get_singleton()->get_ticks_usec() - begin;
+		}
+
+		uint64_t distance_usec[2] = {};
+		for (int warm = 0; warm < 2; warm++) {
+			Vector3 sep_axis;
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < iterations; i++) {
+				Transform3D transform_B(Basis(Vector3(1, 0, 1).normalized(), i * 0.0001), Vector3(0.1, 1.5, 0.05));
+				Vector3 point_A, point_B;
+				gjk_epa_calculate_distance(pair.shape_A, Transform3D(), pair.shape_B, transform_B, point_A, point_B, warm ? &sep_axis : nullptr);
+			}
+			distance_usec[warm] = OS::get_singleton()->get_ticks_usec() - begin;
+		}
+
+		report += vformat("%s: contacts %d / %d usec (cold / warm), distance %d / %d usec (cold / warm).\n", pair.name, usec[0], usec[1], distance_usec[0], distance_usec[1]);
+	}
+	MESSAGE(vformat("%d iterations per shape pair:\n%s", iterations, report));
+}
+
+} // namespace TestPhysicsServer3D
+
+#endif // TEST_PHYSICS_SERVER_3D_H
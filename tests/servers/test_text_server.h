@@ -766,6 +766,104 @@ TEST_SUITE("[TextServer]") {
 				}
 			}
 		}
+
+		SUBCASE("[TextServer] Asynchronous glyph rendering") {
+			for (int i = 0; i < TextServerManager::get_singleton()->get_interface_count(); i++) {
+				Ref<TextServer> ts = TextServerManager::get_singleton()->get_interface(i);
+				CHECK_FALSE_MESSAGE(ts.is_null(), "Invalid TS interface.");
+
+				if (!ts->has_feature(TextServer::FEATURE_FONT_DYNAMIC)) {
+					continue;
+				}
+
+				for (int msdf = 0; msdf < 2; msdf++) {
+					RID font_sync = ts->create_font();
+					ts->font_set_data_ptr(font_sync, _font_NotoSans_Regular, _font_NotoSans_Regular_size);
+					ts->font_set_multichannel_signed_distance_field(font_sync, msdf);
+					RID font_async = ts->create_font();
+					ts->font_set_data_ptr(font_async, _font_NotoSans_Regular, _font_NotoSans_Regular_size);
+					ts->font_set_multichannel_signed_distance_field(font_async, msdf);
+
+					const Vector2i size = Vector2i(16, 0);
+					ts->font_render_range(font_sync, size, 0x20, 0x7e);
+					ts->font_render_range_async(font_async, size, 0x20, 0x7e);
+
+					// Glyphs are packed in another order, but must have the same metrics.
+					for (char32_t c = 0x20; c <= 0x7e; c++) {
+						int64_t glyph = ts->font_get_glyph_index(font_sync, 16, c, 0);
+						CHECK(ts->font_get_glyph_size(font_sync, size, glyph) == ts->font_get_glyph_size(font_async, size, glyph));
+						CHECK(ts->font_get_glyph_offset(font_sync, size, glyph) == ts->font_get_glyph_offset(font_async, size, glyph));
+						CHECK(ts->font_get_glyph_advance(font_sync, 16, glyph) == ts->font_get_glyph_advance(font_async, 16, glyph));
+					}
+					CHECK(ts->font_get_texture_count(font_async, size) > 0);
+
+					ts->free_rid(font_sync);
+					ts->free_rid(font_async);
+				}
+			}
+		}
+
+		SUBCASE("[TextServer] Shaping cache") {
+			for (int i = 0; i < TextServerManager::get_singleton()->get_interface_count(); i++) {
+				Ref<TextServer> ts = TextServerManager::get_singleton()->get_interface(i);
+				CHECK_FALSE_MESSAGE(ts.is_null(), "Invalid TS interface.");
+
+				if (!ts->has_feature(TextServer::FEATURE_FONT_DYNAMIC) || ts->shaping_cache_get_capacity() == 0) {
+					continue;
+				}
+
+				RID font1 = ts->create_font();
+				ts->font_set_data_ptr(font1, _font_NotoSans_Regular, _font_NotoSans_Regular_size);
+				Array font;
+				font.push_back(font1);
+
+				String test = U"Shaping cache test";
+				int64_t hits = ts->shaping_cache_get_hit_count();
+				int64_t misses = ts->shaping_cache_get_miss_count();
+
+				RID ctx1 = ts->create_shaped_text();
+				ts->shaped_text_add_string(ctx1, test, font, 16);
+				CHECK(ts->shaped_text_shape(ctx1));
+				CHECK(ts->shaping_cache_get_miss_count() == misses + 1);
+
+				// Same source data, reuses the result of the first buffer.
+				RID ctx2 = ts->create_shaped_text();
+				ts->shaped_text_add_string(ctx2, test, font, 16);
+				CHECK(ts->shaped_text_shape(ctx2));
+				CHECK(ts->shaping_cache_get_hit_count() == hits + 1);
+				CHECK(ts->shaped_text_get_glyph_count(ctx1) == ts->shaped_text_get_glyph_count(ctx2));
+				CHECK(ts->shaped_text_get_width(ctx1) == doctest::Approx(ts->shaped_text_get_width(ctx2)));
+
+				// Different size is a different key.
+				RID ctx3 = ts->create_shaped_text();
+				ts->shaped_text_add_string(ctx3, test, font, 20);
+				CHECK(ts->shaped_text_shape(ctx3));
+				CHECK(ts->shaping_cache_get_miss_count() == misses + 2);
+
+				// Font changes invalidate the cached results.
+				ts->font_set_spacing(font1, TextServer::SPACING_GLYPH, 2);
+				ts->shaped_text_clear(ctx2);
+				ts->shaped_text_add_string(ctx2, test, font, 16);
+				CHECK(ts->shaped_text_shape(ctx2));
+				CHECK(ts->shaping_cache_get_hit_count() == hits + 1);
+				CHECK(ts->shaped_text_get_width(ctx2) > ts->shaped_text_get_width(ctx1));
+
+				// Setting an unchanged value or an atlas-only property keeps them.
+				ts->font_set_spacing(font1, TextServer::SPACING_GLYPH, 2);
+				ts->font_set_embolden(font1, ts->font_get_embolden(font1));
+				ts->font_set_generate_mipmaps(font1, !ts->font_get_generate_mipmaps(font1));
+				RID ctx4 = ts->create_shaped_text();
+				ts->shaped_text_add_string(ctx4, test, font, 16);
+				CHECK(ts->shaped_text_shape(ctx4));
+				CHECK(ts->shaping_cache_get_hit_count() == hits + 2);
+
+				ts->free_rid(ctx1);
+				ts->free_rid(ctx2);
+				ts->free_rid(ctx3);
+				ts->free_rid(ctx4);
+				ts->free_rid(font1);
+			}
+		}
 	}
 }
 }; // namespace TestTextServer